@@ -26,6 +26,80 @@ BOOL_SIZE = 1
 
 HEADER_SIZE = 128
 
+# Entry of the chunk index of compressed fields (see DumpChunk in src/output/dump.hpp)
+CHUNK_FORMAT = "6i2iqqd"
+CHUNK_SIZE = struct.calcsize("=" + CHUNK_FORMAT)
+
+
+def _lzDecompress(src, n):
+    # Decoder of the LZ77 stream written by DumpCodec::LzCompress
+    out = bytearray(n)
+    ip = 0
+    op = 0
+    size = len(src)
+
+    def readLength(ip, length):
+        if length == 15:
+            while True:
+                b = src[ip]
+                ip += 1
+                length += b
+                if b != 255:
+                    break
+        return ip, length
+
+    while op < n:
+        token = src[ip]
+        ip += 1
+        ip, litLen = readLength(ip, token >> 4)
+        out[op : op + litLen] = src[ip : ip + litLen]
+        ip += litLen
+        op += litLen
+        if op >= n:
+            break
+        offset = src[ip] | (src[ip + 1] << 8)
+        ip += 2
+        ip, length = readLength(ip, token & 15)
+        length += 4
+        if offset >= length:
+            out[op : op + length] = out[op - offset : op - offset + length]
+        else:
+            # overlapping match
+            for k in range(length):
+                out[op + k] = out[op + k - offset]
+        op += length
+    if op != n or ip > size:
+        raise RuntimeError("Corrupted chunk in compressed dump file")
+    return out
+
+
+def _decompressChunk(raw, codec, tolerance, wordSize, n, byteorder):
+    # Inverse of DumpCodec::Compress
+    bo = "<" if byteorder == "little" else ">"
+    dtype = np.dtype(bo + ("f8" if wordSize == 8 else "f4"))
+    if codec == 1:
+        # lossy: quantized values stored as zigzag varint differences
+        nq = struct.unpack(bo + "q", raw[:8])[0]
+        quantized = _lzDecompress(raw[8:], nq)
+        diffs = np.empty(n, dtype=np.int64)
+        ip = 0
+        for i in range(n):
+            z = 0
+            shift = 0
+            while True:
+                b = quantized[ip]
+                ip += 1
+                z |= (b & 0x7F) << shift
+                shift += 7
+                if not b & 0x80:
+                    break
+            diffs[i] = (z >> 1) ^ -(z & 1)
+        q = np.cumsum(diffs)
+        return (q * (2.0 * tolerance)).astype(dtype)
+    # lossless: byte-shuffled values
+    shuffled = np.frombuffer(_lzDecompress(raw, n * wordSize), dtype=np.uint8)
+    return shuffled.reshape(wordSize, n).T.copy().view(dtype).reshape(n)
+
 
 class DumpField(object):
     def __init__(self, fh, byteorder="little"):
@@ -52,6 +126,9 @@ class DumpField(object):
             mysize = BOOL_SIZE
             stringchar = "?"
             dtype = bool
+        elif self.type == 4:
+            self._read_compressed(fh, byteorder)
+            return
         else:
             raise RuntimeError(
                 "Found unknown data type %d for field %s" % (self.type, self.name)
@@ -65,6 +142,35 @@ class DumpField(object):
         raw = struct.unpack(str(ntot) + stringchar, fh.read(mysize * ntot))
         self.array = np.asarray(raw, dtype=dtype).reshape(dims[::-1]).T
 
+    def _read_compressed(self, fh, byteorder):
+        # chunked compressed field: chunk index, followed by the compressed chunks
+        bo = "<" if byteorder == "little" else ">"
+        self.ndims = int.from_bytes(fh.read(INT_SIZE), byteorder)
+        dims = [int.from_bytes(fh.read(INT_SIZE), byteorder) for dim in range(self.ndims)]
+        nchunks = int.from_bytes(fh.read(INT_SIZE), byteorder)
+        index = [
+            struct.unpack(bo + CHUNK_FORMAT, fh.read(CHUNK_SIZE)) for c in range(nchunks)
+        ]
+        start = fh.tell()
+        array = None
+        for chunk in index:
+            cstart = chunk[0:3]
+            csize = chunk[3:6]
+            codec, wordSize, position, nbytes, tolerance = chunk[6:]
+            fh.seek(start + position)
+            values = _decompressChunk(
+                fh.read(nbytes), codec, tolerance, wordSize, np.prod(csize), byteorder
+            )
+            if array is None:
+                array = np.empty(dims[::-1], dtype=values.dtype)
+            array[
+                cstart[2] : cstart[2] + csize[2],
+                cstart[1] : cstart[1] + csize[1],
+                cstart[0] : cstart[0] + csize[0],
+            ] = values.reshape(csize[::-1])
+        fh.seek(start + sum(chunk[9] for chunk in index))
+        self.array = array.T
+
 
 class DumpDataset(object):
     def __init__(self, filename):
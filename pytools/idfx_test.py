@@ -66,6 +66,10 @@ class idfxTest:
                         help="Enable single precision",
                         action="store_true")
 
+    parser.add_argument("-mixed",
+                        help="Enable mixed precision (single precision storage, double precision arithmetic)",
+                        action="store_true")
+
     parser.add_argument("-vectPot",
                         help="Enable vector potential formulation",
                         action="store_true")
@@ -127,6 +131,8 @@ class idfxTest:
     #if we use single precision
     if(self.single):
       comm.append("-DIdefix_PRECISION=Single")
+    elif(self.mixed):
+      comm.append("-DIdefix_PRECISION=Mixed")
     else:
       comm.append("-DIdefix_PRECISION=Double")
 
@@ -232,6 +238,11 @@ class idfxTest:
     else:
       self.single = False
 
+    if "MIXED PRECISION" in log:
+      self.mixed = True
+    else:
+      self.mixed = False
+
     if "Kokkos CUDA target ENABLED" in log:
       self.cuda = True
     else:
@@ -338,6 +349,9 @@ class idfxTest:
 
   def makeReference(self,filename):
     self._readLog()
+    if self.mixed:
+      print(bcolors.WARNING+"References are not created from mixed precision runs"+bcolors.ENDC)
+      return
     targetDir = os.path.join(self.referenceDirectory,self.testDir)
     if not os.path.exists(targetDir):
       print("Creating reference directory")
@@ -364,6 +378,8 @@ class idfxTest:
     print("Input File: "+self.inifile)
     if(self.single):
       print("Precision: Single")
+    elif(self.mixed):
+      print("Precision: Mixed")
     else:
       print("Precision: Double")
     if(self.reconstruction==2):
@@ -390,6 +406,7 @@ class idfxTest:
     if self.reconstruction == 4:
       strReconstruction= "ppm"
 
+    # Mixed precision runs are compared to the double precision references
     strPrecision="double"
     if self.single:
       strPrecision="single"
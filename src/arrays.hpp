@@ -16,7 +16,7 @@ template <typename T> using IdefixArray2D =
 template <typename T> using IdefixArray3D =
                             Kokkos::View<T***, Layout, Device>;
 template <typename T> using IdefixArray4D =
-                            Kokkos::View<T****, Layout, Device>;
+                            Kokkos::View<T****, Layout4D, Device>;
 
 template <typename T> using IdefixHostArray1D =
                             Kokkos::View<T*, Kokkos::LayoutRight, Kokkos::HostSpace>;
@@ -37,6 +37,29 @@ template <typename T> using IdefixAtomicArray2D =
 template <typename T> using IdefixAtomicArray3D =
                             Kokkos::View<T***, Layout, Device,
                                          Kokkos::MemoryTraits<Kokkos::Atomic>>;
+
+// Unmanaged arrays living in the scratch memory of a team (e.g. GPU shared memory)
+template <typename T> using IdefixScratchArray1D =
+                            Kokkos::View<T*, Layout,
+                                         Device::scratch_memory_space,
+                                         Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+template <typename T> using IdefixScratchArray2D =
+                            Kokkos::View<T**, Layout,
+                                         Device::scratch_memory_space,
+                                         Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+// Layout of a 4D array of extents (nv, nk, nj, ni), where nv is the variable index.
+// IdefixArray4D should always be allocated with this layout.
+inline Layout4D IdefixLayout4D(const size_t nv, const size_t nk,
+                               const size_t nj, const size_t ni) {
+  #ifdef FIELD_LAYOUT_AOS
+    // Array of structures: all of the variables of a cell are contiguous in memory
+    return Layout4D(nv, 1, nk, nv*ni*nj, nj, nv*ni, ni, nv);
+  #else
+    return Layout4D(nv, nk, nj, ni);
+  #endif
+}
+
 /*
 template <typename T> using IdefixHostArray1D = Kokkos::View<T*, Layout, Host>;
 template <typename T> using IdefixHostArray2D = Kokkos::View<T**, Layout, Host>;
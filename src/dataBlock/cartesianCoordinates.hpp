@@ -0,0 +1,53 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef DATABLOCK_CARTESIANCOORDINATES_HPP_
+#define DATABLOCK_CARTESIANCOORDINATES_HPP_
+
+#include "idefix.hpp"
+
+// Cartesian coordinates of the cell centers, for the kernels which need them (planets, user
+// source terms...). By default, they are computed from the separable trigonometric functions of
+// the DataBlock, which only costs a few multiplications per cell and no 3D array. When cached,
+// they are read from 3D arrays filled once by DataBlock::MakeGeometry.
+// In cylindrical geometry, the coordinates are those of the (phi=0) meridional plane.
+struct CartesianCoordinates {
+  bool cached{false};                 ///< Whether the 3D arrays are used
+  IdefixArray3D<real> xc, yc, zc;     ///< Cached coordinates (only when cached)
+  IdefixArray1D<real> x1, x2, x3;     ///< Cell centers
+  IdefixArray1D<real> sinx2, cosx2;   ///< sin/cos of x2 (polar and spherical)
+  IdefixArray1D<real> sinx3, cosx3;   ///< sin/cos of x3 (spherical)
+
+  KOKKOS_INLINE_FUNCTION void Get(int k, int j, int i, real &x, real &y, real &z) const {
+    if(cached) {
+      x = xc(k,j,i);
+      y = yc(k,j,i);
+      z = zc(k,j,i);
+      return;
+    }
+    #if GEOMETRY == CARTESIAN
+      x = x1(i);
+      y = x2(j);
+      z = x3(k);
+    #elif GEOMETRY == POLAR
+      x = x1(i)*cosx2(j);
+      y = x1(i)*sinx2(j);
+      z = x3(k);
+    #elif GEOMETRY == SPHERICAL
+      const real R = x1(i)*sinx2(j);
+      x = R*cosx3(k);
+      y = R*sinx3(k);
+      z = x1(i)*cosx2(j);
+    #else
+      x = x1(i);
+      y = ZERO_F;
+      z = x2(j);
+    #endif
+  }
+};
+
+#endif // DATABLOCK_CARTESIANCOORDINATES_HPP_
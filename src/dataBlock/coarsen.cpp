@@ -23,6 +23,20 @@ void DataBlock::Coarsen() {
   #endif
 }
 
+// Coarsen the *primitive* variables, before the boundary conditions are enforced
+void DataBlock::CoarsenFlow() {
+  ComputeGridCoarseningLevels();
+  hydro->CoarsenFlow(hydro->Vc);
+  #if MHD==YES
+    hydro->CoarsenMagField(hydro->Vs);
+  #endif
+  if(haveDust) {
+    for(int i = 0 ; i < dust.size() ; i++) {
+      dust[i]->CoarsenFlow(dust[i]->Vc);
+    }
+  }
+}
+
 void DataBlock::EnrollGridCoarseningLevels(GridCoarseningFunc func) {
   if(!haveGridCoarsening) {
     IDEFIX_WARNING("DataBlock:EnrollCoarseningLevels was called but grid "
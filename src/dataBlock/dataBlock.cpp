@@ -30,9 +30,8 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
   // Get the number of points from the parent grid object
   for(int dir = 0 ; dir < 3 ; dir++) {
     nghost[dir] = grid.nghost[dir];
-    // Domain decomposition: decompose the full domain size in grid by the number of processes
-    // in that direction
-    np_int[dir] = grid.np_int[dir]/grid.nproc[dir];
+    // Domain decomposition: the slice of cells of this process in that direction
+    np_int[dir] = grid.procBeg[dir][grid.xproc[dir]+1] - grid.procBeg[dir][grid.xproc[dir]];
     np_tot[dir] = np_int[dir]+2*nghost[dir];
 
     // Boundary conditions
@@ -54,9 +53,8 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
     end[dir] = grid.nghost[dir]+np_int[dir];
 
     // Where does this datablock starts and end in the grid?
-    // This assumes even distribution of points between procs
-    gbeg[dir] = grid.nghost[dir] + grid.xproc[dir]*np_int[dir];
-    gend[dir] = grid.nghost[dir] + (grid.xproc[dir]+1)*np_int[dir];
+    gbeg[dir] = grid.nghost[dir] + grid.procBeg[dir][grid.xproc[dir]];
+    gend[dir] = gbeg[dir] + np_int[dir];
 
     // Local start and end of current datablock
     xbeg[dir] = gridHost.xl[dir](gbeg[dir]);
@@ -88,15 +86,23 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
 
   dV = IdefixArray3D<real>("DataBlock_dV",np_tot[KDIR],np_tot[JDIR],np_tot[IDIR]);
 
+#if GEOMETRY == POLAR || GEOMETRY == SPHERICAL
+  sinx2 = IdefixArray1D<real>("DataBlock_sinx2",np_tot[JDIR]);
+  cosx2 = IdefixArray1D<real>("DataBlock_cosx2",np_tot[JDIR]);
+#endif
 #if GEOMETRY == SPHERICAL
   rt = IdefixArray1D<real>("DataBlock_rt",np_tot[IDIR]);
   sinx2m = IdefixArray1D<real>("DataBlock_sinx2m",np_tot[JDIR]);
   tanx2m = IdefixArray1D<real>("DataBlock_tanx2m",np_tot[JDIR]);
-  sinx2 = IdefixArray1D<real>("DataBlock_sinx2",np_tot[JDIR]);
   tanx2 = IdefixArray1D<real>("DataBlock_tanx2",np_tot[JDIR]);
+  sinx3 = IdefixArray1D<real>("DataBlock_sinx3",np_tot[KDIR]);
+  cosx3 = IdefixArray1D<real>("DataBlock_cosx3",np_tot[KDIR]);
   dmu = IdefixArray1D<real>("DataBlock_dmu",np_tot[JDIR]);
 #endif
 
+  // Store the cartesian coordinates of the cells instead of computing them in each kernel
+  haveCartesianCache = input.GetOrSet<bool>("Memory","cartesianCache",0, false);
+
   // Initialize our sub-domain
   this->ExtractSubdomain();
 
@@ -121,6 +127,23 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
   #endif
 
 
+  // Overlap of the ghost zone exchange with computations
+  haveBoundaryOverlap = input.GetOrSet<bool>("Parallel","overlap",0, false);
+
+  // Pattern of the ghost zone exchange
+  std::string exchange = input.GetOrSet<std::string>("Parallel","exchange",0, "directional");
+  if(exchange.compare("neighbour") == 0) {
+    haveNeighbourExchange = true;
+  } else if(exchange.compare("directional") != 0) {
+    std::stringstream msg;
+    msg << "Unknown ghost zone exchange " << exchange << " in [Parallel]." << std::endl
+        << "Use either directional or neighbour.";
+    IDEFIX_ERROR(msg);
+  }
+
+  // Scratch buffers of the modules, which should be created before them
+  this->scratch = std::make_unique<ScratchArena>(input);
+
   // Initialize the hydro object attached to this datablock
   this->hydro = std::make_unique<Fluid<DefaultPhysics>>(grid, input, this);
 
@@ -146,9 +169,22 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
   if(input.CheckBlock("Dust")) {
     haveDust = true;
     int nSpecies = input.Get<int>("Dust","nSpecies",0);
+    if(input.GetOrSet<bool>("Dust","batch",0,false)) {
+      this->dustBatch = std::make_unique<DustBatch>(input, this);
+      this->haveDustBatch = true;
+    } else if(input.GetOrSet<bool>("Dust","drag_implicit",0,false)) {
+      IDEFIX_ERROR("The implicit drag requires the dust batch (batch entry in [Dust])");
+    }
     for(int i = 0 ; i < nSpecies ; i++) {
       dust.emplace_back(std::make_unique<Fluid<DustPhysics>>(grid, input, this, i));
     }
+    if(haveDustBatch) dustBatch->InitDrag();
+  }
+
+  // Initialise local time stepping if needed
+  if(input.CheckEntry("TimeIntegrator","lts_levels")>=0) {
+    this->lts = std::make_unique<LocalTimestep>(input, this);
+    this->haveLocalTimestep = true;
   }
   // Register variables that need to be saved in case of restart dump
   dump->RegisterVariable(&t, "time");
@@ -175,9 +211,8 @@ DataBlock::DataBlock(SubGrid *subgrid) {
   // Get the number of points from the parent grid object
   for(int dir = 0 ; dir < 3 ; dir++) {
     nghost[dir] = grid->nghost[dir];
-    // Domain decomposition: decompose the full domain size in grid by the number of processes
-    // in that direction
-    np_int[dir] = grid->np_int[dir]/grid->nproc[dir];
+    // Domain decomposition: the slice of cells of this process in that direction
+    np_int[dir] = grid->procBeg[dir][grid->xproc[dir]+1] - grid->procBeg[dir][grid->xproc[dir]];
     np_tot[dir] = np_int[dir]+2*nghost[dir];
 
     // Boundary conditions
@@ -199,9 +234,8 @@ DataBlock::DataBlock(SubGrid *subgrid) {
     end[dir] = grid->nghost[dir]+np_int[dir];
 
     // Where does this datablock starts and end in the grid?
-    // This assumes even distribution of points between procs
-    gbeg[dir] = grid->nghost[dir] + grid->xproc[dir]*np_int[dir];
-    gend[dir] = grid->nghost[dir] + (grid->xproc[dir]+1)*np_int[dir];
+    gbeg[dir] = grid->nghost[dir] + grid->procBeg[dir][grid->xproc[dir]];
+    gend[dir] = gbeg[dir] + np_int[dir];
 
     // Local start and end of current datablock
     xbeg[dir] = gridHost.xl[dir](gbeg[dir]);
@@ -250,7 +284,9 @@ DataBlock::DataBlock(SubGrid *subgrid) {
 
 void DataBlock::ResetStage() {
   this->hydro->ResetStage();
-  if(haveDust) {
+  if(haveDustBatch) {
+    dustBatch->ResetStage();
+  } else if(haveDust) {
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->ResetStage();
     }
@@ -259,7 +295,9 @@ void DataBlock::ResetStage() {
 
 void DataBlock::ConsToPrim() {
   this->hydro->ConvertConsToPrim();
-  if(haveDust) {
+  if(haveDustBatch) {
+    dustBatch->ConvertConsToPrim();
+  } else if(haveDust) {
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->ConvertConsToPrim();
     }
@@ -268,7 +306,9 @@ void DataBlock::ConsToPrim() {
 
 void DataBlock::PrimToCons() {
   this->hydro->ConvertPrimToCons();
-  if(haveDust) {
+  if(haveDustBatch) {
+    dustBatch->ConvertPrimToCons();
+  } else if(haveDust) {
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->ConvertPrimToCons();
     }
@@ -277,18 +317,7 @@ void DataBlock::PrimToCons() {
 
 // Set the boundaries of the data structures in this datablock
 void DataBlock::SetBoundaries() {
-  if(haveGridCoarsening) {
-    ComputeGridCoarseningLevels();
-    hydro->CoarsenFlow(hydro->Vc);
-    #if MHD==YES
-      hydro->CoarsenMagField(hydro->Vs);
-    #endif
-    if(haveDust) {
-      for(int i = 0 ; i < dust.size() ; i++) {
-        dust[i]->CoarsenFlow(dust[i]->Vc);
-      }
-    }
-  }
+  if(haveGridCoarsening) CoarsenFlow();
   if(haveDust) {
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->boundary->SetBoundaries(t);
@@ -297,6 +326,18 @@ void DataBlock::SetBoundaries() {
   hydro->boundary->SetBoundaries(t);
 }
 
+// Set the boundaries which do not involve the ghost zones. These are exchanged and enforced
+// direction by direction in EvolveStage, overlapped with the update of the interior cells.
+void DataBlock::StartBoundaries() {
+  if(haveGridCoarsening) CoarsenFlow();
+  if(haveDust) {
+    for(int i = 0 ; i < dust.size() ; i++) {
+      dust[i]->boundary->SetInternalBoundaries(t);
+    }
+  }
+  hydro->boundary->SetInternalBoundaries(t);
+}
+
 
 
 void DataBlock::ShowConfig() {
@@ -308,10 +349,35 @@ void DataBlock::ShowConfig() {
         << "...." << xend[dir] << std::endl;
     }
   }
+  if(haveCartesianCache) {
+    idfx::cout << "DataBlock: cartesian coordinates of the cells stored in 3D arrays."
+               << std::endl;
+  }
+  if(haveBoundaryOverlap) {
+    idfx::cout << "DataBlock: ghost zone exchange overlapped with computations." << std::endl;
+    if(haveFargo) {
+      IDEFIX_ERROR("The overlap of the ghost zone exchange is incompatible with Fargo.");
+    }
+  }
+  #ifdef WITH_MPI
+  if(haveNeighbourExchange) {
+    idfx::cout << "DataBlock: ghost zones exchanged with all neighbours in a single round."
+               << std::endl;
+    for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+      for(BoundaryType bound : {mygrid->lbound[dir], mygrid->rbound[dir]}) {
+        if(bound == shearingbox || bound == axis) {
+          IDEFIX_ERROR("The neighbour ghost zone exchange is incompatible with shearingbox "
+                       "and axis boundaries.");
+        }
+      }
+    }
+  }
+  #endif
   hydro->ShowConfig();
   if(haveFargo) fargo->ShowConfig();
   if(haveplanetarySystem) planetarySystem->ShowConfig();
   if(haveGravity) gravity->ShowConfig();
+  if(haveLocalTimestep) lts->ShowConfig();
   if(haveUserStepFirst) idfx::cout << "DataBlock: User's first step has been enrolled."
                                    << std::endl;
   if(haveUserStepLast) idfx::cout << "DataBlock: User's last step has been enrolled."
@@ -320,11 +386,13 @@ void DataBlock::ShowConfig() {
     idfx::cout << "DataBlock: evolving " << dust.size() << " dust species." << std::endl;
     // Only show the config the first dust specie
     dust[0]->ShowConfig();
+    if(haveDustBatch) dustBatch->ShowConfig();
     /*
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->ShowConfig();
     }*/
   }
+  scratch->ShowConfig();
 }
 
 
@@ -334,6 +402,24 @@ real DataBlock::ComputeTimestep() {
   // First with the hydro block
   auto InvDt = hydro->InvDt;
   real dt;
+  if(haveDustBatch) {
+    // All of the dust species in the same reduction as the gas
+    auto InvDtDust = dustBatch->InvDt;
+    const int nSpecies = dust.size();
+    idefix_reduce("Timestep_reduction",
+          beg[KDIR], end[KDIR],
+          beg[JDIR], end[JDIR],
+          beg[IDIR], end[IDIR],
+          KOKKOS_LAMBDA (int k, int j, int i, real &dtmin) {
+                  dtmin=FMIN(ONE_F/InvDt(k,j,i),dtmin);
+                  for(int n = 0 ; n < nSpecies ; n++) {
+                    dtmin=FMIN(ONE_F/InvDtDust(n,k,j,i),dtmin);
+                  }
+              },
+          Kokkos::Min<real>(dt));
+    Kokkos::fence();
+    return(dt);
+  }
   idefix_reduce("Timestep_reduction",
           beg[KDIR], end[KDIR],
           beg[JDIR], end[JDIR],
@@ -19,6 +19,10 @@
 #include "planetarySystem.hpp"
 #include "gravity.hpp"
 #include "stateContainer.hpp"
+#include "localTimestep.hpp"
+#include "dustBatch.hpp"
+#include "scratchArena.hpp"
+#include "cartesianCoordinates.hpp"
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 /// The DataBlock class is designed to store the data and child class instances that belongs to the
@@ -63,11 +67,19 @@ class DataBlock {
                                ///< gives sin(th) at a j-1/2 interface
   IdefixArray1D<real> tanx2m;  ///< In spherical coordinates,
                                ///< gives tan(th) at a j-1/2 interface
-  IdefixArray1D<real> sinx2;   ///< In spherical coordinates, gives sin(th) at the cell center
+  IdefixArray1D<real> sinx2;   ///< In polar and spherical coordinates,
+                               ///< gives sin(x2) at the cell center
+  IdefixArray1D<real> cosx2;   ///< In polar and spherical coordinates,
+                               ///< gives cos(x2) at the cell center
   IdefixArray1D<real> tanx2;   ///< In spherical coordinates, gives tan(th) at the cell center
+  IdefixArray1D<real> sinx3;   ///< In spherical coordinates, gives sin(phi) at the cell center
+  IdefixArray1D<real> cosx3;   ///< In spherical coordinates, gives cos(phi) at the cell center
   IdefixArray1D<real> dmu;     ///< In spherical coordinates,
                                ///< gives the $\theta$ volume = fabs(cos(th_m) - cos(th_p))
 
+  CartesianCoordinates cartesian; ///< Cartesian coordinates of the cell centers
+  bool haveCartesianCache{false}; ///< Whether the cartesian coordinates are stored in 3D arrays
+
   std::array<IdefixArray2D<int>,3> coarseningLevel; ///< Grid coarsening levels
                                                   ///< (only defined when coarsening
                                                   ///< is enabled)
@@ -111,9 +123,13 @@ class DataBlock {
                                 ///< conservative state of the datablock
                                 ///< (contains references to dedicated objects)
 
+  std::unique_ptr<ScratchArena> scratch;  ///< Scratch buffers shared by the modules
+
   std::unique_ptr<Fluid<DefaultPhysics>> hydro;   ///< The Hydro object attached to this datablock
   bool haveDust{false};
   std::vector<std::unique_ptr<Fluid<DustPhysics>>> dust; ///< Holder for zero pressure dust fluid
+  bool haveDustBatch{false};
+  std::unique_ptr<DustBatch> dustBatch;  ///< Shared storage and batched kernels of the dust
 
   std::unique_ptr<Vtk> vtk;
   std::unique_ptr<Dump> dump;
@@ -137,10 +153,17 @@ class DataBlock {
 
 
   bool rklCycle{false};           ///<  // Set to true when we're inside a RKL call
+  bool hallCycle{false};          ///< Set to true when we're inside the Hall subcycles
+  bool haveBoundaryOverlap{false}; ///< Whether the ghost zones are exchanged while the interior
+                                   ///< of the domain is evolved
+  bool haveNeighbourExchange{false}; ///< Whether the ghost zones are exchanged with all of the
+                                     ///< neighbours (including corners) in a single round
 
   void EvolveStage();             ///< Evolve this DataBlock by dt
   void EvolveRKLStage();          ///< Evolve this DataBlock by dt for terms impacted by RKL
+  void EvolveHallStage();         ///< Evolve the field of this DataBlock by dt for Hall effect
   void SetBoundaries();       ///< Enforce boundary conditions to this datablock
+  void StartBoundaries();     ///< Same, but leave the ghost zones to be filled by EvolveStage
   void ConsToPrim();       ///< Convert conservative to primitive variables
   void PrimToCons();       ///< Convert primitive to conservative variables
   void DeriveVectorPotential(); ///< Compute magnetic fields from vector potential where applicable
@@ -158,6 +181,10 @@ class DataBlock {
   bool haveFargo{false};
   std::unique_ptr<Fargo> fargo;
 
+  // Do we use local time stepping ?
+  bool haveLocalTimestep{false};
+  std::unique_ptr<LocalTimestep> lts;
+
   // Do we have Gravity ?
   bool haveGravity{false};
   std::unique_ptr<Gravity> gravity;
@@ -172,6 +199,7 @@ class DataBlock {
  private:
   void WriteVariable(FILE* , int , int *, char *, void*);
   void ComputeGridCoarseningLevels();   ///< Call user defined function to define Coarsening levels
+  void CoarsenFlow();                   ///< Coarsen the flow before enforcing boundary conditions
 
   // User Steps (either before or after the main integration loop)
   bool haveUserStepFirst{false};
@@ -64,7 +64,7 @@ DataBlockHost::DataBlockHost(DataBlock& datain) {
             Ex2 = Kokkos::create_mirror_view(data->hydro->emf->ey);  )
 #endif
   if(haveDust) {
-    dustVc = std::vector<IdefixHostArray4D<real>>(data->dust.size());
+    dustVc = std::vector<IdefixArray4D<realStore>::HostMirror>(data->dust.size());
     for(int i = 0 ; i < data->dust.size() ; i++) {
       dustVc[i] = Kokkos::create_mirror_view(data->dust[i]->Vc);
     }
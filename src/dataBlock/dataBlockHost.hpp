@@ -33,10 +33,11 @@ class DataBlockHost {
   IdefixArray3D<real>::HostMirror dV;     ///< cell volume
   std::array<IdefixArray3D<real>::HostMirror,3> A;   ///< cell right interface area
 
-  IdefixArray4D<real>::HostMirror Vc;     ///< Main cell-centered primitive variables index
+  IdefixArray4D<realStore>::HostMirror Vc;    ///< Main cell-centered primitive variables index
 
   bool haveDust{false};
-  std::vector<IdefixHostArray4D<real>> dustVc; ///< Cell-centered primitive variables index for dust
+  std::vector<IdefixArray4D<realStore>::HostMirror> dustVc; ///< Cell-centered primitive variables
+                                                       ///< index for dust
 
   #if MHD == YES
   IdefixArray4D<real>::HostMirror Vs;     ///< Main face-centered primitive variables index
@@ -48,7 +49,7 @@ class DataBlockHost {
   IdefixArray3D<real>::HostMirror Ex3;    ///< x3 electric field
 
   #endif
-  IdefixArray4D<real>::HostMirror Uc;     ///< Main cell-centered conservative variables
+  IdefixArray4D<realStore>::HostMirror Uc;    ///< Main cell-centered conservative variables
   IdefixArray3D<real>::HostMirror InvDt;  ///< Inverse of maximum timestep in each cell
 
   std::array<IdefixArray2D<int>::HostMirror,3> coarseningLevel; ///< Grid coarsening level
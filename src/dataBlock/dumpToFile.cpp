@@ -31,6 +31,33 @@ void DataBlock::WriteVariable(FILE* fileHdl, int ndim, int *dim,
   fwrite(data, ntot, size, fileHdl);
 }
 
+// Host copy of a 4D array, with the variable index outermost whatever the device layout
+// and in real precision whatever the storage precision
+template <typename T>
+static IdefixHostArray4D<real> CopyToHost(IdefixArray4D<T> in) {
+  typename IdefixArray4D<T>::HostMirror mirror = Kokkos::create_mirror_view(in);
+  Kokkos::deep_copy(mirror, in);
+  #ifndef FIELD_LAYOUT_AOS
+    if constexpr(std::is_same<T,real>::value) return(mirror);
+  #endif
+  IdefixHostArray4D<real> out("DumpToFileHostArray", in.extent(0), in.extent(1),
+                                                     in.extent(2), in.extent(3));
+  if constexpr(std::is_same<T,real>::value) {
+    Kokkos::deep_copy(out, mirror);
+  } else {
+    for(int n = 0 ; n < in.extent(0) ; n++) {
+      for(int k = 0 ; k < in.extent(1) ; k++) {
+        for(int j = 0 ; j < in.extent(2) ; j++) {
+          for(int i = 0 ; i < in.extent(3) ; i++) {
+            out(n,k,j,i) = mirror(n,k,j,i);
+          }
+        }
+      }
+    }
+  }
+  return(out);
+}
+
 // dump the current dataBlock to a file (mainly used for debug purposes)
 void DataBlock::DumpToFile(std::string filebase)  {
   FILE *fileHdl;
@@ -79,8 +106,7 @@ void DataBlock::DumpToFile(std::string filebase)  {
   fwrite (header, sizeof(char), HEADERSIZE, fileHdl);
 
   // Write Vc
-  IdefixArray4D<real>::HostMirror locVc = Kokkos::create_mirror_view(this->hydro->Vc);
-  Kokkos::deep_copy(locVc,this->hydro->Vc);
+  IdefixHostArray4D<real> locVc = CopyToHost(this->hydro->Vc);
   dims[0] = this->np_tot[IDIR];
   dims[1] = this->np_tot[JDIR];
   dims[2] = this->np_tot[KDIR];
@@ -108,8 +134,7 @@ void DataBlock::DumpToFile(std::string filebase)  {
   // Write Vs
 #if MHD == YES
   // Write Vs
-  IdefixArray4D<real>::HostMirror locVs = Kokkos::create_mirror_view(this->hydro->Vs);
-  Kokkos::deep_copy(locVs,this->hydro->Vs);
+  IdefixHostArray4D<real> locVs = CopyToHost(this->hydro->Vs);
   dims[0] = this->np_tot[IDIR]+IOFFSET;
   dims[1] = this->np_tot[JDIR]+JOFFSET;
   dims[2] = this->np_tot[KDIR]+KOFFSET;
@@ -140,8 +165,7 @@ void DataBlock::DumpToFile(std::string filebase)  {
 
 
   if(hydro->haveCurrent) {
-    IdefixArray4D<real>::HostMirror locJ = Kokkos::create_mirror_view(this->hydro->J);
-    Kokkos::deep_copy(locJ,this->hydro->J);
+    IdefixHostArray4D<real> locJ = CopyToHost(this->hydro->J);
     dims[0] = this->np_tot[IDIR];
     dims[1] = this->np_tot[JDIR];
     dims[2] = this->np_tot[KDIR];
@@ -0,0 +1,358 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <utility>
+
+#include "idefix.hpp"
+#include "dustBatch.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+#include "drag.hpp"
+
+DustBatch::DustBatch(Input &input, DataBlock *data) {
+  this->data = data;
+  nSpecies = input.Get<int>("Dust","nSpecies",0);
+  implicitDrag = input.GetOrSet<bool>("Dust","drag_implicit",0,false);
+}
+
+// Called by the Fluid of each species before it allocates its arrays
+void DustBatch::Allocate(const int nvar) {
+  if(this->nvar == nvar) return;
+  if(this->nvar > 0) {
+    IDEFIX_ERROR("The batched dust species should all have the same number of variables");
+  }
+  this->nvar = nvar;
+  Vc = IdefixArray4D<realStore>("Dust_Vc", IdefixLayout4D(nSpecies*nvar,
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
+  Uc = IdefixArray4D<realStore>("Dust_Uc", IdefixLayout4D(nSpecies*nvar,
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
+  InvDt = Kokkos::View<real****, Layout, Device>("Dust_InvDt", nSpecies,
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+}
+
+IdefixArray4D<realStore> DustBatch::GetVc(const int n) {
+  return(Kokkos::subview(Vc, std::make_pair(n*nvar, (n+1)*nvar),
+                         Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL()));
+}
+
+IdefixArray4D<realStore> DustBatch::GetUc(const int n) {
+  return(Kokkos::subview(Uc, std::make_pair(n*nvar, (n+1)*nvar),
+                         Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL()));
+}
+
+IdefixArray3D<real> DustBatch::GetInvDt(const int n) {
+  return(Kokkos::subview(InvDt, n, Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL()));
+}
+
+void DustBatch::InitDrag() {
+  haveDrag = data->dust[0]->haveDrag;
+  if(!haveDrag) return;
+
+  dragCoeff = IdefixArray1D<real>("DustBatch_dragCoeff", nSpecies);
+  IdefixArray1D<real>::HostMirror dragCoeffHost = Kokkos::create_mirror_view(dragCoeff);
+  for(int n = 0 ; n < nSpecies ; n++) {
+    dragCoeffHost(n) = data->dust[n]->drag->dragCoeff;
+  }
+  Kokkos::deep_copy(dragCoeff, dragCoeffHost);
+
+  // The user-defined drag functions fill the coefficients of their species in the batch
+  if(data->dust[0]->drag->type == Drag::Type::Userdef) {
+    gammai = Kokkos::View<real****, Layout, Device>("DustBatch_gammai", nSpecies,
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+    for(int n = 0 ; n < nSpecies ; n++) {
+      data->dust[n]->drag->gammai = Kokkos::subview(gammai, n, Kokkos::ALL(), Kokkos::ALL(),
+                                                    Kokkos::ALL());
+    }
+  }
+}
+
+void DustBatch::ResetStage() {
+  idfx::pushRegion("DustBatch::ResetStage");
+  Kokkos::deep_copy(InvDt, ZERO_F);
+  idfx::popRegion();
+}
+
+void DustBatch::ConvertConsToPrim() {
+  idfx::pushRegion("DustBatch::ConvertConsToPrim");
+  auto Vc = this->Vc;
+  auto Uc = this->Uc;
+  const int nSpecies = this->nSpecies;
+  const int nvar = this->nvar;
+  EquationOfState eos;
+
+  idefix_for("DustBatch_ConsToPrim",
+             0,data->np_tot[KDIR],
+             0,data->np_tot[JDIR],
+             0,data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      for(int n = 0 ; n < nSpecies ; n++) {
+        real U[DustPhysics::nvar];
+        real V[DustPhysics::nvar];
+        const int offset = n*nvar;
+#pragma unroll
+        for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+          U[nv] = Uc(offset+nv,k,j,i);
+        }
+
+        K_ConsToPrim<DustPhysics>(V,U,&eos);
+
+#pragma unroll
+        for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+          Vc(offset+nv,k,j,i) = V[nv];
+        }
+      }
+    });
+
+  for(int n = 0 ; n < nSpecies ; n++) {
+    if(data->dust[n]->haveTracer) data->dust[n]->tracer->ConvertConsToPrim();
+  }
+  idfx::popRegion();
+}
+
+void DustBatch::ConvertPrimToCons() {
+  idfx::pushRegion("DustBatch::ConvertPrimToCons");
+  auto Vc = this->Vc;
+  auto Uc = this->Uc;
+  const int nSpecies = this->nSpecies;
+  const int nvar = this->nvar;
+  EquationOfState eos;
+
+  idefix_for("DustBatch_PrimToCons",
+             0,data->np_tot[KDIR],
+             0,data->np_tot[JDIR],
+             0,data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      for(int n = 0 ; n < nSpecies ; n++) {
+        real U[DustPhysics::nvar];
+        real V[DustPhysics::nvar];
+        const int offset = n*nvar;
+#pragma unroll
+        for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+          V[nv] = Vc(offset+nv,k,j,i);
+        }
+
+        K_PrimToCons<DustPhysics>(U,V,&eos);
+
+#pragma unroll
+        for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+          Uc(offset+nv,k,j,i) = U[nv];
+        }
+      }
+    });
+
+  for(int n = 0 ; n < nSpecies ; n++) {
+    if(data->dust[n]->haveTracer) data->dust[n]->tracer->ConvertPrimToCons();
+  }
+  idfx::popRegion();
+}
+
+// Same drag force as Drag::AddDragForce, for all of the species at once. The gas state is read
+// once per cell, and the feedback of all of the species is summed before it is applied to the
+// gas.
+void DustBatch::AddDragForce(const real dt) {
+  idfx::pushRegion("DustBatch::AddDragForce");
+
+  Drag *drag = data->dust[0]->drag.get();
+  const Drag::Type type = drag->type;
+  const bool feedback = drag->feedback;
+  EquationOfState eos = *(drag->eos);
+
+  if(type == Drag::Type::Userdef) {
+    for(int n = 0 ; n < nSpecies ; n++) {
+      data->dust[n]->drag->ComputeUserDrag();
+    }
+  }
+
+  if(implicitDrag) {
+    AddImplicitDrag(dt);
+    idfx::popRegion();
+    return;
+  }
+
+  auto Vc = this->Vc;
+  auto Uc = this->Uc;
+  auto InvDt = this->InvDt;
+  auto dragCoeff = this->dragCoeff;
+  auto gammai = this->gammai;
+  auto VcGas = data->hydro->Vc;
+  auto UcGas = data->hydro->Uc;
+  const int nSpecies = this->nSpecies;
+  const int nvar = this->nvar;
+
+  idefix_for("DustBatch_DragForce",0,data->np_tot[KDIR],0,data->np_tot[JDIR],0,data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real rhoGas = VcGas(RHO,k,j,i);
+      real vGas[COMPONENTS];
+      real dmGas[COMPONENTS];
+      for(int c = 0 ; c < COMPONENTS ; c++) {
+        vGas[c] = VcGas(MX1+c,k,j,i);
+        dmGas[c] = ZERO_F;
+      }
+      [[maybe_unused]] real deGas = ZERO_F;
+
+      real cs = ZERO_F;
+      if(type == Drag::Type::Size) {
+        #if HAVE_ENERGY == 1
+          cs = std::sqrt(eos.GetGamma(VcGas(PRS,k,j,i),rhoGas)*VcGas(PRS,k,j,i)/rhoGas);
+        #else
+          cs = eos.GetWaveSpeed(k,j,i);
+        #endif
+      }
+
+      for(int n = 0 ; n < nSpecies ; n++) {
+        const int offset = n*nvar;
+        real gamma;  // The drag coefficient
+        if(type == Drag::Type::Gamma) {
+          gamma = dragCoeff(n);
+        } else if(type == Drag::Type::Tau) {
+          gamma = 1/(dragCoeff(n)*rhoGas);
+        } else if(type == Drag::Type::Size) {
+          gamma = cs/dragCoeff(n);
+        } else {
+          gamma = gammai(n,k,j,i);
+        }
+
+        const real rhoDust = Vc(offset+RHO,k,j,i);
+        const real dp = dt * gamma * rhoDust * rhoGas;
+        for(int c = 0 ; c < COMPONENTS ; c++) {
+          const real dv = Vc(offset+MX1+c,k,j,i) - vGas[c];
+          Uc(offset+MX1+c,k,j,i) -= dp*dv;
+          if(feedback) dmGas[c] += dp*dv;
+          #if HAVE_ENERGY == 1
+            // Friction heating, deposited in the gas (see Drag::AddDragForce)
+            deGas += dp*dv*Vc(offset+MX1+c,k,j,i);
+          #endif
+        }
+        // Cfl constraint
+        real idt = gamma*rhoGas;
+        if(feedback) idt += gamma*rhoDust;
+        InvDt(n,k,j,i) += idt;
+      }
+
+      for(int c = 0 ; c < COMPONENTS ; c++) {
+        UcGas(MX1+c,k,j,i) += dmGas[c];
+      }
+      #if HAVE_ENERGY == 1
+        UcGas(ENG,k,j,i) += deGas;
+      #endif
+    });
+  idfx::popRegion();
+}
+
+// Backward Euler integration of the linear drag between the gas and all of the species, from
+// the conservative variables updated by the stage. With a_n = dt*gamma_n*rho_g, the velocities
+// at the end of the step are
+//   v_g' = (rho_g v_g + sum_n b_n v_n)/(rho_g + sum_n b_n), where b_n = rho_n a_n/(1+a_n)
+//   v_n' = (v_n + a_n v_g')/(1+a_n)
+// (v_g' = v_g without feedback). This is stable for any timestep, so that the drag does not
+// constrain the timestep anymore, and it conserves the total momentum with feedback.
+void DustBatch::AddImplicitDrag(const real dt) {
+  Drag *drag = data->dust[0]->drag.get();
+  const Drag::Type type = drag->type;
+  const bool feedback = drag->feedback;
+  EquationOfState eos = *(drag->eos);
+
+  auto Uc = this->Uc;
+  auto dragCoeff = this->dragCoeff;
+  auto gammai = this->gammai;
+  auto VcGas = data->hydro->Vc;
+  auto UcGas = data->hydro->Uc;
+  const int nSpecies = this->nSpecies;
+  const int nvar = this->nvar;
+
+  idefix_for("DustBatch_ImplicitDrag",
+             data->beg[KDIR],data->end[KDIR],
+             data->beg[JDIR],data->end[JDIR],
+             data->beg[IDIR],data->end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real rhoGas = UcGas(RHO,k,j,i);
+
+      real cs = ZERO_F;
+      if(type == Drag::Type::Size) {
+        #if HAVE_ENERGY == 1
+          cs = std::sqrt(eos.GetGamma(VcGas(PRS,k,j,i),VcGas(RHO,k,j,i))
+                         *VcGas(PRS,k,j,i)/VcGas(RHO,k,j,i));
+        #else
+          cs = eos.GetWaveSpeed(k,j,i);
+        #endif
+      }
+
+      // Momentum of the gas at the end of the step
+      real sumB = ZERO_F;
+      real sumBv[COMPONENTS];
+      for(int c = 0 ; c < COMPONENTS ; c++) {
+        sumBv[c] = ZERO_F;
+      }
+      for(int n = 0 ; feedback && n < nSpecies ; n++) {
+        const int offset = n*nvar;
+        real gamma;
+        if(type == Drag::Type::Gamma) {
+          gamma = dragCoeff(n);
+        } else if(type == Drag::Type::Tau) {
+          gamma = 1/(dragCoeff(n)*rhoGas);
+        } else if(type == Drag::Type::Size) {
+          gamma = cs/dragCoeff(n);
+        } else {
+          gamma = gammai(n,k,j,i);
+        }
+        const real a = dt*gamma*rhoGas;
+        sumB += Uc(offset+RHO,k,j,i)*a/(ONE_F+a);
+        for(int c = 0 ; c < COMPONENTS ; c++) {
+          sumBv[c] += Uc(offset+MX1+c,k,j,i)*a/(ONE_F+a);
+        }
+      }
+      real vGas[COMPONENTS];
+      for(int c = 0 ; c < COMPONENTS ; c++) {
+        vGas[c] = (UcGas(MX1+c,k,j,i) + sumBv[c])/(rhoGas + sumB);
+      }
+
+      // Momentum of each species at the end of the step
+      [[maybe_unused]] real dKinDust = ZERO_F;
+      for(int n = 0 ; n < nSpecies ; n++) {
+        const int offset = n*nvar;
+        real gamma;
+        if(type == Drag::Type::Gamma) {
+          gamma = dragCoeff(n);
+        } else if(type == Drag::Type::Tau) {
+          gamma = 1/(dragCoeff(n)*rhoGas);
+        } else if(type == Drag::Type::Size) {
+          gamma = cs/dragCoeff(n);
+        } else {
+          gamma = gammai(n,k,j,i);
+        }
+        const real a = dt*gamma*rhoGas;
+        const real rhoDust = Uc(offset+RHO,k,j,i);
+        for(int c = 0 ; c < COMPONENTS ; c++) {
+          const real mOld = Uc(offset+MX1+c,k,j,i);
+          const real mNew = (mOld + a*rhoDust*vGas[c])/(ONE_F+a);
+          Uc(offset+MX1+c,k,j,i) = mNew;
+          #if HAVE_ENERGY == 1
+            if(rhoDust > ZERO_F) dKinDust += HALF_F*(mNew*mNew - mOld*mOld)/rhoDust;
+          #endif
+        }
+      }
+
+      if(feedback) {
+        for(int c = 0 ; c < COMPONENTS ; c++) {
+          UcGas(MX1+c,k,j,i) = rhoGas*vGas[c];
+        }
+      }
+      #if HAVE_ENERGY == 1
+        // The kinetic energy lost by the dust is deposited in the gas (see Drag::AddDragForce)
+        UcGas(ENG,k,j,i) -= dKinDust;
+      #endif
+    });
+}
+
+void DustBatch::ShowConfig() {
+  idfx::cout << "DustBatch: the " << nSpecies << " dust species are stored in shared arrays "
+             << "and processed by batched kernels." << std::endl;
+  if(implicitDrag) {
+    idfx::cout << "DustBatch: drag integrated implicitly, coupling the gas and all of the species."
+               << std::endl;
+  }
+}
@@ -0,0 +1,58 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef DATABLOCK_DUSTBATCH_HPP_
+#define DATABLOCK_DUSTBATCH_HPP_
+
+#include "idefix.hpp"
+#include "input.hpp"
+
+class DataBlock;
+
+// Storage of all of the dust species in shared arrays, the species being stored one after the
+// other along the variable index (Vc, Uc) or along a leading species index (InvDt). The Fluid
+// of each species works on views of its own species in these arrays, so that the rest of the
+// code (outputs, boundaries, setups) still sees one Fluid per species, while the operations
+// which are local to a cell process all of the species in a single kernel, reading the gas
+// state once for all of the species. Since all of the species are known in each cell, the
+// drag can also be integrated implicitly, the gas and the species being coupled together.
+class DustBatch {
+ public:
+  DustBatch(Input &, DataBlock *);
+
+  void Allocate(const int);     ///< Allocate the arrays for a given # of variables per species
+  IdefixArray4D<realStore> GetVc(const int);   ///< Primitive variables of species n
+  IdefixArray4D<realStore> GetUc(const int);   ///< Conservative variables of species n
+  IdefixArray3D<real> GetInvDt(const int);     ///< Inverse timestep of species n
+  void InitDrag();              ///< Share the drag coefficients once the species are built
+
+  void ResetStage();
+  void ConvertConsToPrim();
+  void ConvertPrimToCons();
+  void AddDragForce(const real);
+  void ShowConfig();
+
+  bool implicitDrag{false};     ///< Whether the drag is integrated implicitly
+
+  int nSpecies;
+  int nvar{0};                  ///< # of variables of each species
+
+  IdefixArray4D<realStore> Vc;  ///< Primitive variables of all of the species
+  IdefixArray4D<realStore> Uc;  ///< Conservative variables of all of the species
+  Kokkos::View<real****, Layout, Device> InvDt;  ///< Inverse timestep (n,k,j,i)
+
+ private:
+  DataBlock *data;
+
+  void AddImplicitDrag(const real);
+
+  bool haveDrag{false};
+  IdefixArray1D<real> dragCoeff;                   // Drag parameter of each species
+  Kokkos::View<real****, Layout, Device> gammai;   // User-defined drag coefficients (n,k,j,i)
+};
+
+#endif // DATABLOCK_DUSTBATCH_HPP_
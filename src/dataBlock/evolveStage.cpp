@@ -19,6 +19,8 @@ void DataBlock::EvolveStage() {
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->EvolveStage(this->t,this->dt);
     }
+    // With the dust batch, the drag of all of the species is added at once
+    if(haveDustBatch && dust[0]->haveDrag) dustBatch->AddDragForce(this->dt);
   }
 
   idfx::popRegion();
@@ -31,3 +33,11 @@ void DataBlock::EvolveRKLStage() {
   }
   idfx::popRegion();
 }
+
+void DataBlock::EvolveHallStage() {
+  idfx::pushRegion("DataBlock::EvolveHallStage");
+  if(hydro->haveHallSubcycle) {
+    hydro->hallSubcycle->Cycle();
+  }
+  idfx::popRegion();
+}
@@ -43,6 +43,7 @@ Fargo::Fargo(Input &input, int nmax, DataBlock *data) {
       "Only userdef and shearingbox are allowed");
     }
     this->maxShift = input.GetOrSet<int>("Fargo", "maxShift",0, 10);
+    this->haveTranspose = input.GetOrSet<bool>("Fargo", "transpose",0, false);
   } else {
     // DEPRECATED: initialisation from the [Hydro] block
     if(input.CheckEntry("Hydro","fargo")>=0) {
@@ -65,8 +66,10 @@ Fargo::Fargo(Input &input, int nmax, DataBlock *data) {
   }
 
   #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+    // Transposes are only useful with a domain decomposition along the azimuthal direction
+    if(data->mygrid->nproc[JDIR]==1) haveTranspose = false;
     // Check if there is a domain decomposition in the intended fargo direction
-    if(data->mygrid->nproc[JDIR]>1) {
+    if(data->mygrid->nproc[JDIR]>1 && !haveTranspose) {
       haveDomainDecomposition = true;
       this->nghost[JDIR] += this->maxShift;
       this->beg[JDIR] += this->maxShift;
@@ -80,8 +83,10 @@ Fargo::Fargo(Input &input, int nmax, DataBlock *data) {
       this->meanVelocity = IdefixArray2D<real>("FargoVelocity",data->np_tot[KDIR],
                                                              data->np_tot[IDIR]);
   #elif GEOMETRY == SPHERICAL
+    // Transposes are only useful with a domain decomposition along the azimuthal direction
+    if(data->mygrid->nproc[KDIR]==1) haveTranspose = false;
     // Check if there is a domain decomposition in the intended fargo direction
-    if(data->mygrid->nproc[KDIR]>1) {
+    if(data->mygrid->nproc[KDIR]>1 && !haveTranspose) {
       haveDomainDecomposition = true;
       this->nghost[KDIR] += this->maxShift;
       this->beg[KDIR] += this->maxShift;
@@ -96,6 +101,12 @@ Fargo::Fargo(Input &input, int nmax, DataBlock *data) {
   #else
     IDEFIX_ERROR("Fargo is not compatible with the GEOMETRY you intend to use");
   #endif
+  #if MHD == YES
+    if(haveTranspose) {
+      IDEFIX_ERROR("Fargo:transpose is not compatible with MHD, use the ghost cell exchanges "
+                   "(Fargo:maxShift) instead");
+    }
+  #endif
 
 
   // Initialise our scratch space
@@ -107,14 +118,18 @@ Fargo::Fargo(Input &input, int nmax, DataBlock *data) {
     }
   }
 
-  this->scrhUc = IdefixArray4D<real>("FargoVcScratchSpace",nvar
-                                      ,end[KDIR]-beg[KDIR] + 2*nghost[KDIR]
-                                      ,end[JDIR]-beg[JDIR] + 2*nghost[JDIR]
-                                      ,end[IDIR]-beg[IDIR] + 2*nghost[IDIR]);
+  // With transposes, the shift is done on the full rings, the scratch space is not needed
+  if(!haveTranspose) {
+    this->scrhUc = data->scratch->Get4D<realStore>(ScratchArena::Fargo,"FargoVcScratchSpace",nvar
+                                        ,end[KDIR]-beg[KDIR] + 2*nghost[KDIR]
+                                        ,end[JDIR]-beg[JDIR] + 2*nghost[JDIR]
+                                        ,end[IDIR]-beg[IDIR] + 2*nghost[IDIR]);
+  }
 
   #if MHD == YES
     if(haveDomainDecomposition) {
-      this->scrhVs = IdefixArray4D<real>("FargoVsScratchSpace",DIMENSIONS
+      this->scrhVs = data->scratch->Get4D<real>(ScratchArena::Fargo,"FargoVsScratchSpace"
+                                          ,DIMENSIONS
                                           ,end[KDIR]-beg[KDIR] + 2*nghost[KDIR]+KOFFSET
                                           ,end[JDIR]-beg[JDIR] + 2*nghost[JDIR]+JOFFSET
                                           ,end[IDIR]-beg[IDIR] + 2*nghost[IDIR]+IOFFSET);
@@ -126,16 +141,115 @@ Fargo::Fargo(Input &input, int nmax, DataBlock *data) {
       this->scrhVs = data->hydro->Vs;
     }
   #endif
+  // Shift plans, on the columns perpendicular to the azimuthal direction (including the last
+  // faces for the EMFs)
+  #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+    const int ncol = data->np_tot[KDIR]+1;
+  #else
+    const int ncol = data->np_tot[JDIR]+1;
+  #endif
+  planCell.m = IdefixArray2D<int>("FargoPlanShift", ncol, data->np_tot[IDIR]+1);
+  planCell.eps = IdefixArray2D<real>("FargoPlanEps", ncol, data->np_tot[IDIR]+1);
+  #if MHD == YES
+    planEk.m = IdefixArray2D<int>("FargoPlanEkShift", ncol, data->np_tot[IDIR]+1);
+    planEk.eps = IdefixArray2D<real>("FargoPlanEkEps", ncol, data->np_tot[IDIR]+1);
+    #if DIMENSIONS == 3
+      planEi.m = IdefixArray2D<int>("FargoPlanEiShift", ncol, data->np_tot[IDIR]+1);
+      planEi.eps = IdefixArray2D<real>("FargoPlanEiEps", ncol, data->np_tot[IDIR]+1);
+    #endif
+  #endif
+
   #ifdef WITH_MPI
     if(haveDomainDecomposition) {
-      std::vector<int> vars;
-      for(int i=0 ; i < nvar ; i++) {
-        vars.push_back(i);
+      #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+        const int sdir = JDIR;
+      #else
+        const int sdir = KDIR;
+      #endif
+      MPI_SAFE_CALL(MPI_Cart_shift(data->mygrid->CartComm, sdir, 1, &procLeft, &procRight));
+      // The buffers are sized for the largest shift (maxShift)
+      int size = 1;
+      int sizeVs = 1;
+      for(int dir = 0 ; dir < 3 ; dir++) {
+        const int n = (dir == sdir) ? nghost[dir] : end[dir]-beg[dir];
+        size *= n;
+        sizeVs *= (dir == sdir) ? n : n+1;
       }
+      size *= nvar;
       #if MHD == YES
-        this->mpi.Init(data->mygrid, vars, this->nghost.data(), data->np_int.data(), true);
+        size += DIMENSIONS*sizeVs;
+      #endif
+      for(int side = faceLeft ; side <= faceRight ; side++) {
+        bufferSend[side] = Buffer(size);
+        bufferRecv[side] = Buffer(size);
+      }
+    }
+    if(haveTranspose) {
+      #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+        const int sdir = JDIR;
+        const int cdir = KDIR;
+      #else
+        const int sdir = KDIR;
+        const int cdir = JDIR;
+      #endif
+      // Processes sharing the same azimuthal rings (ranked along the azimuthal direction)
+      int remain[3] = {0, 0, 0};
+      remain[sdir] = 1;
+      MPI_SAFE_CALL(MPI_Cart_sub(data->mygrid->CartComm, remain, &ringComm));
+      MPI_SAFE_CALL(MPI_Comm_size(ringComm, &ringSize));
+      MPI_SAFE_CALL(MPI_Comm_rank(ringComm, &ringRank));
+
+      // Azimuthal range of each process
+      std::vector<int> ns(ringSize);
+      int nsMe = data->np_int[sdir];
+      MPI_SAFE_CALL(MPI_Allgather(&nsMe, 1, MPI_INT, ns.data(), 1, MPI_INT, ringComm));
+      ringSbegHost.resize(ringSize+1);
+      ringSbegHost[0] = 0;
+      for(int r = 0 ; r < ringSize ; r++) {
+        ringSbegHost[r+1] = ringSbegHost[r] + ns[r];
+      }
+      ringNphi = ringSbegHost[ringSize];
+
+      // Radial range of the rings owned by each process after the transpose
+      const int ni = data->np_int[IDIR];
+      if(ni < ringSize) {
+        IDEFIX_ERROR("Fargo:transpose requires at least as many cells along X1 as processes "
+                     "along the azimuthal direction");
+      }
+      ringIbegHost.resize(ringSize+1);
+      for(int r = 0 ; r <= ringSize ; r++) {
+        ringIbegHost[r] = (r*ni)/ringSize;
+      }
+
+      ringSbeg = IdefixArray1D<int>("FargoRingSbeg", ringSize+1);
+      ringIbeg = IdefixArray1D<int>("FargoRingIbeg", ringSize+1);
+      ringSOwner = IdefixArray1D<int>("FargoRingSOwner", ringNphi);
+      ringIOwner = IdefixArray1D<int>("FargoRingIOwner", ni);
+      IdefixArray1D<int>::HostMirror sbegHost = Kokkos::create_mirror_view(ringSbeg);
+      IdefixArray1D<int>::HostMirror ibegHost = Kokkos::create_mirror_view(ringIbeg);
+      IdefixArray1D<int>::HostMirror sOwnerHost = Kokkos::create_mirror_view(ringSOwner);
+      IdefixArray1D<int>::HostMirror iOwnerHost = Kokkos::create_mirror_view(ringIOwner);
+      for(int r = 0 ; r < ringSize ; r++) {
+        for(int s = ringSbegHost[r] ; s < ringSbegHost[r+1] ; s++) sOwnerHost(s) = r;
+        for(int i = ringIbegHost[r] ; i < ringIbegHost[r+1] ; i++) iOwnerHost(i) = r;
+      }
+      for(int r = 0 ; r <= ringSize ; r++) {
+        sbegHost(r) = ringSbegHost[r];
+        ibegHost(r) = ringIbegHost[r];
+      }
+      Kokkos::deep_copy(ringSbeg, sbegHost);
+      Kokkos::deep_copy(ringIbeg, ibegHost);
+      Kokkos::deep_copy(ringSOwner, sOwnerHost);
+      Kokkos::deep_copy(ringIOwner, iOwnerHost);
+
+      const int nc = data->np_int[cdir];
+      const int nir = ringIbegHost[ringRank+1] - ringIbegHost[ringRank];
+      ringSend = IdefixArray1D<real>("FargoRingSend", nvar*nc*nsMe*ni);
+      ringRecv = IdefixArray1D<real>("FargoRingRecv", nvar*nc*ringNphi*nir);
+      #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+        ring = IdefixArray4D<real>("FargoRing", IdefixLayout4D(nvar, nc, ringNphi, nir));
       #else
-        this->mpi.Init(data->mygrid, vars, this->nghost.data(), data->np_int.data());
+        ring = IdefixArray4D<real>("FargoRing", IdefixLayout4D(nvar, ringNphi, nc, nir));
       #endif
     }
   #endif
@@ -144,6 +258,16 @@ Fargo::Fargo(Input &input, int nmax, DataBlock *data) {
   idfx::popRegion();
 }
 
+Fargo::~Fargo() {
+  #ifdef WITH_MPI
+    if(haveTranspose) {
+      int finalized;
+      MPI_Finalized(&finalized);
+      if(!finalized) MPI_Comm_free(&ringComm);
+    }
+  #endif
+}
+
 void Fargo::ShowConfig() {
   idfx::pushRegion("Fargo::ShowConfig");
   if(type==userdef) {
@@ -165,6 +289,10 @@ void Fargo::ShowConfig() {
     idfx::cout << "Fargo: using domain decomposition along the azimuthal direction"
                << " with maxShift=" << this->maxShift << std::endl;
   }
+  if(haveTranspose) {
+    idfx::cout << "Fargo: using domain decomposition along the azimuthal direction"
+               << " with transposes of the full azimuthal rings" << std::endl;
+  }
   idfx::popRegion();
 }
 
@@ -187,6 +315,8 @@ void Fargo::GetFargoVelocity(real t) {
     }
     fargoVelocityFunc(*data, meanVelocity);
     velocityHasBeenComputed = true;
+    planValid = false;
+    scheduleValid = false;
     if(this->haveDomainDecomposition) {
       CheckMaxDisplacement();
     }
@@ -252,6 +382,186 @@ void Fargo::CheckMaxDisplacement() {
   this->dtMax = this->maxShift / invDt;
 }
 
+// This function computes the shift of each column for a given dt (only when dt or the fargo
+// velocity have changed), and with domain decomposition, the number of cells exchanged with the
+// neighbours. The latter is computed for a slightly larger dt, so that it is kept as long as dt
+// stays in [scheduleDt/2, scheduleDt]: since the shifts grow with dt, the cells exchanged for
+// scheduleDt include those needed for any smaller dt.
+void Fargo::BuildShiftPlan(const real dt) {
+  if(planValid && dt == planDt) return;
+  idfx::pushRegion("Fargo::BuildShiftPlan");
+
+  #ifdef WITH_MPI
+    if(haveDomainDecomposition &&
+       (!scheduleValid || dt > scheduleDt || dt < HALF_F*scheduleDt)) {
+      // dt <= dtMax, which ensures that the shifts for scheduleDt are not wrapped around Lphi
+      scheduleDt = std::min(scheduleMargin*dt, dtMax);
+      ComputeShiftPlan(scheduleDt);
+      BuildSchedule();
+      scheduleValid = true;
+    }
+  #endif
+  ComputeShiftPlan(dt);
+
+  planDt = dt;
+  planValid = true;
+  idfx::popRegion();
+}
+
+// Integer shift and remaining fraction of a cell of each column for a given dt
+void Fargo::ComputeShiftPlan(const real dt) {
+  IdefixArray2D<real> meanV = this->meanVelocity;
+  IdefixArray1D<real> x1 = data->x[IDIR];
+  IdefixArray1D<real> x1m = data->xl[IDIR];
+  IdefixArray1D<real> sinx2 = data->sinx2;
+  [[maybe_unused]] FargoType fargoType = type;
+  [[maybe_unused]] real sbS = data->hydro->sbS;
+
+  // Columns: (k,i) in cartesian and polar geometries, (j,i) in spherical geometry
+  real Lphi;
+  int sdir, cdir;
+  #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+    sdir = JDIR;
+    cdir = KDIR;
+  #else
+    sdir = KDIR;
+    cdir = JDIR;
+  #endif
+  Lphi = data->mygrid->xend[sdir] - data->mygrid->xbeg[sdir];
+  // dphi is supposedly constant when using fargo.
+  IdefixArray1D<real> dphiArr = data->dx[sdir];
+  const int sbeg = data->beg[sdir];
+  const int cbeg = data->beg[cdir];
+  const int cend = data->end[cdir];
+  const int ibeg = data->beg[IDIR];
+  const int iend = data->end[IDIR];
+  const int coffset = (cdir < DIMENSIONS) ? 1 : 0;
+
+  IdefixArray2D<int> mCell = planCell.m;
+  IdefixArray2D<real> epsCell = planCell.eps;
+  idefix_for("Fargo:PlanCell", cbeg, cend, ibeg, iend,
+    KOKKOS_LAMBDA(int c, int i) {
+      real w;
+      #if GEOMETRY == CARTESIAN
+        if(fargoType==userdef) {
+          w = meanV(c,i);
+        } else if(fargoType==shearingbox) {
+          w = sbS*x1(i);
+        }
+      #elif GEOMETRY == POLAR
+        w = meanV(c,i)/x1(i);
+      #elif GEOMETRY == SPHERICAL
+        w = meanV(c,i)/(x1(i)*sinx2(c));
+      #endif
+      FargoShift(w, dt, Lphi, dphiArr(sbeg), mCell(c,i), epsCell(c,i));
+    });
+
+  #if MHD == YES
+    // EMF along the radial faces (Ez in cartesian and polar geometries, Ey in spherical)
+    IdefixArray2D<int> mEk = planEk.m;
+    IdefixArray2D<real> epsEk = planEk.eps;
+    idefix_for("Fargo:PlanEk", cbeg, cend+coffset, ibeg, iend+IOFFSET,
+      KOKKOS_LAMBDA(int c, int i) {
+        real w;
+        #if GEOMETRY == CARTESIAN
+          if(fargoType==userdef) {
+            w = 0.5*(meanV(c,i-1)+meanV(c,i));
+          } else if(fargoType==shearingbox) {
+            w = sbS*x1m(i);
+          }
+        #elif GEOMETRY == POLAR
+          w = 0.5*(meanV(c,i-1)+meanV(c,i))/x1m(i);
+        #elif GEOMETRY == SPHERICAL
+          w = 0.5*(meanV(c,i-1)/x1(i-1)+meanV(c,i)/x1(i))/sinx2(c);
+        #endif
+        FargoShift(w, dt, Lphi, dphiArr(sbeg), mEk(c,i), epsEk(c,i));
+      });
+    #if DIMENSIONS == 3
+      // EMF along the vertical (cartesian, polar) or meridional (spherical) faces
+      IdefixArray2D<int> mEi = planEi.m;
+      IdefixArray2D<real> epsEi = planEi.eps;
+      idefix_for("Fargo:PlanEi", cbeg, cend+coffset, ibeg, iend+IOFFSET,
+        KOKKOS_LAMBDA(int c, int i) {
+          real w;
+          #if GEOMETRY == CARTESIAN
+            if(fargoType==userdef) {
+              w = 0.5*(meanV(c,i)+meanV(c-1,i));
+            } else if(fargoType==shearingbox) {
+              w = sbS*x1(i);
+            }
+          #elif GEOMETRY == POLAR
+            w = 0.5*(meanV(c-1,i)+meanV(c,i))/x1(i);
+          #elif GEOMETRY == SPHERICAL
+            w = 0.5*(meanV(c-1,i)/sinx2(c-1)+meanV(c,i)/sinx2(c))/(x1(i));
+          #endif
+          FargoShift(w, dt, Lphi, dphiArr(sbeg), mEi(c,i), epsEi(c,i));
+        });
+    #endif
+  #endif
+}
+
+// Number of cells exchanged with the neighbours by the shift, from the shifts of the current
+// plan
+void Fargo::BuildSchedule() {
+  #ifdef WITH_MPI
+    idfx::pushRegion("Fargo::BuildSchedule");
+    #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+      const int sdir = JDIR;
+      const int cdir = KDIR;
+    #else
+      const int sdir = KDIR;
+      const int cdir = JDIR;
+    #endif
+    const int cbeg = data->beg[cdir];
+    const int cend = data->end[cdir];
+    const int ibeg = data->beg[IDIR];
+    const int iend = data->end[IDIR];
+    const int coffset = (cdir < DIMENSIONS) ? 1 : 0;
+    // Largest shifts to the right (m>0, the origin is on the left) and to the left
+    int mMax = 0;
+    int mMin = 0;
+    std::vector<std::pair<IdefixArray2D<int>, int>> plans = {{planCell.m, 0}};
+    #if MHD == YES
+      plans.push_back({planEk.m, 1});
+      #if DIMENSIONS == 3
+        plans.push_back({planEi.m, 1});
+      #endif
+    #endif
+    for(auto &plan : plans) {
+      IdefixArray2D<int> m = plan.first;
+      int mMaxLoc = 0;
+      int mMinLoc = 0;
+      idefix_reduce("Fargo:PlanMax", cbeg, cend + plan.second*coffset,
+                                     ibeg, iend + plan.second*IOFFSET,
+        KOKKOS_LAMBDA(int c, int i, int &localMax) {
+          if(m(c,i) > localMax) localMax = m(c,i);
+        },
+        Kokkos::Max<int>(mMaxLoc));
+      idefix_reduce("Fargo:PlanMin", cbeg, cend + plan.second*coffset,
+                                     ibeg, iend + plan.second*IOFFSET,
+        KOKKOS_LAMBDA(int c, int i, int &localMin) {
+          if(m(c,i) < localMin) localMin = m(c,i);
+        },
+        Kokkos::Min<int>(mMinLoc));
+      mMax = std::max(mMax, mMaxLoc);
+      mMin = std::min(mMin, mMinLoc);
+    }
+    // Ghost cells needed on each side: the largest shift and the stencil of the fluxes
+    recvWidth[faceLeft] = std::min(mMax + data->nghost[sdir], nghost[sdir]);
+    recvWidth[faceRight] = std::min(-mMin + data->nghost[sdir], nghost[sdir]);
+
+    // Tell the neighbours how many cells they should send
+    MPI_Comm comm = data->mygrid->CartComm;
+    MPI_SAFE_CALL(MPI_Sendrecv(&recvWidth[faceLeft], 1, MPI_INT, procLeft, 320,
+                               &sendWidth[faceRight], 1, MPI_INT, procRight, 320,
+                               comm, MPI_STATUS_IGNORE));
+    MPI_SAFE_CALL(MPI_Sendrecv(&recvWidth[faceRight], 1, MPI_INT, procRight, 321,
+                               &sendWidth[faceLeft], 1, MPI_INT, procLeft, 321,
+                               comm, MPI_STATUS_IGNORE));
+    idfx::popRegion();
+  #endif
+}
+
 void Fargo::AddVelocity(const real t) {
   idfx::pushRegion("Fargo::AddVelocity");
 
@@ -290,3 +600,137 @@ void Fargo::ShiftSolution(const real t, const real dt) {
 
   idfx::popRegion();
 }
+
+// Shift of the cell-centered variables with transposes: the columns of the process are
+// redistributed between the processes sharing the same azimuthal rings, so that each process
+// owns the full rings of a radial range, shifts them locally, and sends them back. The shift is
+// then independent of the domain decomposition, and is not limited by maxShift.
+void Fargo::ShiftRings(IdefixArray4D<realStore> Uc, int nvar) {
+#ifdef WITH_MPI
+  idfx::pushRegion("Fargo::ShiftRings");
+  #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+    const int sdir = JDIR;
+    const int cdir = KDIR;
+  #else
+    const int sdir = KDIR;
+    const int cdir = JDIR;
+  #endif
+  const int ns = data->np_int[sdir];
+  const int nc = data->np_int[cdir];
+  const int ni = data->np_int[IDIR];
+  const int nphi = ringNphi;
+  const int ir0 = ringIbegHost[ringRank];
+  const int nir = ringIbegHost[ringRank+1] - ir0;
+  const int sbeg = data->beg[sdir];
+  const int cbeg = data->beg[cdir];
+  const int ibeg = data->beg[IDIR];
+
+  IdefixArray1D<real> sendBuf = this->ringSend;
+  IdefixArray1D<real> recvBuf = this->ringRecv;
+  IdefixArray4D<real> ring = this->ring;
+  IdefixArray1D<int> ringSbeg = this->ringSbeg;
+  IdefixArray1D<int> ringSOwner = this->ringSOwner;
+  IdefixArray1D<int> ringIbeg = this->ringIbeg;
+  IdefixArray1D<int> ringIOwner = this->ringIOwner;
+  IdefixArray2D<int> planM = planCell.m;
+  IdefixArray2D<real> planEps = planCell.eps;
+
+  // Pack the columns of the process, ordered by the process owning their radius
+  idefix_for("Fargo:PackRings",0,nvar,0,nc,0,ns,0,ni,
+    KOKKOS_LAMBDA(int n, int c, int s, int ii) {
+      const int r = ringIOwner(ii);
+      const int nirR = ringIbeg(r+1) - ringIbeg(r);
+      const int idx = nvar*nc*ns*ringIbeg(r) + ((n*nc+c)*ns+s)*nirR + ii - ringIbeg(r);
+      #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+        sendBuf(idx) = Uc(n,cbeg+c,sbeg+s,ibeg+ii);
+      #else
+        sendBuf(idx) = Uc(n,sbeg+s,cbeg+c,ibeg+ii);
+      #endif
+    });
+
+  std::vector<int> sendCount(ringSize), sendDispl(ringSize);
+  std::vector<int> recvCount(ringSize), recvDispl(ringSize);
+  for(int r = 0 ; r < ringSize ; r++) {
+    const int nirR = ringIbegHost[r+1] - ringIbegHost[r];
+    const int nsR = ringSbegHost[r+1] - ringSbegHost[r];
+    sendCount[r] = nvar*nc*ns*nirR;
+    sendDispl[r] = nvar*nc*ns*ringIbegHost[r];
+    recvCount[r] = nvar*nc*nsR*nir;
+    recvDispl[r] = nvar*nc*nir*ringSbegHost[r];
+  }
+  Kokkos::fence();
+
+  double tStart = MPI_Wtime();
+  MPI_SAFE_CALL(MPI_Alltoallv(sendBuf.data(), sendCount.data(), sendDispl.data(), realMPI,
+                              recvBuf.data(), recvCount.data(), recvDispl.data(), realMPI,
+                              ringComm));
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
+  // Assemble the full rings
+  idefix_for("Fargo:UnpackRings",0,nvar,0,nc,0,nphi,0,nir,
+    KOKKOS_LAMBDA(int n, int c, int s, int ii) {
+      const int r = ringSOwner(s);
+      const int nsR = ringSbeg(r+1) - ringSbeg(r);
+      const int idx = nvar*nc*nir*ringSbeg(r) + ((n*nc+c)*nsR+s-ringSbeg(r))*nir + ii;
+      #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+        ring(n,c,s,ii) = recvBuf(idx);
+      #else
+        ring(n,s,c,ii) = recvBuf(idx);
+      #endif
+    });
+
+  // Shift the rings as Fargo:ShiftVc without domain decomposition, and store the result in
+  // the receive buffer, which is sent back
+  idefix_for("Fargo:ShiftRings",0,nvar,0,nc,0,nphi,0,nir,
+    KOKKOS_LAMBDA(int n, int c, int s, int ii) {
+      const int m = planM(cbeg+c,ibeg+ir0+ii);
+      const real eps = planEps(cbeg+c,ibeg+ir0+ii);
+      const int so = modPositive(s-m, nphi);
+
+      real Fl,Fr;
+      if(eps>=ZERO_F) {
+        int som1 = so-1;
+        if(som1 < 0) som1 = som1+nphi;
+        Fl = FargoFlux(ring, n, c, c, ii, som1, nphi, 0, eps, false);
+        Fr = FargoFlux(ring, n, c, c, ii, so, nphi, 0, eps, false);
+      } else {
+        int sop1 = so+1;
+        if(sop1 >= nphi) sop1 = sop1-nphi;
+        Fl = FargoFlux(ring, n, c, c, ii, so, nphi, 0, eps, false);
+        Fr = FargoFlux(ring, n, c, c, ii, sop1, nphi, 0, eps, false);
+      }
+      #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+        const real q0 = ring(n,c,so,ii);
+      #else
+        const real q0 = ring(n,so,c,ii);
+      #endif
+      const int r = ringSOwner(s);
+      const int nsR = ringSbeg(r+1) - ringSbeg(r);
+      const int idx = nvar*nc*nir*ringSbeg(r) + ((n*nc+c)*nsR+s-ringSbeg(r))*nir + ii;
+      recvBuf(idx) = static_cast<realStore>(q0 - (Fr - Fl));
+    });
+  Kokkos::fence();
+
+  tStart = MPI_Wtime();
+  MPI_SAFE_CALL(MPI_Alltoallv(recvBuf.data(), recvCount.data(), recvDispl.data(), realMPI,
+                              sendBuf.data(), sendCount.data(), sendDispl.data(), realMPI,
+                              ringComm));
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
+  // Unpack the shifted columns of the process
+  idefix_for("Fargo:UnpackShiftedRings",0,nvar,0,nc,0,ns,0,ni,
+    KOKKOS_LAMBDA(int n, int c, int s, int ii) {
+      const int r = ringIOwner(ii);
+      const int nirR = ringIbeg(r+1) - ringIbeg(r);
+      const int idx = nvar*nc*ns*ringIbeg(r) + ((n*nc+c)*ns+s)*nirR + ii - ringIbeg(r);
+      #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+        Uc(n,cbeg+c,sbeg+s,ibeg+ii) = sendBuf(idx);
+      #else
+        Uc(n,sbeg+s,cbeg+c,ibeg+ii) = sendBuf(idx);
+      #endif
+    });
+  idfx::popRegion();
+#else
+  IDEFIX_ERROR("Fargo::ShiftRings requires MPI");
+#endif
+}
@@ -8,6 +8,8 @@
 #ifndef DATABLOCK_FARGO_HPP_
 #define DATABLOCK_FARGO_HPP_
 
+#include <array>
+#include <utility>
 #include <vector>
 #include "idefix.hpp"
 #ifdef WITH_MPI
@@ -30,6 +32,7 @@ class Fargo {
  public:
   enum FargoType {none, userdef, shearingbox};
   Fargo(Input &, int, DataBlock*);  // Initialisation
+  ~Fargo();
   void ShiftSolution(const real t, const real dt);  // Effectively shift the solution
   void SubstractVelocity(const real);
   void AddVelocity(const real);
@@ -50,7 +53,14 @@ class Fargo {
   template <typename Phys>
   void StoreToScratch(Fluid<Phys>*);
 
+  template <typename T>
+  void ExchangeShift(IdefixArray4D<T>, int, IdefixArray4D<real>, bool);
+
   void GetFargoVelocity(real);
+  void BuildShiftPlan(const real);
+  void ComputeShiftPlan(const real);
+  void BuildSchedule();
+  void ShiftRings(IdefixArray4D<realStore>, int);
 
   IdefixArray2D<real> meanVelocity;
   FargoType type{none};                 // By default, Fargo is disabled
@@ -59,11 +69,36 @@ class Fargo {
   friend Hydro;
   DataBlock *data;
 
-  IdefixArray4D<real> scrhUc;
+  IdefixArray4D<realStore> scrhUc;
   IdefixArray4D<real> scrhVs;
 
+  // Shift plan: integer number of cells m and remaining fraction eps of the azimuthal shift of
+  // each column, at the cell centers and at the two locations of the fargo EMFs. It only
+  // depends on dt and on the Fargo velocity, so it is shared by all of the fluids and kept
+  // as long as none of them changes.
+  struct ShiftPlan {
+    IdefixArray2D<int> m;
+    IdefixArray2D<real> eps;
+  };
+  ShiftPlan planCell, planEk, planEi;
+  real planDt{0};
+  bool planValid{false};
+  // The exchange widths are computed for scheduleDt = scheduleMargin*dt, and kept while dt
+  // stays in [scheduleDt/2, scheduleDt]
+  real scheduleMargin{1.2};
+  real scheduleDt{0};
+  bool scheduleValid{false};
+
 #ifdef WITH_MPI
-  Mpi mpi;                      // Fargo-specific MPI layer
+  // Communication schedule of the shift with domain decomposition: number of cells received in
+  // the left and right ghost zones, and sent to the left and right neighbours, according to
+  // the largest shifts of the subdomains (instead of maxShift)
+  enum {faceLeft, faceRight};
+  std::array<int,2> recvWidth{0,0};
+  std::array<int,2> sendWidth{0,0};
+  int procLeft, procRight;
+  Buffer bufferSend[2];
+  Buffer bufferRecv[2];
 #endif
 
   std::array<int,3> beg;
@@ -74,6 +109,23 @@ class Fargo {
                                         //< when domain decomposition is enabled
   bool velocityHasBeenComputed{false};
   bool haveDomainDecomposition{false};
+  bool haveTranspose{false};            //< Shift full azimuthal rings after a transpose, instead
+                                        //< of exchanging maxShift ghost cells
+
+#ifdef WITH_MPI
+  // Transposes: communicator of the processes sharing the same azimuthal rings, azimuthal
+  // range of each of them, and radial range of the rings each of them owns after the transpose
+  MPI_Comm ringComm;
+  int ringSize{1};
+  int ringRank{0};
+  int ringNphi{0};                      //< Number of cells of a full azimuthal ring
+  std::vector<int> ringSbegHost;
+  std::vector<int> ringIbegHost;
+  IdefixArray1D<int> ringSbeg, ringSOwner;
+  IdefixArray1D<int> ringIbeg, ringIOwner;
+  IdefixArray1D<real> ringSend, ringRecv;
+  IdefixArray4D<real> ring;             //< Full azimuthal rings owned by this process
+#endif
 
   FargoVelocityFunc fargoVelocityFunc{NULL};  // The user-defined fargo velocity function
 };
@@ -87,7 +139,8 @@ class Fargo {
 #endif
 
 #ifdef HIGH_ORDER_FARGO
-KOKKOS_INLINE_FUNCTION real FargoFlux(const IdefixArray4D<real> &Vin, int n, int k, int j, int i,
+template <typename T>
+KOKKOS_INLINE_FUNCTION real FargoFlux(const IdefixArray4D<T> &Vin, int n, int k, int j, int i,
                                       int so, int ds, int sbeg, real eps,
                                       bool haveDomainDecomposition) {
   // compute shifted indices, taking into account the fact that we're periodic
@@ -136,7 +189,8 @@ KOKKOS_INLINE_FUNCTION real FargoFlux(const IdefixArray4D<real> &Vin, int n, int
 }
 
 #else// HIGH_ORDER_FARGO
-KOKKOS_INLINE_FUNCTION real FargoFlux(const IdefixArray4D<real> &Vin, int n, int k, int j, int i,
+template <typename T>
+KOKKOS_INLINE_FUNCTION real FargoFlux(const IdefixArray4D<T> &Vin, int n, int k, int j, int i,
                                       int so, int ds, int sbeg, real eps,
                                       bool haveDomainDecomposition) {
   // compute shifted indices, taking into account the fact that we're periodic
@@ -167,6 +221,19 @@ KOKKOS_INLINE_FUNCTION int modPositive(int x, int divisor) {
   return m + ((m >> 31) & divisor); // equivalent to m + (m < 0 ? divisor : 0);
 }
 
+// Split the azimuthal displacement w*dt into an integer number of cells m and the remaining
+// fraction eps of a cell
+KOKKOS_INLINE_FUNCTION void FargoShift(real w, real dt, real Lphi, real dphi, int &m, real &eps) {
+  // Compute the offset in phi, modulo the full domain size
+  real dL = std::fmod(w*dt, Lphi);
+
+  // Translate this into # of cells
+  m = static_cast<int> (std::floor(dL/dphi+HALF_F));
+
+  // get the remainding shift
+  eps = dL/dphi - m;
+}
+
 
 template <typename Phys>
 void Fargo::AddVelocityFluid(const real t, Fluid<Phys>* hydro ) {
@@ -175,7 +242,7 @@ void Fargo::AddVelocityFluid(const real t, Fluid<Phys>* hydro ) {
     GetFargoVelocity(t);
   }
   IdefixArray1D<real> x1 = data->x[IDIR];
-  IdefixArray4D<real> Vc = hydro->Vc;
+  IdefixArray4D<realStore> Vc = hydro->Vc;
   IdefixArray2D<real> meanV = this->meanVelocity;
   [[maybe_unused]] FargoType fargoType = type;
   [[maybe_unused]] real sbS = hydro->sbS;
@@ -211,7 +278,7 @@ void Fargo::SubstractVelocityFluid(const real t, Fluid<Phys>* hydro) {
     GetFargoVelocity(t);
   }
   IdefixArray1D<real> x1 = data->x[IDIR];
-  IdefixArray4D<real> Vc = hydro->Vc;
+  IdefixArray4D<realStore> Vc = hydro->Vc;
   [[maybe_unused]] IdefixArray2D<real> meanV = this->meanVelocity;
   [[maybe_unused]] FargoType fargoType = type;
   [[maybe_unused]] real sbS = hydro->sbS;
@@ -242,8 +309,8 @@ void Fargo::SubstractVelocityFluid(const real t, Fluid<Phys>* hydro) {
 
 template<typename Phys>
 void Fargo::StoreToScratch(Fluid<Phys>* hydro) {
-  IdefixArray4D<real> Uc = hydro->Uc;
-  IdefixArray4D<real> scrhUc = this->scrhUc;
+  IdefixArray4D<realStore> Uc = hydro->Uc;
+  IdefixArray4D<realStore> scrhUc = this->scrhUc;
   bool haveDomainDecomposition = this->haveDomainDecomposition;
   int maxShift = this->maxShift;
 
@@ -290,15 +357,97 @@ void Fargo::StoreToScratch(Fluid<Phys>* hydro) {
   }
   #if WITH_MPI
     if(haveDomainDecomposition) {
-      #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
-        this->mpi.ExchangeX2(scrhUc, scrhVs);
-      #elif GEOMETRY == SPHERICAL
-        this->mpi.ExchangeX3(scrhUc, scrhVs);
-      #endif
+      ExchangeShift(scrhUc, Phys::nvar+hydro->nTracer, scrhVs, Phys::mhd);
     }
   #endif
 }
 
+// Fill the azimuthal ghost zones of the scratch arrays with the cells of the neighbours which
+// are needed by the shift, following the communication schedule of the shift plan
+template<typename T>
+void Fargo::ExchangeShift(IdefixArray4D<T> Vc, int nvar, IdefixArray4D<real> Vs, bool haveVs) {
+#ifdef WITH_MPI
+  idfx::pushRegion("Fargo::ExchangeShift");
+  #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+    const int sdir = JDIR;
+    const int nrm = BX2s;   // field component normal to the shift direction
+  #else
+    const int sdir = KDIR;
+    const int nrm = BX3s;
+  #endif
+  const std::array<int,3> beg = this->beg;
+  const std::array<int,3> end = this->end;
+
+  // Range of the box exchanged in direction dir: r along the shift direction, and the active
+  // zone (including the last face in the staggered directions when stag) otherwise
+  auto box = [&](int dir, std::pair<int,int> r, bool stag) {
+    if(dir == sdir) return r;
+    return std::make_pair(beg[dir], end[dir] + ((stag && dir < DIMENSIONS) ? 1 : 0));
+  };
+
+  auto size = [](std::pair<int,int> ib, std::pair<int,int> jb, std::pair<int,int> kb) {
+    return (ib.second-ib.first)*(jb.second-jb.first)*(kb.second-kb.first);
+  };
+
+  // Pack the cells sent to the left (beginning of the active zone) and to the right (end of
+  // the active zone) neighbours. The faces normal to the shift direction are shifted by one,
+  // since the first face of the active zone is shared with the left neighbour.
+  std::array<int,2> sendSize{0,0};
+  for(int side = faceLeft ; side <= faceRight ; side++) {
+    const int w = sendWidth[side];
+    Buffer buffer = bufferSend[side];
+    buffer.ResetPointer();
+    auto r = (side == faceLeft) ? std::make_pair(beg[sdir], beg[sdir]+w)
+                                : std::make_pair(end[sdir]-w, end[sdir]);
+    for(int n = 0 ; n < nvar ; n++) {
+      buffer.Pack(Vc, n, box(IDIR, r, false), box(JDIR, r, false), box(KDIR, r, false));
+      sendSize[side] += size(box(IDIR, r, false), box(JDIR, r, false), box(KDIR, r, false));
+    }
+    if(haveVs) {
+      for(int n = 0 ; n < DIMENSIONS ; n++) {
+        auto rs = (n == nrm && side == faceLeft) ? std::make_pair(r.first+1, r.second+1) : r;
+        buffer.Pack(Vs, n, box(IDIR, rs, true), box(JDIR, rs, true), box(KDIR, rs, true));
+        sendSize[side] += size(box(IDIR, rs, true), box(JDIR, rs, true), box(KDIR, rs, true));
+      }
+    }
+  }
+  Kokkos::fence();
+
+  double tStart = MPI_Wtime();
+  MPI_Request requests[4];
+  MPI_Comm comm = data->mygrid->CartComm;
+  MPI_SAFE_CALL(MPI_Irecv(bufferRecv[faceLeft].data(), bufferRecv[faceLeft].Size(), realMPI,
+                          procLeft, 310, comm, &requests[0]));
+  MPI_SAFE_CALL(MPI_Irecv(bufferRecv[faceRight].data(), bufferRecv[faceRight].Size(), realMPI,
+                          procRight, 311, comm, &requests[1]));
+  MPI_SAFE_CALL(MPI_Isend(bufferSend[faceRight].data(), sendSize[faceRight], realMPI,
+                          procRight, 310, comm, &requests[2]));
+  MPI_SAFE_CALL(MPI_Isend(bufferSend[faceLeft].data(), sendSize[faceLeft], realMPI,
+                          procLeft, 311, comm, &requests[3]));
+  MPI_SAFE_CALL(MPI_Waitall(4, requests, MPI_STATUSES_IGNORE));
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
+  // Unpack in the ghost zones
+  for(int side = faceLeft ; side <= faceRight ; side++) {
+    const int w = recvWidth[side];
+    Buffer buffer = bufferRecv[side];
+    buffer.ResetPointer();
+    auto r = (side == faceLeft) ? std::make_pair(beg[sdir]-w, beg[sdir])
+                                : std::make_pair(end[sdir], end[sdir]+w);
+    for(int n = 0 ; n < nvar ; n++) {
+      buffer.Unpack(Vc, n, box(IDIR, r, false), box(JDIR, r, false), box(KDIR, r, false));
+    }
+    if(haveVs) {
+      for(int n = 0 ; n < DIMENSIONS ; n++) {
+        auto rs = (n == nrm && side == faceRight) ? std::make_pair(r.first+1, r.second+1) : r;
+        buffer.Unpack(Vs, n, box(IDIR, rs, true), box(JDIR, rs, true), box(KDIR, rs, true));
+      }
+    }
+  }
+  idfx::popRegion();
+#endif
+}
+
 template<typename Phys>
 void Fargo::ShiftFluid(const real t, const real dt, Fluid<Phys>* hydro) {
   idfx::pushRegion("Fargo::ShiftFluid");
@@ -321,32 +470,36 @@ void Fargo::ShiftFluid(const real t, const real dt, Fluid<Phys>* hydro) {
     IDEFIX_ERROR(message);
   }
 
-  IdefixArray4D<real> Uc = hydro->Uc;
-  IdefixArray4D<real> scrh = this->scrhUc;
-  IdefixArray2D<real> meanV = this->meanVelocity;
+  // Get the shift of each column (only recomputed when dt or the Fargo velocity have changed)
+  BuildShiftPlan(dt);
+
+  #ifdef WITH_MPI
+    if(haveTranspose) {
+      ShiftRings(hydro->Uc, Phys::nvar+hydro->nTracer);
+      idfx::popRegion();
+      return;
+    }
+  #endif
+
+  IdefixArray4D<realStore> Uc = hydro->Uc;
+  IdefixArray4D<realStore> scrh = this->scrhUc;
+  IdefixArray2D<int> planM = this->planCell.m;
+  IdefixArray2D<real> planEps = this->planCell.eps;
   IdefixArray1D<real> x1 = data->x[IDIR];
-  IdefixArray1D<real> x2 = data->x[JDIR];
   IdefixArray1D<real> dx2 = data->dx[JDIR];
   IdefixArray1D<real> dx3 = data->dx[KDIR];
   IdefixArray1D<real> sinx2 = data->sinx2;
   IdefixArray1D<real> sinx2m = data->sinx2m;
-  [[maybe_unused]] FargoType fargoType = type;
-  [[maybe_unused]] real sbS = hydro->sbS;
   bool haveDomainDecomposition = this->haveDomainDecomposition;
   int maxShift = this->maxShift;
 
-  real Lphi;
   int sbeg, send;
   #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
-    Lphi = data->mygrid->xend[JDIR] - data->mygrid->xbeg[JDIR];
     sbeg = data->beg[JDIR];
     send = data->end[JDIR];
   #elif GEOMETRY == SPHERICAL
-    Lphi = data->mygrid->xend[KDIR] - data->mygrid->xbeg[KDIR];
     sbeg = data->beg[KDIR];
     send = data->end[KDIR];
-  #else
-    Lphi = 1.0;   // Do nothing, but initialize this.
   #endif
 
   // move Uc to scratch, and fill the ghost zones if required.
@@ -358,35 +511,18 @@ void Fargo::ShiftFluid(const real t, const real dt, Fluid<Phys>* hydro) {
               data->beg[JDIR],data->end[JDIR],
               data->beg[IDIR],data->end[IDIR],
               KOKKOS_LAMBDA(int n, int k, int j, int i) {
-                real w,dphi;
-                int s;
-                #if GEOMETRY == CARTESIAN
-                 if(fargoType==userdef) {
-                  w = meanV(k,i);
-                 } else if(fargoType==shearingbox) {
-                  w = sbS*x1(i);
-                 }
-                 dphi = dx2(j);
-                 s = j;
-                #elif GEOMETRY == POLAR
-                 w = meanV(k,i)/x1(i);
-                 dphi = dx2(j);
+                int s, m;
+                real eps;
+                #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+                 m = planM(k,i);
+                 eps = planEps(k,i);
                  s = j;
                 #elif GEOMETRY == SPHERICAL
-                 w = meanV(j,i)/(x1(i)*sinx2(j));
-                 dphi = dx3(k);
+                 m = planM(j,i);
+                 eps = planEps(j,i);
                  s = k;
                 #endif
 
-                // Compute the offset in phi, modulo the full domain size
-                real dL = std::fmod(w*dt, Lphi);
-
-                // Translate this into # of cells
-                int m = static_cast<int> (std::floor(dL/dphi+HALF_F));
-
-                // get the remainding shift
-                real eps = dL/dphi - m;
-
                 // origin index before the shift
                 // Note the trick to get a positive module i%%n = (i%n + n)%n;
                 int ds = send-sbeg;
@@ -442,40 +578,28 @@ void Fargo::ShiftFluid(const real t, const real dt, Fluid<Phys>* hydro) {
       IdefixArray3D<real> ek = ey;
     #endif
 
+    IdefixArray2D<int> planEkM = this->planEk.m;
+    IdefixArray2D<real> planEkEps = this->planEk.eps;
+
     idefix_for("Fargo:ComputeEk",
       data->beg[KDIR],data->end[KDIR]+KOFFSET,
       data->beg[JDIR],data->end[JDIR]+JOFFSET,
       data->beg[IDIR],data->end[IDIR]+IOFFSET,
       KOKKOS_LAMBDA(int k, int j, int i) {
-        real w,dphi;
-        int s;
-        #if GEOMETRY == CARTESIAN
-          if(fargoType==userdef) {
-          w = 0.5*(meanV(k,i-1)+meanV(k,i));
-          } else if(fargoType==shearingbox) {
-          w = sbS*x1m(i);
-          }
-          dphi = dx2(j);
-          s = j;
-        #elif GEOMETRY == POLAR
-          w = 0.5*(meanV(k,i-1)+meanV(k,i))/x1m(i);
+        real dphi, eps;
+        int s, m;
+        #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+          m = planEkM(k,i);
+          eps = planEkEps(k,i);
           dphi = dx2(j);
           s = j;
         #elif GEOMETRY == SPHERICAL
-          w = 0.5*(meanV(j,i-1)/x1(i-1)+meanV(j,i)/x1(i))/sinx2(j);
+          m = planEkM(j,i);
+          eps = planEkEps(j,i);
           dphi = dx3(k);
           s = k;
         #endif
 
-        // Compute the offset in phi, modulo the full domain size
-        real dL = std::fmod(w*dt, Lphi);
-
-        // Translate this into # of cells
-        int m = static_cast<int> (std::floor(dL/dphi+HALF_F));
-
-        // get the remainding shift
-        real eps = dL/dphi - m;
-
         // origin index before the shift
         // Note the trick to get a positive module i%%n = (i%n + n)%n;
         int n = send-sbeg;
@@ -570,41 +694,28 @@ void Fargo::ShiftFluid(const real t, const real dt, Fluid<Phys>* hydro) {
     // In cartesian and polar coordinates, ei is actually -Ex
     IdefixArray3D<real> ei = ex;
 
+    IdefixArray2D<int> planEiM = this->planEi.m;
+    IdefixArray2D<real> planEiEps = this->planEi.eps;
+
     idefix_for("Fargo:ComputeEi",
       data->beg[KDIR],data->end[KDIR]+KOFFSET,
       data->beg[JDIR],data->end[JDIR]+JOFFSET,
       data->beg[IDIR],data->end[IDIR]+IOFFSET,
       KOKKOS_LAMBDA(int k, int j, int i) {
-        real w,dphi;
-        int s;
-        #if GEOMETRY == CARTESIAN
-          if(fargoType==userdef) {
-          w = 0.5*(meanV(k,i)+meanV(k-1,i));
-          } else if(fargoType==shearingbox) {
-          w = sbS*x1(i);
-          }
-
-          dphi = dx2(j);
-          s = j;
-        #elif GEOMETRY == POLAR
-          w = 0.5*(meanV(k-1,i)+meanV(k,i))/x1(i);
+        real dphi, eps;
+        int s, m;
+        #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+          m = planEiM(k,i);
+          eps = planEiEps(k,i);
           dphi = dx2(j);
           s = j;
         #elif GEOMETRY == SPHERICAL
-          w = 0.5*(meanV(j-1,i)/sinx2(j-1)+meanV(j,i)/sinx2(j))/(x1(i));
+          m = planEiM(j,i);
+          eps = planEiEps(j,i);
           dphi = dx3(k);
           s = k;
         #endif
 
-        // Compute the offset in phi, modulo the full domain size
-        real dL = std::fmod(w*dt, Lphi);
-
-        // Translate this into # of cells
-        int m = static_cast<int> (std::floor(dL/dphi+HALF_F));
-
-        // get the remainding shift
-        real eps = dL/dphi - m;
-
         // origin index before the shift
         // Note the trick to get a positive module i%%n = (i%n + n)%n;
         int n = send-sbeg;
@@ -0,0 +1,181 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "idefix.hpp"
+#include "localTimestep.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+#include "dump.hpp"
+
+LocalTimestep::LocalTimestep(Input &input, DataBlock *data) {
+  idfx::pushRegion("LocalTimestep::LocalTimestep");
+  this->data = data;
+
+  maxLevels = input.Get<int>("TimeIntegrator","lts_levels",0);
+  if(maxLevels < 0 || maxLevels > 10) {
+    IDEFIX_ERROR("lts_levels should be between 0 and 10");
+  }
+
+  const int ntot = data->np_tot[IDIR];
+  bandDt = std::vector<real>(data->mygrid->np_int[IDIR]);
+  bandInvDt = IdefixArray1D<real>("LTS_bandInvDt", ntot);
+  cellPeriod = IdefixArray1D<int>("LTS_cellPeriod", ntot);
+  facePeriod = IdefixArray1D<int>("LTS_facePeriod", ntot+1);
+  cellWeight = IdefixArray1D<real>("LTS_cellWeight", ntot);
+
+  weight[IDIR] = IdefixArray1D<real>("LTS_faceWeight", ntot+1);
+  weight[JDIR] = cellWeight;
+  weight[KDIR] = cellWeight;
+
+  // Until the first timestep is known, every cell is updated at each (single) substep
+  Kokkos::deep_copy(cellPeriod, 0);
+  Kokkos::deep_copy(facePeriod, 0);
+  SetSubstep(0);
+
+  // The finest timestep is needed to restart with the levels of the previous cycle
+  data->dump->RegisterVariable(&dtSub, "ltsDtSub");
+
+  idfx::popRegion();
+}
+
+// Compute the CFL timestep of each band of the full grid from the InvDt of the fluids. This
+// should be called once all of the cells have been updated, i.e. during the first substep.
+real LocalTimestep::ComputeTimestep(const real cfl) {
+  idfx::pushRegion("LocalTimestep::ComputeTimestep");
+
+  IdefixArray1D<real> bandInvDt = this->bandInvDt;
+  Kokkos::deep_copy(bandInvDt, ZERO_F);
+
+  std::vector<IdefixArray3D<real>> invDts{data->hydro->InvDt};
+  for(int n = 0 ; n < data->dust.size() ; n++) {
+    invDts.push_back(data->dust[n]->InvDt);
+  }
+  for(auto &InvDt : invDts) {
+    idefix_for("LTS_BandInvDt",
+               data->beg[KDIR],data->end[KDIR],
+               data->beg[JDIR],data->end[JDIR],
+               data->beg[IDIR],data->end[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        Kokkos::atomic_max(&bandInvDt(i), InvDt(k,j,i));
+      });
+  }
+
+  IdefixArray1D<real>::HostMirror bandInvDtHost = Kokkos::create_mirror_view(bandInvDt);
+  Kokkos::deep_copy(bandInvDtHost, bandInvDt);
+
+  // Gather the bands of the full grid (all of the processes sharing a band contribute to it)
+  std::vector<real> invDt(bandDt.size(), ZERO_F);
+  const int offset = data->gbeg[IDIR] - data->beg[IDIR];
+  for(int i = data->beg[IDIR] ; i < data->end[IDIR] ; i++) {
+    invDt[i + offset - data->nghost[IDIR]] = bandInvDtHost(i);
+  }
+  #ifdef WITH_MPI
+    if(idfx::psize>1) {
+      MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, invDt.data(), invDt.size(), realMPI, MPI_MAX,
+                                  MPI_COMM_WORLD));
+    }
+  #endif
+
+  const real maxInvDt = *std::max_element(invDt.begin(), invDt.end());
+  for(int g = 0 ; g < bandDt.size() ; g++) {
+    bandDt[g] = cfl / invDt[g];
+  }
+
+  idfx::popRegion();
+  return(cfl/maxInvDt);
+}
+
+// Group the bands in levels of the finest timestep dtSub, so that the timestep 2^p*dtSub of
+// each band does not exceed its own CFL timestep nor maxDt. Return the timestep of the cycle.
+real LocalTimestep::SetLevels(const real maxDt) {
+  idfx::pushRegion("LocalTimestep::SetLevels");
+
+  const int nglob = bandDt.size();
+  std::vector<int> period(nglob);
+  nlevels = 0;
+  for(int g = 0 ; g < nglob ; g++) {
+    int p = 0;
+    while(p < maxLevels && std::ldexp(dtSub, p+1) <= bandDt[g]) p++;
+    period[g] = p;
+    nlevels = std::max(nlevels, p);
+  }
+  while(nlevels > 0 && std::ldexp(dtSub, nlevels) > maxDt) nlevels--;
+
+  // Periods of the local cells, including the ghost zones
+  IdefixArray1D<int>::HostMirror cellPeriodHost = Kokkos::create_mirror_view(cellPeriod);
+  IdefixArray1D<int>::HostMirror facePeriodHost = Kokkos::create_mirror_view(facePeriod);
+  const bool isPeriodic = data->mygrid->lbound[IDIR] == periodic;
+  const int ntot = data->np_tot[IDIR];
+  for(int i = 0 ; i < ntot ; i++) {
+    int g = data->gbeg[IDIR] - data->nghost[IDIR] + i - data->beg[IDIR];
+    if(isPeriodic) {
+      g = (g % nglob + nglob) % nglob;
+    } else {
+      g = std::clamp(g, 0, nglob-1);
+    }
+    cellPeriodHost(i) = std::min(period[g], nlevels);
+  }
+  // A face is updated whenever one of its neighbours is
+  facePeriodHost(0) = cellPeriodHost(0);
+  facePeriodHost(ntot) = cellPeriodHost(ntot-1);
+  for(int i = 1 ; i < ntot ; i++) {
+    facePeriodHost(i) = std::min(cellPeriodHost(i-1), cellPeriodHost(i));
+  }
+  Kokkos::deep_copy(cellPeriod, cellPeriodHost);
+  Kokkos::deep_copy(facePeriod, facePeriodHost);
+
+  idfx::popRegion();
+  return(std::ldexp(dtSub, nlevels));
+}
+
+// A cell (or face) of period 2^p is updated with a timestep 2^p*dtSub every 2^p substeps
+void LocalTimestep::SetSubstep(const int substep) {
+  IdefixArray1D<int> cellPeriod = this->cellPeriod;
+  IdefixArray1D<int> facePeriod = this->facePeriod;
+  IdefixArray1D<real> cellWeight = this->cellWeight;
+  IdefixArray1D<real> faceWeight = this->weight[IDIR];
+
+  const int ntot = data->np_tot[IDIR];
+  idefix_for("LTS_SetSubstep", 0, ntot+1,
+    KOKKOS_LAMBDA (int i) {
+      const int np = 1 << facePeriod(i);
+      faceWeight(i) = (substep % np == 0) ? static_cast<real>(np) : ZERO_F;
+      if(i < ntot) {
+        const int nc = 1 << cellPeriod(i);
+        cellWeight(i) = (substep % nc == 0) ? static_cast<real>(nc) : ZERO_F;
+      }
+    });
+}
+
+void LocalTimestep::ShowConfig() {
+  idfx::cout << "LocalTimestep: local time stepping ENABLED with up to " << maxLevels
+             << " levels above the finest timestep." << std::endl;
+  #if MHD == YES
+    IDEFIX_ERROR("Local time stepping is not compatible with MHD (constrained transport).");
+  #endif
+  if(data->haveFargo) {
+    IDEFIX_ERROR("Local time stepping is not compatible with Fargo.");
+  }
+  if(data->hydro->haveFusedSweep) {
+    IDEFIX_ERROR("Local time stepping is not compatible with fused sweeps.");
+  }
+  if(data->hydro->haveTiledSweep) {
+    IDEFIX_ERROR("Local time stepping is not compatible with tiled sweeps.");
+  }
+  for(int n = 0 ; n < data->dust.size() ; n++) {
+    if(data->dust[n]->haveFusedSweep) {
+      IDEFIX_ERROR("Local time stepping is not compatible with fused sweeps.");
+    }
+    if(data->dust[n]->haveTiledSweep) {
+      IDEFIX_ERROR("Local time stepping is not compatible with tiled sweeps.");
+    }
+  }
+}
@@ -0,0 +1,52 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef DATABLOCK_LOCALTIMESTEP_HPP_
+#define DATABLOCK_LOCALTIMESTEP_HPP_
+
+#include <array>
+#include <vector>
+#include "idefix.hpp"
+#include "input.hpp"
+
+class DataBlock;
+
+// Hierarchical (power-of-two) local time stepping.
+// The radial bands of the grid (cells sharing the same global i index) are grouped in levels
+// according to their own CFL timestep. A cycle is made of 2^nlevels substeps of the finest
+// timestep dtSub, and a band of level p is only updated every 2^p substeps, with a timestep
+// 2^p*dtSub. The faces normal to IDIR are updated at the pace of their finest neighbour, and
+// their flux is applied with the same weight on both sides, so that the exchanges between
+// levels are conservative.
+class LocalTimestep {
+ public:
+  LocalTimestep(Input &, DataBlock *);
+
+  real ComputeTimestep(const real);  ///< Compute the timestep of each band, return the finest
+  real SetLevels(const real);        ///< Group the bands in levels, return the cycle timestep
+  void SetSubstep(const int);        ///< Set the weights of the cells and faces for a substep
+  int GetNSubsteps() const { return(1 << nlevels); }
+  void ShowConfig();
+
+  real dtSub{0};                     ///< Finest timestep (duration of a substep)
+  int nlevels{0};                    ///< Number of levels above the finest one in this cycle
+  int maxLevels;                     ///< Maximum number of levels above the finest one
+
+  std::array<IdefixArray1D<real>,3> weight;  ///< Timestep of the faces normal to dir in units
+                                             ///< of dtSub (0 when inactive), function of i
+  IdefixArray1D<real> cellWeight;            ///< Same for the cells
+
+ private:
+  DataBlock *data;
+
+  std::vector<real> bandDt;          ///< Timestep of each band of the full grid
+  IdefixArray1D<real> bandInvDt;     ///< Largest InvDt of each local band
+  IdefixArray1D<int> cellPeriod;     ///< log2 of the update period of the cells (in substeps)
+  IdefixArray1D<int> facePeriod;     ///< Same for the faces normal to IDIR
+};
+
+#endif // DATABLOCK_LOCALTIMESTEP_HPP_
@@ -61,7 +61,10 @@ void DataBlock::MakeGeometry() {
   IdefixArray1D<real> sinx2m  = this->sinx2m;
   IdefixArray1D<real> tanx2m  = this->tanx2m;
   IdefixArray1D<real> sinx2   = this->sinx2;
+  IdefixArray1D<real> cosx2   = this->cosx2;
   IdefixArray1D<real> tanx2   = this->tanx2;
+  IdefixArray1D<real> sinx3   = this->sinx3;
+  IdefixArray1D<real> cosx3   = this->cosx3;
   IdefixArray1D<real> dmu = this->dmu;
 
   idefix_for("Volumes",0,this->np_tot[KDIR],0,this->np_tot[JDIR],0,this->np_tot[IDIR],
@@ -114,6 +117,10 @@ void DataBlock::MakeGeometry() {
     KOKKOS_LAMBDA (int j) {
 #if GEOMETRY != SPHERICAL
       x2gc(j) = x2(j);
+  #if GEOMETRY == POLAR
+      sinx2(j) = sin(x2(j));
+      cosx2(j) = cos(x2(j));
+  #endif
 #else
       real xL = x2m(j);
       real xR = x2p(j);
@@ -121,6 +128,7 @@ void DataBlock::MakeGeometry() {
       sinx2m(j) = sin(xL);
       tanx2m(j) = tan(xL);
       sinx2(j) = sin(x2(j));
+      cosx2(j) = cos(x2(j));
       tanx2(j) = tan(x2(j));
       dmu(j) = FABS(cos(xL)-cos(xR));
 #endif
@@ -131,9 +139,37 @@ void DataBlock::MakeGeometry() {
   idefix_for("GeometricalCentersX3",0,np_tot[KDIR],
     KOKKOS_LAMBDA (int k) {
       x3gc(k) = x3(k);
+#if GEOMETRY == SPHERICAL
+      sinx3(k) = sin(x3(k));
+      cosx3(k) = cos(x3(k));
+#endif
     }
   );
 
+  // Cartesian coordinates of the cell centers, from the separable functions above
+  cartesian.x1 = x1;
+  cartesian.x2 = x2;
+  cartesian.x3 = x3;
+  cartesian.sinx2 = sinx2;
+  cartesian.cosx2 = cosx2;
+  cartesian.sinx3 = sinx3;
+  cartesian.cosx3 = cosx3;
+  if(haveCartesianCache) {
+    cartesian.xc = IdefixArray3D<real>("DataBlock_xc",np_tot[KDIR],np_tot[JDIR],np_tot[IDIR]);
+    cartesian.yc = IdefixArray3D<real>("DataBlock_yc",np_tot[KDIR],np_tot[JDIR],np_tot[IDIR]);
+    cartesian.zc = IdefixArray3D<real>("DataBlock_zc",np_tot[KDIR],np_tot[JDIR],np_tot[IDIR]);
+    CartesianCoordinates separable = cartesian;
+    IdefixArray3D<real> xc = cartesian.xc;
+    IdefixArray3D<real> yc = cartesian.yc;
+    IdefixArray3D<real> zc = cartesian.zc;
+    idefix_for("CartesianCoordinates",0,np_tot[KDIR],0,np_tot[JDIR],0,np_tot[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        separable.Get(k,j,i, xc(k,j,i), yc(k,j,i), zc(k,j,i));
+      }
+    );
+    cartesian.cached = true;
+  }
+
   // Compute Areas
   IdefixArray3D<real> Ax1 = this->A[IDIR];
   IdefixArray3D<real> Ax2 = this->A[JDIR];
@@ -251,10 +251,14 @@ void Planet::updateMp(const real t) {
 }
 
 Point Planet::computeAccel(DataBlock& data, bool& isPlanet) {
-  Point acceleration;
-  Force &force = this->m_force;
-//  Force &force = data.planet[0].force;
   computeForce(data,isPlanet);
+  return getAccel();
+}
+
+// Acceleration due to the force computed by the last computeForce
+Point Planet::getAccel() const {
+  Point acceleration;
+  const Force &force = this->m_force;
   bool excludeHill = pSys->excludeHill;
   if (excludeHill) {
     acceleration.x = force.f_ex_inner[0]+force.f_ex_outer[0];
@@ -268,184 +272,8 @@ Point Planet::computeAccel(DataBlock& data, bool& isPlanet) {
   return acceleration;
 }
 
-/*
-Be careful: you need to substract
-the azimuthally averaged density
-prior to the torque evaluation (BM08 trick)
-*/
+// Force of the gas on this planet (the planets of a system are better computed all at once
+// with PlanetarySystem::ComputeForces)
 void Planet::computeForce(DataBlock& data, bool& isPlanet) {
-  PlanetarySystem::SmoothingFunction smoothingFunction = pSys->myPlanetarySmoothing;
-  real smoothingValue = pSys->smoothingValue;
-  real smoothingExponent = pSys->smoothingExponent;
-
-  IdefixArray1D<real> x1 = data.x[IDIR];
-  IdefixArray1D<real> x2 = data.x[JDIR];
-  IdefixArray1D<real> x3 = data.x[KDIR];
-
-  IdefixArray4D<real> Vc = data.hydro->Vc;
-  IdefixArray3D<real> dV = data.dV;
-
-  real xp;
-  real yp;
-  real zp;
-  real qp;
-
-  if(isPlanet) {
-    xp = this->m_xp;
-    yp = this->m_yp;
-    zp = this->m_zp;
-    qp = this->m_qp;
-  } else {
-    xp = ZERO_F;
-    yp = ZERO_F;
-    zp = ZERO_F;
-    qp = ZERO_F;
-  }
-  real distPlanet = sqrt(xp*xp+yp*yp+zp*zp);
-  real smoothing = smoothingValue * pow(distPlanet,ONE_F+smoothingExponent);
-  real rh = pow(qp/3., 1./3.)*distPlanet;
-  bool excludeHill = pSys->excludeHill;
-
-  // since we cannot throw an error in kokkos kernel, with throw this one before the kernel.
-  #if GEOMETRY == CYLINDRICAL
-    IDEFIX_ERROR("Planet::ComputeForce is not compatible with the GEOMETRY you intend to use");
-  #endif
-
-  Kokkos::parallel_reduce("ComputeForce",
-    Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-    ({data.beg[KDIR],data.beg[JDIR],data.beg[IDIR]},
-      {data.end[KDIR], data.end[JDIR], data.end[IDIR]}),
-    KOKKOS_LAMBDA (int k, int j, int i, Force &forceProc) {
-      real cellMass = dV(k,j,i)*Vc(RHO,k,j,i);
-      real xc, yc, zc;
-      #if GEOMETRY == CARTESIAN
-        xc = x1(i);
-        yc = x2(j);
-        zc = x3(k);
-      #elif GEOMETRY == POLAR
-        xc = x1(i)*cos(x2(j));
-        yc = x1(i)*sin(x2(j));
-        zc = x3(k);
-      #elif GEOMETRY == SPHERICAL
-        xc = x1(i)*sin(x2(j))*cos(x3(k));
-        yc = x1(i)*sin(x2(j))*sin(x3(k));
-        zc = x1(i)*cos(x2(j));
-      #endif
-
-      real distc = sqrt(xc*xc+yc*yc+zc*zc);
-      real dist2 = ((xc-xp)*(xc-xp) + (yc-yp)*(yc-yp) + (zc-zp)*(zc-zp));
-      real hillcut;
-
-      if(excludeHill) {
-        real squaredist2 = sqrt(dist2);
-        if (squaredist2/rh < 0.5) {
-          hillcut = ZERO_F;
-        } else {
-          if (squaredist2 > rh) {
-            hillcut = ONE_F;
-          } else {
-            hillcut = pow(sin((squaredist2/rh-.5)*M_PI),2.);
-          }
-        }
-      }
-
-      real forceCell;
-      switch(smoothingFunction) {
-        case PlanetarySystem::SmoothingFunction::PLUMMER:
-          {
-            dist2 += smoothing*smoothing; // if default potential
-            real distance = sqrt(dist2); // if default potential
-            real InvDist3 = ONE_F/(dist2*distance); // if default potential
-            forceCell = cellMass * InvDist3; // if default potential
-            break;
-          }
-        case PlanetarySystem::SmoothingFunction::POLYNOMIAL:
-          {
-            real rmrp = sqrt(dist2); // if other potential
-            if (rmrp/smoothing < 1) {
-              forceCell = -cellMass*(3.0*rmrp/smoothing - 4.0)/smoothing/smoothing/smoothing;
-            } else {
-              forceCell = cellMass/rmrp/rmrp/rmrp;
-            }
-            break;
-          }
-        default: // do nothing
-          break;
-      }
-      if (distc < distPlanet) {
-        // INNER FORCE
-        forceProc.f_inner[0] += (xc-xp)*forceCell;
-        forceProc.f_inner[1] += (yc-yp)*forceCell;
-        forceProc.f_inner[2] += (zc-zp)*forceCell;
-        if(excludeHill) {
-          forceProc.f_ex_inner[0] += (xc-xp)*forceCell*hillcut;
-          forceProc.f_ex_inner[1] += (yc-yp)*forceCell*hillcut;
-          forceProc.f_ex_inner[2] += (zc-zp)*forceCell*hillcut;
-        } else {
-          forceProc.f_ex_inner[0] += ZERO_F;
-          forceProc.f_ex_inner[1] += ZERO_F;
-          forceProc.f_ex_inner[2] += ZERO_F;
-        }
-      } else {
-        // OUTER FORCE
-        forceProc.f_outer[0] += (xc-xp)*forceCell;
-        forceProc.f_outer[1] += (yc-yp)*forceCell;
-        forceProc.f_outer[2] += (zc-zp)*forceCell;
-        if(excludeHill) {
-          forceProc.f_ex_outer[0] += (xc-xp)*forceCell*hillcut;
-          forceProc.f_ex_outer[1] += (yc-yp)*forceCell*hillcut;
-          forceProc.f_ex_outer[2] += (zc-zp)*forceCell*hillcut;
-        } else {
-          forceProc.f_ex_outer[0] += ZERO_F;
-          forceProc.f_ex_outer[1] += ZERO_F;
-          forceProc.f_ex_outer[2] += ZERO_F;
-        }
-      }
-    }, this->m_force );
-
-  if(pSys->halfdisk) {
-    // Cancel vertical component
-    m_force.f_inner[2] = 0;
-    m_force.f_ex_inner[2] = 0;
-    m_force.f_outer[2] = 0;
-    m_force.f_ex_outer[2] = 0;
-
-    // Multiply by 2 the remaining components
-    for(int i = 0 ; i < 2 ; i++) {
-      m_force.f_inner[i] *= 2;
-      m_force.f_ex_inner[i] *= 2;
-      m_force.f_outer[i] *= 2;
-      m_force.f_ex_outer[i] *= 2;
-    }
-  }
-
-  #ifdef WITH_MPI
-    real forceGlob[12];
-    real forceLoc[12];
-    forceLoc[0] = this->m_force.f_inner[0];
-    forceLoc[1] = this->m_force.f_inner[1];
-    forceLoc[2] = this->m_force.f_inner[2];
-    forceLoc[3] = this->m_force.f_ex_inner[0];
-    forceLoc[4] = this->m_force.f_ex_inner[1];
-    forceLoc[5] = this->m_force.f_ex_inner[2];
-    forceLoc[6] = this->m_force.f_outer[0];
-    forceLoc[7] = this->m_force.f_outer[1];
-    forceLoc[8] = this->m_force.f_outer[2];
-    forceLoc[9] = this->m_force.f_ex_outer[0];
-    forceLoc[10] = this->m_force.f_ex_outer[1];
-    forceLoc[11] = this->m_force.f_ex_outer[2];
-    MPI_SAFE_CALL(MPI_Allreduce(&forceLoc, &forceGlob, 12, realMPI, MPI_SUM, MPI_COMM_WORLD));
-    this->m_force.f_inner[0] = forceGlob[0];
-    this->m_force.f_inner[1] = forceGlob[1];
-    this->m_force.f_inner[2] = forceGlob[2];
-    this->m_force.f_ex_inner[0] = forceGlob[3];
-    this->m_force.f_ex_inner[1] = forceGlob[4];
-    this->m_force.f_ex_inner[2] = forceGlob[5];
-    this->m_force.f_outer[0] = forceGlob[6];
-    this->m_force.f_outer[1] = forceGlob[7];
-    this->m_force.f_outer[2] = forceGlob[8];
-    this->m_force.f_ex_outer[0] = forceGlob[9];
-    this->m_force.f_ex_outer[1] = forceGlob[10];
-    this->m_force.f_ex_outer[2] = forceGlob[11];
-  #endif
+  pSys->ComputeForces(data, {this}, isPlanet);
 }
@@ -47,6 +47,7 @@ class Planet {
     void activatePlanet(const real);
     // refresh the force
     Point computeAccel(DataBlock&, bool&);
+    Point getAccel() const;
     void computeForce(DataBlock&, bool&);
 
  protected:
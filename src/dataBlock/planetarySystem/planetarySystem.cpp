@@ -98,6 +98,9 @@ indirect term, with multiple planets that don't feel each others.");
   }
 #endif
 
+  this->planetParams = IdefixArray2D<real>("Planet_params", this->nbp, nPlanetParameters);
+  this->planetParamsHost = Kokkos::create_mirror_view(this->planetParams);
+
   idfx::popRegion();
 }
 
@@ -166,25 +169,19 @@ void PlanetarySystem::EvolveSystem(DataBlock& data, const real& dt) {
 
 void PlanetarySystem::AdvancePlanetFromDisk(DataBlock& data, const real& dt) {
   idfx::pushRegion("PlanetarySystem::AdvancePlanetFromDisk");
+  // The forces on all of the active planets are computed at once
+  std::vector<Planet*> activePlanets;
   for(int ip=0; ip< this->nbp ; ip++) {
-    if (!(planet[ip].m_isActive)) continue;
-    Point gamma;
-    bool isp = true;
-
-    real qp = planet[ip].m_qp;
-    real xp = planet[ip].m_xp;
-    real yp = planet[ip].m_yp;
-    real zp = planet[ip].m_zp;
-    real vxp = planet[ip].m_vxp;
-    real vyp = planet[ip].m_vyp;
-    real vzp = planet[ip].m_vzp;
-    real r = sqrt(xp*xp + yp*yp + zp*zp);
+    if (planet[ip].m_isActive) activePlanets.push_back(&planet[ip]);
+  }
+  ComputeForces(data, activePlanets, true);
 
-    gamma = planet[ip].computeAccel (data, isp);
+  for(Planet *p : activePlanets) {
+    Point gamma = p->getAccel();
 
-    planet[ip].m_vxp += dt * gamma.x*this->torqueNormalization;
-    planet[ip].m_vyp += dt * gamma.y*this->torqueNormalization;
-    planet[ip].m_vzp += dt * gamma.z*this->torqueNormalization;
+    p->m_vxp += dt * gamma.x*this->torqueNormalization;
+    p->m_vyp += dt * gamma.y*this->torqueNormalization;
+    p->m_vzp += dt * gamma.z*this->torqueNormalization;
   }
   idfx::popRegion();
 }
@@ -407,86 +404,263 @@ std::vector<PointSpeed> PlanetarySystem::ComputeRHS(real& t, std::vector<Planet>
   return planet_update;
 }
 
+// Fill the parameters of a set of planets on the device (the origin with a zero mass when
+// isPlanet is false)
+void PlanetarySystem::PackPlanets(const std::vector<Planet*> &planets, bool isPlanet) {
+  for(int n = 0 ; n < planets.size() ; n++) {
+    real xp{ZERO_F}, yp{ZERO_F}, zp{ZERO_F}, qp{ZERO_F};
+    if(isPlanet) {
+      xp = planets[n]->m_xp;
+      yp = planets[n]->m_yp;
+      zp = planets[n]->m_zp;
+      qp = planets[n]->m_qp;
+    }
+    real distPlanet = sqrt(xp*xp+yp*yp+zp*zp);
+    planetParamsHost(n,PX) = xp;
+    planetParamsHost(n,PY) = yp;
+    planetParamsHost(n,PZ) = zp;
+    planetParamsHost(n,PQ) = qp;
+    planetParamsHost(n,PDIST) = distPlanet;
+    planetParamsHost(n,PSMOOTH) = smoothingValue * pow(distPlanet,ONE_F+smoothingExponent);
+    planetParamsHost(n,PHILL) = pow(qp/3., 1./3.)*distPlanet;
+  }
+  Kokkos::deep_copy(planetParams, planetParamsHost);
+}
+
 void PlanetarySystem::AddPlanetsPotential(IdefixArray3D<real> &phiP, real t) {
   idfx::pushRegion("PlanetarySystem::AddPlanetsPotential");
   bool indirectPlanetsTerm = this->indirectPlanetsTerm;
-  real smoothingValue = this->smoothingValue;
-  real smoothingExponent = this->smoothingExponent;
   SmoothingFunction myPlanetarySmoothing = this->myPlanetarySmoothing;
 
-  IdefixArray1D<real> x1 = this->data->x[IDIR];
-  IdefixArray1D<real> x2 = this->data->x[JDIR];
-  IdefixArray1D<real> x3 = this->data->x[KDIR];
-
+  std::vector<Planet*> activePlanets;
   for(Planet& p : this->planet) {
     // update mass according to mass taper
     p.updateMp(t);
     p.activatePlanet(t);
 
-    bool isActive = p.getIsActive();
-    if (!(isActive)) continue;
-
-    real qp = p.getMp();
-    real xp = p.getXp();
-    real yp = p.getYp();
-    real zp = p.getZp();
-
-    real distPlanet = sqrt(xp*xp+yp*yp+zp*zp);
-    real smoothing = smoothingValue * pow(distPlanet,1.0+smoothingExponent);
-    real Mcentral = this->data->gravity->centralMass;
-
-    idefix_for("PlanetPotential",
-      0,this->data->np_tot[KDIR],
-      0, this->data->np_tot[JDIR],
-      0, this->data->np_tot[IDIR],
-        KOKKOS_LAMBDA (int k, int j, int i) {
-          real xc, yc, zc;
-          #if GEOMETRY == CARTESIAN
-            xc = x1(i);
-            yc = x2(j);
-            zc = x3(k);
-          #elif GEOMETRY == POLAR
-            xc = x1(i)*cos(x2(j));
-            yc = x1(i)*sin(x2(j));
-            zc = x3(k);
-          #elif GEOMETRY == SPHERICAL
-            xc = x1(i)*sin(x2(j))*cos(x3(k));
-            yc = x1(i)*sin(x2(j))*sin(x3(k));
-            zc = x1(i)*cos(x2(j));
-          #endif
-
-        real dist = ((xc-xp)*(xc-xp)+
-                    (yc-yp)*(yc-yp)+
-                    (zc-zp)*(zc-zp));
-
-        // term due to planet
-        switch(myPlanetarySmoothing) {
-            case PLUMMER:
-              {
-                phiP(k,j,i) += -Mcentral*qp/sqrt(dist+smoothing*smoothing);
-                break;
-              }
-            case POLYNOMIAL:
-              {
-                real rmrp = sqrt(dist);
-                if (rmrp/smoothing < 1) {
-                  phiP(k,j,i) += -(Mcentral*qp/rmrp)*(pow(rmrp/smoothing,4.0) -
-                                                     2.0*pow(rmrp/smoothing,3.0)+
-                                                     2.0*rmrp/smoothing);
-                } else {
-                  phiP(k,j,i) += -(Mcentral*qp/rmrp);
+    if (p.getIsActive()) activePlanets.push_back(&p);
+  }
+  const int nActive = activePlanets.size();
+  if(nActive == 0) {
+    idfx::popRegion();
+    return;
+  }
+  PackPlanets(activePlanets, true);
+
+  CartesianCoordinates cartesian = this->data->cartesian;
+  IdefixArray2D<real> params = this->planetParams;
+  real Mcentral = this->data->gravity->centralMass;
+
+  // Potential of all of the active planets, in a single pass on the grid
+  idefix_for("PlanetPotential",
+    0,this->data->np_tot[KDIR],
+    0, this->data->np_tot[JDIR],
+    0, this->data->np_tot[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        real x, y, z;
+        cartesian.Get(k,j,i, x, y, z);
+        real phi = phiP(k,j,i);
+
+        for(int n = 0 ; n < nActive ; n++) {
+          const real xp = params(n,PX);
+          const real yp = params(n,PY);
+          const real zp = params(n,PZ);
+          const real qp = params(n,PQ);
+          const real distPlanet = params(n,PDIST);
+          const real smoothing = params(n,PSMOOTH);
+
+          real dist = ((x-xp)*(x-xp)+
+                      (y-yp)*(y-yp)+
+                      (z-zp)*(z-zp));
+
+          // term due to planet
+          switch(myPlanetarySmoothing) {
+              case PLUMMER:
+                {
+                  phi += -Mcentral*qp/sqrt(dist+smoothing*smoothing);
+                  break;
+                }
+              case POLYNOMIAL:
+                {
+                  real rmrp = sqrt(dist);
+                  if (rmrp/smoothing < 1) {
+                    phi += -(Mcentral*qp/rmrp)*(pow(rmrp/smoothing,4.0) -
+                                               2.0*pow(rmrp/smoothing,3.0)+
+                                               2.0*rmrp/smoothing);
+                  } else {
+                    phi += -(Mcentral*qp/rmrp);
+                  }
+                  break;
                 }
+              default: // do nothing
                 break;
-              }
-            default: // do nothing
-              break;
+          }
+          // indirect term due to planet
+          if (indirectPlanetsTerm) {
+            phi += Mcentral*qp*(x*xp+y*yp+z*zp)/(distPlanet*distPlanet*distPlanet);
+          }
         }
-        // indirect term due to planet
-        if (indirectPlanetsTerm) {
-          phiP(k,j,i) += Mcentral*qp*(xc*xp+yc*yp+zc*zp)/(distPlanet*distPlanet*distPlanet);
+        phiP(k,j,i) = phi;
+  });
+
+  idfx::popRegion();
+}
+
+// Force of the gas on nPlanets planets, reduced in an array of 12 components per planet:
+// f_inner, f_ex_inner, f_outer and f_ex_outer (see Force)
+struct PlanetarySystem_ForceFunctor {
+  using value_type = real[];
+  using size_type = int;
+
+  const int value_count;
+  const int nPlanets;
+  IdefixArray4D<realStore> Vc;
+  IdefixArray3D<real> dV;
+  CartesianCoordinates cartesian;
+  IdefixArray2D<real> params;
+  PlanetarySystem::SmoothingFunction smoothingFunction;
+  bool excludeHill;
+
+  PlanetarySystem_ForceFunctor(int nPlanets, IdefixArray4D<realStore> Vc, IdefixArray3D<real> dV,
+                               CartesianCoordinates cartesian, IdefixArray2D<real> params,
+                               PlanetarySystem::SmoothingFunction smoothingFunction,
+                               bool excludeHill):
+    value_count(12*nPlanets), nPlanets(nPlanets), Vc(Vc), dV(dV), cartesian(cartesian),
+    params(params), smoothingFunction(smoothingFunction), excludeHill(excludeHill) {}
+
+  KOKKOS_INLINE_FUNCTION void init(value_type force) const {
+    for(int n = 0 ; n < value_count ; n++) force[n] = ZERO_F;
+  }
+
+  KOKKOS_INLINE_FUNCTION void join(value_type dst, const value_type src) const {
+    for(int n = 0 ; n < value_count ; n++) dst[n] += src[n];
+  }
+
+  KOKKOS_INLINE_FUNCTION void operator()(int k, int j, int i, value_type force) const {
+    const real cellMass = dV(k,j,i)*Vc(RHO,k,j,i);
+    real x, y, z;
+    cartesian.Get(k,j,i, x, y, z);
+    const real distc = sqrt(x*x+y*y+z*z);
+
+    for(int n = 0 ; n < nPlanets ; n++) {
+      const real xp = params(n,PlanetarySystem::PX);
+      const real yp = params(n,PlanetarySystem::PY);
+      const real zp = params(n,PlanetarySystem::PZ);
+      const real distPlanet = params(n,PlanetarySystem::PDIST);
+      const real smoothing = params(n,PlanetarySystem::PSMOOTH);
+      const real rh = params(n,PlanetarySystem::PHILL);
+
+      real dist2 = ((x-xp)*(x-xp) + (y-yp)*(y-yp) + (z-zp)*(z-zp));
+      real hillcut{ONE_F};
+
+      if(excludeHill) {
+        real squaredist2 = sqrt(dist2);
+        if (squaredist2/rh < 0.5) {
+          hillcut = ZERO_F;
+        } else {
+          if (squaredist2 > rh) {
+            hillcut = ONE_F;
+          } else {
+            hillcut = pow(sin((squaredist2/rh-.5)*M_PI),2.);
+          }
         }
-    });
+      }
+
+      real forceCell{ZERO_F};
+      switch(smoothingFunction) {
+        case PlanetarySystem::SmoothingFunction::PLUMMER:
+          {
+            dist2 += smoothing*smoothing;
+            real distance = sqrt(dist2);
+            real InvDist3 = ONE_F/(dist2*distance);
+            forceCell = cellMass * InvDist3;
+            break;
+          }
+        case PlanetarySystem::SmoothingFunction::POLYNOMIAL:
+          {
+            real rmrp = sqrt(dist2);
+            if (rmrp/smoothing < 1) {
+              forceCell = -cellMass*(3.0*rmrp/smoothing - 4.0)/smoothing/smoothing/smoothing;
+            } else {
+              forceCell = cellMass/rmrp/rmrp/rmrp;
+            }
+            break;
+          }
+        default: // do nothing
+          break;
+      }
+      // Inner (offset 0) or outer (offset 6) force, and the same without the Hill sphere
+      real *f = force + 12*n + (distc < distPlanet ? 0 : 6);
+      f[0] += (x-xp)*forceCell;
+      f[1] += (y-yp)*forceCell;
+      f[2] += (z-zp)*forceCell;
+      if(excludeHill) {
+        f[3] += (x-xp)*forceCell*hillcut;
+        f[4] += (y-yp)*forceCell*hillcut;
+        f[5] += (z-zp)*forceCell*hillcut;
+      }
+    }
+  }
+};
+
+/*
+Be careful: you need to substract
+the azimuthally averaged density
+prior to the torque evaluation (BM08 trick)
+*/
+void PlanetarySystem::ComputeForces(DataBlock& data, const std::vector<Planet*> &planets,
+                                    bool isPlanet) {
+  idfx::pushRegion("PlanetarySystem::ComputeForces");
+  const int nPlanets = planets.size();
+  if(nPlanets == 0) {
+    idfx::popRegion();
+    return;
   }
 
+  // since we cannot throw an error in kokkos kernel, with throw this one before the kernel.
+  #if GEOMETRY == CYLINDRICAL
+    IDEFIX_ERROR("Planet::ComputeForce is not compatible with the GEOMETRY you intend to use");
+  #endif
+
+  PackPlanets(planets, isPlanet);
+
+  PlanetarySystem_ForceFunctor func(nPlanets, data.hydro->Vc, data.dV, data.cartesian,
+                                    planetParams, myPlanetarySmoothing, excludeHill);
+
+  std::vector<real> force(12*nPlanets);
+  Kokkos::View<real*, Kokkos::HostSpace, Kokkos::MemoryUnmanaged> result(force.data(),
+                                                                         force.size());
+  Kokkos::parallel_reduce("ComputeForce",
+    Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
+    ({data.beg[KDIR],data.beg[JDIR],data.beg[IDIR]},
+      {data.end[KDIR], data.end[JDIR], data.end[IDIR]}),
+    func, result);
+
+  if(halfdisk) {
+    for(int n = 0 ; n < nPlanets ; n++) {
+      real *f = force.data() + 12*n;
+      // Cancel vertical component, and multiply by 2 the remaining components
+      for(int m = 0 ; m < 12 ; m += 3) {
+        f[m] *= 2;
+        f[m+1] *= 2;
+        f[m+2] = 0;
+      }
+    }
+  }
+
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, force.data(), 12*nPlanets, realMPI, MPI_SUM,
+                                MPI_COMM_WORLD));
+  #endif
+
+  for(int n = 0 ; n < nPlanets ; n++) {
+    Force &f = planets[n]->m_force;
+    for(int m = 0 ; m < 3 ; m++) {
+      f.f_inner[m] = force[12*n+m];
+      f.f_ex_inner[m] = force[12*n+3+m];
+      f.f_outer[m] = force[12*n+6+m];
+      f.f_ex_outer[m] = force[12*n+9+m];
+    }
+  }
   idfx::popRegion();
 }
@@ -29,6 +29,8 @@ class PlanetarySystem {
  public:
     enum Integrator {RK4=1, ANALYTICAL, RK5};
     enum SmoothingFunction {PLUMMER=1, POLYNOMIAL};
+    // Parameters of each planet in the batched kernels
+    enum PlanetParameter {PX, PY, PZ, PQ, PDIST, PSMOOTH, PHILL, nPlanetParameters};
 
     PlanetarySystem(Input&, DataBlock*);
     void EvolveSystem(DataBlock&, const real& );
@@ -37,6 +39,8 @@ class PlanetarySystem {
     void IntegrateRK5(DataBlock&, const real&);
     void ShowConfig();
     void AddPlanetsPotential(IdefixArray3D<real> &, real);
+    // Forces of the disk on a set of planets, computed in a single reduction
+    void ComputeForces(DataBlock&, const std::vector<Planet*> &, bool);
     std::vector<PointSpeed> ComputeRHS(real&, std::vector<Planet>);
 
     // number of planets
@@ -49,6 +53,7 @@ class PlanetarySystem {
  protected:
     void AdvancePlanetFromDisk(DataBlock&, const real&);
     void IntegratePlanets(DataBlock&, const real&);
+    void PackPlanets(const std::vector<Planet*> &, bool);
     friend class Planet;
     real massTaper{ZERO_F};
     real smoothingValue;
@@ -61,6 +66,10 @@ class PlanetarySystem {
     Integrator myPlanetaryIntegrator;
     SmoothingFunction myPlanetarySmoothing;
     DataBlock *data;
+
+    // Parameters of the planets processed by the batched kernels
+    IdefixArray2D<real> planetParams;
+    IdefixArray2D<real>::HostMirror planetParamsHost;
 };
 
 #endif // DATABLOCK_PLANETARYSYSTEM_PLANETARYSYSTEM_HPP_
@@ -0,0 +1,45 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include "scratchArena.hpp"
+
+ScratchArena::ScratchArena(Input &input) {
+  aliasing = input.GetOrSet<bool>("Memory","aliasing",0, true);
+}
+
+// Place the buffer in the smallest block which is large enough and does not already hold a
+// buffer of the same phases, or in a new block if there is none.
+void *ScratchArena::Allocate(int phases, const std::string &name, size_t bytes) {
+  requested += bytes;
+  Block *target = nullptr;
+  if(aliasing) {
+    for(Block &block : blocks) {
+      if((block.phases & phases) == 0 && block.memory.extent(0) >= bytes) {
+        if(target == nullptr || block.memory.extent(0) < target->memory.extent(0)) {
+          target = &block;
+        }
+      }
+    }
+  }
+  if(target == nullptr) {
+    blocks.emplace_back();
+    target = &blocks.back();
+    target->memory = Kokkos::View<char*, Device>("Scratch_"+name, bytes);
+    allocated += bytes;
+  }
+  target->phases |= phases;
+  target->names.push_back(name);
+  return(target->memory.data());
+}
+
+void ScratchArena::ShowConfig() {
+  if(blocks.empty()) return;
+  idfx::cout << "ScratchArena: " << requested/(1024.0*1024.0) << " MB of scratch buffers held in "
+             << allocated/(1024.0*1024.0) << " MB (" << blocks.size() << " blocks)";
+  if(!aliasing) idfx::cout << ", aliasing disabled";
+  idfx::cout << "." << std::endl;
+}
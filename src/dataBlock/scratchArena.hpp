@@ -0,0 +1,69 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef DATABLOCK_SCRATCHARENA_HPP_
+#define DATABLOCK_SCRATCHARENA_HPP_
+
+#include <string>
+#include <vector>
+
+#include "idefix.hpp"
+#include "input.hpp"
+
+// Pool of the scratch buffers of the modules of a DataBlock. Each buffer is requested for the
+// phases of the cycle during which it is live (a buffer which is only used while the RKL cycle
+// runs does not hold any data during the stages of the main integrator). Since the phases never
+// overlap, the buffers of different phases can share the same memory: each block of the pool
+// holds at most one buffer of each phase. The buffers are unmanaged views of the blocks, the
+// blocks being freed with the DataBlock.
+class ScratchArena {
+ public:
+  // Phases of a cycle, which may be combined when a buffer is live in several of them
+  enum Phase {
+    Stage = 1,    ///< Stages of the main integrator (Fluid::EvolveStage)
+    RKL = 2,      ///< Runge-Kutta-Legendre cycle
+    Hall = 4,     ///< Hall subcycles
+    Fargo = 8     ///< Fargo advection (Fargo::ShiftSolution)
+  };
+
+  explicit ScratchArena(Input &);
+
+  template <typename T>
+  IdefixArray3D<T> Get3D(int phases, const std::string &name,
+                         size_t nk, size_t nj, size_t ni) {
+    const size_t bytes = IdefixArray3D<T>::required_allocation_size(nk, nj, ni);
+    T *ptr = reinterpret_cast<T*>(Allocate(phases, name, bytes));
+    return(IdefixArray3D<T>(ptr, nk, nj, ni));
+  }
+
+  template <typename T>
+  IdefixArray4D<T> Get4D(int phases, const std::string &name,
+                         size_t nv, size_t nk, size_t nj, size_t ni) {
+    const Layout4D layout = IdefixLayout4D(nv, nk, nj, ni);
+    const size_t bytes = IdefixArray4D<T>::required_allocation_size(layout);
+    T *ptr = reinterpret_cast<T*>(Allocate(phases, name, bytes));
+    return(IdefixArray4D<T>(ptr, layout));
+  }
+
+  void ShowConfig();
+
+ private:
+  struct Block {
+    Kokkos::View<char*, Device> memory;
+    int phases{0};                      // Phases of the buffers held by this block
+    std::vector<std::string> names;     // Names of these buffers
+  };
+
+  void *Allocate(int, const std::string &, size_t);
+
+  std::vector<Block> blocks;
+  size_t requested{0};          // Total size of the buffers (bytes)
+  size_t allocated{0};          // Total size of the blocks (bytes)
+  bool aliasing{true};          // Whether the buffers of different phases share the blocks
+};
+
+#endif // DATABLOCK_SCRATCHARENA_HPP_
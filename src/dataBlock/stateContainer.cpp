@@ -29,6 +29,8 @@ void StateContainer::CopyFrom(StateContainer &in) {
     }
     if(this->stateVector[s].type == State::idefixArray4D) {
       Kokkos::deep_copy(this->stateVector[s].array, in.stateVector[s].array);
+    } else if(this->stateVector[s].type == State::idefixStoreArray4D) {
+      Kokkos::deep_copy(this->stateVector[s].storeArray, in.stateVector[s].storeArray);
     } else {
       IDEFIX_ERROR("Cannot copy states which are undefined");
     }
@@ -45,10 +47,16 @@ void StateContainer::AllocateAs(StateContainer &in) {
 
     if(stateIn.type == State::idefixArray4D) {
       // But then reinit the array
-      stateOut.array = IdefixArray4D<real>(stateIn.name, stateIn.array.extent(0),
+      stateOut.array = IdefixArray4D<real>(stateIn.name, IdefixLayout4D(stateIn.array.extent(0),
                                                               stateIn.array.extent(1),
                                                               stateIn.array.extent(2),
-                                                              stateIn.array.extent(3));
+                                                              stateIn.array.extent(3)));
+    } else if(stateIn.type == State::idefixStoreArray4D) {
+      stateOut.storeArray = IdefixArray4D<realStore>(stateIn.name,
+                                              IdefixLayout4D(stateIn.storeArray.extent(0),
+                                                             stateIn.storeArray.extent(1),
+                                                             stateIn.storeArray.extent(2),
+                                                             stateIn.storeArray.extent(3)));
     } else {
       IDEFIX_ERROR("Cannot allocate a state with type none");
     }
@@ -71,6 +79,21 @@ void StateContainer::PushArray(IdefixArray4D<real>& in,
   idfx::popRegion();
 }
 
+#ifdef MIXED_PRECISION
+void StateContainer::PushArray(IdefixArray4D<realStore>& in,
+                               State::TypeLocation loc,
+                               std::string name) {
+  idfx::pushRegion("StateContainer::PushArray");
+  State state;
+  state.storeArray = in;
+  state.type = State::idefixStoreArray4D;
+  state.name = name;
+  state.location = loc;
+  this->stateVector.push_back(state);
+  idfx::popRegion();
+}
+#endif
+
 
 void StateContainer::AddAndStore(const real wl, const real wr, StateContainer & in) {
   idfx::pushRegion("StateContainer::AddAndStore");
@@ -96,6 +119,19 @@ void StateContainer::AddAndStore(const real wl, const real wr, StateContainer &
                   KOKKOS_LAMBDA(int n, int k, int j, int i) {
                     Vout(n,k,j,i) = wl * Vout(n,k,j,i) + wr * Vin(n,k,j,i);
                   } );
+    } else if(stateIn.type == State::idefixStoreArray4D) {
+      // The weighted sum is computed in real precision
+      auto Vin = stateIn.storeArray;
+      auto Vout = stateOut.storeArray;
+      idefix_for("StateContainer::AddAndStore",
+                  0, Vin.extent(0),
+                  0, Vin.extent(1),
+                  0, Vin.extent(2),
+                  0, Vin.extent(3),
+                  KOKKOS_LAMBDA(int n, int k, int j, int i) {
+                    Vout(n,k,j,i) = wl * static_cast<real>(Vout(n,k,j,i))
+                                  + wr * static_cast<real>(Vin(n,k,j,i));
+                  } );
     } else {
       IDEFIX_ERROR("Cannot Add and store from state of unknown type");
     }
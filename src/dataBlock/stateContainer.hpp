@@ -15,10 +15,11 @@
 class State{
  public:
   enum TypeLocation{undefined, center, face, edge};
-  enum TypeState{none, idefixArray4D};
+  enum TypeState{none, idefixArray4D, idefixStoreArray4D};
 
   TypeState type{none};           ///< type of data contained by this state
   IdefixArray4D<real> array;      ///< only defined if type==IdefixArray4D
+  IdefixArray4D<realStore> storeArray;  ///< only defined if type==IdefixStoreArray4D
   TypeLocation location{undefined};    ///< location of array when type==IdefixArray4D
                                        ///< (otherwise undefined)
   std::string name;               ///< Name of the full state (always applicable)
@@ -30,6 +31,9 @@ class StateContainer {
   void CopyFrom(StateContainer &);    // Return a deepcopy of the current state container
   void AllocateAs(StateContainer &);    // Return a deepcopy of the current state container
   void PushArray(IdefixArray4D<real> &, State::TypeLocation, std::string);
+#ifdef MIXED_PRECISION
+  void PushArray(IdefixArray4D<realStore> &, State::TypeLocation, std::string);
+#endif
   void AddAndStore(const real, const real, StateContainer&);
 
 
@@ -15,101 +15,135 @@
 #include "convertConsToPrim.hpp"
 
 // Compute Riemann fluxes from states using HLL solver
+template <typename Phys, int DIR>
+struct RiemannSolver_HllHDFunctor {
+  //*****************************************************************
+  // Functor constructor
+  //*****************************************************************
+  explicit RiemannSolver_HllHDFunctor(RiemannSolver<Phys> *rSolver):
+      extrapol{*rSolver->template GetExtrapolator<DIR>()} {
+    eos = *(rSolver->hydro->eos.get());
+  }
+
+  //*****************************************************************
+  // Functor Variables
+  //*****************************************************************
+  EquationOfState eos;
+  ExtrapolateToFaces<Phys,DIR> extrapol;
+
+  // No extension in the directions perpendicular to DIR
+  int iextend{0};
+  int jextend{0};
+  int kextend{0};
+
+  //*****************************************************************
+  // Functor Operator
+  //*****************************************************************
+  // Flux and cMax are either the global arrays of the hydro object, or pencil arrays held in
+  // scratch memory when the fused directional sweep is used.
+  template <typename FluxArray, typename SpeedArray>
+  KOKKOS_INLINE_FUNCTION void operator() (const int k, const int j, const int i,
+                                          const FluxArray &Flux,
+                                          const SpeedArray &cMax) const {
+    [[maybe_unused]] constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
+    [[maybe_unused]] constexpr int joffset = (DIR==JDIR) ? 1 : 0;
+    [[maybe_unused]] constexpr int koffset = (DIR==KDIR) ? 1 : 0;
+
+    // Init the directions (should be in the kernel for proper optimisation by the compilers)
+    constexpr int Xn = DIR+MX1;
+
+    // Primitive variables
+    real vL[Phys::nvar];
+    real vR[Phys::nvar];
+
+    // Conservative variables
+    real uL[Phys::nvar];
+    real uR[Phys::nvar];
+
+    // Flux (left and right)
+    real fluxL[Phys::nvar];
+    real fluxR[Phys::nvar];
+
+    // Signal speeds
+    real cL, cR, cmax;
+
+    // 1-- Store the primitive variables on the left, right, and averaged states
+    extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+
+    // 2-- Get the wave speed
+    #if HAVE_ENERGY
+      cL = std::sqrt(eos.GetGamma(vL[PRS],vL[RHO])*(vL[PRS]/vL[RHO]));
+      cR = std::sqrt(eos.GetGamma(vR[PRS],vR[RHO])*(vR[PRS]/vR[RHO]));
+    #else
+      cL = HALF_F*(eos.GetWaveSpeed(k,j,i)
+                  +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
+      cR = cL;
+    #endif
+
+    // 4.1
+    real cminL = vL[Xn] - cL;
+    real cmaxL = vL[Xn] + cL;
+
+    real cminR = vR[Xn] - cR;
+    real cmaxR = vR[Xn] + cR;
+
+    real SL = FMIN(cminL, cminR);
+    real SR = FMAX(cmaxL, cmaxR);
+
+    cmax  = FMAX(FABS(SL), FABS(SR));
+
+    // 2-- Compute the conservative variables: do this by extrapolation
+    K_PrimToCons<Phys>(uL, vL, &eos);
+    K_PrimToCons<Phys>(uR, vR, &eos);
+
+    // 3-- Compute the left and right fluxes
+    K_Flux<Phys,DIR>(fluxL, vL, uL, cL*cL);
+    K_Flux<Phys,DIR>(fluxR, vR, uR, cR*cR);
+
+    // 5-- Compute the flux from the left and right states
+    if (SL > 0) {
+#pragma unroll
+      for (int nv = 0 ; nv < Phys::nvar; nv++) {
+        Flux(nv,k,j,i) = fluxL[nv];
+      }
+    } else if (SR < 0) {
+#pragma unroll
+      for (int nv = 0 ; nv < Phys::nvar; nv++) {
+        Flux(nv,k,j,i) = fluxR[nv];
+      }
+    } else {
+#pragma unroll
+      for(int nv = 0 ; nv < Phys::nvar; nv++) {
+        Flux(nv,k,j,i) = SL*SR*uR[nv] - SL*SR*uL[nv] + SR*fluxL[nv] - SL*fluxR[nv];
+        Flux(nv,k,j,i) /= (SR - SL);
+      }
+    }
+
+    //6-- Compute maximum wave speed for this sweep
+    cMax(k,j,i) = cmax;
+  }
+};
+
+// Compute Riemann fluxes on all of the faces of the domain with the HllHD solver
 template <typename Phys>
 template<const int DIR>
-void RiemannSolver<Phys>::HllHD(IdefixArray4D<real> &Flux) {
+void RiemannSolver<Phys>::HllHD(IdefixArray4D<realStore> &Flux) {
   idfx::pushRegion("RiemannSolver::HLL_Solver");
 
   constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
   constexpr int joffset = (DIR==JDIR) ? 1 : 0;
   constexpr int koffset = (DIR==KDIR) ? 1 : 0;
 
-  IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Vs = this->Vs;
   IdefixArray3D<real> cMax = this->cMax;
-  EquationOfState eos = *(hydro->eos.get());
 
-  // Required for high order interpolations
-  IdefixArray1D<real> dx = this->data->dx[DIR];
+  RiemannSolver_HllHDFunctor<Phys,DIR> riemannFlux(this);
 
-  ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
   idefix_for("HLL_Kernel",
              data->beg[KDIR],data->end[KDIR]+koffset,
              data->beg[JDIR],data->end[JDIR]+joffset,
              data->beg[IDIR],data->end[IDIR]+ioffset,
     KOKKOS_LAMBDA (int k, int j, int i) {
-      // Init the directions (should be in the kernel for proper optimisation by the compilers)
-      constexpr int Xn = DIR+MX1;
-
-      // Primitive variables
-      real vL[Phys::nvar];
-      real vR[Phys::nvar];
-
-      // Conservative variables
-      real uL[Phys::nvar];
-      real uR[Phys::nvar];
-
-      // Flux (left and right)
-      real fluxL[Phys::nvar];
-      real fluxR[Phys::nvar];
-
-      // Signal speeds
-      real cL, cR, cmax;
-
-      // 1-- Store the primitive variables on the left, right, and averaged states
-      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
-
-      // 2-- Get the wave speed
-      #if HAVE_ENERGY
-        cL = std::sqrt(eos.GetGamma(vL[PRS],vL[RHO])*(vL[PRS]/vL[RHO]));
-        cR = std::sqrt(eos.GetGamma(vR[PRS],vR[RHO])*(vR[PRS]/vR[RHO]));
-      #else
-        cL = HALF_F*(eos.GetWaveSpeed(k,j,i)
-                    +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
-        cR = cL;
-      #endif
-
-      // 4.1
-      real cminL = vL[Xn] - cL;
-      real cmaxL = vL[Xn] + cL;
-
-      real cminR = vR[Xn] - cR;
-      real cmaxR = vR[Xn] + cR;
-
-      real SL = FMIN(cminL, cminR);
-      real SR = FMAX(cmaxL, cmaxR);
-
-      cmax  = FMAX(FABS(SL), FABS(SR));
-
-      // 2-- Compute the conservative variables: do this by extrapolation
-      K_PrimToCons<Phys>(uL, vL, &eos);
-      K_PrimToCons<Phys>(uR, vR, &eos);
-
-      // 3-- Compute the left and right fluxes
-      K_Flux<Phys,DIR>(fluxL, vL, uL, cL*cL);
-      K_Flux<Phys,DIR>(fluxR, vR, uR, cR*cR);
-
-      // 5-- Compute the flux from the left and right states
-      if (SL > 0) {
-#pragma unroll
-        for (int nv = 0 ; nv < Phys::nvar; nv++) {
-          Flux(nv,k,j,i) = fluxL[nv];
-        }
-      } else if (SR < 0) {
-#pragma unroll
-        for (int nv = 0 ; nv < Phys::nvar; nv++) {
-          Flux(nv,k,j,i) = fluxR[nv];
-        }
-      } else {
-#pragma unroll
-        for(int nv = 0 ; nv < Phys::nvar; nv++) {
-          Flux(nv,k,j,i) = SL*SR*uR[nv] - SL*SR*uL[nv] + SR*fluxL[nv] - SL*fluxR[nv];
-          Flux(nv,k,j,i) /= (SR - SL);
-        }
-      }
-
-      //6-- Compute maximum wave speed for this sweep
-      cMax(k,j,i) = cmax;
+      riemannFlux(k, j, i, Flux, cMax);
     }
   );
 
@@ -11,10 +11,10 @@
 #include "idefix.hpp"
 #include "fluid.hpp"
 
-template <const int DIR>
+template <const int DIR, typename FluxArray>
 KOKKOS_FORCEINLINE_FUNCTION void K_StoreEMF( const int i, const int j, const int k,
                                         const real st, const real sb,
-                                        const IdefixArray4D<real> &Flux,
+                                        const FluxArray &Flux,
                                         const IdefixArray3D<real> &Et,
                                         const IdefixArray3D<real> &Eb ) {
   EXPAND(                                           ,
@@ -28,10 +28,10 @@ KOKKOS_FORCEINLINE_FUNCTION void K_StoreEMF( const int i, const int j, const int
   #endif
 }
 
-template <const int DIR>
+template <const int DIR, typename FluxArray>
 KOKKOS_FORCEINLINE_FUNCTION void K_StoreContact( const int i, const int j, const int k,
                                         const real st, const real sb,
-                                        const IdefixArray4D<real> &Flux,
+                                        const FluxArray &Flux,
                                         const IdefixArray3D<real> &Et,
                                         const IdefixArray3D<real> &Eb,
                                         const IdefixArray3D<real> &SV) {
@@ -16,222 +16,270 @@
 #include "constrainedTransport.hpp"
 
 // Compute Riemann fluxes from states using TVDLF solver
-template <typename Phys>
-template<const int DIR>
-void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
-  idfx::pushRegion("RiemannSolver::TVDLF_MHD");
-
+template <typename Phys, int DIR>
+struct RiemannSolver_TvdlfMHDFunctor {
   using EMF = ConstrainedTransport<Phys>;
 
-  constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
-  constexpr int joffset = (DIR==JDIR) ? 1 : 0;
-  constexpr int koffset = (DIR==KDIR) ? 1 : 0;
+  //*****************************************************************
+  // Functor constructor
+  //*****************************************************************
+  explicit RiemannSolver_TvdlfMHDFunctor(RiemannSolver<Phys> *rSolver):
+      extrapol{*rSolver->template GetExtrapolator<DIR>()} {
+    Fluid<Phys> *hydro = rSolver->hydro;
+    DataBlock *data = rSolver->data;
 
-  // extension in perp to the direction of integration, as required by CT.
-  constexpr int iextend = (DIR==IDIR) ? 0 : 1;
-  #if DIMENSIONS > 1
-    constexpr int jextend = (DIR==JDIR) ? 0 : 1;
-  #else
-    constexpr int jextend = 0;
-  #endif
-  #if DIMENSIONS > 2
-    constexpr int kextend = (DIR==KDIR) ? 0 : 1;
-  #else
-    constexpr int kextend = 0;
-  #endif
-
-  IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Vs = this->Vs;
-  IdefixArray3D<real> cMax = this->cMax;
+    constexpr int perpExtension = 1;
+    // extension in perp to the direction of integration, as required by CT.
+    iextend = (DIR==IDIR) ? 0 : perpExtension;
+    #if DIMENSIONS > 1
+      jextend = (DIR==JDIR) ? 0 : perpExtension;
+    #endif
+    #if DIMENSIONS > 2
+      kextend = (DIR==KDIR) ? 0 : perpExtension;
+    #endif
 
-  // Required for high order interpolations
-  IdefixArray1D<real> dx = this->data->dx[DIR];
-
-  // References to required emf components
-  IdefixArray3D<real> Eb;
-  IdefixArray3D<real> Et;
-
-  const typename EMF::AveragingType emfAverage = hydro->emf->averaging;
-
-  // Required by UCT_Contact
-  IdefixArray3D<real> SV;
+    Vs = rSolver->Vs;
 
-  // Required by UCT_HLLX
-  IdefixArray3D<real> aL;
-  IdefixArray3D<real> aR;
-  IdefixArray3D<real> dL;
-  IdefixArray3D<real> dR;
+    emfAverage = hydro->emf->averaging;
 
-  EquationOfState eos = *(hydro->eos.get());
+    eos = *(hydro->eos.get());
 
-  ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
-  // Define normal, tangent and bi-tanget indices
-  // st and sb will be useful only when Hall is included
-  real st = ONE_F, sb = ONE_F;
+    // st and sb will be useful only when Hall is included
+    st = ONE_F;
+    sb = ONE_F;
 
-  switch(DIR) {
-    case(IDIR):
-      D_EXPAND(
-                st = -ONE_F;  ,
-                  ,
+    switch(DIR) {
+      case(IDIR):
+        D_EXPAND(
+                  st = -ONE_F;  ,
+                    ,
 
-                sb = +ONE_F;  )
+                  sb = +ONE_F;  )
 
-      Et = hydro->emf->ezi;
-      Eb = hydro->emf->eyi;
+        Et = hydro->emf->ezi;
+        Eb = hydro->emf->eyi;
 
-      SV = hydro->emf->svx;
+        SV = hydro->emf->svx;
 
-      aL = hydro->emf->axL;
-      aR = hydro->emf->axR;
+        aL = hydro->emf->axL;
+        aR = hydro->emf->axR;
 
-      dL = hydro->emf->dxL;
-      dR = hydro->emf->dxR;
+        dL = hydro->emf->dxL;
+        dR = hydro->emf->dxR;
 
-      break;
+        break;
 #if DIMENSIONS >= 2
-    case(JDIR):
-      D_EXPAND(
-                st = +ONE_F;  ,
-                              ,
+      case(JDIR):
+        D_EXPAND(
+                  st = +ONE_F;  ,
+                                ,
 
-                sb = -ONE_F;  )
+                  sb = -ONE_F;  )
 
-      Et = hydro->emf->ezj;
-      Eb = hydro->emf->exj;
+        Et = hydro->emf->ezj;
+        Eb = hydro->emf->exj;
 
-      SV = hydro->emf->svy;
+        SV = hydro->emf->svy;
 
-      aL = hydro->emf->ayL;
-      aR = hydro->emf->ayR;
+        aL = hydro->emf->ayL;
+        aR = hydro->emf->ayR;
 
-      dL = hydro->emf->dyL;
-      dR = hydro->emf->dyR;
+        dL = hydro->emf->dyL;
+        dR = hydro->emf->dyR;
 
-      break;
+        break;
 #endif
 #if DIMENSIONS == 3
-    case(KDIR):
+      case(KDIR):
 
-      D_EXPAND(
+        D_EXPAND(
 
-                st = -ONE_F;  ,
-                  ,
-                sb = +ONE_F;  )
+                  st = -ONE_F;  ,
+                    ,
+                  sb = +ONE_F;  )
 
-      Et = hydro->emf->eyk;
-      Eb = hydro->emf->exk;
+        Et = hydro->emf->eyk;
+        Eb = hydro->emf->exk;
 
-      SV = hydro->emf->svz;
+        SV = hydro->emf->svz;
 
-      aL = hydro->emf->azL;
-      aR = hydro->emf->azR;
+        aL = hydro->emf->azL;
+        aR = hydro->emf->azR;
 
-      dL = hydro->emf->dzL;
-      dR = hydro->emf->dzR;
-      break;
+        dL = hydro->emf->dzL;
+        dR = hydro->emf->dzR;
+        break;
 #endif
-    default:
-      IDEFIX_ERROR("Wrong direction");
+      default:
+        IDEFIX_ERROR("Wrong direction");
+    }
   }
 
-  idefix_for("CalcRiemannFlux",
-             data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
-             data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
-             data->beg[IDIR]-iextend,data->end[IDIR]+ioffset+iextend,
-    KOKKOS_LAMBDA (int k, int j, int i) {
-      // Init the directions (should be in the kernel for proper optimisation by the compilers)
-      const int Xn = DIR+MX1;
-      EXPAND( const int BXn = DIR+BX1;                    ,
-              const int BXt = (DIR == IDIR ? BX2 : BX1);  ,
-              const int BXb = (DIR == KDIR ? BX2 : BX3);   )
-      // Primitive variables
-      real vL[Phys::nvar];
-      real vR[Phys::nvar];
-      real v[Phys::nvar];
-
-      real uL[Phys::nvar];
-      real uR[Phys::nvar];
-
-      real fluxL[Phys::nvar];
-      real fluxR[Phys::nvar];
-
-      // Load primitive variables
-      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
-      vL[BXn] = Vs(DIR,k,j,i);
-      vR[BXn] = vL[BXn];
+  //*****************************************************************
+  // Functor Variables
+  //*****************************************************************
+  IdefixArray4D<real> Vs;
+
+  // References to required emf components
+  IdefixArray3D<real> Eb;
+  IdefixArray3D<real> Et;
+
+  typename EMF::AveragingType emfAverage;
+
+  // Required by UCT_Contact
+  IdefixArray3D<real> SV;
+
+  // Required by UCT_HLLX
+  IdefixArray3D<real> aL;
+  IdefixArray3D<real> aR;
+  IdefixArray3D<real> dL;
+  IdefixArray3D<real> dR;
+
+  EquationOfState eos;
+  ExtrapolateToFaces<Phys,DIR> extrapol;
+
+  // Define normal, tangent and bi-tanget indices
+  real st, sb;
+
+  // extension in perp to the direction of integration, as required by CT.
+  int iextend{0};
+  int jextend{0};
+  int kextend{0};
+
+  //*****************************************************************
+  // Functor Operator
+  //*****************************************************************
+  // Flux and cMax are either the global arrays of the hydro object, or pencil arrays held in
+  // scratch memory when the fused directional sweep is used.
+  template <typename FluxArray, typename SpeedArray>
+  KOKKOS_INLINE_FUNCTION void operator() (const int k, const int j, const int i,
+                                          const FluxArray &Flux,
+                                          const SpeedArray &cMax) const {
+    [[maybe_unused]] constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
+    [[maybe_unused]] constexpr int joffset = (DIR==JDIR) ? 1 : 0;
+    [[maybe_unused]] constexpr int koffset = (DIR==KDIR) ? 1 : 0;
+
+    // Init the directions (should be in the kernel for proper optimisation by the compilers)
+    const int Xn = DIR+MX1;
+    EXPAND( const int BXn = DIR+BX1;                    ,
+            const int BXt = (DIR == IDIR ? BX2 : BX1);  ,
+            const int BXb = (DIR == KDIR ? BX2 : BX3);   )
+    // Primitive variables
+    real vL[Phys::nvar];
+    real vR[Phys::nvar];
+    real v[Phys::nvar];
+
+    real uL[Phys::nvar];
+    real uR[Phys::nvar];
+
+    real fluxL[Phys::nvar];
+    real fluxR[Phys::nvar];
+
+    // Load primitive variables
+    extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+    vL[BXn] = Vs(DIR,k,j,i);
+    vR[BXn] = vL[BXn];
 #pragma unroll
-      for(int nv = 0 ; nv < Phys::nvar; nv++) {
-        v[nv] = HALF_F*(vL[nv] + vR[nv]);
-      }
+    for(int nv = 0 ; nv < Phys::nvar; nv++) {
+      v[nv] = HALF_F*(vL[nv] + vR[nv]);
+    }
 
-      // Get the wave speed
-      // Signal speeds
-      real cRL, cmax, c2Iso;
-      real gpr, Bt2, B2;
+    // Get the wave speed
+    // Signal speeds
+    real cRL, cmax, c2Iso;
+    real gpr, Bt2, B2;
 
-      // Init c2Isothermal (used only when isothermal approx is set)
-      c2Iso = ZERO_F;
+    // Init c2Isothermal (used only when isothermal approx is set)
+    c2Iso = ZERO_F;
 
 #if HAVE_ENERGY
-      real gamma = eos.GetGamma(v[PRS],v[RHO]);
-      gpr=gamma*v[PRS];
+    real gamma = eos.GetGamma(v[PRS],v[RHO]);
+    gpr=gamma*v[PRS];
 #else
-      c2Iso = HALF_F*(eos.GetWaveSpeed(k,j,i)
-                    +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
-      c2Iso *= c2Iso;
+    c2Iso = HALF_F*(eos.GetWaveSpeed(k,j,i)
+                  +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
+    c2Iso *= c2Iso;
 
-      gpr = c2Iso*v[RHO];
+    gpr = c2Iso*v[RHO];
 #endif
-      Bt2=EXPAND( ZERO_F           ,
-                  + v[BXt]*v[BXt]  ,
-                  + v[BXb]*v[BXb]  );
+    Bt2=EXPAND( ZERO_F           ,
+                + v[BXt]*v[BXt]  ,
+                + v[BXb]*v[BXb]  );
 
-      B2=Bt2 + v[BXn]*v[BXn];
+    B2=Bt2 + v[BXn]*v[BXn];
 
-      cRL = gpr - B2;
-      cRL = cRL + B2 + std::sqrt(cRL*cRL + FOUR_F*gpr*Bt2);
-      cRL = std::sqrt(HALF_F * cRL/v[RHO]);
+    cRL = gpr - B2;
+    cRL = cRL + B2 + std::sqrt(cRL*cRL + FOUR_F*gpr*Bt2);
+    cRL = std::sqrt(HALF_F * cRL/v[RHO]);
 
-      cmax = std::fmax(std::fabs(v[Xn]+cRL),FABS(v[Xn]-cRL));
+    cmax = std::fmax(std::fabs(v[Xn]+cRL),FABS(v[Xn]-cRL));
 
-      real sl, sr;
-      sl = -cmax;
-      sr = cmax;
+    real sl, sr;
+    sl = -cmax;
+    sr = cmax;
 
 
-      // 2-- Compute the conservative variables
-      K_PrimToCons<Phys>(uL, vL, &eos);
-      K_PrimToCons<Phys>(uR, vR, &eos);
+    // 2-- Compute the conservative variables
+    K_PrimToCons<Phys>(uL, vL, &eos);
+    K_PrimToCons<Phys>(uR, vR, &eos);
 
-      // 3-- Compute the left and right fluxes
-      K_Flux<Phys,DIR>(fluxL, vL, uL, c2Iso);
-      K_Flux<Phys,DIR>(fluxR, vR, uR, c2Iso);
+    // 3-- Compute the left and right fluxes
+    K_Flux<Phys,DIR>(fluxL, vL, uL, c2Iso);
+    K_Flux<Phys,DIR>(fluxR, vR, uR, c2Iso);
 
 
-      // 5-- Compute the flux from the left and right states
+    // 5-- Compute the flux from the left and right states
 #pragma unroll
-      for(int nv = 0 ; nv < Phys::nvar; nv++) {
-        Flux(nv,k,j,i) = HALF_F*(fluxL[nv] + fluxR[nv] + cmax*(uL[nv] - uR[nv]));
-      }
-
-      //6-- Compute maximum wave speed for this sweep
-      cMax(k,j,i) = cmax;
-
-      // 7-- Store the flux in the emf components
-      if (emfAverage==EMF::arithmetic
-                || emfAverage==EMF::uct0) {
-        K_StoreEMF<DIR>(i,j,k,st,sb,Flux,Et,Eb);
-      } else if (emfAverage==EMF::uct_contact) {
-        K_StoreContact<DIR>(i,j,k,st,sb,Flux,Et,Eb,SV);
-      } else if (emfAverage==EMF::uct_hll) {
-        K_StoreHLL<DIR>(i,j,k,st,sb,sl,sr,vL,vR,Et,Eb,aL,aR,dL,dR);
-      }
-      /*else if (emfAverage==EMF::uct_hlld) {
-        // We do not have the Alfven speed in the HLL solver
-        K_StoreHLLD<DIR>(i,j,k,st,sb,c2Iso,sl,sr,vL,vR,uL,uR,Et,Eb,aL,aR,dL,dR);
-      } */
-  });
+    for(int nv = 0 ; nv < Phys::nvar; nv++) {
+      Flux(nv,k,j,i) = HALF_F*(fluxL[nv] + fluxR[nv] + cmax*(uL[nv] - uR[nv]));
+    }
+
+    //6-- Compute maximum wave speed for this sweep
+    cMax(k,j,i) = cmax;
+
+    // 7-- Store the flux in the emf components
+    if (emfAverage==EMF::arithmetic
+              || emfAverage==EMF::uct0) {
+      K_StoreEMF<DIR>(i,j,k,st,sb,Flux,Et,Eb);
+    } else if (emfAverage==EMF::uct_contact) {
+      K_StoreContact<DIR>(i,j,k,st,sb,Flux,Et,Eb,SV);
+    } else if (emfAverage==EMF::uct_hll) {
+      K_StoreHLL<DIR>(i,j,k,st,sb,sl,sr,vL,vR,Et,Eb,aL,aR,dL,dR);
+    }
+    /*else if (emfAverage==EMF::uct_hlld) {
+      // We do not have the Alfven speed in the HLL solver
+      K_StoreHLLD<DIR>(i,j,k,st,sb,c2Iso,sl,sr,vL,vR,uL,uR,Et,Eb,aL,aR,dL,dR);
+    } */
+  }
+};
+
+// Compute Riemann fluxes on all of the faces of the domain with the TvdlfMHD solver
+template <typename Phys>
+template<const int DIR>
+void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<realStore> &Flux) {
+  idfx::pushRegion("RiemannSolver::TVDLF_MHD");
+
+  constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
+  constexpr int joffset = (DIR==JDIR) ? 1 : 0;
+  constexpr int koffset = (DIR==KDIR) ? 1 : 0;
+
+  IdefixArray3D<real> cMax = this->cMax;
+
+  RiemannSolver_TvdlfMHDFunctor<Phys,DIR> riemannFlux(this);
+
+  // extension in perp to the direction of integration, as required by CT.
+  const int iextend = riemannFlux.iextend;
+  const int jextend = riemannFlux.jextend;
+  const int kextend = riemannFlux.kextend;
+
+  idefix_for("CalcRiemannFlux",
+             data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
+             data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
+             data->beg[IDIR]-iextend,data->end[IDIR]+ioffset+iextend,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      riemannFlux(k, j, i, Flux, cMax);
+    }
+  );
 
   idfx::popRegion();
 }
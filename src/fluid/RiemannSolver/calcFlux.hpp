@@ -26,14 +26,17 @@
 // Compute Riemann fluxes from states
 template <typename Phys>
 template <int dir>
-void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<real> &flux) {
+void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<realStore> &flux) {
   idfx::pushRegion("RiemannSolver::CalcFlux");
   if constexpr(dir == IDIR) {
     // enable shock flattening
     if(haveShockFlattening) shockFlattening->FindShock();
   }
 
-  if constexpr(Phys::mhd) {
+  if(data->haveLocalTimestep) {
+    // Only the faces which are updated in the current substep are computed
+    CalcFlux<dir>(flux, SweepRegion::all);
+  } else if constexpr(Phys::mhd) {
     switch (mySolver) {
       case TVDLF_MHD:
         TvdlfMHD<dir>(flux);
@@ -83,4 +86,117 @@ void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<real> &flux) {
   }
   idfx::popRegion();
 }
+
+// Compute Riemann fluxes on a region of the faces of the cells of box (the active domain or a
+// tile of it)
+template <typename Phys>
+template <int dir, typename RiemannFlux>
+void RiemannSolver<Phys>::RegionSweep(const RiemannFlux &riemannFlux,
+                                      IdefixArray4D<realStore> &Flux,
+                                      const SweepRegion region,
+                                      const IndexBox &cells) {
+  IdefixArray3D<real> cMax = this->cMax;
+
+  // The Riemann fluxes may be required in the ghost zones perpendicular to dir (CT)
+  // (a tile only extends in the ghost zones on the sides of the active domain)
+  const int extend[3] = {riemannFlux.iextend, riemannFlux.jextend, riemannFlux.kextend};
+
+  IndexBox box;
+  for(int n = 0 ; n < 3 ; n++) {
+    box.beg[n] = cells.beg[n] - (cells.beg[n] == data->beg[n] ? extend[n] : 0);
+    box.end[n] = cells.end[n] + (cells.end[n] == data->end[n] ? extend[n] : 0);
+  }
+  box.end[dir] += 1;
+
+  // Faces of the cells which do not depend on the ghost zones
+  const IndexBox inner = InteriorFaces(data->beg, data->end, data->nghost, dir, region);
+
+  // With local time stepping, the faces which are not updated in this substep are skipped
+  const bool haveLocalTimestep = data->haveLocalTimestep;
+  IdefixArray1D<real> ltsWeight;
+  if(haveLocalTimestep) ltsWeight = data->lts->weight[dir];
+
+  idefix_for_region("CalcRiemannFlux", region, box, inner,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      if(haveLocalTimestep && ltsWeight(i) == ZERO_F) return;
+      riemannFlux(k, j, i, Flux, cMax);
+    }
+  );
+}
+
+template <typename Phys>
+template <int dir>
+void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<realStore> &flux, const SweepRegion region) {
+  if(region == SweepRegion::all && !data->haveLocalTimestep) {
+    CalcFlux<dir>(flux);
+    return;
+  }
+  idfx::pushRegion("RiemannSolver::CalcFlux");
+  RegionFlux<dir>(flux, region, IndexBox{data->beg, data->end});
+  idfx::popRegion();
+}
+
+template <typename Phys>
+template <int dir>
+void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<realStore> &flux, const IndexBox &tile) {
+  idfx::pushRegion("RiemannSolver::CalcFlux");
+  RegionFlux<dir>(flux, SweepRegion::all, tile);
+  idfx::popRegion();
+}
+
+// Call the region sweep of our solver
+template <typename Phys>
+template <int dir>
+void RiemannSolver<Phys>::RegionFlux(IdefixArray4D<realStore> &flux, const SweepRegion region,
+                                     const IndexBox &cells) {
+  if constexpr(Phys::mhd) {
+    switch (mySolver) {
+      case TVDLF_MHD:
+        RegionSweep<dir>(RiemannSolver_TvdlfMHDFunctor<Phys,dir>(this), flux, region, cells);
+        break;
+      case HLL_MHD:
+        RegionSweep<dir>(RiemannSolver_HllMHDFunctor<Phys,dir>(this), flux, region, cells);
+        break;
+      case HLLD_MHD:
+        RegionSweep<dir>(RiemannSolver_HlldMHDFunctor<Phys,dir>(this), flux, region, cells);
+        break;
+      case ROE_MHD:
+        RegionSweep<dir>(RiemannSolver_RoeMHDFunctor<Phys,dir>(this), flux, region, cells);
+        break;
+      default:
+        IDEFIX_ERROR("Internal error: Unknown solver");
+        break;
+    }
+  } else {
+    if constexpr(Phys::dust) {
+      switch (mySolver) {
+        case HLL_DUST:
+          RegionSweep<dir>(RiemannSolver_HllDustFunctor<Phys,dir>(this), flux, region, cells);
+          break;
+        default:
+          IDEFIX_ERROR("Internal error: Unknown solver");
+          break;
+      }
+    } else {
+      switch (mySolver) {
+        case TVDLF:
+          RegionSweep<dir>(RiemannSolver_TvdlfHDFunctor<Phys,dir>(this), flux, region, cells);
+          break;
+        case HLL:
+          RegionSweep<dir>(RiemannSolver_HllHDFunctor<Phys,dir>(this), flux, region, cells);
+          break;
+        case HLLC:
+          RegionSweep<dir>(RiemannSolver_HllcHDFunctor<Phys,dir>(this), flux, region, cells);
+          break;
+        case ROE:
+          RegionSweep<dir>(RiemannSolver_RoeHDFunctor<Phys,dir>(this), flux, region, cells);
+          break;
+        default:
+          IDEFIX_ERROR("Internal error: Unknown solver");
+          break;
+      }
+    }
+  }
+}
+
 #endif // FLUID_RIEMANNSOLVER_CALCFLUX_HPP_
@@ -0,0 +1,192 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_RIEMANNSOLVER_CALCFUSEDFLUX_HPP_
+#define FLUID_RIEMANNSOLVER_CALCFUSEDFLUX_HPP_
+
+#include "idefix.hpp"
+#include "riemannSolver.hpp"
+
+// Intercell fluxes of a single pencil of faces along dir, held in team scratch memory.
+// It can be used in place of the global (nv,k,j,i) flux array by the Riemann solvers and
+// by the flux correction/right hand side functors.
+template <int dir>
+struct PencilFluxArray {
+  IdefixScratchArray2D<real> flux;
+  int offset;
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  real& operator() (const int nv, const int k, const int j, const int i) const {
+    if constexpr(dir == IDIR) {
+      return flux(nv, i-offset);
+    } else if constexpr(dir == JDIR) {
+      return flux(nv, j-offset);
+    } else {
+      return flux(nv, k-offset);
+    }
+  }
+};
+
+// Maximum signal speed on the same pencil of faces, used in place of the global cMax array
+template <int dir>
+struct PencilSpeedArray {
+  IdefixScratchArray1D<real> speed;
+  int offset;
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  real& operator() (const int k, const int j, const int i) const {
+    if constexpr(dir == IDIR) {
+      return speed(i-offset);
+    } else if constexpr(dir == JDIR) {
+      return speed(j-offset);
+    } else {
+      return speed(k-offset);
+    }
+  }
+};
+
+// Fused sweep along direction dir: each team takes care of one pencil of cells. It computes
+// the Riemann fluxes on every face of the pencil into scratch memory, corrects them and applies
+// the flux divergence to the conservative variables, so that the intercell fluxes are never
+// written to the global FluxRiemann array.
+template <typename Phys>
+template <int dir, typename RiemannFlux, typename CorrectFlux, typename CalcRHS>
+void RiemannSolver<Phys>::FusedSweep(const RiemannFlux &riemannFlux,
+                                     const CorrectFlux &correctFlux,
+                                     const CalcRHS &calcRHS) {
+  // The two directions perpendicular to dir, labelling the pencils
+  constexpr int dir1 = (dir == IDIR) ? JDIR : IDIR;
+  constexpr int dir2 = (dir == KDIR) ? JDIR : KDIR;
+
+  // The Riemann fluxes may be required in the ghost zones perpendicular to dir (CT)
+  const int extend[3] = {riemannFlux.iextend, riemannFlux.jextend, riemannFlux.kextend};
+
+  const int beg1 = data->beg[dir1] - extend[dir1];
+  const int n1 = data->end[dir1] + extend[dir1] - beg1;
+  const int beg2 = data->beg[dir2] - extend[dir2];
+  const int n2 = data->end[dir2] + extend[dir2] - beg2;
+
+  // Pencils in which the conservative variables are evolved
+  const int activeBeg1 = data->beg[dir1];
+  const int activeEnd1 = data->end[dir1];
+  const int activeBeg2 = data->beg[dir2];
+  const int activeEnd2 = data->end[dir2];
+
+  // Faces along dir
+  const int faceBeg = data->beg[dir];
+  const int nFaces = data->np_int[dir] + 1;
+
+  const size_t scratchSize = IdefixScratchArray2D<real>::shmem_size(Phys::nvar, nFaces)
+                           + IdefixScratchArray1D<real>::shmem_size(nFaces);
+  // Use the fastest scratch memory level when the pencil fits in it
+  const int scratchLevel = (scratchSize <= team_policy::scratch_size_max(0)) ? 0 : 1;
+
+  Kokkos::parallel_for("FusedSweep",
+    team_policy(n1*n2, Kokkos::AUTO).set_scratch_size(scratchLevel,
+                                                        Kokkos::PerTeam(scratchSize)),
+    KOKKOS_LAMBDA (member_type team) {
+      const int p1 = beg1 + team.league_rank() % n1;
+      const int p2 = beg2 + team.league_rank() / n1;
+
+      PencilFluxArray<dir> flux{
+          IdefixScratchArray2D<real>(team.team_scratch(scratchLevel), Phys::nvar, nFaces),
+          faceBeg};
+      PencilSpeedArray<dir> speed{
+          IdefixScratchArray1D<real>(team.team_scratch(scratchLevel), nFaces),
+          faceBeg};
+
+      const bool active = (p1 >= activeBeg1) && (p1 < activeEnd1)
+                       && (p2 >= activeBeg2) && (p2 < activeEnd2);
+
+      // 1-- Riemann fluxes on the faces of the pencil
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nFaces), [&] (const int n) {
+        int idx[3];
+        idx[dir] = faceBeg + n;
+        idx[dir1] = p1;
+        idx[dir2] = p2;
+        riemannFlux(idx[KDIR], idx[JDIR], idx[IDIR], flux, speed);
+        // Flux correction (for fargo/non-cartesian geometry)
+        if(active) correctFlux.CorrectFlux(idx[KDIR], idx[JDIR], idx[IDIR], flux);
+      });
+
+      // 2-- Flux divergence in the cells of the pencil
+      if(active) {
+        team.team_barrier();
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nFaces-1), [&] (const int n) {
+          int idx[3];
+          idx[dir] = faceBeg + n;
+          idx[dir1] = p1;
+          idx[dir2] = p2;
+          calcRHS.CalcRHS(idx[KDIR], idx[JDIR], idx[IDIR], flux, speed);
+        });
+      }
+    });
+}
+
+// Select the Riemann solver for the fused sweep
+template <typename Phys>
+template <int dir, typename CorrectFlux, typename CalcRHS>
+void RiemannSolver<Phys>::CalcFusedFlux(const CorrectFlux &correctFlux,
+                                        const CalcRHS &calcRHS) {
+  idfx::pushRegion("RiemannSolver::CalcFusedFlux");
+  if constexpr(dir == IDIR) {
+    // enable shock flattening
+    if(haveShockFlattening) shockFlattening->FindShock();
+  }
+
+  if constexpr(Phys::mhd) {
+    switch (mySolver) {
+      case TVDLF_MHD:
+        FusedSweep<dir>(RiemannSolver_TvdlfMHDFunctor<Phys,dir>(this), correctFlux, calcRHS);
+        break;
+      case HLL_MHD:
+        FusedSweep<dir>(RiemannSolver_HllMHDFunctor<Phys,dir>(this), correctFlux, calcRHS);
+        break;
+      case HLLD_MHD:
+        FusedSweep<dir>(RiemannSolver_HlldMHDFunctor<Phys,dir>(this), correctFlux, calcRHS);
+        break;
+      case ROE_MHD:
+        FusedSweep<dir>(RiemannSolver_RoeMHDFunctor<Phys,dir>(this), correctFlux, calcRHS);
+        break;
+      default:
+        IDEFIX_ERROR("Internal error: Unknown solver");
+        break;
+    }
+  } else {
+    if constexpr(Phys::dust) {
+      switch (mySolver) {
+        case HLL_DUST:
+          FusedSweep<dir>(RiemannSolver_HllDustFunctor<Phys,dir>(this), correctFlux, calcRHS);
+          break;
+        default:
+          IDEFIX_ERROR("Internal error: Unknown solver");
+          break;
+      }
+    } else {
+      switch (mySolver) {
+        case TVDLF:
+          FusedSweep<dir>(RiemannSolver_TvdlfHDFunctor<Phys,dir>(this), correctFlux, calcRHS);
+          break;
+        case HLL:
+          FusedSweep<dir>(RiemannSolver_HllHDFunctor<Phys,dir>(this), correctFlux, calcRHS);
+          break;
+        case HLLC:
+          FusedSweep<dir>(RiemannSolver_HllcHDFunctor<Phys,dir>(this), correctFlux, calcRHS);
+          break;
+        case ROE:
+          FusedSweep<dir>(RiemannSolver_RoeHDFunctor<Phys,dir>(this), correctFlux, calcRHS);
+          break;
+        default:
+          IDEFIX_ERROR("Internal error: Unknown solver");
+          break;
+      }
+    }
+  }
+  idfx::popRegion();
+}
+
+#endif // FLUID_RIEMANNSOLVER_CALCFUSEDFLUX_HPP_
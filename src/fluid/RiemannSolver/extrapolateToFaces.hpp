@@ -308,7 +308,7 @@ class ExtrapolateToFaces {
     }
   }
 
-  IdefixArray4D<real> Vc;
+  IdefixArray4D<realStore> Vc;
   IdefixArray1D<real> dx;
   IdefixArray3D<FlagShock> flags;
 
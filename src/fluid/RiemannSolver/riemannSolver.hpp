@@ -18,6 +18,17 @@
 template<typename Phys>
 class ShockFlattening;
 
+// Per-face Riemann solver functors
+template<typename Phys, int dir> struct RiemannSolver_TvdlfMHDFunctor;
+template<typename Phys, int dir> struct RiemannSolver_HllMHDFunctor;
+template<typename Phys, int dir> struct RiemannSolver_HlldMHDFunctor;
+template<typename Phys, int dir> struct RiemannSolver_RoeMHDFunctor;
+template<typename Phys, int dir> struct RiemannSolver_TvdlfHDFunctor;
+template<typename Phys, int dir> struct RiemannSolver_HllHDFunctor;
+template<typename Phys, int dir> struct RiemannSolver_HllcHDFunctor;
+template<typename Phys, int dir> struct RiemannSolver_RoeHDFunctor;
+template<typename Phys, int dir> struct RiemannSolver_HllDustFunctor;
+
 #include "extrapolateToFaces.hpp"
 
 template <typename Phys>
@@ -29,7 +40,23 @@ class RiemannSolver {
 
   RiemannSolver(Input &input, Fluid<Phys>* hydro);
 
-  template <int> void CalcFlux(IdefixArray4D<real> &);
+  template <int> void CalcFlux(IdefixArray4D<realStore> &);
+
+  // Compute the fluxes on a region of the faces only (overlap of the ghost zone exchange)
+  template <int> void CalcFlux(IdefixArray4D<realStore> &, const SweepRegion);
+
+  // Compute the fluxes of the faces of a tile of cells only (tiled sweeps)
+  template <int> void CalcFlux(IdefixArray4D<realStore> &, const IndexBox &);
+
+  // Flag the shocks before the fluxes are computed tile by tile (tiled sweeps)
+  void FindShock() {
+    if(haveShockFlattening) shockFlattening->FindShock();
+  }
+
+  // Compute the fluxes pencil by pencil in scratch memory, and apply them on the fly with the
+  // flux correction and right hand side functors of the fluid (fused directional sweep)
+  template <int dir, typename CorrectFlux, typename CalcRHS>
+    void CalcFusedFlux(const CorrectFlux &, const CalcRHS &);
 
   Solver GetSolver() {
     return(mySolver);
@@ -39,25 +66,25 @@ class RiemannSolver {
 
   // Riemann Solvers
   template<const int>
-    void HlldMHD(IdefixArray4D<real> &);
+    void HlldMHD(IdefixArray4D<realStore> &);
   template<const int>
-    void HllMHD(IdefixArray4D<real> &);
+    void HllMHD(IdefixArray4D<realStore> &);
   template<const int>
-    void RoeMHD(IdefixArray4D<real> &);
+    void RoeMHD(IdefixArray4D<realStore> &);
   template<const int>
-    void TvdlfMHD(IdefixArray4D<real> &);
+    void TvdlfMHD(IdefixArray4D<realStore> &);
 
   template<const int>
-    void HllcHD(IdefixArray4D<real> &);
+    void HllcHD(IdefixArray4D<realStore> &);
   template<const int>
-    void HllHD(IdefixArray4D<real> &);
+    void HllHD(IdefixArray4D<realStore> &);
   template<const int>
-    void RoeHD(IdefixArray4D<real> &);
+    void RoeHD(IdefixArray4D<realStore> &);
   template<const int>
-    void TvdlfHD(IdefixArray4D<real> &);
+    void TvdlfHD(IdefixArray4D<realStore> &);
 
   template<const int>
-    void HllDust(IdefixArray4D<real> &);
+    void HllDust(IdefixArray4D<realStore> &);
   // Get the right slope limiter
   template<int dir>
   ExtrapolateToFaces<Phys, dir>* GetExtrapolator();
@@ -66,9 +93,28 @@ class RiemannSolver {
   template <typename P, int dir, PLMLimiter L, int O>
   friend class ExtrapolateToFaces;
 
-  IdefixArray4D<real> Vc;
+  template <typename P, int dir> friend struct RiemannSolver_TvdlfMHDFunctor;
+  template <typename P, int dir> friend struct RiemannSolver_HllMHDFunctor;
+  template <typename P, int dir> friend struct RiemannSolver_HlldMHDFunctor;
+  template <typename P, int dir> friend struct RiemannSolver_RoeMHDFunctor;
+  template <typename P, int dir> friend struct RiemannSolver_TvdlfHDFunctor;
+  template <typename P, int dir> friend struct RiemannSolver_HllHDFunctor;
+  template <typename P, int dir> friend struct RiemannSolver_HllcHDFunctor;
+  template <typename P, int dir> friend struct RiemannSolver_RoeHDFunctor;
+  template <typename P, int dir> friend struct RiemannSolver_HllDustFunctor;
+
+  template <int dir, typename RiemannFlux, typename CorrectFlux, typename CalcRHS>
+    void FusedSweep(const RiemannFlux &, const CorrectFlux &, const CalcRHS &);
+
+  template <int dir, typename RiemannFlux>
+    void RegionSweep(const RiemannFlux &, IdefixArray4D<realStore> &, const SweepRegion,
+                     const IndexBox &);
+  template <int dir>
+    void RegionFlux(IdefixArray4D<realStore> &, const SweepRegion, const IndexBox &);
+
+  IdefixArray4D<realStore> Vc;
   IdefixArray4D<real> Vs;
-  IdefixArray4D<real> Flux;
+  IdefixArray4D<realStore> Flux;
   IdefixArray3D<real> cMax;
   Fluid<Phys>* hydro;
   DataBlock *data;
@@ -205,6 +251,9 @@ void RiemannSolver<Phys>::ShowConfig() {
 
   if(haveShockFlattening) {
     idfx::cout << Phys::prefix << ": Shock Flattening ENABLED." << std::endl;
+    if(data->haveBoundaryOverlap) {
+      IDEFIX_ERROR("Shock flattening is incompatible with the overlap of the ghost zone exchange.");
+    }
   }
 }
 
@@ -222,5 +271,6 @@ ExtrapolateToFaces<Phys, dir>* RiemannSolver<Phys>::GetExtrapolator() {
 
 
 #include "calcFlux.hpp"
+#include "calcFusedFlux.hpp"
 
 #endif //FLUID_RIEMANNSOLVER_RIEMANNSOLVER_HPP_
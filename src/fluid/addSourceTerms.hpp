@@ -42,13 +42,18 @@ struct Fluid_AddSourceTermsFunctor {
     }
     // shearing box (only with fargo&cartesian)
     sbS = hydro->sbS;
+    // Local time stepping
+    haveLocalTimestep = hydro->data->haveLocalTimestep;
+    if(haveLocalTimestep) {
+      ltsWeight = hydro->data->lts->cellWeight;
+    }
   }
 
   //*****************************************************************
   // Functor Variables
   //*****************************************************************
-  IdefixArray4D<real> Uc;
-  IdefixArray4D<real> Vc;
+  IdefixArray4D<realStore> Uc;
+  IdefixArray4D<realStore> Vc;
   IdefixArray1D<real> x1;
   IdefixArray1D<real> x2;
   IdefixArray3D<real> csIsoArr;
@@ -72,19 +77,29 @@ struct Fluid_AddSourceTermsFunctor {
   // shearing box (only with fargo&cartesian)
   real sbS;
 
+  // Local time stepping
+  bool haveLocalTimestep{false};
+  IdefixArray1D<real> ltsWeight;
+
   //*****************************************************************
   // Functor Operator
   //*****************************************************************
   KOKKOS_INLINE_FUNCTION void operator() (const int k, const int j,  const int i) const {
+    // With local time stepping, the cell is evolved by a multiple of dt (possibly 0)
+    real dtc = dt;
+    if(haveLocalTimestep) {
+      dtc = ltsWeight(i)*dt;
+      if(dtc == ZERO_F) return;
+    }
     #if GEOMETRY == CARTESIAN
       // Manually add Coriolis force in cartesian geometry. Otherwise
       // Coriolis is treated as a modification to the fluxes
       if(haveRotation) {
-        Uc(MX1,k,j,i) +=   TWO_F * dt * Vc(RHO,k,j,i) * OmegaZ * Vc(VX2,k,j,i);
-        Uc(MX2,k,j,i) += - TWO_F * dt * Vc(RHO,k,j,i) * OmegaZ * Vc(VX1,k,j,i);
+        Uc(MX1,k,j,i) +=   TWO_F * dtc * Vc(RHO,k,j,i) * OmegaZ * Vc(VX2,k,j,i);
+        Uc(MX2,k,j,i) += - TWO_F * dtc * Vc(RHO,k,j,i) * OmegaZ * Vc(VX1,k,j,i);
       }
       if(haveFargo) {
-        Uc(MX1,k,j,i) +=   TWO_F * dt * Vc(RHO,k,j,i) * OmegaZ * sbS * x1(i);
+        Uc(MX1,k,j,i) +=   TWO_F * dtc * Vc(RHO,k,j,i) * OmegaZ * sbS * x1(i);
       }
     #endif
       // fetch fargo velocity when required
@@ -119,7 +134,7 @@ struct Fluid_AddSourceTermsFunctor {
                               +Vc(BX2,k,j,i)*Vc(BX2,k,j,i)  ,
                               +Vc(BX3,k,j,i)*Vc(BX3,k,j,i)  ));
       } // MHD
-      Uc(MX1,k,j,i) += dt * Sm / x1(i);
+      Uc(MX1,k,j,i) += dtc * Sm / x1(i);
   #endif // COMPONENTS
 
 #elif GEOMETRY == POLAR
@@ -143,7 +158,7 @@ struct Fluid_AddSourceTermsFunctor {
                               +Vc(BX2,k,j,i)*Vc(BX2,k,j,i)  ,
                               +Vc(BX3,k,j,i)*Vc(BX3,k,j,i)  ));
       } // MHD
-      Uc(MX1,k,j,i) += dt * Sm / x1(i);
+      Uc(MX1,k,j,i) += dtc * Sm / x1(i);
 
 #elif GEOMETRY == SPHERICAL
       real vphi,Sm;
@@ -170,7 +185,7 @@ struct Fluid_AddSourceTermsFunctor {
                       +Vc(BX2,k,j,i)*Vc(BX2,k,j,i)  ,
                       +Vc(BX3,k,j,i)*Vc(BX3,k,j,i)  );
       } //MHD
-      Uc(MX1,k,j,i) += dt*Sm/rt(i);
+      Uc(MX1,k,j,i) += dtc*Sm/rt(i);
   #if COMPONENTS >= 2
       real ct = 1.0/tanx2(j);
        // Centrifugal
@@ -191,7 +206,7 @@ struct Fluid_AddSourceTermsFunctor {
                                 +Vc(BX2,k,j,i)*Vc(BX2,k,j,i)   ,
                                 +Vc(BX3,k,j,i)*Vc(BX3,k,j,i))  );
       } // MHD
-      Uc(MX2,k,j,i) += dt*Sm / rt(i);
+      Uc(MX2,k,j,i) += dtc*Sm / rt(i);
   #endif // COMPONENTS
 #endif
     }
@@ -222,4 +237,20 @@ void Fluid<Phys>::AddSourceTerms(real t, real dt) {
 
   idfx::popRegion();
 }
+
+// Add the (non user-defined) source terms to the cells of a tile only (tiled sweeps)
+template <typename Phys>
+void Fluid<Phys>::AddSourceTerms(real t, real dt, const IndexBox &tile) {
+  idfx::pushRegion("Fluid::AddSourceTerms");
+
+  auto func = Fluid_AddSourceTermsFunctor<Phys>(this,dt);
+
+  idefix_for("AddSourceTerms",
+             tile.beg[KDIR],tile.end[KDIR],
+             tile.beg[JDIR],tile.end[JDIR],
+             tile.beg[IDIR],tile.end[IDIR],
+            func);
+
+  idfx::popRegion();
+}
 #endif //FLUID_ADDSOURCETERMS_HPP_
@@ -99,7 +99,8 @@ void Axis::RegularizeCurrentSide(int side) {
       sign = -1;
     }
     IdefixArray1D<real> BAvg = this->Ex1Avg;
-    IdefixArray1D<real> x2 = data->x[JDIR];
+    IdefixArray1D<real> sinx2 = data->sinx2;
+    IdefixArray1D<real> cosx2 = data->cosx2;
     IdefixArray1D<real> x1 = data->x[IDIR];
     IdefixArray1D<real> dx3 = data->dx[KDIR];
 
@@ -131,8 +132,7 @@ void Axis::RegularizeCurrentSide(int side) {
 
     idefix_for("fixJ",0,data->np_tot[KDIR],0,data->np_tot[IDIR],
         KOKKOS_LAMBDA(int k,int i) {
-          real th = x2(jc);
-          real fact = sign*sin(th)/(deltaPhi*x1(i)*(1-cos(th)));
+          real fact = sign*sinx2(jc)/(deltaPhi*x1(i)*(1-cosx2(jc)));
           J(IDIR, k,js,i) = BAvg(i)*fact;
         });
 
@@ -179,7 +179,8 @@ void Axis::FixBx2sAxis(int side) {
   #if DIMENSIONS == 3
     IdefixArray4D<real> Vs = this->Vs;
     IdefixArray2D<real> BAvg = this->BAvg;
-    IdefixArray1D<real> phi = data->x[KDIR];
+    IdefixArray1D<real> sinphi = data->sinx3;
+    IdefixArray1D<real> cosphi = data->cosx3;
 
     int jin = 0;
     int jout = 0;
@@ -210,8 +211,8 @@ void Axis::FixBx2sAxis(int side) {
           //Bthmid = 0.0;
           //Bphimid = 0.0;
 
-          Kokkos::atomic_add(&BAvg(i,IDIR), Bthmid * cos(phi(k)) - Bphimid * sin(phi(k)));
-          Kokkos::atomic_add(&BAvg(i,JDIR), Bthmid * sin(phi(k)) + Bphimid * cos(phi(k)));
+          Kokkos::atomic_add(&BAvg(i,IDIR), Bthmid * cosphi(k) - Bphimid * sinphi(k));
+          Kokkos::atomic_add(&BAvg(i,JDIR), Bthmid * sinphi(k) + Bphimid * cosphi(k));
     });
     if(needMPIExchange) {
       Kokkos::fence();
@@ -228,7 +229,7 @@ void Axis::FixBx2sAxis(int side) {
           real Bx = BAvg(i,IDIR) / ((real) ncells);
           real By = BAvg(i,JDIR) / ((real) ncells);
 
-          Vs(BX2s,k,jaxe,i) = sign*(cos(phi(k))*Bx + sin(phi(k))*By);
+          Vs(BX2s,k,jaxe,i) = sign*(cosphi(k)*Bx + sinphi(k)*By);
         });
   #endif // DIMENSIONS
 }
@@ -267,7 +268,7 @@ void Axis::FixBx2sAxisGhostAverage(int side) {
 
 void Axis::EnforceAxisBoundary(int side) {
   idfx::pushRegion("Axis::EnforceAxisBoundary");
-  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<realStore> Vc = this->Vc;
   IdefixArray1D<int> sVc = this->symmetryVc;
 
   int ibeg = 0;
@@ -442,7 +443,7 @@ void Axis::ExchangeMPI(int side) {
   int nx,ny,nz;
   auto bufferSend = this->bufferSend;
   IdefixArray1D<int> map = this->mapVars;
-  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<realStore> Vc = this->Vc;
   IdefixArray4D<real> Vs = this->Vs;
 
 // If MPI Persistent, start receiving even before the buffers are filled
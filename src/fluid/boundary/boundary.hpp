@@ -39,8 +39,13 @@ class Boundary {
  public:
   explicit Boundary(Fluid<Phys>*);
   void SetBoundaries(real);                         ///< Set the ghost zones in all directions
+  void SetInternalBoundaries(real);                 ///< Enforce user-defined internal boundaries
+  void StartBoundaryDir(int);                       ///< Start filling the ghost zones in direction
+  void FinishBoundaryDir(real, int);                ///< Finish filling the ghost zones in direction
+  void StartBoundaryAll();                          ///< Start filling all of the ghost zones
+  void FinishBoundaryAll(real);                     ///< Finish filling all of the ghost zones
   void EnforceBoundaryDir(real, int);             ///< write in the ghost zone in specific direction
-  void ReconstructVcField(IdefixArray4D<real> &);  ///< reconstruct cell-centered magnetic field
+  void ReconstructVcField(IdefixArray4D<realStore> &); ///< reconstruct cell-centered B field
   void ReconstructNormalField(int dir);           ///< reconstruct normal field using divB=0
 
   void EnforceFluxBoundaries(int,real);      ///< Apply boundary condition conditions to the fluxes
@@ -108,7 +113,7 @@ class Boundary {
                             Function );
   IdefixArray4D<real> sBArray;    ///< Array use by shearingbox boundary conditions
 
-  IdefixArray4D<real> Vc; ///< reference to cell-centered array that we should sync
+  IdefixArray4D<realStore> Vc; ///< reference to cell-centered array that we should sync
   IdefixArray4D<real> Vs; ///< reference to face-centered array that we should sync
   std::unique_ptr<Axis> axis; ///< Axis object, initialised if needed.
   bool haveAxis{false};
@@ -143,11 +148,11 @@ Boundary<Phys>::Boundary(Fluid<Phys>* fluid) {
   if(data->lbound[IDIR] == shearingbox || data->rbound[IDIR] == shearingbox) {
     // using np_tot[...]+1 points to allow this buffer to represent
     // fields that are defined on faces
-    sBArray = IdefixArray4D<real>("ShearingBoxArray",
+    sBArray = IdefixArray4D<real>("ShearingBoxArray",IdefixLayout4D(
                                   nVar,
                                   data->np_tot[KDIR]+1,
                                   data->np_tot[JDIR]+1,
-                                  data->nghost[IDIR]);
+                                  data->nghost[IDIR]));
   }
 
   // Init MPI stack when needed
@@ -182,6 +187,7 @@ Boundary<Phys>::Boundary(Fluid<Phys>* fluid) {
   }
 
   mpi.Init(data->mygrid, mapVars, data->nghost.data(), data->np_int.data(), Phys::mhd);
+  if(data->haveNeighbourExchange) mpi.InitExchangeAll();
 
 #endif // MPI
   idfx::popRegion();
@@ -204,6 +210,9 @@ void Boundary<Phys>::EnrollFluxBoundary(UserDefBoundaryFuncOld myFunc) {
 
 template<typename Phys>
 void Boundary<Phys>::EnrollFluxBoundary(UserDefBoundaryFunc<Phys> myFunc) {
+  if(fluid->haveFusedSweep) {
+    IDEFIX_ERROR("Fused sweep is incompatible with user-defined flux boundaries.");
+  }
   this->haveFluxBoundary = true;
   this->fluxBoundaryFunc = myFunc;
 }
@@ -236,6 +245,28 @@ template<typename Phys>
 void Boundary<Phys>::SetBoundaries(real t) {
   idfx::pushRegion("Boundary::SetBoundaries");
   // set internal boundary conditions
+  SetInternalBoundaries(t);
+
+  if(data->haveNeighbourExchange) {
+    StartBoundaryAll();
+    FinishBoundaryAll(t);
+  } else {
+    for(int dir=0 ; dir < DIMENSIONS ; dir++ ) {
+      StartBoundaryDir(dir);
+      FinishBoundaryDir(t, dir);
+    } // Loop on dimension ends
+  }
+
+  if constexpr(Phys::mhd) {
+    // Remake the cell-centered field.
+    ReconstructVcField(this->Vc);
+  }
+
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void Boundary<Phys>::SetInternalBoundaries(real t) {
   if(haveInternalBoundary) {
     idfx::pushRegion("Boundary::UserDefInternalBoundary");
     if(internalBoundaryFunc != NULL) {
@@ -245,36 +276,80 @@ void Boundary<Phys>::SetBoundaries(real t) {
     }
     idfx::popRegion();
   }
-  for(int dir=0 ; dir < DIMENSIONS ; dir++ ) {
-      // MPI Exchange data when needed
-    #ifdef WITH_MPI
-    if(data->mygrid->nproc[dir]>1) {
-      switch(dir) {
-        case 0:
-          mpi.ExchangeX1(this->Vc, this->Vs);
-          break;
-        case 1:
-          mpi.ExchangeX2(this->Vc, this->Vs);
-          break;
-        case 2:
-          mpi.ExchangeX3(this->Vc, this->Vs);
-          break;
-      }
+}
+
+// Start the exchange of the ghost zones in direction dir. The ghost zones are only filled once
+// FinishBoundaryDir has been called, so that the interior of the domain can be computed
+// while the MPI messages are in flight.
+template<typename Phys>
+void Boundary<Phys>::StartBoundaryDir(int dir) {
+  // MPI Exchange data when needed
+  #ifdef WITH_MPI
+  if(data->mygrid->nproc[dir]>1) {
+    switch(dir) {
+      case 0:
+        mpi.StartExchangeX1(this->Vc, this->Vs);
+        break;
+      case 1:
+        mpi.StartExchangeX2(this->Vc, this->Vs);
+        break;
+      case 2:
+        mpi.StartExchangeX3(this->Vc, this->Vs);
+        break;
     }
-    #endif
+  }
+  #endif
+}
+
+// Fill the ghost zones in direction dir, once the exchange has been started
+template<typename Phys>
+void Boundary<Phys>::FinishBoundaryDir(real t, int dir) {
+  #ifdef WITH_MPI
+  if(data->mygrid->nproc[dir]>1) {
+    switch(dir) {
+      case 0:
+        mpi.FinishExchangeX1(this->Vc, this->Vs);
+        break;
+      case 1:
+        mpi.FinishExchangeX2(this->Vc, this->Vs);
+        break;
+      case 2:
+        mpi.FinishExchangeX3(this->Vc, this->Vs);
+        break;
+    }
+  }
+  #endif
+  EnforceBoundaryDir(t, dir);
+  if constexpr(Phys::mhd) {
+    // Reconstruct the normal field component when using CT
+    ReconstructNormalField(dir);
+  }
+}
+
+// Start the exchange of the ghost zones with all of the neighbours (including edges and
+// corners) in a single round of messages.
+template<typename Phys>
+void Boundary<Phys>::StartBoundaryAll() {
+  #ifdef WITH_MPI
+  if(idfx::psize>1) mpi.StartExchangeAll(this->Vc, this->Vs);
+  #endif
+}
+
+// Fill all of the ghost zones, once the exchange with all of the neighbours has been started.
+// The boundary conditions are then enforced direction by direction, as in the directional
+// exchange.
+template<typename Phys>
+void Boundary<Phys>::FinishBoundaryAll(real t) {
+  #ifdef WITH_MPI
+  if(idfx::psize>1) mpi.FinishExchangeAll(this->Vc, this->Vs);
+  #endif
+  for(int dir=0 ; dir < DIMENSIONS ; dir++ ) {
     EnforceBoundaryDir(t, dir);
     if constexpr(Phys::mhd) {
       // Reconstruct the normal field component when using CT
       ReconstructNormalField(dir);
     }
-  } // Loop on dimension ends
-
-  if constexpr(Phys::mhd) {
-    // Remake the cell-centered field.
-    ReconstructVcField(this->Vc);
   }
-
-  idfx::popRegion();
 }
 
 
@@ -382,7 +457,7 @@ void Boundary<Phys>::EnforceBoundaryDir(real t, int dir) {
 
 
 template<typename Phys>
-void Boundary<Phys>::ReconstructVcField(IdefixArray4D<real> &Vc) {
+void Boundary<Phys>::ReconstructVcField(IdefixArray4D<realStore> &Vc) {
   idfx::pushRegion("Boundary::ReconstructVcField");
 
   IdefixArray4D<real> Vs=this->Vs;
@@ -568,7 +643,7 @@ void Boundary<Phys>::EnrollInternalBoundary(InternalBoundaryFunc<Phys> myFunc) {
 template<typename Phys>
 void Boundary<Phys>::EnforcePeriodic(int dir, BoundarySide side ) {
   idfx::pushRegion("Boundary::EnforcePeriodic");
-  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<realStore> Vc = this->Vc;
   int nxi = data->np_int[IDIR];
   int nxj = data->np_int[JDIR];
   int nxk = data->np_int[KDIR];
@@ -668,7 +743,7 @@ void Boundary<Phys>::EnforcePeriodic(int dir, BoundarySide side ) {
 template<typename Phys>
 void Boundary<Phys>::EnforceReflective(int dir, BoundarySide side ) {
   idfx::pushRegion("Boundary::EnforceReflective");
-  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<realStore> Vc = this->Vc;
   const int nxi = data->np_int[IDIR];
   const int nxj = data->np_int[JDIR];
   const int nxk = data->np_int[KDIR];
@@ -731,7 +806,7 @@ void Boundary<Phys>::EnforceReflective(int dir, BoundarySide side ) {
 template<typename Phys>
 void Boundary<Phys>::EnforceOutflow(int dir, BoundarySide side ) {
   idfx::pushRegion("Boundary::EnforceOutflow");
-  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<realStore> Vc = this->Vc;
   const int nxi = data->np_int[IDIR];
   const int nxj = data->np_int[JDIR];
   const int nxk = data->np_int[KDIR];
@@ -812,7 +887,7 @@ void Boundary<Phys>::EnforceShearingBox(real t, int dir, BoundarySide side) {
   if(data->mygrid->nproc[dir] == 1) EnforcePeriodic(dir, side);
 
   IdefixArray4D<real> scrh = sBArray;
-  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<realStore> Vc = this->Vc;
 
   const int nxi = data->np_int[IDIR];
   const int nxj = data->np_int[JDIR];
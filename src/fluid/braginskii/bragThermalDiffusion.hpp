@@ -9,6 +9,7 @@
 #define FLUID_BRAGINSKII_BRAGTHERMALDIFFUSION_HPP_
 
 #include <string>
+#include <memory>
 
 #include "idefix.hpp"
 #include "input.hpp"
@@ -21,6 +22,7 @@
 template <typename Phys> class Fluid;
 
 class DataBlock;
+class FaceGradients;
 
 class BragThermalDiffusion {
  public:
@@ -29,10 +31,10 @@ class BragThermalDiffusion {
 
   void ShowConfig(); // display configuration
 
-  void AddBragDiffusiveFlux(int, const real, const IdefixArray4D<real> &);
+  void AddBragDiffusiveFlux(int, const real, const IdefixArray4D<realStore> &);
 
   template<const PLMLimiter>
-  void AddBragDiffusiveFluxLim(int, const real, const IdefixArray4D<real> &);
+  void AddBragDiffusiveFluxLim(int, const real, const IdefixArray4D<realStore> &);
 
   // Enroll user-defined thermal conductivity
   void EnrollBragThermalDiffusivity(BragDiffusivityFunc);
@@ -55,10 +57,13 @@ class BragThermalDiffusion {
   bool haveSlopeLimiter{false};
 
   // helper array
-  IdefixArray4D<real> &Vc;
+  IdefixArray4D<realStore> &Vc;
   IdefixArray4D<real> &Vs;
   IdefixArray3D<real> &dMax;
 
+  // Temperature differences shared with the thermal diffusion (when allocated)
+  std::unique_ptr<FaceGradients> &faceGradients;
+
   // constant diffusion coefficient (when needed)
   real knor, kpar;
 
@@ -70,12 +75,14 @@ class BragThermalDiffusion {
 
 #include "fluid.hpp"
 #include "dataBlock.hpp"
+#include "faceGradients.hpp"
 
 template <typename Phys>
 BragThermalDiffusion::BragThermalDiffusion(Input &input, Grid &grid, Fluid<Phys> *hydroin):
                             Vc(hydroin->Vc),
                             Vs(hydroin->Vs),
                             dMax(hydroin->dMax),
+                            faceGradients(hydroin->faceGradients),
                             eos(hydroin->eos.get()),
                             data(hydroin->data),
                             status(hydroin->bragThermalDiffusionStatus) {
@@ -136,9 +143,14 @@ BragThermalDiffusion::BragThermalDiffusion(Input &input, Grid &grid, Fluid<Phys>
 //    It is rather defined as PRS/RHO.
 //    Special spatial derivative macros are therefore needed and defined here
 //    directly at the right cell interface according to the direciton of the flux.
-#define D_DX_I_T(q)  (q(PRS,k,j,i)/q(RHO,k,j,i) - q(PRS,k,j,i - 1)/q(RHO,k,j,i - 1))
-#define D_DY_J_T(q)  (q(PRS,k,j,i)/q(RHO,k,j,i) - q(PRS,k,j - 1,i)/q(RHO,k,j - 1,i))
-#define D_DZ_K_T(q)  (q(PRS,k,j,i)/q(RHO,k,j,i) - q(PRS,k - 1,j,i)/q(RHO,k - 1,j,i))
+//    The normal derivatives are read from FaceGradients::dT when they are shared with the
+//    thermal diffusion (haveFaceDT).
+#define D_DX_I_T(q)  (haveFaceDT ? dT(k,j,i) \
+                      : q(PRS,k,j,i)/q(RHO,k,j,i) - q(PRS,k,j,i - 1)/q(RHO,k,j,i - 1))
+#define D_DY_J_T(q)  (haveFaceDT ? dT(k,j,i) \
+                      : q(PRS,k,j,i)/q(RHO,k,j,i) - q(PRS,k,j - 1,i)/q(RHO,k,j - 1,i))
+#define D_DZ_K_T(q)  (haveFaceDT ? dT(k,j,i) \
+                      : q(PRS,k,j,i)/q(RHO,k,j,i) - q(PRS,k - 1,j,i)/q(RHO,k - 1,j,i))
 
 #define SL_DX_T(q,k,j,i)  (q(PRS,k,j,i)/q(RHO,k,j,i)           \
                                         - q(PRS,k,j,i - 1)/q(RHO,k,j,i - 1))
@@ -200,10 +212,10 @@ BragThermalDiffusion::BragThermalDiffusion(Input &input, Grid &grid, Fluid<Phys>
 // (this avoids an extra array)
 template <PLMLimiter limTemplate>
 void BragThermalDiffusion::AddBragDiffusiveFluxLim(int dir, const real t,
-                                                const IdefixArray4D<real> &Flux) {
+                                                const IdefixArray4D<realStore> &Flux) {
   idfx::pushRegion("BragThermalDiffusion::AddBragDiffusiveFluxLim");
 
-  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<realStore> Vc = this->Vc;
   IdefixArray4D<real> Vs = this->Vs;
   IdefixArray3D<real> dMax = this->dMax;
   EquationOfState eos = *(this->eos);
@@ -212,6 +224,11 @@ void BragThermalDiffusion::AddBragDiffusiveFluxLim(int dir, const real t,
   bool haveSlopeLimiter = this->haveSlopeLimiter;
   using SL = SlopeLimiter<limTemplate>;
 
+  // Temperature differences computed once for the thermal and braginskii thermal diffusions
+  const bool haveFaceDT = faceGradients && faceGradients->haveTemperature;
+  IdefixArray3D<real> dT;
+  if(haveFaceDT) dT = faceGradients->dT;
+
   int ibeg, iend, jbeg, jend, kbeg, kend;
   ibeg = this->data->beg[IDIR];
   iend = this->data->end[IDIR];
@@ -33,9 +33,10 @@ void BragViscosity::InitArrays() {
         dmu(j) = 1.0/scrch;
       });
   #endif
-  bragViscSrc = IdefixArray4D<real>("BragViscosity_source", COMPONENTS, data->np_tot[KDIR],
-                                                                data->np_tot[JDIR],
-                                                                data->np_tot[IDIR]);
+  bragViscSrc = IdefixArray4D<real>("BragViscosity_source",
+                                    IdefixLayout4D(COMPONENTS, data->np_tot[KDIR],
+                                                               data->np_tot[JDIR],
+                                                               data->np_tot[IDIR]));
 }
 void BragViscosity::ShowConfig() {
   if(status.status==Constant) {
@@ -80,7 +81,8 @@ void BragViscosity::EnrollBragViscousDiffusivity(DiffusivityFunc myFunc) {
 // (this avoids an extra array)
 // Associated source terms, present in non-cartesian geometry are also computed
 // and stored in this->viscSrc for later use (in calcRhs).
-void BragViscosity::AddBragViscousFlux(int dir, const real t, const IdefixArray4D<real> &Flux) {
+void BragViscosity::AddBragViscousFlux(int dir, const real t,
+                                       const IdefixArray4D<realStore> &Flux) {
   idfx::pushRegion("BragViscosity::AddBragViscousFlux");
   switch(limiter) {
     case PLMLimiter::VanLeer:
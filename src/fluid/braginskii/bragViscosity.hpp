@@ -9,6 +9,7 @@
 #define FLUID_BRAGINSKII_BRAGVISCOSITY_HPP_
 
 #include <string>
+#include <memory>
 
 #include "idefix.hpp"
 #include "input.hpp"
@@ -19,16 +20,17 @@
 // Forward class hydro declaration
 template <typename Phys> class Fluid;
 class DataBlock;
+class FaceGradients;
 
 class BragViscosity {
  public:
   template <typename Phys>
   BragViscosity(Input &, Grid &, Fluid<Phys> *);
   void ShowConfig();                    // print configuration
-  void AddBragViscousFlux(int, const real, const IdefixArray4D<real> &);
+  void AddBragViscousFlux(int, const real, const IdefixArray4D<realStore> &);
 
   template <const PLMLimiter>
-  void AddBragViscousFluxLim(int, const real, const IdefixArray4D<real> &);
+  void AddBragViscousFluxLim(int, const real, const IdefixArray4D<realStore> &);
 
   // Enroll user-defined viscous diffusivity
   void EnrollBragViscousDiffusivity(DiffusivityFunc);
@@ -53,10 +55,13 @@ class BragViscosity {
 
   bool haveSlopeLimiter{false};
 
-  IdefixArray4D<real> &Vc;
+  IdefixArray4D<realStore> &Vc;
   IdefixArray4D<real> &Vs;
   IdefixArray3D<real> &dMax;
 
+  // Velocity differences shared with the viscosity (when allocated)
+  std::unique_ptr<FaceGradients> &faceGradients;
+
   // constant diffusion coefficient (when needed)
   real etaBrag;
 
@@ -64,12 +69,14 @@ class BragViscosity {
 };
 
 #include "fluid.hpp"
+#include "faceGradients.hpp"
 
 template<typename Phys>
 BragViscosity::BragViscosity(Input &input, Grid &grid, Fluid<Phys> *hydroin):
                       Vc(hydroin->Vc),
                       Vs(hydroin->Vs),
                       dMax(hydroin->dMax),
+                      faceGradients(hydroin->faceGradients),
                       status(hydroin->bragViscosityStatus) {
   idfx::pushRegion("BragViscosity::BragViscosity");
   // Save the parent hydro object
@@ -114,32 +121,12 @@ BragViscosity::BragViscosity(Input &input, Grid &grid, Fluid<Phys> *hydroin):
 
 //We now define spatial derivative macros for the velocity field.
 //    They are directly computed at the right cell interface according to the direciton of the flux.
-#define D_DX_I(q,n)  (q(n,k,j,i) - q(n,k,j,i - 1))
-#define D_DY_J(q,n)  (q(n,k,j,i) - q(n,k,j - 1,i))
-#define D_DZ_K(q,n)  (q(n,k,j,i) - q(n,k - 1,j,i))
-
+//    The unlimited ones (D_DX_I...) are defined in faceGradients.hpp, since they can be shared
+//    with the viscosity.
 #define SL_DX(q,n,k,j,i)  (q(n,k,j,i) - q(n,k,j,i - 1))
 #define SL_DY(q,n,k,j,i)  (q(n,k,j,i) - q(n,k,j - 1,i))
 #define SL_DZ(q,n,k,j,i)  (q(n,k,j,i) - q(n,k - 1,j,i))
 
-#define D_DY_I(q,n)  (  0.25*(q(n,k,j + 1,i) + q(n,k,j + 1,i - 1)) \
-                    - 0.25*(q(n,k,j - 1,i) + q(n,k,j - 1,i - 1)))
-
-#define D_DZ_I(q,n)  (  0.25*(q(n,k + 1,j,i) + q(n,k + 1,j,i - 1))  \
-                    - 0.25*(q(n,k - 1,j,i) + q(n,k - 1,j,i - 1)))
-
-#define D_DX_J(q,n)  (  0.25*(q(n,k,j,i + 1) + q(n,k,j - 1,i + 1)) \
-                    - 0.25*(q(n,k,j,i - 1) + q(n,k,j - 1,i - 1)))
-
-#define D_DZ_J(q,n)  (  0.25*(q(n,k + 1,j,i) + q(n,k + 1,j - 1,i)) \
-                    - 0.25*(q(n,k - 1,j,i) + q(n,k - 1,j - 1,i)))
-
-#define D_DX_K(q,n)  (  0.25*(q(n,k,j,i + 1) + q(n,k - 1,j,i + 1)) \
-                    - 0.25*(q(n,k,j,i - 1) + q(n,k - 1,j,i - 1)))
-
-#define D_DY_K(q,n)  (  0.25*(q(n,k,j + 1,i) + q(n,k - 1,j + 1,i)) \
-                    - 0.25*(q(n,k,j - 1,i) + q(n,k - 1,j - 1,i)))
-
 //We now define spatial average macros for the magnetic field.
 //    The magnetic field appears in the expression of the Braginskii heat flux.
 //    It is therefore needed at the right cell interface according to the direction of the flux.
@@ -165,9 +152,10 @@ BragViscosity::BragViscosity(Input &input, Grid &grid, Fluid<Phys> *hydroin):
 // Associated source terms, present in non-cartesian geometry are also computed
 // and stored in this->bragViscSrc for later use (in calcRhs).
 template <PLMLimiter limTemplate>
-void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArray4D<real> &Flux) {
+void BragViscosity::AddBragViscousFluxLim(int dir, const real t,
+                                          const IdefixArray4D<realStore> &Flux) {
   idfx::pushRegion("BragViscosity::AddBragViscousFlux");
-  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<realStore> Vc = this->Vc;
   IdefixArray4D<real> Vs = this->Vs;
   IdefixArray4D<real> bragViscSrc = this->bragViscSrc;
   IdefixArray3D<real> dMax = this->dMax;
@@ -193,6 +181,11 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
   HydroModuleStatus haveViscosity = this->status.status;
   bool haveSlopeLimiter = this->haveSlopeLimiter;
 
+  // Velocity differences computed once for the viscosity and the braginskii viscosity
+  const bool haveFaceDV = faceGradients && faceGradients->haveVelocity;
+  IdefixArray4D<real> dV;
+  if(haveFaceDV) dV = faceGradients->dV;
+
   using SL = SlopeLimiter<limTemplate>;
 
   // Braginskii Viscosity
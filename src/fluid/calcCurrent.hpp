@@ -14,7 +14,7 @@
 template <typename Phys>
 void Fluid<Phys>::CalcCurrent() {
   idfx::pushRegion("Fluid::CalcCurrent");
-  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<realStore> Vc = this->Vc;
   IdefixArray4D<real> Vs = this->Vs;
   IdefixArray4D<real> J = this->J;
 
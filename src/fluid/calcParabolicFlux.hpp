@@ -36,6 +36,19 @@ void Fluid<Phys>::CalcParabolicFlux(const real t) {
       this->AddNonIdealMHDFlux<dir>(t);
   }
 
+  // Face differences shared by the modules called below
+  if(faceGradients) {
+    auto active = [&](const ParabolicModuleStatus &status) {
+      return (status.isExplicit && (!data->rklCycle)) || (status.isRKL && data->rklCycle);
+    };
+    // The explicit viscosity is computed with the fargo velocity added to Vc
+    const bool shareVelocity = active(viscosityStatus) && active(bragViscosityStatus)
+                               && !(data->haveFargo && viscosityStatus.isExplicit);
+    const bool shareTemperature = active(thermalDiffusionStatus)
+                                  && active(bragThermalDiffusionStatus);
+    faceGradients->Compute(dir, shareVelocity, shareTemperature);
+  }
+
   if( (viscosityStatus.isExplicit && (!data->rklCycle))
     || (viscosityStatus.isRKL && data->rklCycle))  {
       // Add fargo velocity if using fargo
@@ -47,14 +47,20 @@ struct Fluid_CorrectFluxFunctor {
 
     // Shearing box shear rate
     sbS = hydro->sbS;
+
+    // Local time stepping
+    haveLocalTimestep = hydro->data->haveLocalTimestep;
+    if(haveLocalTimestep) {
+      ltsWeight = hydro->data->lts->weight[dir];
+    }
   }
 
   //*****************************************************************
   // Functor Variables
   //*****************************************************************
-  IdefixArray4D<real> Uc;
-  IdefixArray4D<real> Vc;
-  IdefixArray4D<real> Flux;
+  IdefixArray4D<realStore> Uc;
+  IdefixArray4D<realStore> Vc;
+  IdefixArray4D<realStore> Flux;
   IdefixArray3D<real> A;
   IdefixArray3D<real> dV;
   IdefixArray1D<real> x1m;
@@ -62,6 +68,10 @@ struct Fluid_CorrectFluxFunctor {
   IdefixArray1D<real> sinx2m;
   IdefixArray1D<real> sinx2;
 
+  // Local time stepping (faces which are not updated in the current substep)
+  bool haveLocalTimestep{false};
+  IdefixArray1D<real> ltsWeight;
+
   // Fargo
   IdefixArray2D<real> fargoVelocity;
   Fargo::FargoType fargoType;
@@ -82,6 +92,16 @@ struct Fluid_CorrectFluxFunctor {
   // Functor Operator
   //*****************************************************************
   KOKKOS_INLINE_FUNCTION void operator() (const int k, const int j,  const int i) const {
+    CorrectFlux(k, j, i, Flux);
+  }
+
+  // Correct the flux on face (k,j,i) of any array indexed as Flux(nv,k,j,i)
+  template<typename FluxArray>
+  KOKKOS_INLINE_FUNCTION void CorrectFlux(const int k, const int j,  const int i,
+                                          const FluxArray &Flux) const {
+      // Inactive faces are left untouched
+      if(haveLocalTimestep && ltsWeight(i) == ZERO_F) return;
+
       // Add Fargo velocity to the fluxes
       if(haveFargo || haveRotation) {
         // Set mean advection direction
@@ -264,13 +284,20 @@ struct Fluid_CalcRHSFunctor {
 
     // Shearing box shear rate
     sbS = hydro->sbS;
+
+    // Local time stepping
+    haveLocalTimestep = hydro->data->haveLocalTimestep;
+    if(haveLocalTimestep) {
+      ltsFaceWeight = hydro->data->lts->weight[dir];
+      ltsCellWeight = hydro->data->lts->cellWeight;
+    }
   }
   //*****************************************************************
   // Functor Variables
   //*****************************************************************
-  IdefixArray4D<real> Uc;
-  IdefixArray4D<real> Vc;
-  IdefixArray4D<real> Flux;
+  IdefixArray4D<realStore> Uc;
+  IdefixArray4D<realStore> Vc;
+  IdefixArray4D<realStore> Flux;
   IdefixArray3D<real> A;
   IdefixArray3D<real> dV;
   IdefixArray1D<real> x1m;
@@ -322,6 +349,11 @@ struct Fluid_CalcRHSFunctor {
   // shearingBox
   real sbS;
 
+  // Local time stepping
+  bool haveLocalTimestep{false};
+  IdefixArray1D<real> ltsFaceWeight;
+  IdefixArray1D<real> ltsCellWeight;
+
   // timestep
   real dt;
 
@@ -329,16 +361,38 @@ struct Fluid_CalcRHSFunctor {
   // Functor Operator
   //*****************************************************************
   KOKKOS_INLINE_FUNCTION void operator() (const int k, const int j,  const int i) const {
+    CalcRHS(k, j, i, Flux, cMax);
+  }
+
+  // Update the conservative variables of cell (k,j,i) from the fluxes and signal speeds
+  // on its faces
+  template<typename FluxArray, typename SpeedArray>
+  KOKKOS_INLINE_FUNCTION void CalcRHS(const int k, const int j,  const int i,
+                                      const FluxArray &Flux, const SpeedArray &cMax) const {
     const int ioffset = (dir==IDIR) ? 1 : 0;
     const int joffset = (dir==JDIR) ? 1 : 0;
     const int koffset = (dir==KDIR) ? 1 : 0;
 
+    // With local time stepping, the cell and its faces are evolved by a multiple of dt
+    // (the flux of a face is applied with the same weight on both of its sides)
+    real wL = ONE_F;
+    real wR = ONE_F;
+    real wC = ONE_F;
+    if(haveLocalTimestep) {
+      wL = ltsFaceWeight(i);
+      wR = ltsFaceWeight(i+ioffset);
+      // Nothing to do if neither the cell nor its faces are updated in this substep
+      if(wL == ZERO_F && wR == ZERO_F) return;
+      wC = ltsCellWeight(i);
+    }
+    const real dtc = wC*dt;
+
     real dtdV=dt / dV(k,j,i);
     real rhs[Phys::nvar];
 
     #pragma unroll
     for(int nv = 0 ; nv < Phys::nvar ; nv++) {
-      rhs[nv] = -  dtdV*(Flux(nv, k+koffset, j+joffset, i+ioffset) - Flux(nv, k, j, i));
+      rhs[nv] = -  dtdV*(wR*Flux(nv, k+koffset, j+joffset, i+ioffset) - wL*Flux(nv, k, j, i));
     }
 
     #if GEOMETRY != CARTESIAN
@@ -412,12 +466,12 @@ struct Fluid_CalcRHSFunctor {
       if(haveViscosity) {
         #pragma unroll
         for(int nv = 0 ; nv < COMPONENTS ; nv++) {
-          rhs[nv + VX1] += dt*viscSrc(nv,k,j,i);
+          rhs[nv + VX1] += dtc*viscSrc(nv,k,j,i);
         }
       } else if(haveBragViscosity) {
         #pragma unroll
         for(int nv = 0 ; nv < COMPONENTS ; nv++) {
-          rhs[nv + VX1] += dt*bragViscSrc(nv,k,j,i);
+          rhs[nv + VX1] += dtc*bragViscSrc(nv,k,j,i);
         }
       }
     #endif // GEOMETRY != CARTESIAN
@@ -457,44 +511,44 @@ struct Fluid_CalcRHSFunctor {
                       - phiP(k+2,j,i) + 8.0 * phiP(k+1,j,i)
                       - 8.0*phiP(k-1,j,i) + phiP(k-2,j,i));
       }
-      rhs[MX1+dir] += dt * Vc(RHO,k,j,i) * dphi /dl;
+      rhs[MX1+dir] += dtc * Vc(RHO,k,j,i) * dphi /dl;
 
       if constexpr(Phys::pressure) {
         // Add gravitational force work as a source term
         // This is equivalent to rho * v . nabla(phi)
         // (note that Flux has already been multiplied by A)
         rhs[ENG] += HALF_F * dtdV  *
-                  (Flux(RHO,k,j,i) + Flux(RHO, k+koffset, j+joffset, i+ioffset)) * dphi;
+                  (wL*Flux(RHO,k,j,i) + wR*Flux(RHO, k+koffset, j+joffset, i+ioffset)) * dphi;
       }
     }
 
     // Body force
     if(needBodyForce) {
-      rhs[MX1+dir] += dt * Vc(RHO,k,j,i) * bodyForce(dir,k,j,i);
+      rhs[MX1+dir] += dtc * Vc(RHO,k,j,i) * bodyForce(dir,k,j,i);
       if constexpr(Phys::pressure) {
         //  rho * v . f, where rhov is taken as a  volume average of Flux(RHO)
         rhs[ENG] += HALF_F * dtdV * dl *
-                      (Flux(RHO,k,j,i) + Flux(RHO, k+koffset, j+joffset, i+ioffset)) *
+                      (wL*Flux(RHO,k,j,i) + wR*Flux(RHO, k+koffset, j+joffset, i+ioffset)) *
                         bodyForce(dir,k,j,i);
       } // Pressure
 
       // Particular cases if we do not sweep all of the components
       #if DIMENSIONS == 1 && COMPONENTS > 1
         EXPAND(                                                           ,
-                  rhs[MX2] += dt * Vc(RHO,k,j,i) * bodyForce(JDIR,k,j,i);   ,
-                  rhs[MX3] += dt * Vc(RHO,k,j,i) * bodyForce(KDIR,k,j,i);    )
+                  rhs[MX2] += dtc * Vc(RHO,k,j,i) * bodyForce(JDIR,k,j,i);  ,
+                  rhs[MX3] += dtc * Vc(RHO,k,j,i) * bodyForce(KDIR,k,j,i);   )
         if constexpr(Phys::pressure) {
-          rhs[ENG] += dt * (EXPAND( ZERO_F                                              ,
-                                    + Vc(RHO,k,j,i) * Vc(VX2,k,j,i) * bodyForce(JDIR,k,j,i)   ,
-                                    + Vc(RHO,k,j,i) * Vc(VX3,k,j,i) * bodyForce(KDIR,k,j,i) ));
+          rhs[ENG] += dtc * (EXPAND( ZERO_F                                             ,
+                                     + Vc(RHO,k,j,i) * Vc(VX2,k,j,i) * bodyForce(JDIR,k,j,i)   ,
+                                     + Vc(RHO,k,j,i) * Vc(VX3,k,j,i) * bodyForce(KDIR,k,j,i) ));
         }
       #endif
       #if DIMENSIONS == 2 && COMPONENTS == 3
         // Only add this term once!
         if constexpr (dir==JDIR) {
-          rhs[MX3] += dt * Vc(RHO,k,j,i) * bodyForce(KDIR,k,j,i);
+          rhs[MX3] += dtc * Vc(RHO,k,j,i) * bodyForce(KDIR,k,j,i);
           if constexpr(Phys::pressure) {
-            rhs[ENG] += dt * Vc(RHO,k,j,i) * Vc(VX3,k,j,i) * bodyForce(KDIR,k,j,i);
+            rhs[ENG] += dtc * Vc(RHO,k,j,i) * Vc(VX3,k,j,i) * bodyForce(KDIR,k,j,i);
           }
         }
       #endif
@@ -545,9 +599,10 @@ struct Fluid_CalcRHSFunctor {
 
 
 // Compute the right handside in direction dir from conservative equation, with timestep dt
+// When region is not SweepRegion::all, only the cells of that region are updated.
 template<typename Phys>
 template<int dir>
-void Fluid<Phys>::CalcRightHandSide(real t, real dt) {
+void Fluid<Phys>::CalcRightHandSide(real t, real dt, const SweepRegion region) {
   idfx::pushRegion("Fluid::CalcRightHandSide");
 
   // Update fargo velocity when needed
@@ -563,26 +618,94 @@ void Fluid<Phys>::CalcRightHandSide(real t, real dt) {
   const int ioffset = (dir==IDIR) ? 1 : 0;
   const int joffset = (dir==JDIR) ? 1 : 0;
   const int koffset = (dir==KDIR) ? 1 : 0;
-  idefix_for("Correct Flux",
-             data->beg[KDIR],data->end[KDIR]+koffset,
-             data->beg[JDIR],data->end[JDIR]+joffset,
-             data->beg[IDIR],data->end[IDIR]+ioffset,
-              fluxCorrection);
-
+  if(region == SweepRegion::all) {
+    idefix_for("Correct Flux",
+               data->beg[KDIR],data->end[KDIR]+koffset,
+               data->beg[JDIR],data->end[JDIR]+joffset,
+               data->beg[IDIR],data->end[IDIR]+ioffset,
+                fluxCorrection);
+  } else {
+    IndexBox faces{data->beg, data->end};
+    faces.end[dir] += 1;
+    idefix_for_region("Correct Flux", region, faces,
+                      InteriorFaces(data->beg, data->end, data->nghost, dir, region),
+                      fluxCorrection);
+  }
 
   // If user has requested specific flux functions for the boundaries, here they come
-  if(boundary->haveFluxBoundary) boundary->EnforceFluxBoundaries(dir,t);
+  // (the boundary faces are not part of the interior)
+  if(boundary->haveFluxBoundary && region != SweepRegion::interior) {
+    boundary->EnforceFluxBoundaries(dir,t);
+  }
 
   auto calcRHS = Fluid_CalcRHSFunctor<Phys,dir>(this,dt);
   /////////////////////////////////////////////////////////////////////////////
   // Final conserved quantity budget from fluxes divergence
   /////////////////////////////////////////////////////////////////////////////
+  if(region == SweepRegion::all) {
+    idefix_for("CalcRightHandSide",
+               data->beg[KDIR],data->end[KDIR],
+               data->beg[JDIR],data->end[JDIR],
+               data->beg[IDIR],data->end[IDIR],
+                calcRHS);
+  } else {
+    idefix_for_region("CalcRightHandSide", region, IndexBox{data->beg, data->end},
+                      InteriorBox(data->beg, data->end, data->nghost),
+                      calcRHS);
+  }
+
+  idfx::popRegion();
+}
+
+// Same, on the cells of a tile only (tiled sweeps). The fargo velocity is updated once for all
+// of the tiles in EvolveStage.
+template<typename Phys>
+template<int dir>
+void Fluid<Phys>::CalcRightHandSide(real t, real dt, const IndexBox &tile) {
+  idfx::pushRegion("Fluid::CalcRightHandSide");
+
+  auto fluxCorrection = Fluid_CorrectFluxFunctor<Phys,dir>(this,dt);
+  const int ioffset = (dir==IDIR) ? 1 : 0;
+  const int joffset = (dir==JDIR) ? 1 : 0;
+  const int koffset = (dir==KDIR) ? 1 : 0;
+  idefix_for("Correct Flux",
+             tile.beg[KDIR],tile.end[KDIR]+koffset,
+             tile.beg[JDIR],tile.end[JDIR]+joffset,
+             tile.beg[IDIR],tile.end[IDIR]+ioffset,
+              fluxCorrection);
+
+  // The boundary fluxes are only enforced by the tiles which hold boundary faces
+  if(boundary->haveFluxBoundary && (tile.beg[dir] == data->beg[dir]
+                                    || tile.end[dir] == data->end[dir])) {
+    boundary->EnforceFluxBoundaries(dir,t);
+  }
+
+  auto calcRHS = Fluid_CalcRHSFunctor<Phys,dir>(this,dt);
   idefix_for("CalcRightHandSide",
-             data->beg[KDIR],data->end[KDIR],
-             data->beg[JDIR],data->end[JDIR],
-             data->beg[IDIR],data->end[IDIR],
+             tile.beg[KDIR],tile.end[KDIR],
+             tile.beg[JDIR],tile.end[JDIR],
+             tile.beg[IDIR],tile.end[IDIR],
               calcRHS);
 
+  idfx::popRegion();
+}
+
+// Fused version of CalcFlux+CalcRightHandSide in direction dir: the Riemann fluxes are
+// computed, corrected and differenced pencil by pencil, without going through FluxRiemann
+template<typename Phys>
+template<int dir>
+void Fluid<Phys>::CalcFusedRightHandSide(real t, real dt) {
+  idfx::pushRegion("Fluid::CalcFusedRightHandSide");
+
+  // Update fargo velocity when needed
+  if(data->haveFargo && data->fargo->type == Fargo::userdef) {
+    data->fargo->GetFargoVelocity(t);
+  }
+
+  auto fluxCorrection = Fluid_CorrectFluxFunctor<Phys,dir>(this,dt);
+  auto calcRHS = Fluid_CalcRHSFunctor<Phys,dir>(this,dt);
+
+  rSolver->template CalcFusedFlux<dir>(fluxCorrection, calcRHS);
 
   idfx::popRegion();
 }
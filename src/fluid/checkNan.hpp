@@ -19,7 +19,7 @@ int Fluid<Phys>::CheckNan()  {
   int nanVc=0;
 
   idfx::pushRegion("Fluid::CheckNan");
-  IdefixArray4D<real> Vc=this->Vc;
+  IdefixArray4D<realStore> Vc=this->Vc;
 
   idefix_reduce("checkNanVc",
     0, Phys::nvar,
@@ -66,7 +66,7 @@ int Fluid<Phys>::CheckNan()  {
 
       DataBlockHost dataHost(*data);
 
-      IdefixHostArray4D<real> VcHost = Kokkos::create_mirror_view(this->Vc);
+      IdefixArray4D<realStore>::HostMirror VcHost = Kokkos::create_mirror_view(this->Vc);
       Kokkos::deep_copy(VcHost,Vc);
 
       int nerrormax=10;
@@ -94,7 +94,7 @@ int Fluid<Phys>::CheckNan()  {
       }
 
       if constexpr(Phys::mhd) {
-        IdefixHostArray4D<real> VsHost = Kokkos::create_mirror_view(this->Vs);
+        IdefixArray4D<real>::HostMirror VsHost = Kokkos::create_mirror_view(this->Vs);
         Kokkos::deep_copy(VsHost,Vs);
         for(int k = data->beg[KDIR] ; k < data->end[KDIR]+KOFFSET ; k++) {
           for(int j = data->beg[JDIR] ; j < data->end[JDIR]+JOFFSET ; j++) {
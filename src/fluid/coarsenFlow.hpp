@@ -17,7 +17,7 @@ KOKKOS_INLINE_FUNCTION int Kmax(int n, int m) {
 // This function coarsen the flow according to the grid coarsening array
 
 template<typename Phys>
-void Fluid<Phys>::CoarsenFlow(IdefixArray4D<real> &Vi) {
+void Fluid<Phys>::CoarsenFlow(IdefixArray4D<realStore> &Vi) {
   idfx::pushRegion("Fluid::CoarsenFlow");
 
   IdefixArray3D<real> dV   = data->dV;
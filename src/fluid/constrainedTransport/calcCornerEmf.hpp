@@ -84,7 +84,7 @@ void ConstrainedTransport<Phys>::CalcArithmeticAverage() {
 template<typename Phys>
 void ConstrainedTransport<Phys>::CalcCellCenteredEMF() {
   idfx::pushRegion("ConstrainedTransport::CalcCellCenteredEMF");
-  IdefixArray4D<real> Vc = hydro->Vc;
+  IdefixArray4D<realStore> Vc = hydro->Vc;
     // cell-centered EMFs
   IdefixArray3D<real> Ex1 = this->Ex1;
   IdefixArray3D<real> Ex2 = this->Ex2;
@@ -23,20 +23,26 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
   IdefixArray3D<real> ez = this->ez;
   IdefixArray4D<real> J = hydro->J;
   IdefixArray4D<real> Vs = hydro->Vs;
-  IdefixArray4D<real> Vc = hydro->Vc;
+  IdefixArray4D<realStore> Vc = hydro->Vc;
 
   // These arrays have been previously computed in calcParabolicFlux
   IdefixArray3D<real> etaArr = hydro->etaOhmic;
   IdefixArray3D<real> xAmbiArr = hydro->xAmbipolar;
+  IdefixArray3D<real> xHallArr = hydro->xHall;
 
   // these two are required to ensure that the type is captured by KOKKOS_LAMBDA
   HydroModuleStatus resistivity = hydro->resistivityStatus.status;
   HydroModuleStatus ambipolar = hydro->ambipolarStatus.status;
+  HydroModuleStatus hall = hydro->hallStatus.status;
 
   bool haveResistivity{false};
   bool haveAmbipolar{false};
+  bool haveHall{false};
 
-  if(data->rklCycle) {
+  if(data->hallCycle) {
+    // Only the Hall EMF is computed by the Hall subcycles
+    haveHall = true;
+  } else if(data->rklCycle) {
     haveResistivity = hydro->resistivityStatus.isRKL;
     haveAmbipolar = hydro->ambipolarStatus.isRKL;
   } else {
@@ -46,6 +52,7 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
 
   real etaConstant = hydro->etaO;
   real xAConstant = hydro->xA;
+  real xHConstant = hydro->xH;
 
   idefix_for("CalcNIEMF",
              data->beg[KDIR],data->end[KDIR]+KOFFSET,
@@ -54,13 +61,15 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
     KOKKOS_LAMBDA (int k, int j, int i) {
       real Bx1, Bx2, Bx3;
       real Jx1, Jx2, Jx3;
-      real eta, xA;
+      real eta, xA, xH;
       // CT_EMF_ArithmeticAverage (emf, 0.25);
 
       if(resistivity == Constant)
         eta = etaConstant;
       if(ambipolar == Constant)
         xA = xAConstant;
+      if(hall == Constant)
+        xH = xHConstant;
 
   #if DIMENSIONS == 3
       // -----------------------
@@ -75,9 +84,8 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         ex(k,j,i) += eta * Jx1;
       }
 
-      // Ambipolar diffusion
-      if(haveAmbipolar) {
-        if(ambipolar == UserDefFunction) xA = AVERAGE_3D_YZ(xAmbiArr,k,j,i);
+      // Ambipolar diffusion and Hall effect
+      if(haveAmbipolar || haveHall) {
         Bx1 = AVERAGE_4D_XYZ(Vs, BX1s, k,j,i+1);
         Bx2 = AVERAGE_4D_Z(Vs, BX2s, k, j, i);
         Bx3 = AVERAGE_4D_Y(Vs, BX3s, k, j, i);
@@ -89,7 +97,14 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         real JdotB = (Jx1*Bx1 + Jx2*Bx2 + Jx3*Bx3);
         real BdotB = (Bx1*Bx1 + Bx2*Bx2 + Bx3*Bx3);
 
-        ex(k,j,i) += xA * (BdotB*Jx1 - JdotB * Bx1);
+        if(haveAmbipolar) {
+          if(ambipolar == UserDefFunction) xA = AVERAGE_3D_YZ(xAmbiArr,k,j,i);
+          ex(k,j,i) += xA * (BdotB*Jx1 - JdotB * Bx1);
+        }
+        if(haveHall) {
+          if(hall == UserDefFunction) xH = AVERAGE_3D_YZ(xHallArr,k,j,i);
+          ex(k,j,i) += xH * (Jx2*Bx3 - Jx3*Bx2);
+        }
       }
 
       // -----------------------
@@ -103,9 +118,8 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         ey(k,j,i) += eta * Jx2;
       }
 
-      // Ambipolar diffusion
-      if(haveAmbipolar) {
-        if(ambipolar == UserDefFunction) xA = AVERAGE_3D_XZ(xAmbiArr,k,j,i);
+      // Ambipolar diffusion and Hall effect
+      if(haveAmbipolar || haveHall) {
         Bx1 = AVERAGE_4D_Z(Vs, BX1s, k, j, i);
         Bx2 = AVERAGE_4D_XYZ(Vs, BX2s, k, j+1, i);
         Bx3 = AVERAGE_4D_X(Vs, BX3s, k, j, i);
@@ -117,7 +131,14 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         real JdotB = (Jx1*Bx1 + Jx2*Bx2 + Jx3*Bx3);
         real BdotB = (Bx1*Bx1 + Bx2*Bx2 + Bx3*Bx3);
 
-        ey(k,j,i) += xA * (BdotB*Jx2 - JdotB * Bx2);
+        if(haveAmbipolar) {
+          if(ambipolar == UserDefFunction) xA = AVERAGE_3D_XZ(xAmbiArr,k,j,i);
+          ey(k,j,i) += xA * (BdotB*Jx2 - JdotB * Bx2);
+        }
+        if(haveHall) {
+          if(hall == UserDefFunction) xH = AVERAGE_3D_XZ(xHallArr,k,j,i);
+          ey(k,j,i) += xH * (Jx3*Bx1 - Jx1*Bx3);
+        }
       }
   #endif
       // -----------------------
@@ -131,9 +152,8 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         ez(k,j,i) += eta * Jx3;
       }
 
-      // Ambipolar diffusion
-      if(haveAmbipolar) {
-        if(ambipolar == UserDefFunction) xA = AVERAGE_3D_XY(xAmbiArr,k,j,i);
+      // Ambipolar diffusion and Hall effect
+      if(haveAmbipolar || haveHall) {
         Bx1 = AVERAGE_4D_Y(Vs, BX1s, k, j, i);
   #if DIMENSIONS >= 2
         Bx2 = AVERAGE_4D_X(Vs, BX2s, k, j, i);
@@ -166,7 +186,14 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         real JdotB = (Jx1*Bx1 + Jx2*Bx2 + Jx3*Bx3);
         real BdotB = (Bx1*Bx1 + Bx2*Bx2 + Bx3*Bx3);
 
-        ez(k,j,i) += xA * (BdotB * Jx3 - JdotB * Bx3);
+        if(haveAmbipolar) {
+          if(ambipolar == UserDefFunction) xA = AVERAGE_3D_XY(xAmbiArr,k,j,i);
+          ez(k,j,i) += xA * (BdotB * Jx3 - JdotB * Bx3);
+        }
+        if(haveHall) {
+          if(hall == UserDefFunction) xH = AVERAGE_3D_XY(xHallArr,k,j,i);
+          ez(k,j,i) += xH * (Jx1*Bx2 - Jx2*Bx1);
+        }
       }
     }
   );
@@ -170,7 +170,7 @@ ConstrainedTransport<Phys>::ConstrainedTransport(Input &input, Fluid<Phys> *hydr
       IDEFIX_ERROR("Unknown EMF averaging scheme");
     }
   } else {
-    if(hydro->hallStatus.status == HydroModuleStatus::Disabled) {
+    if(!hydro->hallStatus.isExplicit) {
       // by default, use uct_contact
       this->averaging = uct_contact;
     } else {
@@ -196,59 +196,63 @@ ConstrainedTransport<Phys>::ConstrainedTransport(Input &input, Fluid<Phys> *hydr
             ey = IdefixArray3D<real>("EMF_ey",
                               data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  )
 
-  D_EXPAND( ezi = IdefixArray3D<real>("EMF_ezi",
+  // The face and corner EMFs of the Riemann averaging only live during a stage
+  ScratchArena *scratch = data->scratch.get();
+  constexpr int phase = ScratchArena::Stage;
+
+  D_EXPAND( ezi = scratch->Get3D<real>(phase, "EMF_ezi",
                               data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-            ezj = IdefixArray3D<real>("EMF_ezj",
+            ezj = scratch->Get3D<real>(phase, "EMF_ezj",
                               data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
                                                                                             ,
-            exj = IdefixArray3D<real>("EMF_exj",
+            exj = scratch->Get3D<real>(phase, "EMF_exj",
                               data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-            exk = IdefixArray3D<real>("EMF_exj",
+            exk = scratch->Get3D<real>(phase, "EMF_exk",
                               data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-            eyi = IdefixArray3D<real>("EMF_eyi",
+            eyi = scratch->Get3D<real>(phase, "EMF_eyi",
                               data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-            eyk = IdefixArray3D<real>("EMF_eyi",
+            eyk = scratch->Get3D<real>(phase, "EMF_eyk",
                               data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]); )
 
   if(averaging==uct_contact) {
-    D_EXPAND( svx = IdefixArray3D<real>("EMF_svx",
+    D_EXPAND( svx = scratch->Get3D<real>(phase, "EMF_svx",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
-              svy = IdefixArray3D<real>("EMF_svy",
+              svy = scratch->Get3D<real>(phase, "EMF_svy",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
-              svz = IdefixArray3D<real>("EMF_svz",
+              svz = scratch->Get3D<real>(phase, "EMF_svz",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  )
   }
 
 
   if(averaging==uct_hll || averaging==uct_hlld) {
-    D_EXPAND( axL = IdefixArray3D<real>("EMF_axL",
+    D_EXPAND( axL = scratch->Get3D<real>(phase, "EMF_axL",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-              axR = IdefixArray3D<real>("EMF_axR",
+              axR = scratch->Get3D<real>(phase, "EMF_axR",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
 
-              ayL = IdefixArray3D<real>("EMF_ayL",
+              ayL = scratch->Get3D<real>(phase, "EMF_ayL",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-              ayR = IdefixArray3D<real>("EMF_ayR",
+              ayR = scratch->Get3D<real>(phase, "EMF_ayR",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
 
-              azL = IdefixArray3D<real>("EMF_azL",
+              azL = scratch->Get3D<real>(phase, "EMF_azL",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-              azR = IdefixArray3D<real>("EMF_azR",
+              azR = scratch->Get3D<real>(phase, "EMF_azR",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  )
 
-    D_EXPAND( dxL = IdefixArray3D<real>("EMF_dxL",
+    D_EXPAND( dxL = scratch->Get3D<real>(phase, "EMF_dxL",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-              dxR = IdefixArray3D<real>("EMF_dxR",
+              dxR = scratch->Get3D<real>(phase, "EMF_dxR",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
 
-              dyL = IdefixArray3D<real>("EMF_dyL",
+              dyL = scratch->Get3D<real>(phase, "EMF_dyL",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-              dyR = IdefixArray3D<real>("EMF_dyR",
+              dyR = scratch->Get3D<real>(phase, "EMF_dyR",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
 
-              dzL = IdefixArray3D<real>("EMF_dzL",
+              dzL = scratch->Get3D<real>(phase, "EMF_dzL",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-              dzR = IdefixArray3D<real>("EMF_dzR",
+              dzR = scratch->Get3D<real>(phase, "EMF_dzR",
                                 data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  )
   }
   if(averaging==uct_hlld) {
@@ -106,8 +106,8 @@ template<typename Phys>
 void Fluid<Phys>::ConvertConsToPrim() {
   idfx::pushRegion("Fluid::ConvertConsToPrim");
 
-  IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Uc = this->Uc;
+  IdefixArray4D<realStore> Vc = this->Vc;
+  IdefixArray4D<realStore> Uc = this->Uc;
   EquationOfState eos;
   if constexpr(Phys::eos) {
     eos = *(this->eos.get());
@@ -153,8 +153,8 @@ template<typename Phys>
 void Fluid<Phys>::ConvertPrimToCons() {
   idfx::pushRegion("Fluid::ConvertPrimToCons");
 
-  IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Uc = this->Uc;
+  IdefixArray4D<realStore> Vc = this->Vc;
+  IdefixArray4D<realStore> Uc = this->Uc;
   EquationOfState eos;
   if constexpr(Phys::eos) {
     eos = *(this->eos.get());
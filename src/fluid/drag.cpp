@@ -22,15 +22,7 @@ void Drag::AddDragForce(const real dt) {
   EquationOfState eos = *(this->eos);
 
   auto userGammai = this->gammai;
-  if(type == Type::Userdef) {
-    if(userDrag != NULL) {
-      idfx::pushRegion("Drag::UserDrag");
-      userDrag(data, dragCoeff, userGammai);
-      idfx::popRegion();
-    } else {
-      IDEFIX_ERROR("No User-defined drag function has been enrolled");
-    }
-  }
+  if(type == Type::Userdef) ComputeUserDrag();
   // Compute a drag force fd = - gamma*rhod*rhog*(vd-vg)
   // Where gamma is computed according to the choice of drag type
   idefix_for("DragForce",0,data->np_tot[KDIR],0,data->np_tot[JDIR],0,data->np_tot[IDIR],
@@ -47,8 +39,8 @@ void Drag::AddDragForce(const real dt) {
         // Assume a fixed size, hence for both Epstein or Stokes, gamma~1/rho_g/cs
         // Get the sound speed
         #if HAVE_ENERGY == 1
-          cs = std::sqrt(eos.GetGamma(VcGas(PRS,k,j,i),VcGas(RHO,k,j,i)
-                         *VcGas(PRS,k,j,i)/VcGas(RHO,k,j,i)));
+          cs = std::sqrt(eos.GetGamma(VcGas(PRS,k,j,i),VcGas(RHO,k,j,i))
+                         *VcGas(PRS,k,j,i)/VcGas(RHO,k,j,i));
         #else
           cs = eos.GetWaveSpeed(k,j,i);
         #endif
@@ -79,6 +71,16 @@ void Drag::AddDragForce(const real dt) {
   idfx::popRegion();
 }
 
+void Drag::ComputeUserDrag() {
+  if(userDrag != NULL) {
+    idfx::pushRegion("Drag::UserDrag");
+    userDrag(data, dragCoeff, gammai);
+    idfx::popRegion();
+  } else {
+    IDEFIX_ERROR("No User-defined drag function has been enrolled");
+  }
+}
+
 void Drag::ShowConfig() {
   idfx::cout << "Drag: Using ";
   switch(type) {
@@ -26,15 +26,19 @@ class Drag {
   void AddDragForce(const real);
   void EnrollUserDrag(UserDefDragFunc);   // User defined drag function enrollment
 
-  IdefixArray4D<real> UcDust;  // Dust conservative quantities
-  IdefixArray4D<real> UcGas;  // Gas conservative quantities
-  IdefixArray4D<real> VcDust;  // Gas primitive quantities
-  IdefixArray4D<real> VcGas;  // Gas primitive quantities
+  IdefixArray4D<realStore> UcDust;  // Dust conservative quantities
+  IdefixArray4D<realStore> UcGas;  // Gas conservative quantities
+  IdefixArray4D<realStore> VcDust;  // Gas primitive quantities
+  IdefixArray4D<realStore> VcGas;  // Gas primitive quantities
   IdefixArray3D<real> InvDt;  // The InvDt of current dust specie
   IdefixArray3D<real> gammai; // the drag coefficient (only used for user-defined dust grains)
   Type type;
 
  private:
+  friend class DustBatch;
+
+  void ComputeUserDrag();   // Fill gammai with the user-defined drag function
+
   DataBlock* data;
   real dragCoeff;
   bool feedback{false};
@@ -13,29 +13,70 @@
 template<typename Phys>
 template<int dir>
 void Fluid<Phys>::LoopDir(const real t, const real dt) {
-    // Step 2: compute the intercell flux with our Riemann solver, store the resulting InvDt
-    this->rSolver->template CalcFlux<dir>(this->FluxRiemann);
+    if(haveFusedSweep) {
+      // Steps 2 & 3 in a single pass, without storing the intercell flux
+      CalcFusedRightHandSide<dir>(t,dt);
+    } else {
+      // Step 2: compute the intercell flux with our Riemann solver, store the resulting InvDt
+      this->rSolver->template CalcFlux<dir>(this->FluxRiemann);
+
+      // Step 2.5: compute intercell parabolic flux when needed
+      if(haveExplicitParabolicTerms) CalcParabolicFlux<dir>(t);
+
+      // If we have tracers, compute the tracer intercell flux
+      if(haveTracer) {
+        this->tracer->template CalcFlux<dir, Phys>(this->FluxRiemann);
+      }
+
+      // Step 3: compute the resulting evolution of the conserved variables, stored in Uc
+      CalcRightHandSide<dir>(t,dt);
+      if(haveTracer) {
+        this->tracer->template CalcRightHandSide<dir, Phys>(this->FluxRiemann,t ,dt);
+      }
+    }
+
+    // Recursive: do next dimension
+    if constexpr (dir+1 < DIMENSIONS) LoopDir<dir+1>(t, dt);
+}
+
+// Fill the ghost zones one direction after the other, and update the interior of the domain
+// (which does not depend on the ghost zones) in each direction while the corresponding MPI
+// messages are in flight. The skin of the domain is updated afterwards in EvolveStage.
+// With the neighbour exchange, the ghost zones are all exchanged at once around this loop.
+template<typename Phys>
+template<int dir>
+void Fluid<Phys>::LoopDirOverlap(const real t, const real dt) {
+    if(!data->haveNeighbourExchange) boundary->StartBoundaryDir(dir);
+
+    this->rSolver->template CalcFlux<dir>(this->FluxRiemann, SweepRegion::interior);
+    CalcRightHandSide<dir>(t, dt, SweepRegion::interior);
+
+    if(!data->haveNeighbourExchange) boundary->FinishBoundaryDir(t, dir);
+
+    // Recursive: do next dimension
+    if constexpr (dir+1 < DIMENSIONS) LoopDirOverlap<dir+1>(t, dt);
+}
+
 
-    // Step 2.5: compute intercell parabolic flux when needed
-    if(haveExplicitParabolicTerms) CalcParabolicFlux<dir>(t);
 
-    // If we have tracers, compute the tracer intercell flux
+// Sweep the cells of a tile in every direction. The faces of the tile are computed again by the
+// sweeps of the neighbouring tiles, since the flux array is shared between directions.
+template<typename Phys>
+template<int dir>
+void Fluid<Phys>::LoopDirTile(const real t, const real dt, const IndexBox &tile) {
+    this->rSolver->template CalcFlux<dir>(this->FluxRiemann, tile);
     if(haveTracer) {
-      this->tracer->template CalcFlux<dir, Phys>(this->FluxRiemann);
+      this->tracer->template CalcFlux<dir, Phys>(this->FluxRiemann, tile);
     }
-
-    // Step 3: compute the resulting evolution of the conserved variables, stored in Uc
-    CalcRightHandSide<dir>(t,dt);
+    CalcRightHandSide<dir>(t, dt, tile);
     if(haveTracer) {
-      this->tracer->template CalcRightHandSide<dir, Phys>(this->FluxRiemann,t ,dt);
+      this->tracer->template CalcRightHandSide<dir, Phys>(this->FluxRiemann, t, dt, tile);
     }
 
     // Recursive: do next dimension
-    if constexpr (dir+1 < DIMENSIONS) LoopDir<dir+1>(t, dt);
+    if constexpr (dir+1 < DIMENSIONS) LoopDirTile<dir+1>(t, dt, tile);
 }
 
-
-
 // Evolve one step forward in time of hydro
 template<typename Phys>
 void Fluid<Phys>::EvolveStage(const real t, const real dt) {
@@ -43,7 +84,8 @@ void Fluid<Phys>::EvolveStage(const real t, const real dt) {
   // Compute current when needed
   if(needExplicitCurrent) CalcCurrent();
 
-  if(hallStatus.status == UserDefFunction) {
+  // (the subcycled Hall effect computes its diffusivity in HallSubcycle::Cycle)
+  if(hallStatus.status == UserDefFunction && hallStatus.isExplicit) {
     if(hallDiffusivityFunc)
       hallDiffusivityFunc(*data, t, xHall);
     else
@@ -55,13 +97,49 @@ void Fluid<Phys>::EvolveStage(const real t, const real dt) {
   }
 
   // Loop on all of the directions
-  LoopDir<IDIR>(t,dt);
+  bool sourceTermsAdded = false;
+  if(haveTiledSweep) {
+    // Each tile is swept in all of the directions and gets its source terms before the next
+    // one, while it is in cache. The operations which are not local to a cell are done once
+    // for all of the tiles.
+    this->rSolver->FindShock();
+    if(data->haveFargo && data->fargo->type == Fargo::userdef) {
+      data->fargo->GetFargoVelocity(t);
+    }
+    // (user-defined source terms work on the whole domain, and come before the others)
+    sourceTermsAdded = haveSourceTerms && !haveUserSourceTerm;
+    for(const IndexBox &tile : tiles) {
+      LoopDirTile<IDIR>(t, dt, tile);
+      if(sourceTermsAdded) AddSourceTerms(t, dt, tile);
+    }
+  } else if(data->haveBoundaryOverlap) {
+    if(data->haveNeighbourExchange) boundary->StartBoundaryAll();
+    LoopDirOverlap<IDIR>(t,dt);
+    if(data->haveNeighbourExchange) boundary->FinishBoundaryAll(t);
+    if constexpr(Phys::mhd) {
+      // Remake the cell-centered field in the ghost zones
+      boundary->ReconstructVcField(Vc);
+    }
+    // Now that the ghost zones are filled, update the skin of the domain
+    this->rSolver->template CalcFlux<IDIR>(this->FluxRiemann, SweepRegion::skin);
+    CalcRightHandSide<IDIR>(t, dt, SweepRegion::skin);
+    #if DIMENSIONS >= 2
+      this->rSolver->template CalcFlux<JDIR>(this->FluxRiemann, SweepRegion::skin);
+      CalcRightHandSide<JDIR>(t, dt, SweepRegion::skin);
+    #endif
+    #if DIMENSIONS == 3
+      this->rSolver->template CalcFlux<KDIR>(this->FluxRiemann, SweepRegion::skin);
+      CalcRightHandSide<KDIR>(t, dt, SweepRegion::skin);
+    #endif
+  } else {
+    LoopDir<IDIR>(t,dt);
+  }
 
   // Step 4: add source terms to the conserved variables (curvature, rotation, etc)
-  if(haveSourceTerms) AddSourceTerms(t, dt);
+  if(haveSourceTerms && !sourceTermsAdded) AddSourceTerms(t, dt);
 
-  // Step 5: add drag when needed
-  if(haveDrag) drag->AddDragForce(dt);
+  // Step 5: add drag when needed (added by the dust batch for all of the species at once)
+  if(haveDrag && !data->haveDustBatch) drag->AddDragForce(dt);
 
   if constexpr(Phys::mhd) {
     #if DIMENSIONS >= 2
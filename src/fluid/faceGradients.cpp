@@ -0,0 +1,84 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include "faceGradients.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+
+void FaceGradients::ShowConfig() {
+  idfx::cout << "FaceGradients: the";
+  if(dV.is_allocated()) idfx::cout << " velocity";
+  if(dV.is_allocated() && dT.is_allocated()) idfx::cout << " and";
+  if(dT.is_allocated()) idfx::cout << " temperature";
+  idfx::cout << " differences across the faces are shared by the parabolic modules."
+             << std::endl;
+}
+
+// Compute the velocity and/or temperature differences across the faces normal to dir, on the
+// faces where the parabolic fluxes are computed
+void FaceGradients::Compute(int dir, bool velocity, bool temperature) {
+  idfx::pushRegion("FaceGradients::Compute");
+  haveVelocity = velocity && dV.is_allocated();
+  haveTemperature = temperature && dT.is_allocated();
+
+  IdefixArray4D<realStore> Vc = this->Vc;
+  IdefixArray4D<real> dV = this->dV;
+  IdefixArray3D<real> dT = this->dT;
+
+  int ibeg = data->beg[IDIR];
+  int iend = data->end[IDIR];
+  int jbeg = data->beg[JDIR];
+  int jend = data->end[JDIR];
+  int kbeg = data->beg[KDIR];
+  int kend = data->end[KDIR];
+
+  if(dir==IDIR) iend++;
+  if(dir==JDIR) jend++;
+  if(dir==KDIR) kend++;
+
+  if(haveVelocity) {
+    idefix_for("FaceGradients_Velocity",kbeg, kend, jbeg, jend, ibeg, iend,
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        for(int n = VX1 ; n < VX1+COMPONENTS ; n++) {
+          if(dir == IDIR) {
+            dV(IDIR*COMPONENTS+n-VX1,k,j,i) = FACE_DX_I(Vc,n);
+            #if DIMENSIONS >= 2
+              dV(JDIR*COMPONENTS+n-VX1,k,j,i) = FACE_DY_I(Vc,n);
+            #endif
+            #if DIMENSIONS == 3
+              dV(KDIR*COMPONENTS+n-VX1,k,j,i) = FACE_DZ_I(Vc,n);
+            #endif
+          } else if(dir == JDIR) {
+            dV(IDIR*COMPONENTS+n-VX1,k,j,i) = FACE_DX_J(Vc,n);
+            dV(JDIR*COMPONENTS+n-VX1,k,j,i) = FACE_DY_J(Vc,n);
+            #if DIMENSIONS == 3
+              dV(KDIR*COMPONENTS+n-VX1,k,j,i) = FACE_DZ_J(Vc,n);
+            #endif
+          } else {
+            dV(IDIR*COMPONENTS+n-VX1,k,j,i) = FACE_DX_K(Vc,n);
+            dV(JDIR*COMPONENTS+n-VX1,k,j,i) = FACE_DY_K(Vc,n);
+            dV(KDIR*COMPONENTS+n-VX1,k,j,i) = FACE_DZ_K(Vc,n);
+          }
+        }
+      });
+  }
+
+  #if HAVE_ENERGY
+  if(haveTemperature) {
+    const int ioffset = (dir==IDIR) ? 1 : 0;
+    const int joffset = (dir==JDIR) ? 1 : 0;
+    const int koffset = (dir==KDIR) ? 1 : 0;
+
+    idefix_for("FaceGradients_Temperature",kbeg, kend, jbeg, jend, ibeg, iend,
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        dT(k,j,i) = Vc(PRS,k,j,i) / Vc(RHO,k,j,i)
+                  - Vc(PRS,k-koffset,j-joffset,i-ioffset) / Vc(RHO,k-koffset,j-joffset,i-ioffset);
+      });
+  }
+  #endif
+  idfx::popRegion();
+}
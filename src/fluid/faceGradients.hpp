@@ -0,0 +1,107 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_FACEGRADIENTS_HPP_
+#define FLUID_FACEGRADIENTS_HPP_
+
+#include "idefix.hpp"
+#include "input.hpp"
+#include "fluid_defs.hpp"
+
+// Forward class hydro declaration
+template <typename Phys> class Fluid;
+class DataBlock;
+
+// Differences of the velocity (and temperature) across the faces normal to one direction,
+// shared by the parabolic modules which need the same ones in the same call of
+// Fluid::CalcParabolicFlux: the viscosity and the braginskii viscosity (without slope limiter)
+// use the full velocity gradient tensor, the thermal diffusion and the braginskii thermal
+// diffusion the normal temperature gradient. The differences are computed in a single pass
+// before the flux kernels, which read them instead of computing them again from Vc. They are
+// raw differences (not divided by the cell widths), so that each module keeps its own metric.
+class FaceGradients {
+ public:
+  template <typename Phys>
+  FaceGradients(Fluid<Phys> *, bool, bool);
+  void Compute(int, bool, bool);   // Fill the differences across the faces normal to dir
+  void ShowConfig();
+
+  IdefixArray4D<real> dV;   // Velocity: dV(b*COMPONENTS+n,k,j,i) is the difference of VX1+n
+                            // along b (IDIR, JDIR or KDIR)
+  IdefixArray3D<real> dT;   // Temperature (PRS/RHO) along the normal direction
+  bool haveVelocity{false};     // whether dV is shared in the current call
+  bool haveTemperature{false};  // whether dT is shared in the current call
+
+ private:
+  DataBlock *data;
+  IdefixArray4D<realStore> &Vc;
+};
+
+// Differences of the variable n of q across the faces. FACE_DX_I is the difference along X at
+// the faces normal to I, the transverse differences being averaged over the 4 neighbours.
+#define FACE_DX_I(q,n)  (q(n,k,j,i) - q(n,k,j,i - 1))
+#define FACE_DY_J(q,n)  (q(n,k,j,i) - q(n,k,j - 1,i))
+#define FACE_DZ_K(q,n)  (q(n,k,j,i) - q(n,k - 1,j,i))
+
+#define FACE_DY_I(q,n)  (  0.25*(q(n,k,j + 1,i) + q(n,k,j + 1,i - 1)) \
+                         - 0.25*(q(n,k,j - 1,i) + q(n,k,j - 1,i - 1)))
+
+#define FACE_DZ_I(q,n)  (  0.25*(q(n,k + 1,j,i) + q(n,k + 1,j,i - 1))  \
+                         - 0.25*(q(n,k - 1,j,i) + q(n,k - 1,j,i - 1)))
+
+#define FACE_DX_J(q,n)  (  0.25*(q(n,k,j,i + 1) + q(n,k,j - 1,i + 1)) \
+                         - 0.25*(q(n,k,j,i - 1) + q(n,k,j - 1,i - 1)))
+
+#define FACE_DZ_J(q,n)  (  0.25*(q(n,k + 1,j,i) + q(n,k + 1,j - 1,i)) \
+                         - 0.25*(q(n,k - 1,j,i) + q(n,k - 1,j - 1,i)))
+
+#define FACE_DX_K(q,n)  (  0.25*(q(n,k,j,i + 1) + q(n,k - 1,j,i + 1)) \
+                         - 0.25*(q(n,k,j,i - 1) + q(n,k - 1,j,i - 1)))
+
+#define FACE_DY_K(q,n)  (  0.25*(q(n,k,j + 1,i) + q(n,k - 1,j + 1,i)) \
+                         - 0.25*(q(n,k,j - 1,i) + q(n,k - 1,j - 1,i)))
+
+// Velocity differences used by the viscous fluxes: read from FaceGradients::dV when it is
+// shared (haveFaceDV), computed from q otherwise
+#define FACE_DV(n,b)  dV((b)*COMPONENTS+(n)-VX1,k,j,i)
+
+#define D_DX_I(q,n)  (haveFaceDV ? FACE_DV(n,IDIR) : FACE_DX_I(q,n))
+#define D_DY_J(q,n)  (haveFaceDV ? FACE_DV(n,JDIR) : FACE_DY_J(q,n))
+#define D_DZ_K(q,n)  (haveFaceDV ? FACE_DV(n,KDIR) : FACE_DZ_K(q,n))
+#define D_DY_I(q,n)  (haveFaceDV ? FACE_DV(n,JDIR) : FACE_DY_I(q,n))
+#define D_DZ_I(q,n)  (haveFaceDV ? FACE_DV(n,KDIR) : FACE_DZ_I(q,n))
+#define D_DX_J(q,n)  (haveFaceDV ? FACE_DV(n,IDIR) : FACE_DX_J(q,n))
+#define D_DZ_J(q,n)  (haveFaceDV ? FACE_DV(n,KDIR) : FACE_DZ_J(q,n))
+#define D_DX_K(q,n)  (haveFaceDV ? FACE_DV(n,IDIR) : FACE_DX_K(q,n))
+#define D_DY_K(q,n)  (haveFaceDV ? FACE_DV(n,JDIR) : FACE_DY_K(q,n))
+
+#include "fluid.hpp"
+#include "dataBlock.hpp"
+
+template <typename Phys>
+FaceGradients::FaceGradients(Fluid<Phys> *hydroin, bool velocity, bool temperature):
+                            data(hydroin->data),
+                            Vc(hydroin->Vc) {
+  idfx::pushRegion("FaceGradients::FaceGradients");
+  // The buffers are live during the parabolic fluxes of the stages and of the RKL cycle
+  const int phases = ScratchArena::Stage | ScratchArena::RKL;
+  if(velocity) {
+    dV = data->scratch->Get4D<real>(phases, "FaceGradients_dV", COMPONENTS*DIMENSIONS,
+                                    data->np_tot[KDIR],
+                                    data->np_tot[JDIR],
+                                    data->np_tot[IDIR]);
+  }
+  if(temperature) {
+    dT = data->scratch->Get3D<real>(phases, "FaceGradients_dT",
+                                    data->np_tot[KDIR],
+                                    data->np_tot[JDIR],
+                                    data->np_tot[IDIR]);
+  }
+  idfx::popRegion();
+}
+
+#endif // FLUID_FACEGRADIENTS_HPP_
@@ -8,13 +8,16 @@
 #ifndef FLUID_FLUID_HPP_
 #define FLUID_FLUID_HPP_
 
+#include <array>
 #include <string>
 #include <vector>
 #include <memory>
 
 #include "idefix.hpp"
+#include "profiler.hpp"
 #include "grid.hpp"
 #include "fluid_defs.hpp"
+#include "sweepRegion.hpp"
 #include "eos.hpp"
 #include "thermalDiffusion.hpp"
 #include "bragThermalDiffusion.hpp"
@@ -36,6 +39,9 @@ class ConstrainedTransport;
 template<typename Phys>
 class RKLegendre;
 
+template<typename Phys>
+class HallSubcycle;
+
 template<typename Phys>
 class RiemannSolver;
 
@@ -46,6 +52,7 @@ class Viscosity;
 class ThermalDiffusion;
 class BragViscosity;
 class BragThermalDiffusion;
+class FaceGradients;
 class Drag;
 class Tracer;
 
@@ -58,16 +65,19 @@ class Fluid {
   void ConvertPrimToCons();
   template <int> void CalcParabolicFlux(const real);
   template <int> void AddNonIdealMHDFlux(const real);
-  template <int> void CalcRightHandSide(real, real );
+  template <int> void CalcRightHandSide(real, real, const SweepRegion = SweepRegion::all);
+  template <int> void CalcRightHandSide(real, real, const IndexBox &);
+  template <int> void CalcFusedRightHandSide(real, real );
   void CalcCurrent();
   void AddSourceTerms(real, real );
-  void CoarsenFlow(IdefixArray4D<real>&);
+  void AddSourceTerms(real, real, const IndexBox &);
+  void CoarsenFlow(IdefixArray4D<realStore>&);
   void CoarsenMagField(IdefixArray4D<real>&);
   real CheckDivB();
   void EvolveStage(const real, const real);
   void ResetStage();
   void ShowConfig();
-  IdefixArray4D<real> GetFlux() {return this->FluxRiemann;}
+  IdefixArray4D<realStore> GetFlux() {return this->FluxRiemann;}
   int CheckNan();
 
   // Our boundary conditions
@@ -83,8 +93,20 @@ class Fluid {
   bool haveExplicitParabolicTerms{false};
   bool haveRKLParabolicTerms{false};
 
+  // Fused directional sweep
+  bool haveFusedSweep{false};
+
+  // Tiled sweeps (cache blocking of the stage)
+  bool haveTiledSweep{false};
+  std::array<int,3> tileSize{0,0,0};
+  std::vector<IndexBox> tiles;
+
   std::unique_ptr<RKLegendre<Phys>> rkl;
 
+  // Hall effect integrated in subcycles of the hyperbolic timestep
+  bool haveHallSubcycle{false};
+  std::unique_ptr<HallSubcycle<Phys>> hallSubcycle;
+
   // Current
   bool haveCurrent{false};
   bool needExplicitCurrent{false};
@@ -117,6 +139,9 @@ class Fluid {
   // Braginskii Thermal Diffusion object
   std::unique_ptr<BragThermalDiffusion> bragThermalDiffusion;
 
+  // Face differences shared by the parabolic modules (only with shareGradients)
+  std::unique_ptr<FaceGradients> faceGradients;
+
   // Drag object
   bool haveDrag{false};
   std::unique_ptr<Drag> drag;
@@ -164,10 +189,10 @@ class Fluid {
 
 
   // Arrays required by the Hydro object
-  IdefixArray4D<real> Vc;      // Main cell-centered primitive variables index
+  IdefixArray4D<realStore> Vc; // Main cell-centered primitive variables index
   IdefixArray4D<real> Vs;      // Main face-centered varariables
   IdefixArray4D<real> Ve;      // Main edge-centered varariables (only when EVOLVE_VECTOR_POTENTIAL)
-  IdefixArray4D<real> Uc;      // Main cell-centered conservative variables
+  IdefixArray4D<realStore> Uc; // Main cell-centered conservative variables
   IdefixArray4D<real> J;       // Electrical current
                                // (only defined when non-ideal MHD effects are enabled)
 
@@ -182,7 +207,7 @@ class Fluid {
   // Required by time integrator
   IdefixArray3D<real> InvDt;
 
-  IdefixArray4D<real> FluxRiemann;
+  IdefixArray4D<realStore> FluxRiemann;
   IdefixArray3D<real> dMax;    // Maximum diffusion speed
 
   std::unique_ptr<RiemannSolver<Phys>> rSolver;
@@ -197,6 +222,7 @@ class Fluid {
   friend class ConstrainedTransport<Phys>;
   friend class Fargo;
   friend class RKLegendre<Phys>;
+  friend class HallSubcycle<Phys>;
   friend class Boundary<Phys>;
   friend class ShockFlattening<Phys>;
   friend class RiemannSolver<Phys>;
@@ -218,6 +244,9 @@ class Fluid {
   template<typename P>
   friend struct ShockFlattening_FindShockFunctor;
 
+  template<typename P, int dir>
+  friend struct RiemannSolver_HllMHDFunctor;
+
   // Emf boundary conditions
   bool haveEmfBoundary{false};
   EmfBoundaryFunc emfBoundaryFunc{NULL};
@@ -244,6 +273,14 @@ class Fluid {
   // Loop on dimensions
   template <int dir>
   void LoopDir(const real, const real);
+
+  // Loop on dimensions, overlapping the ghost zone exchange with the update of the interior
+  template <int dir>
+  void LoopDirOverlap(const real, const real);
+
+  // Loop on dimensions, on the cells of a tile only
+  template <int dir>
+  void LoopDirTile(const real, const real, const IndexBox &);
 };
 
 #include "physics.hpp"
@@ -252,9 +289,11 @@ class Fluid {
 #include "constrainedTransport.hpp"
 #include "axis.hpp"
 #include "rkl.hpp"
+#include "hallSubcycle.hpp"
 #include "riemannSolver.hpp"
 #include "viscosity.hpp"
 #include "bragViscosity.hpp"
+#include "faceGradients.hpp"
 #include "drag.hpp"
 #include "checkNan.hpp"
 #include "tracer.hpp"
@@ -501,8 +540,11 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
         if(opType.compare("explicit") == 0 ) {
           hallStatus.isExplicit = true;
           needExplicitCurrent = true;
+        } else if(opType.compare("subcycle") == 0 ) {
+          hallStatus.isSubcycled = true;
+          haveHallSubcycle = true;
         } else if(opType.compare("rkl") == 0 ) {
-          IDEFIX_ERROR("RKL inegration is incompatible with Hall");
+          IDEFIX_ERROR("RKL inegration is incompatible with Hall. Use subcycle instead.");
         } else {
           std::stringstream msg;
           msg  << "Unknown integration type for hall: " << opType;
@@ -521,36 +563,81 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     }
   } // MHD
 
+  // Fused directional sweep (Riemann fluxes and flux divergence computed in a single pass)
+  haveFusedSweep = input.GetOrSet<bool>(std::string(Phys::prefix),"fusedSweep",0, false);
+  if(haveFusedSweep) {
+    if(haveExplicitParabolicTerms) {
+      IDEFIX_ERROR("Fused sweep is incompatible with explicit parabolic terms. "
+                   "Use rkl integration for these terms instead.");
+    }
+    if(haveTracer) {
+      IDEFIX_ERROR("Fused sweep is incompatible with passive tracers.");
+    }
+  }
+
+  // Tiled sweeps: the stage is computed tile by tile, each tile holding at most tileSize cells
+  // in each direction (the size of the first direction being used for the missing ones)
+  if(input.CheckEntry(std::string(Phys::prefix),"tileSize")>=0) {
+    haveTiledSweep = true;
+    for(int dir = 0 ; dir < 3 ; dir++) {
+      tileSize[dir] = data->np_int[dir];
+      if(dir < DIMENSIONS) {
+        tileSize[dir] = input.GetOrSet<int>(std::string(Phys::prefix),"tileSize",dir,
+                                            tileSize[IDIR]);
+      }
+      if(tileSize[dir] < 1) {
+        IDEFIX_ERROR("tileSize should be positive");
+      }
+    }
+    tiles = MakeTiles(data->beg, data->end, tileSize);
+    if(haveFusedSweep) {
+      IDEFIX_ERROR("Tiled sweeps are incompatible with fused sweeps.");
+    }
+    if(haveExplicitParabolicTerms) {
+      IDEFIX_ERROR("Tiled sweeps are incompatible with explicit parabolic terms. "
+                   "Use rkl integration for these terms instead.");
+    }
+  }
+
   /////////////////////////////////////////
   //  ALLOCATION SECION ///////////////////
   /////////////////////////////////////////
 
   // We now allocate the fields required by the hydro solver
-  Vc = IdefixArray4D<real>(prefix+"_Vc", Phys::nvar+nTracer,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  Uc = IdefixArray4D<real>(prefix+"_Uc", Phys::nvar+nTracer,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  if(Phys::dust && data->haveDustBatch) {
+    // The dust species are views of the shared arrays of the dust batch
+    data->dustBatch->Allocate(Phys::nvar+nTracer);
+    Vc = data->dustBatch->GetVc(instanceNumber);
+    Uc = data->dustBatch->GetUc(instanceNumber);
+    InvDt = data->dustBatch->GetInvDt(instanceNumber);
+  } else {
+    Vc = IdefixArray4D<realStore>(prefix+"_Vc", IdefixLayout4D(Phys::nvar+nTracer,
+                             data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
+    Uc = IdefixArray4D<realStore>(prefix+"_Uc", IdefixLayout4D(Phys::nvar+nTracer,
+                             data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
+    InvDt = IdefixArray3D<real>(prefix+"_InvDt",
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  }
 
   data->states["current"].PushArray(Uc, State::center, prefix+"_Uc");
 
-  InvDt = IdefixArray3D<real>(prefix+"_InvDt",
-                              data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
   cMax = IdefixArray3D<real>(prefix+"_cMax",
                               data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
   dMax = IdefixArray3D<real>(prefix+"_dMax",
                               data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  FluxRiemann =  IdefixArray4D<real>(prefix+"_FluxRiemann", Phys::nvar+nTracer,
-                                     data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  FluxRiemann =  IdefixArray4D<realStore>(prefix+"_FluxRiemann",
+                                          IdefixLayout4D(Phys::nvar+nTracer, data->np_tot[KDIR],
+                                                         data->np_tot[JDIR], data->np_tot[IDIR]));
 
   if constexpr(Phys::mhd) {
-    Vs = IdefixArray4D<real>(prefix+"_Vs", DIMENSIONS,
-              data->np_tot[KDIR]+KOFFSET, data->np_tot[JDIR]+JOFFSET, data->np_tot[IDIR]+IOFFSET);
+    Vs = IdefixArray4D<real>(prefix+"_Vs", IdefixLayout4D(DIMENSIONS,
+              data->np_tot[KDIR]+KOFFSET, data->np_tot[JDIR]+JOFFSET, data->np_tot[IDIR]+IOFFSET));
     #ifdef EVOLVE_VECTOR_POTENTIAL
       #if DIMENSIONS == 1
         IDEFIX_ERROR("EVOLVE_VECTOR_POTENTIAL is not compatible with 1D MHD");
       #else
-        Ve = IdefixArray4D<real>(prefix+"_Ve", AX3e+1,
-              data->np_tot[KDIR]+KOFFSET, data->np_tot[JDIR]+JOFFSET, data->np_tot[IDIR]+IOFFSET);
+        Ve = IdefixArray4D<real>(prefix+"_Ve", IdefixLayout4D(AX3e+1,
+              data->np_tot[KDIR]+KOFFSET, data->np_tot[JDIR]+JOFFSET, data->np_tot[IDIR]+IOFFSET));
 
         data->states["current"].PushArray(Ve, State::center, prefix+"_Ve");
       #endif
@@ -561,8 +648,8 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
 
   if(this->haveCurrent) {
     // Allocate current (when hydro needs it)
-    J = IdefixArray4D<real>(prefix+"_J", 3,
-                            data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+    J = IdefixArray4D<real>(prefix+"_J", IdefixLayout4D(3,
+                            data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
   }
 
   // Allocate nonideal MHD effects array when a user-defined function is used
@@ -693,6 +780,25 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
   }
 
 
+  // Estimated cost of one call of the main regions of the gas, from which the profiler reports
+  // the achieved bandwidth (the dust species share the names of these regions)
+  if(prefix.compare("Hydro") == 0) {
+    const double ncells = static_cast<double>(data->np_tot[IDIR])*data->np_tot[JDIR]
+                                             *data->np_tot[KDIR];
+    const double nv = Phys::nvar+nTracer;
+    const double store = sizeof(realStore);
+    // Read Vc, write the fluxes and the signal speed (the reconstruction dominates the flops)
+    idfx::prof.RegisterCost("RiemannSolver::CalcFlux", ncells*(nv*store + (nv+1)*sizeof(real)),
+                            ncells*(50*nv));
+    // Read the fluxes, update Uc and InvDt
+    idfx::prof.RegisterCost("Fluid::CalcRightHandSide",
+                            ncells*(nv*sizeof(real) + 2*nv*store + 2*sizeof(real)),
+                            ncells*(4*nv+5));
+    // Read Uc (resp. Vc), write Vc (resp. Uc)
+    idfx::prof.RegisterCost("Fluid::ConvertConsToPrim", ncells*2*nv*store, ncells*(2*nv+5));
+    idfx::prof.RegisterCost("Fluid::ConvertPrimToCons", ncells*2*nv*store, ncells*(2*nv+5));
+  }
+
   //*******************************************
   //** Child object allocation section
   //*********************************************
@@ -717,6 +823,10 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     this->rkl = std::make_unique<RKLegendre<Phys>>(input,this);
   }
 
+  if(haveHallSubcycle) {
+    this->hallSubcycle = std::make_unique<HallSubcycle<Phys>>(input,this);
+  }
+
   // Thermal diffusion
   if(thermalDiffusionStatus.status != Disabled ) {
     this->thermalDiffusion = std::make_unique<ThermalDiffusion>(input, grid, this);
@@ -737,6 +847,22 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     this->bragViscosity = std::make_unique<BragViscosity>(input, grid, this);
   }
 
+  // Face differences shared by the parabolic modules integrated together (explicitly or in the
+  // RKL cycle), which would otherwise compute them twice
+  if(input.GetOrSet<bool>(std::string(Phys::prefix),"shareGradients",0, false)) {
+    auto together = [](const ParabolicModuleStatus &a, const ParabolicModuleStatus &b) {
+      return (a.isExplicit && b.isExplicit) || (a.isRKL && b.isRKL);
+    };
+    const bool shareVelocity = viscosity && bragViscosity
+                               && together(viscosityStatus, bragViscosityStatus);
+    const bool shareTemperature = thermalDiffusion && bragThermalDiffusion
+                               && together(thermalDiffusionStatus, bragThermalDiffusionStatus);
+    if(shareVelocity || shareTemperature) {
+      this->faceGradients = std::make_unique<FaceGradients>(this, shareVelocity,
+                                                                  shareTemperature);
+    }
+  }
+
 
   // Drag force when needed
   if(haveDrag) {
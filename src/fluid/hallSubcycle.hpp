@@ -0,0 +1,277 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_HALLSUBCYCLE_HPP_
+#define FLUID_HALLSUBCYCLE_HPP_
+
+#include <vector>
+
+#include "idefix.hpp"
+#include "input.hpp"
+#include "dataBlock.hpp"
+#ifdef WITH_MPI
+#include "mpi.hpp"
+#endif
+
+// Operator-split integration of the Hall term of the induction equation. The face-centered
+// field is evolved by the hyperbolic timestep with the Hall EMF only, in substeps of the Hall
+// (whistler) timestep, the other variables being left untouched. Each substep is a 3rd order
+// SSP Runge-Kutta step, which is stable for the imaginary eigenvalues of the Hall operator.
+// Since the Hall EMF is perpendicular to the current, the Hall term does no work on the gas:
+// the pressure is kept and the total energy follows the magnetic energy.
+template<typename Phys>
+class HallSubcycle {
+ public:
+  HallSubcycle(Input &, Fluid<Phys>*);
+  void Cycle();
+  void ShowConfig();
+
+  real dt{0};           // Hall timestep of the last cycle
+  real cfl;             // CFL number of the substeps
+  real nmax;            // Maximum # of substeps per hyperbolic timestep
+  int nsteps{0};        // # of substeps of the last cycle
+
+ private:
+  void ComputeDt();
+  void EvolveStage(real, real);   // Add dt*(Hall induction) to the field
+  void SetBoundaries(real);       // Enforce boundary conditions on the field
+
+  DataBlock *data;
+  Fluid<Phys> *hydro;
+
+#ifdef WITH_MPI
+  Mpi mpi;                        // Exchange of the field only
+#endif
+
+  #ifdef EVOLVE_VECTOR_POTENTIAL
+  IdefixArray4D<real> Ve0;        // Ve at the beginning of the substep
+  #else
+  IdefixArray4D<real> Vs0;        // Vs at the beginning of the substep
+  #endif
+};
+
+#include "fluid.hpp"
+
+template<typename Phys>
+HallSubcycle<Phys>::HallSubcycle(Input &input, Fluid<Phys>* hydroin) {
+  idfx::pushRegion("HallSubcycle::Init");
+  this->data = hydroin->data;
+  this->hydro = hydroin;
+
+  cfl = input.GetOrSet<real>("Hall","cfl",0, 0.4);
+  nmax = input.GetOrSet<real>("Hall","nmax",0, 100.0);
+
+  #if COMPONENTS != DIMENSIONS || DIMENSIONS < 2
+    IDEFIX_ERROR("Hall subcycling requires as many field components as dimensions (2 or 3)");
+  #endif
+  if(data->haveGridCoarsening) {
+    IDEFIX_ERROR("Hall subcycling is not compatible with grid coarsening");
+  }
+
+  #ifdef WITH_MPI
+    // No cell-centered variable is exchanged, only the face-centered field
+    std::vector<int> varList;
+    mpi.Init(data->mygrid, varList, data->nghost.data(), data->np_int.data(), true);
+    if(data->haveNeighbourExchange) mpi.InitExchangeAll();
+  #endif
+
+  #ifdef EVOLVE_VECTOR_POTENTIAL
+    Ve0 = data->scratch->Get4D<real>(ScratchArena::Hall, "Hall_Ve0", AX3e+1,
+                      data->np_tot[KDIR]+KOFFSET,
+                      data->np_tot[JDIR]+JOFFSET,
+                      data->np_tot[IDIR]+IOFFSET);
+  #else
+    Vs0 = data->scratch->Get4D<real>(ScratchArena::Hall, "Hall_Vs0", DIMENSIONS,
+                      data->np_tot[KDIR]+KOFFSET,
+                      data->np_tot[JDIR]+JOFFSET,
+                      data->np_tot[IDIR]+IOFFSET);
+  #endif
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void HallSubcycle<Phys>::ShowConfig() {
+  idfx::cout << "HallSubcycle: 3rd order SSP Runge-Kutta substeps with cfl " << cfl << "."
+             << std::endl;
+  idfx::cout << "HallSubcycle: maximum # of substeps per hyperbolic timestep "
+             << nmax << "." << std::endl;
+}
+
+template<typename Phys>
+void HallSubcycle<Phys>::Cycle() {
+  idfx::pushRegion("HallSubcycle::Cycle");
+
+  IdefixArray4D<real> Vs = hydro->Vs;
+  #ifdef EVOLVE_VECTOR_POTENTIAL
+  IdefixArray4D<real> Ve = hydro->Ve;
+  IdefixArray4D<real> X0 = this->Ve0;
+  IdefixArray4D<real> X = Ve;
+  const int nX = AX3e+1;
+  #else
+  IdefixArray4D<real> X0 = this->Vs0;
+  IdefixArray4D<real> X = Vs;
+  const int nX = DIMENSIONS;
+  #endif
+
+  const real dt_hyp = data->dt;
+  real time = data->t;
+
+  data->hallCycle = true;
+
+  SetBoundaries(time);
+
+  if(hydro->hallStatus.status == UserDefFunction) {
+    if(hydro->hallDiffusivityFunc)
+      hydro->hallDiffusivityFunc(*data, time, hydro->xHall);
+    else
+      IDEFIX_ERROR("No user-defined Hall diffusivity function has been enrolled");
+  }
+
+  ComputeDt();
+  nsteps = static_cast<int>(std::ceil(dt_hyp/dt));
+  const real dtSub = dt_hyp/nsteps;
+
+  // Weights of the stages of the SSP-RK3 scheme: X = w0*X0 + (1-w0)*(X + dt*L(X))
+  const real w0[3] = {ZERO_F, 0.75, 1.0/3.0};
+
+  for(int step = 0 ; step < nsteps ; step++) {
+    Kokkos::deep_copy(X0, X);
+    for(int stage = 0 ; stage < 3 ; stage++) {
+      if(step > 0 || stage > 0) SetBoundaries(time);
+      EvolveStage(time, dtSub);
+      const real w = w0[stage];
+      if(stage > 0) {
+        idefix_for("Hall_Combine",
+                0, nX,
+                data->beg[KDIR],data->end[KDIR]+KOFFSET,
+                data->beg[JDIR],data->end[JDIR]+JOFFSET,
+                data->beg[IDIR],data->end[IDIR]+IOFFSET,
+          KOKKOS_LAMBDA (int n, int k, int j, int i) {
+            X(n,k,j,i) = w*X0(n,k,j,i) + (ONE_F-w)*X(n,k,j,i);
+          });
+      }
+      #ifdef EVOLVE_VECTOR_POTENTIAL
+        hydro->emf->ComputeMagFieldFromA(Ve, Vs);
+      #endif
+    }
+    time += dtSub;
+  }
+
+  // Update the ghost zones and the cell-centered field, and make the conservative variables
+  // consistent with the new field (at constant pressure)
+  SetBoundaries(time);
+  hydro->ConvertPrimToCons();
+
+  data->hallCycle = false;
+  idfx::popRegion();
+}
+
+// Largest stable timestep of the Hall term, from the whistler frequency xH |B| k^2 of the
+// smallest wavelength of each direction
+template<typename Phys>
+void HallSubcycle<Phys>::ComputeDt() {
+  idfx::pushRegion("HallSubcycle::ComputeDt");
+
+  IdefixArray4D<realStore> Vc = hydro->Vc;
+  IdefixArray3D<real> xHallArr = hydro->xHall;
+  HydroModuleStatus hall = hydro->hallStatus.status;
+  const real xHConstant = hydro->xH;
+
+  IdefixArray1D<real> dx1 = data->dx[IDIR];
+  IdefixArray1D<real> dx2 = data->dx[JDIR];
+  IdefixArray1D<real> dx3 = data->dx[KDIR];
+  IdefixArray1D<real> x1 = data->x[IDIR];
+  IdefixArray1D<real> rt = data->rt;
+  IdefixArray1D<real> dmu = data->dmu;
+
+  real maxInvDt = ZERO_F;
+  idefix_reduce("Hall_Timestep",
+                data->beg[KDIR], data->end[KDIR],
+                data->beg[JDIR], data->end[JDIR],
+                data->beg[IDIR], data->end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i, real &invDtMax) {
+      const real xH = (hall == UserDefFunction) ? xHallArr(k,j,i) : xHConstant;
+      const real B = std::sqrt(EXPAND(  Vc(BX1,k,j,i)*Vc(BX1,k,j,i)  ,
+                                      + Vc(BX2,k,j,i)*Vc(BX2,k,j,i)  ,
+                                      + Vc(BX3,k,j,i)*Vc(BX3,k,j,i)  ));
+      [[maybe_unused]] real dl1 = dx1(i), dl2 = dx2(j), dl3 = dx3(k);
+      #if GEOMETRY == POLAR
+        dl2 = dl2*x1(i);
+      #elif GEOMETRY == SPHERICAL
+        dl2 = dl2*rt(i);
+        dl3 = dl3*rt(i)*dmu(j)/dx2(j);
+      #endif
+      const real invDt = FABS(xH)*B*(D_EXPAND(  ONE_F/(dl1*dl1)  ,
+                                              + ONE_F/(dl2*dl2)  ,
+                                              + ONE_F/(dl3*dl3)  ));
+      invDtMax = std::fmax(invDt, invDtMax);
+    },
+    Kokkos::Max<real>(maxInvDt));
+
+#ifdef WITH_MPI
+  if(idfx::psize>1) {
+    MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &maxInvDt, 1, realMPI, MPI_MAX, MPI_COMM_WORLD));
+  }
+#endif
+
+  dt = cfl/std::fmax(maxInvDt, SMALL_NUMBER);
+
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void HallSubcycle<Phys>::EvolveStage(real t, real dtStage) {
+  idfx::pushRegion("HallSubcycle::EvolveStage");
+  hydro->CalcCurrent();
+
+  // The EMFs are only made of the Hall EMF
+  Kokkos::deep_copy(hydro->emf->ez, ZERO_F);
+  #if DIMENSIONS == 3
+    Kokkos::deep_copy(hydro->emf->ex, ZERO_F);
+    Kokkos::deep_copy(hydro->emf->ey, ZERO_F);
+  #endif
+  hydro->emf->CalcNonidealEMF(t);
+  hydro->emf->EnforceEMFBoundary();
+
+  #ifdef EVOLVE_VECTOR_POTENTIAL
+    hydro->emf->EvolveVectorPotential(dtStage, hydro->Ve);
+  #else
+    hydro->emf->EvolveMagField(t, dtStage, hydro->Vs);
+  #endif
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void HallSubcycle<Phys>::SetBoundaries(real t) {
+  idfx::pushRegion("HallSubcycle::SetBoundaries");
+  #ifdef WITH_MPI
+  if(data->haveNeighbourExchange && idfx::psize>1) this->mpi.ExchangeAll(hydro->Vc, hydro->Vs);
+  #endif
+  for(int dir=0 ; dir < DIMENSIONS ; dir++ ) {
+    #ifdef WITH_MPI
+    if(data->mygrid->nproc[dir]>1 && !data->haveNeighbourExchange) {
+      switch(dir) {
+        case 0:
+          this->mpi.ExchangeX1(hydro->Vc, hydro->Vs);
+          break;
+        case 1:
+          this->mpi.ExchangeX2(hydro->Vc, hydro->Vs);
+          break;
+        case 2:
+          this->mpi.ExchangeX3(hydro->Vc, hydro->Vs);
+          break;
+      }
+    }
+    #endif
+    hydro->boundary->EnforceBoundaryDir(t, dir);
+    hydro->boundary->ReconstructNormalField(dir);
+  }
+  hydro->boundary->ReconstructVcField(hydro->Vc);
+  idfx::popRegion();
+}
+
+#endif // FLUID_HALLSUBCYCLE_HPP_
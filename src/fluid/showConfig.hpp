@@ -41,7 +41,32 @@ void Fluid<Phys>::ShowConfig() {
     idfx::cout << "4th order (PPM)" << std::endl;
   #endif
 
+  if(haveFusedSweep) {
+    idfx::cout << Phys::prefix << ": Fused directional sweep ENABLED." << std::endl;
+  }
 
+  if(haveTiledSweep) {
+    idfx::cout << Phys::prefix << ": Tiled sweeps ENABLED with " << tiles.size() << " tiles of "
+               << tileSize[IDIR] << "x" << tileSize[JDIR] << "x" << tileSize[KDIR]
+               << " cells." << std::endl;
+  }
+
+  if(data->haveBoundaryOverlap) {
+    // The interior of the domain is updated before the ghost zones are filled
+    if(haveFusedSweep) {
+      IDEFIX_ERROR("The overlap of the ghost zone exchange is incompatible with fused sweeps.");
+    }
+    if(haveTiledSweep) {
+      IDEFIX_ERROR("The overlap of the ghost zone exchange is incompatible with tiled sweeps.");
+    }
+    if(haveExplicitParabolicTerms || needExplicitCurrent) {
+      IDEFIX_ERROR("The overlap of the ghost zone exchange is incompatible with explicit "
+                   "parabolic terms. Use rkl integration for these terms instead.");
+    }
+    if(haveTracer) {
+      IDEFIX_ERROR("The overlap of the ghost zone exchange is incompatible with passive tracers.");
+    }
+  }
 
   if(haveRotation) {
     idfx::cout << Phys::prefix << ": Rotation ENABLED with Omega=" << this->OmegaZ << std::endl;
@@ -118,6 +143,9 @@ void Fluid<Phys>::ShowConfig() {
     }
     if(hallStatus.isExplicit) {
       idfx::cout << Phys::prefix << ": Hall effect uses an explicit time integration." << std::endl;
+    } else if(hallStatus.isSubcycled) {
+      idfx::cout << Phys::prefix << ": Hall effect is integrated in subcycles of the field only."
+                 << std::endl;
     }  else {
       IDEFIX_ERROR("Unknown time integrator for Hall effect");
     }
@@ -146,6 +174,9 @@ void Fluid<Phys>::ShowConfig() {
   if(haveRKLParabolicTerms) {
     rkl->ShowConfig();
   }
+  if(haveHallSubcycle) {
+    hallSubcycle->ShowConfig();
+  }
   if(viscosityStatus.isExplicit || viscosityStatus.isRKL) {
     viscosity->ShowConfig();
   }
@@ -158,6 +189,9 @@ void Fluid<Phys>::ShowConfig() {
   if(bragThermalDiffusionStatus.status != Disabled) {
     bragThermalDiffusion->ShowConfig();
   }
+  if(faceGradients) {
+    faceGradients->ShowConfig();
+  }
   if(haveAxis) {
     boundary->axis->ShowConfig();
   }
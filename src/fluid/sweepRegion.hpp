@@ -0,0 +1,123 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_SWEEPREGION_HPP_
+#define FLUID_SWEEPREGION_HPP_
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+#include "../idefix.hpp"
+
+// Part of the domain covered by a directional sweep. When the ghost zone exchange is overlapped
+// with computations, the interior (which does not depend on the ghost zones) is swept while the
+// MPI messages are in flight, and the skin (the remaining part) once the ghost zones are filled.
+enum class SweepRegion {all, interior, skin};
+
+// Index range [beg,end) in each direction
+struct IndexBox {
+  std::array<int,3> beg;
+  std::array<int,3> end;
+};
+
+// Cells of the active domain which do not depend on the ghost zones, i.e. which are further
+// than nghost cells away from them in every direction.
+inline IndexBox InteriorBox(const std::array<int,3> &beg, const std::array<int,3> &end,
+                            const std::array<int,3> &nghost) {
+  IndexBox box;
+  bool isEmpty = false;
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    box.beg[dir] = beg[dir] + nghost[dir];
+    box.end[dir] = end[dir] - nghost[dir];
+    if(box.end[dir] <= box.beg[dir]) isEmpty = true;
+  }
+  // The domain is too small to have an interior
+  if(isEmpty) box.end = box.beg;
+  return(box);
+}
+
+// Faces normal to faceDir which are swept with the interior cells. In the interior region, these
+// are all of the faces of the interior cells. Since the flux arrays are shared between
+// directions, the faces bounding the interior cells are overwritten by the interior sweep of the
+// next direction, hence they are computed again in the skin region, which only excludes the
+// faces lying strictly inside the interior box.
+inline IndexBox InteriorFaces(const std::array<int,3> &beg, const std::array<int,3> &end,
+                              const std::array<int,3> &nghost, const int faceDir,
+                              const SweepRegion region) {
+  IndexBox box = InteriorBox(beg, end, nghost);
+  if(box.end[faceDir] > box.beg[faceDir]) {
+    if(region == SweepRegion::skin) {
+      box.beg[faceDir] += 1;
+      if(box.end[faceDir] <= box.beg[faceDir]) box.end = box.beg;
+    } else {
+      box.end[faceDir] += 1;
+    }
+  }
+  return(box);
+}
+
+// Tiles of at most size cells in each direction covering the active domain, i varying first.
+// With tiled sweeps, each tile is swept in all of the directions before the next one, so that
+// its working set stays in cache (the faces shared by two tiles are computed by both).
+inline std::vector<IndexBox> MakeTiles(const std::array<int,3> &beg, const std::array<int,3> &end,
+                                       const std::array<int,3> &size) {
+  std::vector<IndexBox> tiles;
+  for(int k = beg[KDIR] ; k < end[KDIR] ; k += size[KDIR]) {
+    for(int j = beg[JDIR] ; j < end[JDIR] ; j += size[JDIR]) {
+      for(int i = beg[IDIR] ; i < end[IDIR] ; i += size[IDIR]) {
+        IndexBox tile;
+        tile.beg = {i, j, k};
+        tile.end = {std::min(i+size[IDIR], end[IDIR]),
+                    std::min(j+size[JDIR], end[JDIR]),
+                    std::min(k+size[KDIR], end[KDIR])};
+        tiles.push_back(tile);
+      }
+    }
+  }
+  return(tiles);
+}
+
+// 3D loop on a region of box: the whole box, the inner box, or the skin of box, which is made
+// of the (at most 6) slabs of box lying outside of inner.
+template <typename Function>
+inline void idefix_for_region(const std::string & NAME, const SweepRegion region,
+                              const IndexBox &box, const IndexBox &inner, Function function) {
+  auto loop = [&] (const int kb, const int ke, const int jb, const int je,
+                   const int ib, const int ie) {
+    if(kb < ke && jb < je && ib < ie) idefix_for(NAME, kb, ke, jb, je, ib, ie, function);
+  };
+
+  const bool haveInner = inner.beg[KDIR] < inner.end[KDIR]
+                      && inner.beg[JDIR] < inner.end[JDIR]
+                      && inner.beg[IDIR] < inner.end[IDIR];
+
+  if(region == SweepRegion::all || (region == SweepRegion::skin && !haveInner)) {
+    loop(box.beg[KDIR], box.end[KDIR], box.beg[JDIR], box.end[JDIR], box.beg[IDIR], box.end[IDIR]);
+  } else if(region == SweepRegion::interior) {
+    loop(inner.beg[KDIR], inner.end[KDIR], inner.beg[JDIR], inner.end[JDIR],
+         inner.beg[IDIR], inner.end[IDIR]);
+  } else {
+    // Slabs below and above the inner box in k
+    loop(box.beg[KDIR], inner.beg[KDIR], box.beg[JDIR], box.end[JDIR],
+         box.beg[IDIR], box.end[IDIR]);
+    loop(inner.end[KDIR], box.end[KDIR], box.beg[JDIR], box.end[JDIR],
+         box.beg[IDIR], box.end[IDIR]);
+    // Slabs below and above the inner box in j
+    loop(inner.beg[KDIR], inner.end[KDIR], box.beg[JDIR], inner.beg[JDIR],
+         box.beg[IDIR], box.end[IDIR]);
+    loop(inner.beg[KDIR], inner.end[KDIR], inner.end[JDIR], box.end[JDIR],
+         box.beg[IDIR], box.end[IDIR]);
+    // Slabs below and above the inner box in i
+    loop(inner.beg[KDIR], inner.end[KDIR], inner.beg[JDIR], inner.end[JDIR],
+         box.beg[IDIR], inner.beg[IDIR]);
+    loop(inner.beg[KDIR], inner.end[KDIR], inner.beg[JDIR], inner.end[JDIR],
+         inner.end[IDIR], box.end[IDIR]);
+  }
+}
+
+#endif // FLUID_SWEEPREGION_HPP_
@@ -13,6 +13,7 @@
 #include "dataBlock.hpp"
 #include "fluid.hpp"
 #include "eos.hpp"
+#include "faceGradients.hpp"
 
 
 
@@ -51,9 +52,10 @@ void ThermalDiffusion::EnrollThermalDiffusivity(DiffusivityFunc myFunc) {
 // (this avoids an extra array)
 // Associated source terms, present in non-cartesian geometry are also computed
 // and stored in this->viscSrc for later use (in calcRhs).
-void ThermalDiffusion::AddDiffusiveFlux(int dir, const real t, const IdefixArray4D<real> &Flux) {
+void ThermalDiffusion::AddDiffusiveFlux(int dir, const real t,
+                                        const IdefixArray4D<realStore> &Flux) {
   idfx::pushRegion("ThermalDiffusion::AddDiffusiveFlux");
-  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<realStore> Vc = this->Vc;
   IdefixArray3D<real> dMax = this->dMax;
   IdefixArray3D<real> kappaArr = this->kappaArr;
   IdefixArray1D<real> dx = this->data->dx[dir];
@@ -70,6 +72,11 @@ void ThermalDiffusion::AddDiffusiveFlux(int dir, const real t, const IdefixArray
 
   HydroModuleStatus haveThermalDiffusion = this->status.status;
 
+  // Temperature differences computed once for the thermal and braginskii thermal diffusions
+  const bool haveFaceDT = faceGradients && faceGradients->haveTemperature;
+  IdefixArray3D<real> dT;
+  if(haveFaceDT) dT = faceGradients->dT;
+
   // Compute thermal diffusion if needed
   if(haveThermalDiffusion == UserDefFunction && dir == IDIR) {
     if(diffusivityFunc) {
@@ -105,8 +112,12 @@ void ThermalDiffusion::AddDiffusiveFlux(int dir, const real t, const IdefixArray
         // Compute gradT
         real gradT;
 
-        gradT = Vc(PRS,k,j,i) / Vc(RHO,k,j,i)
-               - Vc(PRS,k-koffset,j-joffset,i-ioffset) / Vc(RHO,k-koffset,j-joffset,i-ioffset);
+        if(haveFaceDT) {
+          gradT = dT(k,j,i);
+        } else {
+          gradT = Vc(PRS,k,j,i) / Vc(RHO,k,j,i)
+                 - Vc(PRS,k-koffset,j-joffset,i-ioffset) / Vc(RHO,k-koffset,j-joffset,i-ioffset);
+        }
 
         // index along dir
         const int ig = ioffset*i + joffset*j + koffset*k;
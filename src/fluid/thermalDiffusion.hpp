@@ -9,6 +9,7 @@
 #define FLUID_THERMALDIFFUSION_HPP_
 
 #include <string>
+#include <memory>
 
 #include "idefix.hpp"
 #include "input.hpp"
@@ -21,6 +22,7 @@
 template <typename Phys> class Fluid;
 
 class DataBlock;
+class FaceGradients;
 
 class ThermalDiffusion {
  public:
@@ -29,7 +31,7 @@ class ThermalDiffusion {
 
   void ShowConfig(); // display configuration
 
-  void AddDiffusiveFlux(int, const real, const IdefixArray4D<real> &);
+  void AddDiffusiveFlux(int, const real, const IdefixArray4D<realStore> &);
 
   // Enroll user-defined viscous diffusivity
   void EnrollThermalDiffusivity(DiffusivityFunc);
@@ -49,9 +51,12 @@ class ThermalDiffusion {
   DiffusivityFunc diffusivityFunc;
 
   // helper array
-  IdefixArray4D<real> &Vc;
+  IdefixArray4D<realStore> &Vc;
   IdefixArray3D<real> &dMax;
 
+  // Temperature differences shared with the braginskii thermal diffusion (when allocated)
+  std::unique_ptr<FaceGradients> &faceGradients;
+
   // constant diffusion coefficient (when needed)
   real kappa;
 
@@ -66,6 +71,7 @@ template <typename Phys>
 ThermalDiffusion::ThermalDiffusion(Input &input, Grid &grid, Fluid<Phys> *hydroin):
                             Vc(hydroin->Vc),
                             dMax(hydroin->dMax),
+                            faceGradients(hydroin->faceGradients),
                             eos(hydroin->eos.get()),
                             data(hydroin->data),
                             status(hydroin->thermalDiffusionStatus) {
@@ -12,8 +12,8 @@
 void Tracer::ConvertConsToPrim() {
   idfx::pushRegion("Tracer::ConvertConsToPrim");
 
-  IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Uc = this->Uc;
+  IdefixArray4D<realStore> Vc = this->Vc;
+  IdefixArray4D<realStore> Uc = this->Uc;
 
   idefix_for("ConsToPrimScalar",
             nVar, nVar+nTracer,   // Loop on the index where scalars are lying
@@ -33,8 +33,8 @@ void Tracer::ConvertConsToPrim() {
 void Tracer::ConvertPrimToCons() {
   idfx::pushRegion("Tracer::ConvertPrimToCons");
 
-  IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Uc = this->Uc;
+  IdefixArray4D<realStore> Vc = this->Vc;
+  IdefixArray4D<realStore> Uc = this->Uc;
 
   idefix_for("PrimToConsScalar",
              nVar, nVar+nTracer,  // Loop on the index where scalars are lying
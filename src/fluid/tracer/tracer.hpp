@@ -11,6 +11,7 @@
 #include <string>
 #include "idefix.hpp"
 #include "slopeLimiter.hpp"
+#include "sweepRegion.hpp"
 
 // Forward class hydro declaration
 template <typename Phys> class Fluid;
@@ -22,12 +23,16 @@ class Tracer {
   template <typename Phys> Tracer(Fluid<Phys> *, int n);
   void ConvertConsToPrim();
   void ConvertPrimToCons();
-  template <int, typename> void CalcFlux(IdefixArray4D<real> &);
-  template <int, typename> void CalcRightHandSide(IdefixArray4D<real> &, real, real);
+  template <int, typename> void CalcFlux(IdefixArray4D<realStore> &);
+  template <int, typename> void CalcRightHandSide(IdefixArray4D<realStore> &, real, real);
+  // Same, on the cells of a tile only (tiled sweeps)
+  template <int, typename> void CalcFlux(IdefixArray4D<realStore> &, const IndexBox &);
+  template <int, typename> void CalcRightHandSide(IdefixArray4D<realStore> &, real, real,
+                                                  const IndexBox &);
 
  private:
-  IdefixArray4D<real> Vc;  // Vector of primitive variables for the passive tracer
-  IdefixArray4D<real> Uc;  // Vector of conservative variables for the passive tracer
+  IdefixArray4D<realStore> Vc;  // Vector of primitive variables for the passive tracer
+  IdefixArray4D<realStore> Uc;  // Vector of conservative variables for the passive tracer
 
   std::string prefix;
 
@@ -55,11 +60,17 @@ Tracer::Tracer(Fluid<Phys> *fluid, int n) {
 
 // Compute the upwinded flux
 template <int dir, typename Phys>
-void Tracer::CalcFlux(IdefixArray4D<real> &Flux) {
+void Tracer::CalcFlux(IdefixArray4D<realStore> &Flux) {
+  CalcFlux<dir, Phys>(Flux, IndexBox{data->beg, data->end});
+}
+
+// Compute the upwinded flux on the faces of the cells of tile
+template <int dir, typename Phys>
+void Tracer::CalcFlux(IdefixArray4D<realStore> &Flux, const IndexBox &tile) {
   idfx::pushRegion("Tracer::CalcFlux");
 
-  IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Uc = this->Uc;
+  IdefixArray4D<realStore> Vc = this->Vc;
+  IdefixArray4D<realStore> Uc = this->Uc;
   IdefixArray3D<real> A    = data->A[dir];
 
   constexpr int ioffset = (dir==IDIR ? 1 : 0);
@@ -68,9 +79,9 @@ void Tracer::CalcFlux(IdefixArray4D<real> &Flux) {
 
   idefix_for("ComputeTracerFlux",
              Phys::nvar, Phys::nvar+nTracer,   // Loop on the index where tracers are lying
-             data->beg[KDIR],data->end[KDIR]+koffset,
-             data->beg[JDIR],data->end[JDIR]+joffset,
-             data->beg[IDIR],data->end[IDIR]+ioffset,
+             tile.beg[KDIR],tile.end[KDIR]+koffset,
+             tile.beg[JDIR],tile.end[JDIR]+joffset,
+             tile.beg[IDIR],tile.end[IDIR]+ioffset,
     KOKKOS_LAMBDA (int nv, int k, int j, int i) {
       real vface;
       if(Flux(RHO,k,j,i) > 0) {
@@ -100,21 +111,51 @@ void Tracer::CalcFlux(IdefixArray4D<real> &Flux) {
 }
 
 template <int dir, typename Phys>
-void Tracer::CalcRightHandSide(IdefixArray4D<real> &Flux, real t, real dt) {
+void Tracer::CalcRightHandSide(IdefixArray4D<realStore> &Flux, real t, real dt) {
+  if(!data->haveLocalTimestep) {
+    CalcRightHandSide<dir, Phys>(Flux, t, dt, IndexBox{data->beg, data->end});
+    return;
+  }
   idfx::pushRegion("Tracer::ComputeRHS");
 
-  IdefixArray4D<real> Uc = this->Uc;
+  IdefixArray4D<realStore> Uc = this->Uc;
   IdefixArray3D<real> dV  = data->dV;
 
   constexpr int ioffset = (dir==IDIR ? 1 : 0);
   constexpr int joffset = (dir==JDIR ? 1 : 0);
   constexpr int koffset = (dir==KDIR ? 1 : 0);
 
+  // Faces are weighted by the multiple of dt they are evolved with in this substep
+  IdefixArray1D<real> w = data->lts->weight[dir];
   idefix_for("ComputeTracerRHS",
-             Phys::nvar, Phys::nvar+nTracer,   // Loop on the index where tracers are lying
+             Phys::nvar, Phys::nvar+nTracer,
              data->beg[KDIR],data->end[KDIR],
              data->beg[JDIR],data->end[JDIR],
              data->beg[IDIR],data->end[IDIR],
+    KOKKOS_LAMBDA (int nv, int k, int j, int i) {
+      Uc(nv,k,j,i) += -dt / dV(k,j,i) * (w(i+ioffset)*Flux(nv,k+koffset,j+joffset,i+ioffset)
+                                        - w(i)*Flux(nv,k,j,i));
+  });
+  idfx::popRegion();
+}
+
+template <int dir, typename Phys>
+void Tracer::CalcRightHandSide(IdefixArray4D<realStore> &Flux, real t, real dt,
+                               const IndexBox &tile) {
+  idfx::pushRegion("Tracer::ComputeRHS");
+
+  IdefixArray4D<realStore> Uc = this->Uc;
+  IdefixArray3D<real> dV  = data->dV;
+
+  constexpr int ioffset = (dir==IDIR ? 1 : 0);
+  constexpr int joffset = (dir==JDIR ? 1 : 0);
+  constexpr int koffset = (dir==KDIR ? 1 : 0);
+
+  idefix_for("ComputeTracerRHS",
+             Phys::nvar, Phys::nvar+nTracer,   // Loop on the index where tracers are lying
+             tile.beg[KDIR],tile.end[KDIR],
+             tile.beg[JDIR],tile.end[JDIR],
+             tile.beg[IDIR],tile.end[IDIR],
     KOKKOS_LAMBDA (int nv, int k, int j, int i) {
       Uc(nv,k,j,i) += -dt / dV(k,j,i) * (Flux(nv,k+koffset,j+joffset,i+ioffset) - Flux(nv,k,j,i));
   });
@@ -14,32 +14,7 @@
 #include "dataBlock.hpp"
 #include "fluid.hpp"
 #include "fargo.hpp"
-
-
-#define D_DX_I(q,n)  (q(n,k,j,i) - q(n,k,j,i - 1))
-#define D_DY_J(q,n)  (q(n,k,j,i) - q(n,k,j - 1,i))
-#define D_DZ_K(q,n)  (q(n,k,j,i) - q(n,k - 1,j,i))
-
-#define D_DY_I(q,n)  (  0.25*(q(n,k,j + 1,i) + q(n,k,j + 1,i - 1)) \
-                    - 0.25*(q(n,k,j - 1,i) + q(n,k,j - 1,i - 1)))
-
-#define D_DZ_I(q,n)  (  0.25*(q(n,k + 1,j,i) + q(n,k + 1,j,i - 1))  \
-                    - 0.25*(q(n,k - 1,j,i) + q(n,k - 1,j,i - 1)))
-
-#define D_DX_J(q,n)  (  0.25*(q(n,k,j,i + 1) + q(n,k,j - 1,i + 1)) \
-                    - 0.25*(q(n,k,j,i - 1) + q(n,k,j - 1,i - 1)))
-
-#define D_DZ_J(q,n)  (  0.25*(q(n,k + 1,j,i) + q(n,k + 1,j - 1,i)) \
-                    - 0.25*(q(n,k - 1,j,i) + q(n,k - 1,j - 1,i)))
-
-#define D_DX_K(q,n)  (  0.25*(q(n,k,j,i + 1) + q(n,k - 1,j,i + 1)) \
-                    - 0.25*(q(n,k,j,i - 1) + q(n,k - 1,j,i - 1)))
-
-#define D_DY_K(q,n)  (  0.25*(q(n,k,j + 1,i) + q(n,k - 1,j + 1,i)) \
-                    - 0.25*(q(n,k,j - 1,i) + q(n,k - 1,j - 1,i)))
-
-
-
+#include "faceGradients.hpp"
 
 // This function is technically part of the constructor,
 // but since constructors cannot be Lambda-captured by cuda
@@ -58,9 +33,9 @@ void Viscosity::InitArrays() {
         dmu(j) = 1.0/scrch;
       });
   #endif
-  viscSrc = IdefixArray4D<real>("Viscosity_source", COMPONENTS, data->np_tot[KDIR],
+  viscSrc = IdefixArray4D<real>("Viscosity_source", IdefixLayout4D(COMPONENTS, data->np_tot[KDIR],
                                                                 data->np_tot[JDIR],
-                                                                data->np_tot[IDIR]);
+                                                                data->np_tot[IDIR]));
 }
 void Viscosity::ShowConfig() {
   if(status.status==Constant) {
@@ -97,9 +72,9 @@ void Viscosity::EnrollViscousDiffusivity(ViscousDiffusivityFunc myFunc) {
 // (this avoids an extra array)
 // Associated source terms, present in non-cartesian geometry are also computed
 // and stored in this->viscSrc for later use (in calcRhs).
-void Viscosity::AddViscousFlux(int dir, const real t, const IdefixArray4D<real> &Flux) {
+void Viscosity::AddViscousFlux(int dir, const real t, const IdefixArray4D<realStore> &Flux) {
   idfx::pushRegion("Viscosity::AddViscousFlux");
-  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<realStore> Vc = this->Vc;
   IdefixArray4D<real> viscSrc = this->viscSrc;
   IdefixArray3D<real> dMax = this->dMax;
   IdefixArray3D<real> eta1Arr = this->eta1Arr;
@@ -132,6 +107,11 @@ void Viscosity::AddViscousFlux(int dir, const real t, const IdefixArray4D<real>
 
   HydroModuleStatus haveViscosity = this->status.status;
 
+  // Velocity differences computed once for the viscosity and the braginskii viscosity
+  const bool haveFaceDV = faceGradients && faceGradients->haveVelocity;
+  IdefixArray4D<real> dV;
+  if(haveFaceDV) dV = faceGradients->dV;
+
   // Compute viscosity if needed
   if(haveViscosity == UserDefFunction && dir == IDIR) {
     if(viscousDiffusivityFunc) {
@@ -9,6 +9,7 @@
 #define FLUID_VISCOSITY_HPP_
 
 #include <string>
+#include <memory>
 
 #include "idefix.hpp"
 #include "input.hpp"
@@ -20,6 +21,7 @@
 // Forward class hydro declaration
 template <typename Phys> class Fluid;
 class DataBlock;
+class FaceGradients;
 
 using ViscousDiffusivityFunc = void (*) (DataBlock &, const real t,
                                          IdefixArray3D<real> &, IdefixArray3D<real> &);
@@ -29,7 +31,7 @@ class Viscosity {
   template <typename Phys>
   Viscosity(Input &, Grid &, Fluid<Phys> *);
   void ShowConfig();                    // print configuration
-  void AddViscousFlux(int, const real, const IdefixArray4D<real> &);
+  void AddViscousFlux(int, const real, const IdefixArray4D<realStore> &);
 
   // Enroll user-defined viscous diffusivity
   void EnrollViscousDiffusivity(ViscousDiffusivityFunc);
@@ -52,9 +54,12 @@ class Viscosity {
 
   ViscousDiffusivityFunc viscousDiffusivityFunc;
 
-  IdefixArray4D<real> &Vc;
+  IdefixArray4D<realStore> &Vc;
   IdefixArray3D<real> &dMax;
 
+  // Velocity differences shared with the braginskii viscosity (when allocated)
+  std::unique_ptr<FaceGradients> &faceGradients;
+
   // constant diffusion coefficient (when needed)
   real eta1, eta2;
 
@@ -68,6 +73,7 @@ template<typename Phys>
 Viscosity::Viscosity(Input &input, Grid &grid, Fluid<Phys> *hydroin):
                       Vc(hydroin->Vc),
                       dMax(hydroin->dMax),
+                      faceGradients(hydroin->faceGradients),
                       status(hydroin->viscosityStatus) {
   idfx::pushRegion("Viscosity::Viscosity");
   // Save the parent hydro object
@@ -21,6 +21,7 @@ int prank;
 int psize;
 
 double mpiCallsTimer = 0.0;
+double mpiOverlapTimer = 0.0;
 
 bool warningsAreErrors{false};
 
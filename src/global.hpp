@@ -25,6 +25,7 @@ extern IdefixOutStream cout;              //< custom cout for idefix
 extern IdefixErrStream cerr;              //< custom cerr for idefix
 extern Profiler prof;                   //< profiler (for memory & performance usage)
 extern double mpiCallsTimer;            //< time significant MPI calls
+extern double mpiOverlapTimer;          //< time MPI messages were in flight during computations
 extern LoopPattern defaultLoopPattern;  //< default loop patterns (for idefix_for loops)
 extern bool warningsAreErrors;    //< whether warnings should be considered as errors
 
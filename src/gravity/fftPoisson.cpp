@@ -0,0 +1,202 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <cmath>
+#include <memory>
+
+#include "fftPoisson.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+
+FftPoisson::FftPoisson(Laplacian &op, real error, DataBlock *datain) :
+                      IterativeSolver<Laplacian>(op, error, 1, op.np_tot, op.beg, op.end) {
+  idfx::pushRegion("FftPoisson::FftPoisson");
+  this->data = datain;
+  Grid *grid = data->mygrid;
+
+  #if GEOMETRY != CARTESIAN
+    IDEFIX_ERROR("FftPoisson:: the FFT solver requires a cartesian geometry");
+  #endif
+
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    if(op.loffset[dir] != 0 || op.roffset[dir] != 0) {
+      IDEFIX_ERROR("FftPoisson:: the FFT solver cannot be used with an extended grid");
+    }
+    for(auto bound : {op.lbound[dir], op.rbound[dir]}) {
+      if(bound == Laplacian::periodic || bound == Laplacian::internalgrav) continue;
+      if(bound == Laplacian::shearingbox && dir == IDIR) {
+        haveShearingBox = true;
+        continue;
+      }
+      IDEFIX_ERROR("FftPoisson:: the FFT solver requires periodic or shearingbox boundaries");
+    }
+  }
+
+  if(haveShearingBox) {
+    if(grid->nproc[JDIR] > 1) {
+      IDEFIX_ERROR("FftPoisson:: shearing box is not compatible with domain decomposition "
+                   "in X2");
+    }
+    this->sbS = data->hydro->sbS;
+  }
+
+  // The spectral inversion needs uniform cell sizes
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    length[dir] = grid->xend[dir] - grid->xbeg[dir];
+    dx[dir] = length[dir] / grid->np_int[dir];
+    real error = 0;
+    if(dir < DIMENSIONS) {
+      IdefixArray1D<real>::HostMirror dxH = Kokkos::create_mirror_view(op.dx[dir]);
+      Kokkos::deep_copy(dxH, op.dx[dir]);
+      for(int i = op.beg[dir] ; i < op.end[dir] ; i++) {
+        error = std::fmax(error, std::fabs(dxH(i)-dx[dir])/dx[dir]);
+      }
+    }
+    #ifdef WITH_MPI
+      MPI_Allreduce(MPI_IN_PLACE, &error, 1, realMPI, MPI_MAX, MPI_COMM_WORLD);
+    #endif
+    if(error > 1e-8) {
+      IDEFIX_ERROR("FftPoisson:: the FFT solver requires a uniform grid");
+    }
+  }
+
+  fft = std::make_unique<Fft>(grid, op.np_int);
+  re = IdefixArray3D<real>("FftPoisson_re", op.np_int[KDIR], op.np_int[JDIR], op.np_int[IDIR]);
+  im = IdefixArray3D<real>("FftPoisson_im", op.np_int[KDIR], op.np_int[JDIR], op.np_int[IDIR]);
+
+  idfx::popRegion();
+}
+
+int FftPoisson::Solve(IdefixArray3D<real> &guess, IdefixArray3D<real> &rhs) {
+  idfx::pushRegion("FftPoisson::Solve");
+  this->solution = guess;
+  this->rhs = rhs;
+
+  auto re = this->re;
+  auto im = this->im;
+  const int ibeg = this->beg[IDIR];
+  const int jbeg = this->beg[JDIR];
+  const int kbeg = this->beg[KDIR];
+  const int ni = fft->nlocal[IDIR];
+  const int nj = fft->nlocal[JDIR];
+  const int nk = fft->nlocal[KDIR];
+
+  idefix_for("FftPoisson_Load", 0, nk, 0, nj, 0, ni,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      re(k,j,i) = rhs(k+kbeg,j+jbeg,i+ibeg);
+      im(k,j,i) = 0;
+    });
+
+  // Time modulo the period of the shearing box, at which the shift is a multiple of Ly
+  real tsb = 0;
+  if(haveShearingBox && sbS != 0) {
+    const real period = length[JDIR]/(std::fabs(sbS)*length[IDIR]);
+    tsb = data->t - period*std::round(data->t/period);
+  }
+
+  fft->Transform(re, im, KDIR, Fft::forward);
+  fft->Transform(re, im, JDIR, Fft::forward);
+  if(haveShearingBox) ShearPhase(tsb, 1.0);
+  fft->Transform(re, im, IDIR, Fft::forward);
+
+  // Multiply by the inverse of the eigenvalues of the discrete Laplacian
+  const int ioff = fft->offset[IDIR];
+  const int joff = fft->offset[JDIR];
+  const int koff = fft->offset[KDIR];
+  const int nx = fft->nglob[IDIR];
+  const int ny = fft->nglob[JDIR];
+  const int nz = fft->nglob[KDIR];
+  const real dx1 = dx[IDIR];
+  const real dx2 = dx[JDIR];
+  const real dx3 = dx[KDIR];
+  const real Lx = length[IDIR];
+  const real Ly = length[JDIR];
+  const real Lz = length[KDIR];
+  const real shift = sbS*tsb;
+  const real norm = ONE_F/(static_cast<real>(nx)*ny*nz);
+
+  idefix_for("FftPoisson_Invert", 0, nk, 0, nj, 0, ni,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const int ig = i + ioff;
+      const int jg = j + joff;
+      const int kg = k + koff;
+      const real ky = 2.0*M_PI*(jg < (ny+1)/2 ? jg : jg-ny)/Ly;
+      const real kx = 2.0*M_PI*(ig < (nx+1)/2 ? ig : ig-nx)/Lx - shift*ky;
+      real k2 = (2.0-2.0*cos(kx*dx1))/(dx1*dx1);
+      #if DIMENSIONS > 1
+        k2 += (2.0-2.0*cos(ky*dx2))/(dx2*dx2);
+      #endif
+      #if DIMENSIONS > 2
+        const real kz = 2.0*M_PI*kg/Lz;
+        k2 += (2.0-2.0*cos(kz*dx3))/(dx3*dx3);
+      #endif
+      if(ig == 0 && jg == 0 && kg == 0) {
+        // The mean potential is arbitrary
+        re(k,j,i) = 0;
+        im(k,j,i) = 0;
+      } else {
+        re(k,j,i) *= -norm/k2;
+        im(k,j,i) *= -norm/k2;
+      }
+    });
+
+  fft->Transform(re, im, IDIR, Fft::backward);
+  if(haveShearingBox) ShearPhase(tsb, -1.0);
+  fft->Transform(re, im, JDIR, Fft::backward);
+  fft->Transform(re, im, KDIR, Fft::backward);
+
+  idefix_for("FftPoisson_Store", 0, nk, 0, nj, 0, ni,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      guess(k+kbeg,j+jbeg,i+ibeg) = re(k,j,i);
+    });
+
+  // Residual of the discrete equation, for monitoring
+  this->SetRes();
+  this->TestErrorL2();
+
+  idfx::popRegion();
+  return(1);
+}
+
+void FftPoisson::ShearPhase(real tsb, real sign) {
+  auto re = this->re;
+  auto im = this->im;
+  const int ioff = fft->offset[IDIR];
+  const int joff = fft->offset[JDIR];
+  const int ny = fft->nglob[JDIR];
+  const real dx1 = dx[IDIR];
+  const real Ly = length[JDIR];
+  const real shift = sign*sbS*tsb;
+
+  idefix_for("FftPoisson_ShearPhase", 0, fft->nlocal[KDIR],
+                                      0, fft->nlocal[JDIR],
+                                      0, fft->nlocal[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const int jg = j + joff;
+      const real ky = 2.0*M_PI*(jg < (ny+1)/2 ? jg : jg-ny)/Ly;
+      // Distance to the inner radial boundary
+      const real x = (i + ioff + HALF_F)*dx1;
+      const real phase = shift*ky*x;
+      const real c = cos(phase);
+      const real s = sin(phase);
+      const real r = re(k,j,i);
+      re(k,j,i) = r*c - im(k,j,i)*s;
+      im(k,j,i) = r*s + im(k,j,i)*c;
+    });
+}
+
+void FftPoisson::ShowConfig() {
+  idfx::pushRegion("FftPoisson::ShowConfig");
+  idfx::cout << "FftPoisson: global grid " << fft->nglob[IDIR];
+  for(int dir = 1 ; dir < DIMENSIONS ; dir++) idfx::cout << "x" << fft->nglob[dir];
+  idfx::cout << "." << std::endl;
+  if(haveShearingBox) {
+    idfx::cout << "FftPoisson: using shearing box wavenumbers with shear rate " << sbS << "."
+               << std::endl;
+  }
+  idfx::popRegion();
+}
@@ -0,0 +1,47 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef GRAVITY_FFTPOISSON_HPP_
+#define GRAVITY_FFTPOISSON_HPP_
+
+#include <array>
+#include <memory>
+
+#include "idefix.hpp"
+#include "iterativesolver.hpp"
+#include "laplacian.hpp"
+#include "fft.hpp"
+
+// Direct solver of the Poisson equation on uniform periodic cartesian grids, using the
+// distributed FFT. The Laplacian is inverted with the eigenvalues of the second order
+// discrete operator, so that the solution satisfies the same discrete equation as the
+// iterative solvers, in a single pass.
+// Shearing box boundaries in X1 are handled in the shearing frame, where the solution is
+// periodic: the y-Fourier modes are shifted by exp(i ky S x t) before the transform in x,
+// and the radial wavenumbers are remapped to the time-dependent kx - S t ky.
+class FftPoisson : public IterativeSolver<Laplacian> {
+ public:
+  FftPoisson(Laplacian &op, real error, DataBlock *);
+
+  int Solve(IdefixArray3D<real> &guess, IdefixArray3D<real> &rhs);
+  void ShowConfig();
+
+  // Internal function (left public for Lambda capture)
+  void ShearPhase(real tsb, real sign);  // multiply by exp(sign i ky S x tsb)
+
+ private:
+  DataBlock *data;
+  std::unique_ptr<Fft> fft;
+  IdefixArray3D<real> re, im;   // Fourier transform of the density, then of the potential
+
+  std::array<real,3> dx;        // Cell size
+  std::array<real,3> length;    // Box size
+  bool haveShearingBox{false};
+  real sbS{0};                  // Shear rate
+};
+
+#endif // GRAVITY_FFTPOISSON_HPP_
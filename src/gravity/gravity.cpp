@@ -69,8 +69,8 @@ Gravity::Gravity(Input &input, DataBlock *datain) {
     haveInitialisedPotential = true;
   }
   if(haveBodyForce && !haveInitialisedBodyForce) {
-    bodyForceVector = IdefixArray4D<real>("Gravity_bodyForce", COMPONENTS,
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+    bodyForceVector = IdefixArray4D<real>("Gravity_bodyForce", IdefixLayout4D(COMPONENTS,
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
     haveInitialisedBodyForce = true;
   }
 
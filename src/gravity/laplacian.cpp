@@ -12,6 +12,7 @@
 #include "laplacian.hpp"
 #include "selfGravity.hpp"
 #include "dataBlock.hpp"
+#include "fluid.hpp"
 
 
 Laplacian::Laplacian(DataBlock *datain, std::array<LaplacianBoundaryType,3> leftBound,
@@ -39,10 +40,13 @@ Laplacian::Laplacian(DataBlock *datain, std::array<LaplacianBoundaryType,3> left
   this->lbound = leftBound;
   this->rbound = rightBound;
 
+  // Shearing box boundaries are periodic in the shearing frame
   isPeriodic = true;
   for(int dir = 0 ; dir < 3 ; dir++) {
-    if(lbound[dir] != LaplacianBoundaryType::periodic) isPeriodic = false;
-    if(rbound[dir] != LaplacianBoundaryType::periodic) isPeriodic = false;
+    if(lbound[dir] != LaplacianBoundaryType::periodic
+        && lbound[dir] != LaplacianBoundaryType::shearingbox) isPeriodic = false;
+    if(rbound[dir] != LaplacianBoundaryType::periodic
+        && rbound[dir] != LaplacianBoundaryType::shearingbox) isPeriodic = false;
   }
 
   #ifdef WITH_MPI
@@ -50,6 +54,7 @@ Laplacian::Laplacian(DataBlock *datain, std::array<LaplacianBoundaryType,3> left
       // create communicator for spherical radius
       int remainDims[3] = {false, true, true};
       MPI_SAFE_CALL(MPI_Cart_sub(data->mygrid->CartComm, remainDims, &originComm));
+      ownOriginComm = true;
     }
 
   // Update internal boundaries in case of domain decomposition
@@ -95,9 +100,9 @@ Laplacian::Laplacian(DataBlock *datain, std::array<LaplacianBoundaryType,3> left
 
   // Init MPI stack when needed
   #ifdef WITH_MPI
-    this->arr4D = IdefixArray4D<real> ("WorkingArrayMpi", 1, this->np_tot[KDIR],
+    this->arr4D = IdefixArray4D<real> ("WorkingArrayMpi", IdefixLayout4D(1, this->np_tot[KDIR],
                                                             this->np_tot[JDIR],
-                                                            this->np_tot[IDIR]);
+                                                            this->np_tot[IDIR]));
 
     int ntarget = 0;
     std::vector<int> mapVars;
@@ -109,6 +114,158 @@ Laplacian::Laplacian(DataBlock *datain, std::array<LaplacianBoundaryType,3> left
   idfx::popRegion();
 }
 
+Laplacian::Laplacian(Laplacian &fine, std::array<bool,3> coarsen) {
+  idfx::pushRegion("Laplacian::Laplacian");
+  this->data = fine.data;
+  this->havePreconditioner = false;
+  this->lbound = fine.lbound;
+  this->rbound = fine.rbound;
+  this->isPeriodic = fine.isPeriodic;
+  this->isTwoPi = fine.isTwoPi;
+  this->haveUserDefBoundary = fine.haveUserDefBoundary;
+  this->userDefBoundaryFunc = fine.userDefBoundaryFunc;
+  this->loffset = {0,0,0};
+  this->roffset = {0,0,0};
+
+  // A single ghost cell is enough for the Laplacian operator
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    this->np_int[dir] = coarsen[dir] ? fine.np_int[dir]/2 : fine.np_int[dir];
+    this->nghost[dir] = fine.nghost[dir] > 0 ? 1 : 0;
+    this->np_tot[dir] = this->np_int[dir] + 2*this->nghost[dir];
+    this->beg[dir] = this->nghost[dir];
+    this->end[dir] = this->nghost[dir] + this->np_int[dir];
+  }
+
+  // Coarse cells are made of the union of their children
+  std::array<int,3> fbeg = fine.beg;
+  std::array<int,3> ratio;
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    ratio[dir] = coarsen[dir] ? 2 : 1;
+
+    IdefixArray1D<real>::HostMirror xf = Kokkos::create_mirror_view(fine.x[dir]);
+    IdefixArray1D<real>::HostMirror dxf = Kokkos::create_mirror_view(fine.dx[dir]);
+    Kokkos::deep_copy(xf, fine.x[dir]);
+    Kokkos::deep_copy(dxf, fine.dx[dir]);
+
+    this->x[dir] = IdefixArray1D<real>("MG_x", this->np_tot[dir]);
+    this->dx[dir] = IdefixArray1D<real>("MG_dx", this->np_tot[dir]);
+    IdefixArray1D<real>::HostMirror xc = Kokkos::create_mirror_view(this->x[dir]);
+    IdefixArray1D<real>::HostMirror dxc = Kokkos::create_mirror_view(this->dx[dir]);
+
+    for(int i = beg[dir] ; i < end[dir] ; i++) {
+      const int f = fbeg[dir] + ratio[dir]*(i-beg[dir]);
+      if(coarsen[dir]) {
+        dxc(i) = dxf(f) + dxf(f+1);
+        xc(i) = xf(f) - 0.5*dxf(f) + 0.5*dxc(i);
+      } else {
+        dxc(i) = dxf(f);
+        xc(i) = xf(f);
+      }
+    }
+    // Ghost cells mirror the active cells next to the boundary
+    for(int g = 1 ; g <= nghost[dir] ; g++) {
+      dxc(beg[dir]-g) = dxc(beg[dir]+g-1);
+      xc(beg[dir]-g) = xc(beg[dir]-g+1) - 0.5*(dxc(beg[dir]-g+1) + dxc(beg[dir]-g));
+      dxc(end[dir]+g-1) = dxc(end[dir]-g);
+      xc(end[dir]+g-1) = xc(end[dir]+g-2) + 0.5*(dxc(end[dir]+g-2) + dxc(end[dir]+g-1));
+    }
+    Kokkos::deep_copy(this->x[dir], xc);
+    Kokkos::deep_copy(this->dx[dir], dxc);
+  }
+
+  this->sinx2 = IdefixArray1D<real>("MG_sinx2", this->np_tot[JDIR]);
+  {
+    IdefixArray1D<real> x2 = this->x[JDIR];
+    IdefixArray1D<real> sinx2 = this->sinx2;
+    idefix_for("MG_sinx2", 0, this->np_tot[JDIR],
+      KOKKOS_LAMBDA (int j) {
+        sinx2(j) = sin(x2(j));
+      });
+  }
+
+  // Volumes and areas are the sums of the volumes and areas of the children
+  const int rk = ratio[KDIR];
+  const int rj = ratio[JDIR];
+  const int ri = ratio[IDIR];
+  const int kc = this->beg[KDIR];
+  const int jc = this->beg[JDIR];
+  const int ic = this->beg[IDIR];
+  const int kf = fbeg[KDIR];
+  const int jf = fbeg[JDIR];
+  const int iff = fbeg[IDIR];
+
+  this->dV = IdefixArray3D<real>("MG_dV", this->np_tot[KDIR],
+                                          this->np_tot[JDIR],
+                                          this->np_tot[IDIR]);
+  IdefixArray3D<real> dVc = this->dV;
+  IdefixArray3D<real> dVf = fine.dV;
+  idefix_for("MG_Volumes", beg[KDIR], end[KDIR], beg[JDIR], end[JDIR], beg[IDIR], end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      real v = 0;
+      for(int c = 0 ; c < rk ; c++) {
+        for(int b = 0 ; b < rj ; b++) {
+          for(int a = 0 ; a < ri ; a++) {
+            v += dVf(kf+rk*(k-kc)+c, jf+rj*(j-jc)+b, iff+ri*(i-ic)+a);
+          }
+        }
+      }
+      dVc(k,j,i) = v;
+    });
+
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    this->A[dir] = IdefixArray3D<real>("MG_A", this->np_tot[KDIR]+KOFFSET,
+                                               this->np_tot[JDIR]+JOFFSET,
+                                               this->np_tot[IDIR]+IOFFSET);
+    if(dir >= DIMENSIONS) continue;
+    IdefixArray3D<real> Ac = this->A[dir];
+    IdefixArray3D<real> Af = fine.A[dir];
+    // Only the children faces lying on the coarse face are summed
+    const int nk = (dir == KDIR) ? 1 : rk;
+    const int nj = (dir == JDIR) ? 1 : rj;
+    const int ni = (dir == IDIR) ? 1 : ri;
+    idefix_for("MG_Areas", beg[KDIR], end[KDIR] + (dir == KDIR),
+                           beg[JDIR], end[JDIR] + (dir == JDIR),
+                           beg[IDIR], end[IDIR] + (dir == IDIR),
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        real a = 0;
+        for(int c = 0 ; c < nk ; c++) {
+          for(int b = 0 ; b < nj ; b++) {
+            for(int d = 0 ; d < ni ; d++) {
+              a += Af(kf+rk*(k-kc)+c, jf+rj*(j-jc)+b, iff+ri*(i-ic)+d);
+            }
+          }
+        }
+        Ac(k,j,i) = a;
+      });
+  }
+
+  PreComputeLaplacian();
+
+  #ifdef WITH_MPI
+    // The sub-domains sharing the same radial positions are unchanged
+    this->originComm = fine.originComm;
+    this->arr4D = IdefixArray4D<real> ("WorkingArrayMpi", IdefixLayout4D(1, this->np_tot[KDIR],
+                                                            this->np_tot[JDIR],
+                                                            this->np_tot[IDIR]));
+    std::vector<int> mapVars;
+    mapVars.push_back(0);
+    this->mpi.Init(data->mygrid, mapVars, this->nghost.data(), this->np_int.data());
+  #endif
+
+  idfx::popRegion();
+}
+
+Laplacian::~Laplacian() {
+  #ifdef WITH_MPI
+    // The coarse operators of the multigrid solver share the communicator of the fine one
+    if(ownOriginComm) {
+      int finalized;
+      MPI_Finalized(&finalized);
+      if(!finalized) MPI_Comm_free(&originComm);
+    }
+  #endif
+}
+
 void Laplacian::InitInternalGrid() {
   idfx::pushRegion("Laplacian::InitInternalGrid");
   // Extend the grid so that the inner radius will be 1/10 of the initial inner radius
@@ -328,21 +485,21 @@ void Laplacian::PreComputeLaplacian() {
   // Precompute Laplacian Factor
 
   // Allocate Laplacian factors
-  this->Lx1 = IdefixArray4D<real>("SelfGravity_Lx1",2,
+  this->Lx1 = IdefixArray4D<real>("SelfGravity_Lx1",IdefixLayout4D(2,
                                                     this->np_tot[KDIR],
                                                     this->np_tot[JDIR],
-                                                    this->np_tot[IDIR]);
+                                                    this->np_tot[IDIR]));
   #if DIMENSIONS > 1
-    this->Lx2 = IdefixArray4D<real>("SelfGravity_Lx2",2,
+    this->Lx2 = IdefixArray4D<real>("SelfGravity_Lx2",IdefixLayout4D(2,
                                                       this->np_tot[KDIR],
                                                       this->np_tot[JDIR],
-                                                      this->np_tot[IDIR]);
+                                                      this->np_tot[IDIR]));
 
     #if DIMENSIONS > 2
-      this->Lx3 = IdefixArray4D<real>("SelfGravity_Lx3",2,
+      this->Lx3 = IdefixArray4D<real>("SelfGravity_Lx3",IdefixLayout4D(2,
                                                         this->np_tot[KDIR],
                                                         this->np_tot[JDIR],
-                                                        this->np_tot[IDIR]);
+                                                        this->np_tot[IDIR]));
     #endif
   #endif
 
@@ -522,6 +679,54 @@ void Laplacian::EnforceBoundary(int dir, BoundarySide side, LaplacianBoundaryTyp
       break;
     }
 
+    case shearingbox: {
+      if(dir != IDIR)
+        IDEFIX_ERROR("Laplacian:: Shearing box boundaries can only be applied along X1");
+      if(data->mygrid->nproc[JDIR] > 1)
+        IDEFIX_ERROR("Laplacian:: Shearing box is not yet compatible with domain decomposition "
+                     "in X2");
+      if(!data->hydro->haveShearingBox)
+        IDEFIX_ERROR("Laplacian:: Shearing box boundaries require the hydro shearing box");
+
+      // Periodicity in x1 (already performed by MPI)
+      if(data->mygrid->nproc[dir] == 1) EnforceBoundary(dir, side, periodic, arr);
+
+      if(this->sbArray.extent(0) == 0) {
+        this->sbArray = IdefixArray3D<real>("LaplacianShearingBoxArray", this->np_tot[KDIR],
+                                                                      this->np_tot[JDIR],
+                                                                      ighost);
+      }
+      IdefixArray3D<real> scrh = this->sbArray;
+
+      // Offset in y of the neighbouring shearing box, modulo the box size
+      const real S = data->hydro->sbS;
+      const real Lx = data->mygrid->xend[IDIR] - data->mygrid->xbeg[IDIR];
+      const real Ly = data->mygrid->xend[JDIR] - data->mygrid->xbeg[JDIR];
+      const real dy = Ly/nxj;
+      const int sign = 2*side-1;
+      const real dL = std::fmod(sign*S*Lx*data->t, Ly);
+      const int m = static_cast<int> (std::floor(dL/dy+HALF_F));
+      const real eps = dL / dy - m;
+
+      // Linear interpolation of the shifted values
+      idefix_for("BoundaryShearingBox", kbeg, kend, jbeg, jend, ibeg, iend,
+            KOKKOS_LAMBDA (int k, int j, int i) {
+              const int jo = jghost + ((j-m-jghost)%nxj+nxj)%nxj;
+              const int jop1 = jghost + ((jo+1-jghost)%nxj+nxj)%nxj;
+              const int jom1 = jghost + ((jo-1-jghost)%nxj+nxj)%nxj;
+              if(eps >= ZERO_F) {
+                scrh(k,j,i-ibeg) = (ONE_F-eps)*localVar(k,jo,i) + eps*localVar(k,jom1,i);
+              } else {
+                scrh(k,j,i-ibeg) = (ONE_F+eps)*localVar(k,jo,i) - eps*localVar(k,jop1,i);
+              }
+      });
+      idefix_for("BoundaryShearingBoxCopy", kbeg, kend, jbeg, jend, ibeg, iend,
+            KOKKOS_LAMBDA (int k, int j, int i) {
+              localVar(k,j,i) = scrh(k,j,i-ibeg);
+      });
+      break;
+    }
+
     case userdef: {
       if(this->haveUserDefBoundary) {
         // Warning: unlike hydro userdef boundary functions, the selfGravity
@@ -603,11 +808,14 @@ void Laplacian::EnforceBoundary(int dir, BoundarySide side, LaplacianBoundaryTyp
                       psi += localVar(k,j,iref);
                     },Kokkos::Sum<real> (psiIn));
 
+      // Do a mean by dividing by the number of points of the grid
+      // (which might be coarser than the grid when called from the multigrid solver,
+      // and which may not be evenly shared between the procs)
+      real sums[2] = {psiIn, static_cast<real>(np_int[JDIR]*np_int[KDIR])};
       #ifdef WITH_MPI
-        MPI_Allreduce(MPI_IN_PLACE, &psiIn, 1, realMPI, MPI_SUM, originComm);
+        MPI_Allreduce(MPI_IN_PLACE, sums, 2, realMPI, MPI_SUM, originComm);
       #endif
-      // Do a mean by dividing by the number of points
-      psiIn = psiIn/(data->mygrid->np_int[JDIR]*data->mygrid->np_int[KDIR]);
+      psiIn = sums[0]/sums[1];
 
       // put this in the ghost cells
       idefix_for("BoundaryOrigin",kbeg,kend,jbeg,jend,ibeg,iend,
@@ -636,9 +844,9 @@ void Laplacian::SetBoundaries(IdefixArray3D<real> &arr) {
   idfx::pushRegion("Laplacian::SetBoundaries");
 
   #ifdef WITH_MPI
-  this->arr4D = IdefixArray4D<real> (arr.data(), 1, this->np_tot[KDIR],
+  this->arr4D = IdefixArray4D<real> (arr.data(), IdefixLayout4D(1, this->np_tot[KDIR],
                                                     this->np_tot[JDIR],
-                                                    this->np_tot[IDIR]);
+                                                    this->np_tot[IDIR]));
   #endif
 
   for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
@@ -19,11 +19,16 @@ class DataBlock;
 class Laplacian {
  public:
   // Types of boundary which can be treated
-  enum LaplacianBoundaryType {internalgrav, periodic, nullgrad, nullpot, userdef, axis, origin};
+  enum LaplacianBoundaryType {internalgrav, periodic, nullgrad, nullpot, userdef, axis, origin,
+                              shearingbox};
 
   Laplacian() = default;
   Laplacian(DataBlock *, std::array<LaplacianBoundaryType,3>,
                          std::array<LaplacianBoundaryType,3>, bool );
+  // Operator on a grid coarsened by a factor 2 in the directions flagged by the second argument
+  // (used by the multigrid solver)
+  Laplacian(Laplacian &, std::array<bool,3>);
+  ~Laplacian();
 
   void InitPreconditionner();   // For preconditionning versions
   void PreComputeLaplacian();   // For faster Laplacian computation
@@ -75,6 +80,8 @@ class Laplacian {
   std::array<LaplacianBoundaryType,3> rbound;  // Boundary condition to the right
                            // Warning : might differ from (M)HD solver !
 
+  IdefixArray3D<real> sbArray; //< Work array of the shearing box boundaries
+
   IdefixArray3D<real> precond; //< Diagonal preconditionner
   IdefixArray4D<real> Lx1; //< Laplacian operator in x1
   IdefixArray4D<real> Lx2; //< Laplacian operator in x2
@@ -91,6 +98,7 @@ class Laplacian {
   IdefixArray4D<real> arr4D; // Intermediate array for boundary handling
 
   MPI_Comm originComm;                  ///< MPI communicator used by the origin boundary condition
+  bool ownOriginComm{false};            ///< originComm was created (not shared) by this operator
 
   #endif
 };
@@ -0,0 +1,319 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <memory>
+#include <vector>
+
+#include "multigrid.hpp"
+
+Multigrid::Multigrid(Laplacian &fineOp, real error, int maxIter, CycleType cycle,
+                     int nSmooth, int coarseIter, int maxLevels) :
+                     IterativeSolver<Laplacian>(fineOp, error, maxIter,
+                                                fineOp.np_tot, fineOp.beg, fineOp.end),
+                     cycle(cycle), nSmooth(nSmooth), coarseIter(coarseIter) {
+  idfx::pushRegion("Multigrid::Multigrid");
+
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    if(fineOp.lbound[dir] == Laplacian::userdef || fineOp.rbound[dir] == Laplacian::userdef) {
+      IDEFIX_ERROR("Multigrid:: userdef boundary conditions are not supported");
+    }
+  }
+
+  // Optimal damping of the Jacobi smoother for the 2*DIMENSIONS+1 points stencil
+  this->omega = 2.0*DIMENSIONS/(2.0*DIMENSIONS+1.0);
+
+  op.push_back(&fineOp);
+
+  // Build the coarse levels
+  while(maxLevels <= 0 || static_cast<int>(op.size()) < maxLevels) {
+    Laplacian &fine = *op.back();
+    int canCoarsen[3] = {0, 0, 0};
+    bool coarsenAny = false;
+    for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+      const int n = fine.np_int[dir];
+      canCoarsen[dir] = (n % 2 == 0 && n >= 4);
+      // The axis boundary condition needs an even number of cells in phi
+      if(dir == KDIR && fine.isTwoPi && (n/2) % 2 != 0) canCoarsen[dir] = 0;
+    }
+    #ifdef WITH_MPI
+      // All of the sub-domains should agree on the coarsened directions
+      MPI_Allreduce(MPI_IN_PLACE, canCoarsen, 3, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    #endif
+    std::array<bool,3> coarsen;
+    std::array<int,3> r;
+    for(int dir = 0 ; dir < 3 ; dir++) {
+      coarsen[dir] = (canCoarsen[dir] > 0);
+      r[dir] = coarsen[dir] ? 2 : 1;
+      if(coarsen[dir]) coarsenAny = true;
+    }
+    if(!coarsenAny) break;
+    coarseOp.push_back(std::make_unique<Laplacian>(fine, coarsen));
+    op.push_back(coarseOp.back().get());
+    ratio.push_back(r);
+  }
+
+  // Allocate the work arrays of each level
+  const int nlevels = op.size();
+  sol.resize(nlevels);
+  src.resize(nlevels);
+  resid.resize(nlevels);
+  diag.resize(nlevels);
+  prolongIdx0.resize(nlevels-1);
+  prolongIdx1.resize(nlevels-1);
+  prolongWeight.resize(nlevels-1);
+
+  for(int l = 0 ; l < nlevels ; l++) {
+    std::array<int,3> n = op[l]->np_tot;
+    if(l > 0) {
+      sol[l] = IdefixArray3D<real>("MG_Solution", n[KDIR], n[JDIR], n[IDIR]);
+      src[l] = IdefixArray3D<real>("MG_Rhs", n[KDIR], n[JDIR], n[IDIR]);
+      resid[l] = IdefixArray3D<real>("MG_Residual", n[KDIR], n[JDIR], n[IDIR]);
+    } else {
+      resid[l] = this->res;
+    }
+    diag[l] = IdefixArray3D<real>("MG_Diagonal", n[KDIR], n[JDIR], n[IDIR]);
+
+    IdefixArray3D<real> d = diag[l];
+    IdefixArray4D<real> Lx1 = op[l]->Lx1;
+    IdefixArray4D<real> Lx2 = op[l]->Lx2;
+    IdefixArray4D<real> Lx3 = op[l]->Lx3;
+    idefix_for("MG_Diagonal", op[l]->beg[KDIR], op[l]->end[KDIR],
+                              op[l]->beg[JDIR], op[l]->end[JDIR],
+                              op[l]->beg[IDIR], op[l]->end[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        real gc = Lx1(0,k,j,i) + Lx1(1,k,j,i);
+        #if DIMENSIONS > 1
+          gc += Lx2(0,k,j,i) + Lx2(1,k,j,i);
+        #endif
+        #if DIMENSIONS > 2
+          gc += Lx3(0,k,j,i) + Lx3(1,k,j,i);
+        #endif
+        d(k,j,i) = gc;
+      });
+
+    if(l < nlevels-1) InitProlongation(l);
+  }
+
+  idfx::popRegion();
+}
+
+// Linear interpolation in each direction from the cell centers of level+1
+// to the cell centers of level
+void Multigrid::InitProlongation(int level) {
+  Laplacian &fine = *op[level];
+  Laplacian &coarse = *op[level+1];
+
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    IdefixArray1D<real>::HostMirror xf = Kokkos::create_mirror_view(fine.x[dir]);
+    IdefixArray1D<real>::HostMirror xc = Kokkos::create_mirror_view(coarse.x[dir]);
+    Kokkos::deep_copy(xf, fine.x[dir]);
+    Kokkos::deep_copy(xc, coarse.x[dir]);
+
+    prolongIdx0[level][dir] = IdefixArray1D<int>("MG_ProlongIdx0", fine.np_tot[dir]);
+    prolongIdx1[level][dir] = IdefixArray1D<int>("MG_ProlongIdx1", fine.np_tot[dir]);
+    prolongWeight[level][dir] = IdefixArray1D<real>("MG_ProlongWeight", fine.np_tot[dir]);
+    auto idx0 = Kokkos::create_mirror_view(prolongIdx0[level][dir]);
+    auto idx1 = Kokkos::create_mirror_view(prolongIdx1[level][dir]);
+    auto w = Kokkos::create_mirror_view(prolongWeight[level][dir]);
+
+    for(int i = fine.beg[dir] ; i < fine.end[dir] ; i++) {
+      const int ic = coarse.beg[dir] + (i-fine.beg[dir])/ratio[level][dir];
+      idx0(i) = ic;
+      idx1(i) = ic;
+      w(i) = 1.0;
+      if(ratio[level][dir] > 1) {
+        // Second point on the side of the fine cell center (possibly in the ghost zone)
+        const int in = (xf(i) < xc(ic)) ? ic - 1 : ic + 1;
+        idx1(i) = in;
+        w(i) = (xf(i) - xc(in)) / (xc(ic) - xc(in));
+      }
+    }
+    Kokkos::deep_copy(prolongIdx0[level][dir], idx0);
+    Kokkos::deep_copy(prolongIdx1[level][dir], idx1);
+    Kokkos::deep_copy(prolongWeight[level][dir], w);
+  }
+}
+
+int Multigrid::Solve(IdefixArray3D<real> &guess, IdefixArray3D<real> &rhs) {
+  idfx::pushRegion("Multigrid::Solve");
+  this->solution = guess;
+  this->rhs = rhs;
+  sol[0] = guess;
+  src[0] = rhs;
+
+  // Re-initialise convStatus
+  this->convStatus = false;
+
+  int n = 0;
+  while(this->convStatus != true && n < this->maxiter) {
+    Cycle(0);
+    this->SetRes();
+    this->TestErrorL2();
+    n++;
+  }
+
+  if(n == this->maxiter) {
+    idfx::cout << "Multigrid:: Reached max iter." << std::endl;
+    IDEFIX_WARNING("Multigrid:: Failed to converge before reaching max iter."
+                   "You should consider to use the multigrid as a preconditioner (MGBICGSTAB).");
+  }
+
+  idfx::popRegion();
+  return(n);
+}
+
+void Multigrid::Precondition(IdefixArray3D<real> &in, IdefixArray3D<real> &out) {
+  idfx::pushRegion("Multigrid::Precondition");
+  sol[0] = out;
+  src[0] = in;
+  Kokkos::deep_copy(out, 0.0);
+  Cycle(0);
+  idfx::popRegion();
+}
+
+void Multigrid::Cycle(int level) {
+  const int nlevels = op.size();
+  if(level == nlevels-1) {
+    Smooth(level, coarseIter);
+    return;
+  }
+  Smooth(level, nSmooth);
+  ComputeResidual(level);
+  Restrict(level);
+  Kokkos::deep_copy(sol[level+1], 0.0);
+  const int ncycles = (cycle == W) ? 2 : 1;
+  for(int n = 0 ; n < ncycles ; n++) {
+    Cycle(level+1);
+  }
+  Prolongate(level);
+  Smooth(level, nSmooth);
+}
+
+void Multigrid::ComputeResidual(int level) {
+  IdefixArray3D<real> x = sol[level];
+  IdefixArray3D<real> b = src[level];
+  IdefixArray3D<real> r = resid[level];
+  Laplacian &A = *op[level];
+
+  A(x, r);
+  idefix_for("MG_Residual", A.beg[KDIR], A.end[KDIR],
+                            A.beg[JDIR], A.end[JDIR],
+                            A.beg[IDIR], A.end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      r(k,j,i) = b(k,j,i) - r(k,j,i);
+    });
+}
+
+void Multigrid::Smooth(int level, int niter) {
+  idfx::pushRegion("Multigrid::Smooth");
+  IdefixArray3D<real> x = sol[level];
+  IdefixArray3D<real> r = resid[level];
+  IdefixArray3D<real> d = diag[level];
+  Laplacian &A = *op[level];
+  const real omega = this->omega;
+
+  for(int n = 0 ; n < niter ; n++) {
+    ComputeResidual(level);
+    // The diagonal of the operator is -d
+    idefix_for("MG_Jacobi", A.beg[KDIR], A.end[KDIR],
+                            A.beg[JDIR], A.end[JDIR],
+                            A.beg[IDIR], A.end[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        x(k,j,i) -= omega * r(k,j,i) / d(k,j,i);
+      });
+  }
+  idfx::popRegion();
+}
+
+// Volume-weighted average of the residual on the coarse cells
+void Multigrid::Restrict(int level) {
+  idfx::pushRegion("Multigrid::Restrict");
+  Laplacian &fine = *op[level];
+  Laplacian &coarse = *op[level+1];
+  IdefixArray3D<real> rf = resid[level];
+  IdefixArray3D<real> bc = src[level+1];
+  IdefixArray3D<real> dVf = fine.dV;
+  IdefixArray3D<real> dVc = coarse.dV;
+
+  const int rk = ratio[level][KDIR];
+  const int rj = ratio[level][JDIR];
+  const int ri = ratio[level][IDIR];
+  const int kc = coarse.beg[KDIR];
+  const int jc = coarse.beg[JDIR];
+  const int ic = coarse.beg[IDIR];
+  const int kf = fine.beg[KDIR];
+  const int jf = fine.beg[JDIR];
+  const int iff = fine.beg[IDIR];
+
+  idefix_for("MG_Restrict", coarse.beg[KDIR], coarse.end[KDIR],
+                            coarse.beg[JDIR], coarse.end[JDIR],
+                            coarse.beg[IDIR], coarse.end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      real sum = 0;
+      for(int c = 0 ; c < rk ; c++) {
+        for(int b = 0 ; b < rj ; b++) {
+          for(int a = 0 ; a < ri ; a++) {
+            const int kk = kf+rk*(k-kc)+c;
+            const int jj = jf+rj*(j-jc)+b;
+            const int ii = iff+ri*(i-ic)+a;
+            sum += rf(kk,jj,ii) * dVf(kk,jj,ii);
+          }
+        }
+      }
+      bc(k,j,i) = sum / dVc(k,j,i);
+    });
+  idfx::popRegion();
+}
+
+// Add the (interpolated) coarse correction to the fine solution
+void Multigrid::Prolongate(int level) {
+  idfx::pushRegion("Multigrid::Prolongate");
+  Laplacian &fine = *op[level];
+  IdefixArray3D<real> xf = sol[level];
+  IdefixArray3D<real> xc = sol[level+1];
+
+  // The interpolation stencil extends into the coarse ghost zones
+  op[level+1]->SetBoundaries(xc);
+
+  IdefixArray1D<int> i0 = prolongIdx0[level][IDIR];
+  IdefixArray1D<int> i1 = prolongIdx1[level][IDIR];
+  IdefixArray1D<real> wi = prolongWeight[level][IDIR];
+  IdefixArray1D<int> j0 = prolongIdx0[level][JDIR];
+  IdefixArray1D<int> j1 = prolongIdx1[level][JDIR];
+  IdefixArray1D<real> wj = prolongWeight[level][JDIR];
+  IdefixArray1D<int> k0 = prolongIdx0[level][KDIR];
+  IdefixArray1D<int> k1 = prolongIdx1[level][KDIR];
+  IdefixArray1D<real> wk = prolongWeight[level][KDIR];
+
+  idefix_for("MG_Prolongate", fine.beg[KDIR], fine.end[KDIR],
+                              fine.beg[JDIR], fine.end[JDIR],
+                              fine.beg[IDIR], fine.end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real q0 = wj(j) * (wi(i) * xc(k0(k),j0(j),i0(i)) + (1-wi(i)) * xc(k0(k),j0(j),i1(i)))
+                 + (1-wj(j)) * (wi(i) * xc(k0(k),j1(j),i0(i)) + (1-wi(i)) * xc(k0(k),j1(j),i1(i)));
+      const real q1 = wj(j) * (wi(i) * xc(k1(k),j0(j),i0(i)) + (1-wi(i)) * xc(k1(k),j0(j),i1(i)))
+                 + (1-wj(j)) * (wi(i) * xc(k1(k),j1(j),i0(i)) + (1-wi(i)) * xc(k1(k),j1(j),i1(i)));
+      xf(k,j,i) += wk(k) * q0 + (1-wk(k)) * q1;
+    });
+  idfx::popRegion();
+}
+
+void Multigrid::ShowConfig() {
+  idfx::pushRegion("Multigrid::ShowConfig");
+  idfx::cout << "Multigrid: " << (cycle == W ? "W" : "V") << "-cycles with " << op.size()
+             << " levels, " << nSmooth << " pre/post-smoothing and " << coarseIter
+             << " coarse level Jacobi sweeps." << std::endl;
+  idfx::cout << "Multigrid: local sub-domain sizes:";
+  for(int l = 0 ; l < op.size() ; l++) {
+    idfx::cout << " " << op[l]->np_int[IDIR];
+    for(int dir = 1 ; dir < DIMENSIONS ; dir++) idfx::cout << "x" << op[l]->np_int[dir];
+  }
+  idfx::cout << std::endl;
+  idfx::cout << "Multigrid: TargetError: " << this->targetError << std::endl;
+  idfx::cout << "Multigrid: Maximum iterations: " << this->maxiter << std::endl;
+  idfx::popRegion();
+}
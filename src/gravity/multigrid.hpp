@@ -0,0 +1,72 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef GRAVITY_MULTIGRID_HPP_
+#define GRAVITY_MULTIGRID_HPP_
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "idefix.hpp"
+#include "iterativesolver.hpp"
+#include "laplacian.hpp"
+
+// Geometric multigrid solver for the self-gravity Laplacian. The coarse levels are built by
+// merging pairs of cells of the finer level (in each direction where it is possible), and the
+// coarse operators are rediscretised from the merged volumes and areas, so that the metric
+// factors of curvilinear geometries are consistent on each level. The coarsening is done
+// within each MPI sub-domain, so that the ghost zones of every level are exchanged with
+// the same neighbours as the finest level.
+// It can either be used as a standalone solver (one cycle per iteration), or as a
+// preconditioner of the Krylov solvers (one cycle per application).
+class Multigrid : public IterativeSolver<Laplacian> {
+ public:
+  enum CycleType {V, W};
+
+  Multigrid(Laplacian &op, real error, int maxIter, CycleType cycle,
+            int nSmooth, int coarseIter, int maxLevels);
+
+  int Solve(IdefixArray3D<real> &guess, IdefixArray3D<real> &rhs);
+  void ShowConfig();
+
+  // Approximate solution of A out = in with a single cycle starting from out=0
+  void Precondition(IdefixArray3D<real> &in, IdefixArray3D<real> &out);
+
+  int GetNLevels() { return(static_cast<int>(op.size())); }
+
+  // Internal functions (left public for Lambda capture)
+  void Cycle(int level);
+  void Smooth(int level, int niter);     // Damped Jacobi sweeps
+  void ComputeResidual(int level);
+  void Restrict(int level);              // level -> level+1
+  void Prolongate(int level);            // level+1 -> level (correction)
+
+ private:
+  CycleType cycle;
+  int nSmooth;        // Number of pre- and post-smoothing sweeps
+  int coarseIter;     // Number of smoothing sweeps on the coarsest level
+  real omega;         // Damping factor of the Jacobi smoother
+
+  std::vector<Laplacian*> op;                         // Operator on each level
+  std::vector<std::unique_ptr<Laplacian>> coarseOp;   // Coarse operators owned by the solver
+  std::vector<std::array<int,3>> ratio;               // Coarsening ratio between level l and l+1
+
+  std::vector<IdefixArray3D<real>> sol;
+  std::vector<IdefixArray3D<real>> src;
+  std::vector<IdefixArray3D<real>> resid;
+  std::vector<IdefixArray3D<real>> diag;   // Sum of the Laplacian coefficients
+
+  // Linear interpolation stencil from level l+1 to level l, for each direction
+  std::vector<std::array<IdefixArray1D<int>,3>> prolongIdx0;
+  std::vector<std::array<IdefixArray1D<int>,3>> prolongIdx1;
+  std::vector<std::array<IdefixArray1D<real>,3>> prolongWeight;
+
+  void InitProlongation(int level);
+};
+
+#endif // GRAVITY_MULTIGRID_HPP_
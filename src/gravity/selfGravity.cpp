@@ -51,6 +51,11 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
       this->isPeriodic = false;
     } else if(boundary.compare("periodic") == 0) {
       this->lbound[dir] = Laplacian::LaplacianBoundaryType::periodic;
+    } else if(boundary.compare("shearingbox") == 0) {
+      this->lbound[dir] = Laplacian::LaplacianBoundaryType::shearingbox;
+      if(dir != IDIR) {
+        IDEFIX_ERROR("Shearing box boundary conditions are meaningful only on the X1 direction");
+      }
     } else if(boundary.compare("nullgrad") == 0) {
       this->lbound[dir] = Laplacian::LaplacianBoundaryType::nullgrad;
       this->isPeriodic = false;
@@ -86,6 +91,11 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
       this->isPeriodic = false;
     } else if(boundary.compare("periodic") == 0) {
       this->rbound[dir] = Laplacian::LaplacianBoundaryType::periodic;
+    } else if(boundary.compare("shearingbox") == 0) {
+      this->rbound[dir] = Laplacian::LaplacianBoundaryType::shearingbox;
+      if(dir != IDIR) {
+        IDEFIX_ERROR("Shearing box boundary conditions are meaningful only on the X1 direction");
+      }
     } else if(boundary.compare("nullgrad") == 0) {
       this->rbound[dir] = Laplacian::LaplacianBoundaryType::nullgrad;
       this->isPeriodic = false;
@@ -122,6 +132,14 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
       solver = MINRES;
     } else if(strSolver.compare("PMINRES")==0) {
       solver = PMINRES;
+    } else if(strSolver.compare("Multigrid")==0) {
+      solver = MULTIGRID;
+    } else if(strSolver.compare("MGCG")==0) {
+      solver = MGCG;
+    } else if(strSolver.compare("MGBICGSTAB")==0) {
+      solver = MGBICGSTAB;
+    } else if(strSolver.compare("FFT")==0) {
+      solver = FFT;
     } else {
       try {
         // Try to use the old solver definition with integer (deprecated)
@@ -132,7 +150,8 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
       } catch(const std::exception& e) {
         std::stringstream msg;
         msg << "SelfGravity: Unknown solver \"" << strSolver << "\"."
-            << "Use \"Jacobi\", \"BICGSTAB\" or \"PBICGSTAB\"."
+            << "Use \"Jacobi\", \"BICGSTAB\", \"PBICGSTAB\", \"CG\", \"PCG\", \"MINRES\", "
+            << "\"PMINRES\", \"Multigrid\", \"MGCG\", \"MGBICGSTAB\" or \"FFT\"."
             << std::endl;
         IDEFIX_ERROR(msg);
       }
@@ -162,6 +181,50 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
     iterativeSolver = new Minres<Laplacian>(*laplacian.get(),
                                   targetError, maxiter,
                                   laplacian->np_tot, laplacian->beg, laplacian->end);
+  } else if(solver == MULTIGRID || solver == MGCG || solver == MGBICGSTAB) {
+    std::string cycle = input.GetOrSet<std::string>("SelfGravity","mgCycle",0,"V");
+    Multigrid::CycleType cycleType;
+    if(cycle.compare("V") == 0) {
+      cycleType = Multigrid::V;
+    } else if(cycle.compare("W") == 0) {
+      cycleType = Multigrid::W;
+    } else {
+      std::stringstream msg;
+      msg << "SelfGravity: Unknown multigrid cycle \"" << cycle << "\". Use \"V\" or \"W\".";
+      IDEFIX_ERROR(msg);
+    }
+    int nSmooth = input.GetOrSet<int>("SelfGravity","mgSmooth",0,2);
+    int coarseIter = input.GetOrSet<int>("SelfGravity","mgCoarseIter",0,20);
+    int maxLevels = input.GetOrSet<int>("SelfGravity","mgLevels",0,0);
+
+    if(solver == MULTIGRID) {
+      multigrid = std::make_unique<Multigrid>(*laplacian.get(), targetError, maxiter, cycleType,
+                                              nSmooth, coarseIter, maxLevels);
+      iterativeSolver = multigrid.get();
+    } else {
+      // One cycle per application of the preconditioner
+      multigrid = std::make_unique<Multigrid>(*laplacian.get(), targetError, 1, cycleType,
+                                              nSmooth, coarseIter, maxLevels);
+      if(solver == MGCG) {
+        #if GEOMETRY != CARTESIAN
+          IDEFIX_WARNING("SelfGravity: MGCG requires a symmetric operator, use MGBICGSTAB "
+                         "on curvilinear grids.");
+        #endif
+        iterativeSolver = new Cg<Laplacian>(*laplacian.get(), targetError, maxiter,
+                                            laplacian->np_tot, laplacian->beg, laplacian->end);
+      } else {
+        iterativeSolver = new Bicgstab<Laplacian>(*laplacian.get(), targetError, maxiter,
+                                              laplacian->np_tot, laplacian->beg, laplacian->end);
+      }
+      Multigrid *mg = multigrid.get();
+      iterativeSolver->SetPreconditioner(
+        [mg](IdefixArray3D<real> &in, IdefixArray3D<real> &out) {
+          mg->Precondition(in, out);
+        });
+    }
+  } else if(solver == FFT) {
+    fftPoisson = std::make_unique<FftPoisson>(*laplacian.get(), targetError, data);
+    iterativeSolver = fftPoisson.get();
   } else {
       real step = laplacian->ComputeCFL();
       iterativeSolver = new Jacobi<Laplacian>(*laplacian.get(), targetError, maxiter, step,
@@ -216,6 +279,18 @@ void SelfGravity::ShowConfig() {
     case PMINRES:
       idfx::cout << "preconditionned MinRes";
       break;
+    case MULTIGRID:
+      idfx::cout << "multigrid";
+      break;
+    case MGCG:
+      idfx::cout << "multigrid-preconditionned CG";
+      break;
+    case MGBICGSTAB:
+      idfx::cout << "multigrid-preconditionned BICGSTAB";
+      break;
+    case FFT:
+      idfx::cout << "direct FFT";
+      break;
     default:
       IDEFIX_ERROR("SelfGravity:: Unknown solver");
   }
@@ -238,6 +313,7 @@ void SelfGravity::ShowConfig() {
     idfx::cout << "SelfGravity: self-gravity field will be updated every " << skipSelfGravity
                << " cycles." << std::endl;
   }
+  if(solver == MGCG || solver == MGBICGSTAB) multigrid->ShowConfig();
   iterativeSolver->ShowConfig();
 }
 
@@ -248,7 +324,7 @@ void SelfGravity::InitSolver() {
 
   // Loading needed attributes
   IdefixArray3D<real> density = this->density;
-  IdefixArray4D<real> Vc = data->hydro->Vc;
+  IdefixArray4D<realStore> Vc = data->hydro->Vc;
 
   // Initialise the density field
   // todo: check bounds
@@ -266,7 +342,7 @@ void SelfGravity::InitSolver() {
   // Make sure that dust mass contributes to the self-gravitating field
   if(data->haveDust) {
     for(int i = 0 ; i < data->dust.size() ; i++) {
-      IdefixArray4D<real> VcDust = data->dust[i]->Vc;
+      IdefixArray4D<realStore> VcDust = data->dust[i]->Vc;
       idefix_for("InitDustDensity", data->beg[KDIR], data->end[KDIR],
                                     data->beg[JDIR], data->end[JDIR],
                                     data->beg[IDIR], data->end[IDIR],
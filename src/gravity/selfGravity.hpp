@@ -17,6 +17,8 @@
 #include "fluid_defs.hpp"
 #include "iterativesolver.hpp"
 #include "laplacian.hpp"
+#include "multigrid.hpp"
+#include "fftPoisson.hpp"
 
 #ifdef WITH_MPI
 #include "mpi.hpp"
@@ -27,7 +29,8 @@ class DataBlock;
 
 class SelfGravity {
  public:
-  enum GravitySolver {JACOBI, BICGSTAB, PBICGSTAB, PCG, CG, PMINRES, MINRES};
+  enum GravitySolver {JACOBI, BICGSTAB, PBICGSTAB, PCG, CG, PMINRES, MINRES,
+                      MULTIGRID, MGCG, MGBICGSTAB, FFT};
 
   void Init(Input &, DataBlock *);  // Initialisation of the class attributes
   void ShowConfig();                // display current configuration
@@ -45,6 +48,12 @@ class SelfGravity {
   // The linear operator involved in Poisson equation
   std::unique_ptr<Laplacian> laplacian;
 
+  // The multigrid solver (standalone or as a preconditioner)
+  std::unique_ptr<Multigrid> multigrid;
+
+  // The direct FFT solver
+  std::unique_ptr<FftPoisson> fftPoisson;
+
   real currentError{0};       // last error of the iterative solver
   int nsteps{0};              // # of steps of the latest iteration
   double elapsedTime;        // time spent solving self gravity
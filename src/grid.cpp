@@ -35,6 +35,7 @@ Grid::Grid(SubGrid * subgrid) {
 
   nproc = subgrid->parentGrid->nproc;
   xproc = subgrid->parentGrid->xproc;
+  procBeg = subgrid->parentGrid->procBeg;
 
   // Now slice if along the chosen direction
   SliceMe(subgrid);
@@ -217,6 +218,8 @@ Grid::Grid(Input &input) {
   }
 #endif
 
+  MakeUniformDecomposition();
+
   // init coarsening
   if(input.CheckEntry("Grid","coarsening")>=0) {
     std::string coarsenType = input.Get<std::string>("Grid","coarsening",0);
@@ -252,6 +255,17 @@ Grid::Grid(Input &input) {
   idfx::popRegion();
 }
 
+// Each proc of a direction gets the same number of cells. The decomposition can later be
+// made non-uniform by the load balancer, which directly sets procBeg.
+void Grid::MakeUniformDecomposition() {
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    procBeg[dir] = std::vector<int>(nproc[dir]+1);
+    for(int p = 0 ; p <= nproc[dir] ; p++) {
+      procBeg[dir][p] = p*(np_int[dir]/nproc[dir]);
+    }
+  }
+}
+
 bool Grid::isPow2(int n) {
   return( (n & (n-1)) == 0);
 }
@@ -443,4 +457,5 @@ void Grid::SliceMe(SubGrid *subgrid) {
     nproc[dir] = 1;
     xproc[dir] = 0;
   #endif
+  this->procBeg[dir] = {0, 1};
 }
@@ -48,6 +48,8 @@ class Grid {
   // MPI data
   std::array<int,3> nproc;           ///</< Total number of procs in each direction
   std::array<int,3> xproc;           ///</< Coordinates of current proc in the array of procs
+  std::array<std::vector<int>,3> procBeg; ///< Global index (excluding ghosts) of the first cell
+                                          ///< of each slice of procs, plus the end of the grid
 
   #ifdef WITH_MPI
   MPI_Comm CartComm;                ///< Cartesian communicator for the planned domain decomposition
@@ -62,6 +64,7 @@ class Grid {
   void ShowConfig();
 
   void SliceMe(SubGrid *);       ///< Slice this grid according to the subgrid (internal function)
+  void MakeUniformDecomposition(); ///< Share the cells evenly between the procs of each direction
 
   Grid() = default;
 
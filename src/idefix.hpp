@@ -17,6 +17,12 @@
 
 using Device = Kokkos::DefaultExecutionSpace;
 using Layout = Kokkos::LayoutRight;
+// Layout of the 4D (variable, k, j, i) arrays
+#ifdef FIELD_LAYOUT_AOS
+using Layout4D = Kokkos::LayoutStride;
+#else
+using Layout4D = Kokkos::LayoutRight;
+#endif
 
 /// Type of loops we admit in idefix (see loop.hpp for details)
 enum class LoopPattern { SIMDFOR, RANGE, MDRANGE, TPX, TPTTRTVR, UNDEFINED };
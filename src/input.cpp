@@ -176,6 +176,14 @@ void Input::ParseCommandLine(int argc, char **argv) {
       enableLogs = false;
     } else if(std::string(argv[i]) == "-profile") {
       idfx::prof.EnablePerformanceProfiling();
+    } else if(std::string(argv[i]) == "-benchmark") {
+      if((++i) >= argc) IDEFIX_ERROR(
+                      "You must specify -benchmark filename where filename is the output file.");
+      idfx::prof.EnableBenchmark(std::string(argv[i]));
+    } else if(std::string(argv[i]) == "-trace") {
+      idfx::prof.EnableTrace();
+    } else if(std::string(argv[i]) == "-hwcounters") {
+      idfx::prof.EnableHardwareCounters();
     } else if(std::string(argv[i]) == "-Werror") {
       idfx::warningsAreErrors = true;
     } else if(std::string(argv[i]) == "-version" || std::string(argv[i]) == "-v") {
@@ -232,11 +240,17 @@ void Input::ShowConfig() {
   idfx::cout << "-----------------------------------------------------------------------------"
              << std::endl;
 
-  #ifdef SINGLE_PRECISION
+  #if defined(SINGLE_PRECISION)
     idfx::cout << "Input: Compiled with SINGLE PRECISION arithmetic." << std::endl;
+  #elif defined(MIXED_PRECISION)
+    idfx::cout << "Input: Compiled with DOUBLE PRECISION arithmetic and MIXED PRECISION storage."
+               << std::endl;
   #else
     idfx::cout << "Input: Compiled with DOUBLE PRECISION arithmetic." << std::endl;
   #endif
+  #ifdef FIELD_LAYOUT_AOS
+    idfx::cout << "Input: Compiled with array of structures (AoS) field layout." << std::endl;
+  #endif
   // Show dimensionality and other general options:
   idfx::cout << "Input: DIMENSIONS=" << DIMENSIONS << "." << std::endl;
   idfx::cout << "Input: COMPONENTS=" << COMPONENTS << "." << std::endl;
@@ -406,6 +420,12 @@ void Input::PrintOptions() {
   idfx::cout << "         Do not write any log file." << std::endl;
   idfx::cout << " -profile" << std::endl;
   idfx::cout << "         Enable on-the-fly performance profiling." << std::endl;
+  idfx::cout << " -benchmark filename" << std::endl;
+  idfx::cout << "         Write the performances of the run in filename (JSON)." << std::endl;
+  idfx::cout << " -trace" << std::endl;
+  idfx::cout << "         Write a trace of the profiled regions of each process." << std::endl;
+  idfx::cout << " -hwcounters" << std::endl;
+  idfx::cout << "         Read hardware counters around each profiled region (Linux)." << std::endl;
   idfx::cout << " -Werror" << std::endl;
   idfx::cout << "         Consider warnings as errors." << std::endl;
   idfx::cout << " -v/-version" << std::endl;
@@ -0,0 +1,356 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "idefix.hpp"
+#include "loadBalancer.hpp"
+#include "timeIntegrator.hpp"
+#include "gravity.hpp"
+#include "dump.hpp"
+
+LoadBalancer::LoadBalancer(Input &input, DataBlock &data) {
+  idfx::pushRegion("LoadBalancer::LoadBalancer");
+  Grid &grid = *data.mygrid;
+
+  if(input.CheckEntry("Parallel","balance")>0) {
+    threshold = input.Get<real>("Parallel","balance",0);
+    balancePeriod = input.GetOrSet<int>("Parallel","balance_period",0, 100);
+    balancePatience = input.GetOrSet<int>("Parallel","balance_checks",0, 3);
+    if(balancePeriod < 1 || balancePatience < 1) {
+      IDEFIX_ERROR("[Parallel]:balance_period and balance_checks should be positive");
+    }
+    // Nothing to balance with a single process
+    enabled = idfx::psize > 1;
+  }
+
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    balanceDirection[dir] = (dir < DIMENSIONS) && (grid.nproc[dir] > 1);
+    granularity[dir] = 1;
+    // The coarsened directions keep local sizes divisible by the largest power of two
+    // dividing the (uniform) initial size, which fulfills the initial coarsening levels
+    if(grid.haveGridCoarsening != GridCoarsening::disabled && grid.coarseningDirection[dir]) {
+      const int n = grid.np_int[dir]/grid.nproc[dir];
+      granularity[dir] = n & (-n);
+    }
+  }
+  // These exchanges assume an even distribution of the cells between the processes
+  if(grid.lbound[IDIR] == shearingbox || grid.rbound[IDIR] == shearingbox) {
+    balanceDirection[JDIR] = false;
+  }
+  if(grid.haveAxis) {
+    balanceDirection[KDIR] = false;
+  }
+  if(data.haveFargo) {
+    #if GEOMETRY == SPHERICAL
+      balanceDirection[KDIR] = false;
+    #else
+      balanceDirection[JDIR] = false;
+    #endif
+  }
+  if(enabled && data.haveGravity && data.gravity->selfGravity.fftPoisson) {
+    IDEFIX_ERROR("[Parallel]:balance is not compatible with the FFT self-gravity solver");
+  }
+
+  #ifdef WITH_MPI
+    // Coordinates of all of the processes in the array of procs
+    coords = std::vector<std::array<int,3>>(idfx::psize);
+    for(int r = 0 ; r < idfx::psize ; r++) {
+      MPI_SAFE_CALL(MPI_Cart_coords(grid.CartComm, r, 3, coords[r].data()));
+    }
+  #endif
+
+  idfx::popRegion();
+}
+
+// Measure the imbalance every balancePeriod cycles. Return true when the imbalance has been
+// above the threshold for long enough and when a better decomposition has been found.
+bool LoadBalancer::CheckBalance(TimeIntegrator &tint, DataBlock &data) {
+  if(!enabled) return(false);
+  if(tint.GetNCycles() - lastCycle < balancePeriod) return(false);
+  idfx::pushRegion("LoadBalancer::CheckBalance");
+
+  const double cost = tint.GetComputeTime() - lastComputeTime;
+  lastComputeTime = tint.GetComputeTime();
+  lastCycle = tint.GetNCycles();
+
+  std::vector<double> costs(idfx::psize, cost);
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Allgather(&cost, 1, MPI_DOUBLE, costs.data(), 1, MPI_DOUBLE,
+                                MPI_COMM_WORLD));
+  #endif
+  const double costMin = *std::min_element(costs.begin(), costs.end());
+  const double costMax = *std::max_element(costs.begin(), costs.end());
+  double costMean = 0;
+  for(auto c : costs) costMean += c;
+  costMean /= idfx::psize;
+  const double imbalance = costMean > 0 ? (costMax-costMin)/costMean*100 : 0;
+
+  bool rebalance = false;
+  if(imbalance > threshold) {
+    nAbove++;
+  } else {
+    nAbove = 0;
+  }
+  if(nAbove >= balancePatience) {
+    nAbove = 0;
+    rebalance = ComputeDecomposition(data, costs);
+    if(rebalance) {
+      nBalances++;
+      idfx::cout << "LoadBalancer: imbalance of " << imbalance << "% over the last "
+                 << balancePeriod << " cycles, moving the domain boundaries (rebalance #" << nBalances << ")." << std::endl;
+      for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+        if(newProcBeg[dir] == data.mygrid->procBeg[dir]) continue;
+        idfx::cout << "LoadBalancer: X" << dir+1 << " slices:";
+        for(int p = 0 ; p < data.mygrid->nproc[dir] ; p++) {
+          idfx::cout << " " << newProcBeg[dir][p+1]-newProcBeg[dir][p];
+        }
+        idfx::cout << std::endl;
+      }
+    }
+  }
+
+  idfx::popRegion();
+  return(rebalance);
+}
+
+// Along each direction, the measured cost of each process is spread evenly over its cells,
+// and summed over the processes sharing the same slice of cells. The slices are then
+// moved so that each of them gets the same share of the total cost.
+bool LoadBalancer::ComputeDecomposition(DataBlock &data, const std::vector<double> &costs) {
+  Grid &grid = *data.mygrid;
+  newProcBeg = grid.procBeg;
+  bool changed = false;
+
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    if(!balanceDirection[dir]) continue;
+    const int n = grid.np_int[dir];
+    const int np = grid.nproc[dir];
+    const int g = granularity[dir];
+
+    std::vector<double> slabCost(n, 0.0);
+    for(int r = 0 ; r < costs.size() ; r++) {
+      const int b = grid.procBeg[dir][coords[r][dir]];
+      const int e = grid.procBeg[dir][coords[r][dir]+1];
+      for(int i = b ; i < e ; i++) slabCost[i] += costs[r]/(e-b);
+    }
+
+    // Cumulated cost, by groups of granularity cells
+    const int nunits = n/g;
+    std::vector<double> cumCost(nunits+1, 0.0);
+    for(int u = 0 ; u < nunits ; u++) {
+      cumCost[u+1] = cumCost[u];
+      for(int i = u*g ; i < (u+1)*g ; i++) cumCost[u+1] += slabCost[i];
+    }
+
+    // Each slice should be able to fill the ghost zones of its neighbours
+    const int minUnits = std::max(1, (grid.nghost[dir] + g - 1)/g);
+    if(nunits < np*minUnits) continue;
+    int u = 0;
+    int prev = 0;
+    for(int p = 1 ; p < np ; p++) {
+      const double target = cumCost[nunits]*p/np;
+      while(u < nunits && cumCost[u+1] <= target) u++;
+      int b = u;
+      if(u < nunits && target - cumCost[u] > cumCost[u+1] - target) b = u+1;
+      b = std::clamp(b, prev + minUnits, nunits - (np-p)*minUnits);
+      newProcBeg[dir][p] = b*g;
+      prev = b;
+    }
+    if(newProcBeg[dir] != grid.procBeg[dir]) changed = true;
+  }
+  return(changed);
+}
+
+// Box of the global grid (excluding ghosts) covered by a field for the process at coord.
+// Like in the dumps, the extra face (or edge) of a staggered field belongs to the last
+// process when writing, and to all of the processes when reading.
+void LoadBalancer::GetBox(const DumpField &field, const std::array<std::vector<int>,3> &procBeg,
+                          const std::array<int,3> &coord, bool read,
+                          std::array<int,3> &start, std::array<int,3> &size) {
+  const int fieldDir = field.GetDirection();
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    const int nproc = procBeg[dir].size()-1;
+    start[dir] = procBeg[dir][coord[dir]];
+    size[dir] = procBeg[dir][coord[dir]+1] - start[dir];
+    bool staggered = false;
+    if(field.GetLocation() == DumpField::ArrayLocation::Face) {
+      staggered = (dir == fieldDir);
+    } else if(field.GetLocation() == DumpField::ArrayLocation::Edge) {
+      staggered = (dir != fieldDir) && (dir < DIMENSIONS);
+    }
+    if(staggered && (read || coord[dir] == nproc-1)) size[dir]++;
+  }
+}
+
+void LoadBalancer::Store(DataBlock &data) {
+  idfx::pushRegion("LoadBalancer::Store");
+  Grid &grid = *data.mygrid;
+  oldProcBeg = grid.procBeg;
+  fields.clear();
+
+  for(auto const& [name, field] : data.dump->dumpFieldMap) {
+    StoredField stored;
+    stored.name = name;
+    if(field.GetType() == DumpField::Type::IdefixArray) {
+      std::array<int,3> start;
+      GetBox(field, oldProcBeg, grid.xproc, false, start, stored.nx);
+      stored.block.resize(stored.nx[IDIR]*stored.nx[JDIR]*stored.nx[KDIR]);
+      data.dump->LoadLocalBlock(field.GetHostField<IdefixHostArray3D<real>>(),
+                                stored.nx.data(), stored.block.data());
+    } else {
+      size_t wordSize = 0;
+      if(field.GetType() == DumpField::Type::Int) wordSize = sizeof(int);
+      if(field.GetType() == DumpField::Type::Single) wordSize = sizeof(float);
+      if(field.GetType() == DumpField::Type::Double) wordSize = sizeof(double);
+      if(field.GetType() == DumpField::Type::Bool) wordSize = sizeof(bool);
+      stored.raw.resize(wordSize*field.GetSize());
+      std::memcpy(stored.raw.data(), field.GetHostField<void*>(), stored.raw.size());
+    }
+    fields.push_back(std::move(stored));
+  }
+
+  idfx::popRegion();
+}
+
+void LoadBalancer::Apply(Grid &grid) {
+  grid.procBeg = newProcBeg;
+}
+
+// Each process sends the intersection of its previous block with the new block of every
+// other process, for all of the distributed fields at once.
+void LoadBalancer::Load(DataBlock &data) {
+  idfx::pushRegion("LoadBalancer::Load");
+  Grid &grid = *data.mygrid;
+
+  std::vector<const DumpField *> arrays;
+  std::vector<const StoredField *> storedArrays;
+  for(auto const &stored : fields) {
+    auto it = data.dump->dumpFieldMap.find(stored.name);
+    if(it == data.dump->dumpFieldMap.end()) {
+      IDEFIX_ERROR("LoadBalancer: "+stored.name+" is not registered in the new datablock");
+    }
+    const DumpField &field = it->second;
+    if(field.GetType() == DumpField::Type::IdefixArray) {
+      arrays.push_back(&field);
+      storedArrays.push_back(&stored);
+    } else {
+      std::memcpy(field.GetHostField<void*>(), stored.raw.data(), stored.raw.size());
+    }
+  }
+
+  #ifdef WITH_MPI
+    const int nranks = idfx::psize;
+    const std::array<int,3> &myCoord = coords[idfx::prank];
+    std::array<int,3> ws, wn, rs, rn, lo, hi;
+
+    // Intersection of two boxes, false if empty
+    auto intersect = [&]() {
+      for(int dir = 0 ; dir < 3 ; dir++) {
+        lo[dir] = std::max(ws[dir], rs[dir]);
+        hi[dir] = std::min(ws[dir]+wn[dir], rs[dir]+rn[dir]);
+        if(hi[dir] <= lo[dir]) return(false);
+      }
+      return(true);
+    };
+
+    // Pack the overlaps of the previous local block with the new blocks of each process
+    std::vector<real> sendBuf;
+    std::vector<int> sendCount(nranks), sendDispl(nranks);
+    for(int r = 0 ; r < nranks ; r++) {
+      sendDispl[r] = sendBuf.size();
+      for(int n = 0 ; n < arrays.size() ; n++) {
+        GetBox(*arrays[n], oldProcBeg, myCoord, false, ws, wn);
+        GetBox(*arrays[n], newProcBeg, coords[r], true, rs, rn);
+        if(!intersect()) continue;
+        const std::vector<real> &block = storedArrays[n]->block;
+        for(int k = lo[KDIR] ; k < hi[KDIR] ; k++) {
+          for(int j = lo[JDIR] ; j < hi[JDIR] ; j++) {
+            for(int i = lo[IDIR] ; i < hi[IDIR] ; i++) {
+              sendBuf.push_back(block[(i-ws[IDIR]) + (j-ws[JDIR])*wn[IDIR]
+                                      + (k-ws[KDIR])*wn[IDIR]*wn[JDIR]]);
+            }
+          }
+        }
+      }
+      sendCount[r] = sendBuf.size() - sendDispl[r];
+    }
+
+    // Size of the overlaps of the previous blocks of each process with the new local block
+    std::vector<int> recvCount(nranks), recvDispl(nranks);
+    int recvSize = 0;
+    for(int r = 0 ; r < nranks ; r++) {
+      recvDispl[r] = recvSize;
+      for(int n = 0 ; n < arrays.size() ; n++) {
+        GetBox(*arrays[n], oldProcBeg, coords[r], false, ws, wn);
+        GetBox(*arrays[n], newProcBeg, myCoord, true, rs, rn);
+        if(!intersect()) continue;
+        recvSize += (hi[IDIR]-lo[IDIR])*(hi[JDIR]-lo[JDIR])*(hi[KDIR]-lo[KDIR]);
+      }
+      recvCount[r] = recvSize - recvDispl[r];
+    }
+    std::vector<real> recvBuf(recvSize);
+
+    MPI_SAFE_CALL(MPI_Alltoallv(sendBuf.data(), sendCount.data(), sendDispl.data(), realMPI,
+                                recvBuf.data(), recvCount.data(), recvDispl.data(), realMPI,
+                                MPI_COMM_WORLD));
+
+    // Unpack in the new local block
+    std::vector<IdefixHostArray3D<real>> toRead;
+    for(auto field : arrays) toRead.push_back(field->GetHostField<IdefixHostArray3D<real>>());
+    int64_t idx = 0;
+    for(int r = 0 ; r < nranks ; r++) {
+      for(int n = 0 ; n < arrays.size() ; n++) {
+        GetBox(*arrays[n], oldProcBeg, coords[r], false, ws, wn);
+        GetBox(*arrays[n], newProcBeg, myCoord, true, rs, rn);
+        if(!intersect()) continue;
+        for(int k = lo[KDIR] ; k < hi[KDIR] ; k++) {
+          for(int j = lo[JDIR] ; j < hi[JDIR] ; j++) {
+            for(int i = lo[IDIR] ; i < hi[IDIR] ; i++) {
+              toRead[n](k-rs[KDIR]+data.beg[KDIR],
+                        j-rs[JDIR]+data.beg[JDIR],
+                        i-rs[IDIR]+data.beg[IDIR]) = recvBuf[idx++];
+            }
+          }
+        }
+      }
+    }
+    for(int n = 0 ; n < arrays.size() ; n++) {
+      arrays[n]->SyncFrom(toRead[n]);
+    }
+  #endif
+
+  fields.clear();
+  data.DeriveVectorPotential();
+
+  idfx::popRegion();
+}
+
+void LoadBalancer::ShowConfig() {
+  if(!enabled) return;
+  idfx::cout << "LoadBalancer: dynamic load balancing ENABLED above " << threshold
+             << "% of imbalance, checked every " << balancePeriod << " cycles." << std::endl;
+  bool anyDirection = false;
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    if(balanceDirection[dir]) {
+      idfx::cout << "LoadBalancer: the domain decomposition can change along X" << dir+1;
+      if(granularity[dir] > 1) {
+        idfx::cout << " (by multiples of " << granularity[dir] << " cells)";
+      }
+      idfx::cout << "." << std::endl;
+      anyDirection = true;
+    }
+  }
+  if(!anyDirection) {
+    IDEFIX_WARNING("[Parallel]:balance: no direction of the domain decomposition can change. "
+                   "Load balancing is disabled.");
+    enabled = false;
+  }
+}
@@ -0,0 +1,71 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef LOADBALANCER_HPP_
+#define LOADBALANCER_HPP_
+
+#include <array>
+#include <string>
+#include <vector>
+#include "idefix.hpp"
+#include "input.hpp"
+#include "grid.hpp"
+#include "dataBlock.hpp"
+
+class TimeIntegrator;
+class DumpField;
+
+// Dynamic load balancing between the MPI processes, enabled with the balance entry of the
+// [Parallel] section. The compute time of each process is measured every balancePeriod cycles.
+// When the imbalance stays above the threshold for balancePatience consecutive checks, the
+// boundaries between the slices of processes are moved along each direction so that each
+// slice gets the same share of the measured cost. The datablock is then rebuilt on the new
+// decomposition, and the fields registered in the dumps (i.e. the full restart state) are
+// migrated in memory between the processes.
+class LoadBalancer {
+ public:
+  LoadBalancer(Input &, DataBlock &);
+
+  bool CheckBalance(TimeIntegrator &, DataBlock &); ///< true when the domain should be rebalanced
+  void Store(DataBlock &);    ///< Keep a copy of the restart state of the current datablock
+  void Apply(Grid &);         ///< Set the new domain decomposition in the grid
+  void Load(DataBlock &);     ///< Migrate the stored restart state to a new datablock
+  void ShowConfig();
+
+ private:
+  bool enabled{false};
+  real threshold;             // Imbalance (in %) above which a rebalance is considered
+  int64_t balancePeriod;      // # of cycles between two measurements of the imbalance
+  int balancePatience;        // # of consecutive measurements above threshold before a rebalance
+  int nAbove{0};              // # of consecutive measurements above threshold so far
+  int nBalances{0};           // # of rebalances performed so far
+
+  int64_t lastCycle{0};       // Cycle of the last measurement
+  double lastComputeTime{0};  // Compute time of the integrator at the last measurement
+
+  std::array<bool,3> balanceDirection;  // Whether the decomposition can change along dir
+  std::array<int,3> granularity;        // The slices are multiples of granularity cells
+
+  std::vector<std::array<int,3>> coords;  // Coordinates of each process in the array of procs
+  std::array<std::vector<int>,3> oldProcBeg;
+  std::array<std::vector<int>,3> newProcBeg;
+
+  // Copy of a field of the dumps
+  struct StoredField {
+    std::string name;
+    std::vector<real> block;       // Active part of the local block (distributed fields)
+    std::array<int,3> nx;          // Size of the local block
+    std::vector<char> raw;         // Raw content (fundamental types)
+  };
+  std::vector<StoredField> fields;
+
+  bool ComputeDecomposition(DataBlock &, const std::vector<double> &);
+  void GetBox(const DumpField &, const std::array<std::vector<int>,3> &,
+              const std::array<int,3> &, bool, std::array<int,3> &, std::array<int,3> &);
+};
+
+#endif // LOADBALANCER_HPP_
@@ -15,6 +15,9 @@
 #include <string>
 #include "idefix.hpp"
 #include "global.hpp"
+#ifdef LOOP_PATTERN_AUTOTUNE
+#include "loopTuner.hpp"
+#endif
 
 #define KOKKOS_VECTOR_LENGTH  8
 
@@ -140,18 +143,16 @@ inline void idefix_for(const std::string & NAME,
 }
 
 
-// 3D loop
-template <typename Function>
-inline void idefix_for(const std::string & NAME,
-                       const int & KB, const int & KE,
-                       const int & JB, const int & JE,
-                       const int & IB, const int & IE,
-                       Function function) {
-  #ifdef DEBUG
-  idfx::pushRegion("idefix_for("+NAME+")");
-  #endif
+// 3D loop with a given pattern
+template <LoopPattern pattern, typename Function>
+inline void idefix_for_pattern(const std::string & NAME,
+                               const int & KB, const int & KE,
+                               const int & JB, const int & JE,
+                               const int & IB, const int & IE,
+                               Function function,
+                               const int vectorLength = KOKKOS_VECTOR_LENGTH) {
   // Kokkos 1D Range
-  if constexpr(defaultLoop == LoopPattern::RANGE) {
+  if constexpr(pattern == LoopPattern::RANGE) {
     const int NK = KE - KB;
     const int NJ = JE - JB;
     const int NI = IE - IB;
@@ -169,18 +170,18 @@ inline void idefix_for(const std::string & NAME,
     });
 
   // MDRange loops
-  } else if constexpr(defaultLoop == LoopPattern::MDRANGE) {
+  } else if constexpr(pattern == LoopPattern::MDRANGE) {
     Kokkos::parallel_for(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
         ({KB,JB,IB},{KE,JE,IE}), function);
 
   // TeamPolicy with single inner loops
-  } else if constexpr(defaultLoop == LoopPattern::TPX) {
+  } else if constexpr(pattern == LoopPattern::TPX) {
     const int NK = KE - KB;
     const int NJ = JE - JB;
     const int NKNJ = NK * NJ;
     Kokkos::parallel_for(NAME,
-      team_policy (NKNJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+      team_policy (NKNJ, Kokkos::AUTO,vectorLength),
       KOKKOS_LAMBDA (member_type team_member) {
         const int k = team_member.league_rank() / NJ + KB;
         const int j = team_member.league_rank() % NJ + JB;
@@ -191,10 +192,10 @@ inline void idefix_for(const std::string & NAME,
       });
 
   // TeamPolicy with nested TeamThreadRange and ThreadVectorRange
-  } else if constexpr(defaultLoop == LoopPattern::TPTTRTVR) {
+  } else if constexpr(pattern == LoopPattern::TPTTRTVR) {
     const int NK = KE - KB;
     Kokkos::parallel_for(NAME,
-      team_policy (NK, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+      team_policy (NK, Kokkos::AUTO,vectorLength),
       KOKKOS_LAMBDA (member_type team_member) {
         const int k = team_member.league_rank() + KB;
         Kokkos::parallel_for(
@@ -209,7 +210,7 @@ inline void idefix_for(const std::string & NAME,
       });
 
   // SIMD FOR loops
-  } else if constexpr(defaultLoop == LoopPattern::SIMDFOR) {
+  } else if constexpr(pattern == LoopPattern::SIMDFOR) {
     for (auto k = KB; k < KE; k++)
       for (auto j = JB; j < JE; j++)
 #pragma omp simd
@@ -218,6 +219,69 @@ inline void idefix_for(const std::string & NAME,
   } else {
     throw std::runtime_error("Unknown/undefined LoopPattern used.");
   }
+}
+
+#ifdef LOOP_PATTERN_AUTOTUNE
+// 3D loop with a pattern chosen at runtime
+template <typename Function>
+inline void idefix_for_candidate(const LoopTuner::Candidate &candidate,
+                                 const std::string & NAME,
+                                 const int & KB, const int & KE,
+                                 const int & JB, const int & JE,
+                                 const int & IB, const int & IE,
+                                 Function function) {
+  const int vl = candidate.vectorLength;
+  switch(candidate.pattern) {
+    case LoopPattern::RANGE:
+      idefix_for_pattern<LoopPattern::RANGE>(NAME,KB,KE,JB,JE,IB,IE,function,vl);
+      break;
+    case LoopPattern::MDRANGE:
+      idefix_for_pattern<LoopPattern::MDRANGE>(NAME,KB,KE,JB,JE,IB,IE,function,vl);
+      break;
+    case LoopPattern::TPX:
+      idefix_for_pattern<LoopPattern::TPX>(NAME,KB,KE,JB,JE,IB,IE,function,vl);
+      break;
+    case LoopPattern::TPTTRTVR:
+      idefix_for_pattern<LoopPattern::TPTTRTVR>(NAME,KB,KE,JB,JE,IB,IE,function,vl);
+      break;
+    #ifdef LOOP_TUNER_SIMD
+    case LoopPattern::SIMDFOR:
+      idefix_for_pattern<LoopPattern::SIMDFOR>(NAME,KB,KE,JB,JE,IB,IE,function,vl);
+      break;
+    #endif
+    default:
+      throw std::runtime_error("Unknown/undefined LoopPattern used.");
+  }
+}
+#endif
+
+// 3D loop
+template <typename Function>
+inline void idefix_for(const std::string & NAME,
+                       const int & KB, const int & KE,
+                       const int & JB, const int & JE,
+                       const int & IB, const int & IE,
+                       Function function) {
+  #ifdef DEBUG
+  idfx::pushRegion("idefix_for("+NAME+")");
+  #endif
+  #ifdef LOOP_PATTERN_AUTOTUNE
+    auto &entry = idfx::loopTuner.GetEntry(LoopTuner::For, NAME, {KE-KB, JE-JB, IE-IB});
+    if(entry.choice >= 0) {
+      idefix_for_candidate(idfx::loopTuner.GetCandidate(LoopTuner::For, entry.choice),
+                           NAME,KB,KE,JB,JE,IB,IE,function);
+    } else {
+      // Time this call with the next candidate
+      Kokkos::fence();
+      Kokkos::Timer timer;
+      idefix_for_candidate(idfx::loopTuner.GetTrial(LoopTuner::For, entry),
+                           NAME,KB,KE,JB,JE,IB,IE,function);
+      Kokkos::fence();
+      idfx::loopTuner.Record(LoopTuner::For, entry, timer.seconds());
+    }
+  #else
+    idefix_for_pattern<defaultLoop>(NAME,KB,KE,JB,JE,IB,IE,function);
+  #endif
   #ifdef DEBUG
   Kokkos::fence();
   idfx::popRegion();
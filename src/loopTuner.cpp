@@ -0,0 +1,138 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "idefix.hpp"
+#include "loopTuner.hpp"
+
+namespace idfx {
+LoopTuner loopTuner;
+} // namespace idfx
+
+namespace {
+// Names of the patterns in the cache file (same as the Idefix_LOOP_PATTERN options)
+const std::map<LoopPattern, std::string> patternNames = {
+  {LoopPattern::SIMDFOR, "SIMD"},
+  {LoopPattern::RANGE, "Range"},
+  {LoopPattern::MDRANGE, "MDRange"},
+  {LoopPattern::TPX, "TeamPolicy"},
+  {LoopPattern::TPTTRTVR, "TeamPolicyInnerVector"}
+};
+} // namespace
+
+void LoopTuner::Init() {
+  initialized = true;
+
+  // Candidates of the idefix_for loops
+  const int maxVectorLength = Kokkos::TeamPolicy<>::vector_length_max();
+  candidates[For].push_back({LoopPattern::RANGE, 1});
+  candidates[For].push_back({LoopPattern::MDRANGE, 1});
+  for(int vectorLength : {1, 8, 32}) {
+    if(vectorLength > maxVectorLength) break;
+    candidates[For].push_back({LoopPattern::TPX, vectorLength});
+    candidates[For].push_back({LoopPattern::TPTTRTVR, vectorLength});
+  }
+  #ifdef LOOP_TUNER_SIMD
+    candidates[For].push_back({LoopPattern::SIMDFOR, 1});
+  #endif
+
+  // Candidates of the idefix_reduce loops
+  candidates[Reduce].push_back({LoopPattern::MDRANGE, 1});
+  candidates[Reduce].push_back({LoopPattern::RANGE, 1});
+
+  char host[1024];
+  gethostname(host, 1024);
+  hostId = std::string(host) + " " + Kokkos::DefaultExecutionSpace::name();
+
+  Load();
+}
+
+LoopTuner::Entry& LoopTuner::GetEntry(Kind kind, const std::string &name,
+                                      const std::array<int,3> &extent) {
+  if(!initialized) Init();
+  Entry &entry = entries[kind][name][extent];
+  if(entry.time.empty()) {
+    entry.time.resize(candidates[kind].size(), std::numeric_limits<double>::max());
+  }
+  return(entry);
+}
+
+void LoopTuner::Record(Kind kind, Entry &entry, double time) {
+  const int n = entry.call / nTrials;
+  entry.time[n] = std::min(entry.time[n], time);
+  entry.call++;
+  if(entry.call == nTrials*candidates[kind].size()) {
+    entry.choice = std::min_element(entry.time.begin(), entry.time.end()) - entry.time.begin();
+    Save();
+  }
+}
+
+// Each line of the cache file is made of the kind of loop, the extents of the loop, the
+// chosen pattern and vector length, and the name of the kernel (which may contain spaces)
+void LoopTuner::Load() {
+  std::ifstream file(cacheFile);
+  if(!file.good()) {
+    idfx::cout << "LoopTuner: no tuning cache found, the loop patterns will be tuned on the fly."
+               << std::endl;
+    return;
+  }
+  std::string line;
+  std::getline(file, line);
+  if(line != "# host " + hostId) {
+    idfx::cout << "LoopTuner: " << cacheFile << " was tuned on another host, ignoring it."
+               << std::endl;
+    return;
+  }
+  int nloaded = 0;
+  while(std::getline(file, line)) {
+    std::istringstream fields(line);
+    int kind;
+    std::array<int,3> extent;
+    std::string patternName;
+    int vectorLength;
+    std::string name;
+    if(!(fields >> kind >> extent[0] >> extent[1] >> extent[2] >> patternName >> vectorLength))
+      continue;
+    std::getline(fields >> std::ws, name);
+    if(kind != For && kind != Reduce) continue;
+    auto &cands = candidates[kind];
+    for(int n = 0 ; n < cands.size() ; n++) {
+      if(patternNames.at(cands[n].pattern) == patternName
+          && cands[n].vectorLength == vectorLength) {
+        Entry &entry = GetEntry(static_cast<Kind>(kind), name, extent);
+        entry.choice = n;
+        nloaded++;
+        break;
+      }
+    }
+  }
+  idfx::cout << "LoopTuner: loaded the loop patterns of " << nloaded << " kernels from "
+             << cacheFile << "." << std::endl;
+}
+
+void LoopTuner::Save() {
+  if(idfx::prank != 0) return;
+  std::ofstream file(cacheFile, std::ios::trunc);
+  file << "# host " << hostId << std::endl;
+  for(int kind = 0 ; kind < entries.size() ; kind++) {
+    for(auto const& [name, extents] : entries[kind]) {
+      for(auto const& [extent, entry] : extents) {
+        if(entry.choice < 0) continue;
+        const Candidate &c = candidates[kind][entry.choice];
+        file << kind << " " << extent[0] << " " << extent[1] << " " << extent[2] << " "
+             << patternNames.at(c.pattern) << " " << c.vectorLength << " " << name << std::endl;
+      }
+    }
+  }
+}
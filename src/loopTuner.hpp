@@ -0,0 +1,74 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef LOOPTUNER_HPP_
+#define LOOPTUNER_HPP_
+
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+#include "idefix.hpp"
+
+// The SIMD loops run serially on the host, they are only a candidate for serial builds
+#if !defined(KOKKOS_ENABLE_CUDA) && !defined(KOKKOS_ENABLE_HIP) \
+    && !defined(KOKKOS_ENABLE_SYCL) && !defined(KOKKOS_ENABLE_OPENMP)
+  #define LOOP_TUNER_SIMD
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Runtime choice of the loop pattern of the 3D idefix_for and idefix_reduce kernels, enabled
+/// with -DIdefix_LOOP_PATTERN=Autotune. A kernel is identified by its name and by the extents
+/// of its loop. Its first calls are spread over the candidate patterns (and vector lengths of
+/// the team policies), each candidate being timed nTrials times. The fastest candidate is then
+/// used for all of the following calls, and saved in a cache file, which is reused by the next
+/// runs on the same host.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class LoopTuner {
+ public:
+  enum Kind {For, Reduce};
+
+  struct Candidate {
+    LoopPattern pattern;
+    int vectorLength;
+  };
+
+  struct Entry {
+    int choice{-1};              ///< Index of the chosen candidate (-1 while tuning)
+    int call{0};                 ///< Number of timed calls so far
+    std::vector<double> time;    ///< Best time of each candidate
+  };
+
+  static constexpr int nTrials = 3;   ///< Number of timed calls of each candidate
+
+  Entry& GetEntry(Kind, const std::string &, const std::array<int,3> &);
+  const Candidate& GetCandidate(Kind kind, int n) const {
+    return(candidates[kind][n]);
+  }
+  // Candidate to be used for the next call of a kernel which is being tuned
+  const Candidate& GetTrial(Kind kind, const Entry &entry) const {
+    return(candidates[kind][entry.call / nTrials]);
+  }
+  void Record(Kind, Entry &, double);   ///< Record the time of a trial
+
+ private:
+  void Init();
+  void Load();
+  void Save();
+
+  bool initialized{false};
+  std::string hostId;           // Host name and execution space of the cache
+  std::string cacheFile{"idefix-tuning.cache"};
+  std::array<std::vector<Candidate>,2> candidates;
+  std::array<std::map<std::string, std::map<std::array<int,3>, Entry>>,2> entries;
+};
+
+namespace idfx {
+extern LoopTuner loopTuner;            //< loop pattern autotuner (for idefix_for loops)
+} // namespace idfx
+
+#endif // LOOPTUNER_HPP_
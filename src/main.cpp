@@ -23,6 +23,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
 
 #include <Kokkos_Core.hpp>
 
@@ -36,6 +37,7 @@
 #include "timeIntegrator.hpp"
 #include "setup.hpp"
 #include "output.hpp"
+#include "loadBalancer.hpp"
 #ifdef WITH_MPI
 #include "mpi.hpp"
 #endif
@@ -88,10 +90,11 @@ int main( int argc, char* argv[] ) {
     gridHost.SyncToDevice();
 
     // instantiate required objects.
-    DataBlock data(grid, input);
-    TimeIntegrator Tint(input,data);
-    Output output(input, data);
-    Setup mysetup(input, grid, data, output);
+    auto data = std::make_unique<DataBlock>(grid, input);
+    TimeIntegrator Tint(input,*data);
+    auto output = std::make_unique<Output>(input, *data);
+    auto mysetup = std::make_unique<Setup>(input, grid, *data, *output);
+    LoadBalancer balancer(input, *data);
     idfx::cout << "Main: initialisation finished." << std::endl;
 
     char host[1024];
@@ -108,8 +111,9 @@ int main( int argc, char* argv[] ) {
     }
     input.ShowConfig();
     grid.ShowConfig();
-    data.ShowConfig();
+    data->ShowConfig();
     Tint.ShowConfig();
+    balancer.ShowConfig();
 
     ///////////////////////////////
     // Initial conditions (or restart)
@@ -118,28 +122,28 @@ int main( int argc, char* argv[] ) {
     if(input.restartRequested) {
       if(input.forceInitRequested) {
         idfx::pushRegion("Setup::Initflow");
-        mysetup.InitFlow(data);
-        data.DeriveVectorPotential();
+        mysetup->InitFlow(*data);
+        data->DeriveVectorPotential();
         idfx::popRegion();
       }
       idfx::cout << "Main: Restarting from dump file."  << std::endl;
-      bool restartSuccess = output.RestartFromDump(data,input.restartFileNumber);
+      bool restartSuccess = output->RestartFromDump(*data,input.restartFileNumber);
       if(!restartSuccess) {
         idfx::cout << "Main: restart aborted." << std::endl;
         input.restartRequested = false;
       } else {
-        data.SetBoundaries();
+        data->SetBoundaries();
       }
     }
     if(!input.restartRequested) {
       idfx::cout << "Main: Creating initial conditions." << std::endl;
       idfx::pushRegion("Setup::Initflow");
-      mysetup.InitFlow(data);
+      mysetup->InitFlow(*data);
       idfx::popRegion();
-      data.DeriveVectorPotential();   // This does something only when evolveVectorPotential is on
-      data.SetBoundaries();
-      data.Validate();
-      output.CheckForWrites(data);
+      data->DeriveVectorPotential();   // This does something only when evolveVectorPotential is on
+      data->SetBoundaries();
+      data->Validate();
+      output->CheckForWrites(*data);
     }
 
     ///////////////////////////////
@@ -148,14 +152,15 @@ int main( int argc, char* argv[] ) {
     idfx::cout << "Main: Cycling Time Integrator..." << std::endl;
 
     Kokkos::Timer timer;
-    output.ResetTimer();
+    output->ResetTimer();
+    double outputTime = 0;    // Time spent in the outputs of the previous datablocks
 
     real tstop = input.Get<real>("TimeIntegrator","tstop",0);
 
-    while(data.t < tstop) {
-      if(tstop-data.t < data.dt) data.dt = tstop-data.t;
+    while(data->t < tstop) {
+      if(tstop-data->t < data->dt) data->dt = tstop-data->t;
       try {
-        Tint.Cycle(data);
+        Tint.Cycle(*data);
       } catch(std::exception &e) {
         idfx::cout << "Main: WARNING! Caught an exception in TimeIntegrator." << std::endl;
         #ifdef WITH_MPI
@@ -169,15 +174,15 @@ int main( int argc, char* argv[] ) {
         #endif
         idfx::cout << e.what() << std::endl;
         idfx::cout << "Main: attempting to save the current state for inspection." << std::endl;
-        output.ForceWriteVtk(data);
+        output->ForceWriteVtk(*data);
         idfx::cout << "Main: Aborting current calculation." << std::endl;
         returnCode = 1;
         break;
       }
-      output.CheckForWrites(data);
+      output->CheckForWrites(*data);
       if(input.CheckForAbort() || Tint.CheckForMaxRuntime() ) {
         idfx::cout << "Main: Saving current state and aborting calculation." << std::endl;
-        output.ForceWriteDump(data);
+        output->ForceWriteDump(*data);
         returnCode = -1;
         break;
       }
@@ -187,6 +192,21 @@ int main( int argc, char* argv[] ) {
           break;
         }
       }
+      if(balancer.CheckBalance(Tint, *data)) {
+        // Rebuild the datablock on the new domain decomposition, and migrate its state
+        balancer.Store(*data);
+        outputTime += output->GetTimer();
+        mysetup.reset();
+        output.reset();
+        data.reset();
+        balancer.Apply(grid);
+        data = std::make_unique<DataBlock>(grid, input);
+        Tint.Rebind(*data);
+        output = std::make_unique<Output>(input, *data);
+        mysetup = std::make_unique<Setup>(input, grid, *data, *output);
+        balancer.Load(*data);
+        data->SetBoundaries();
+      }
     }
 
     int n_days{0}, n_hours{0}, n_minutes{0}, n_seconds{0};
@@ -202,7 +222,7 @@ int main( int argc, char* argv[] ) {
     double perfs = timer.seconds() / grid.np_int[IDIR] / grid.np_int[JDIR]
                             / grid.np_int[KDIR] / Tint.GetNCycles() * idfx::psize;
 
-    idfx::cout << "Main: Reached t=" << data.t << std::endl;
+    idfx::cout << "Main: Reached t=" << data->t << std::endl;
     idfx::cout << "Main: Completed in ";
     if (n_days > 0) {
       idfx::cout << n_days << " day";
@@ -244,10 +264,13 @@ int main( int argc, char* argv[] ) {
     #endif
 
     idfx::cout << "Outputs represent "
-               << static_cast<int>(100.0*output.GetTimer()/timer.seconds())
+               << static_cast<int>(100.0*(outputTime+output->GetTimer())/timer.seconds())
               << "% of total run time." << std::endl;
     // Show profiler output
     idfx::prof.Show();
+    if(!idfx::prof.benchmarkFile.empty()) {
+      idfx::prof.WriteBenchmark(Tint.GetNCycles(), 1/perfs, idfx::mpiCallsTimer/timer.seconds());
+    }
   }
 
   if(returnCode<0) {
@@ -27,11 +27,6 @@
 // init the number of instances
 int Mpi::nInstances = 0;
 
-// MPI Routines exchange
-void Mpi::ExchangeAll() {
-  IDEFIX_ERROR("Not Implemented");
-}
-
 ///
 /// Initialise an instance of the MPI class.
 /// @param grid: pointer to the grid object (needed to get the MPI neighbours)
@@ -229,6 +224,12 @@ Mpi::~Mpi() {
         MPI_Request_free( &recvRequestX3[i]);
       #endif
       }
+      if(haveExchangeAll) {
+        for(int n = 0 ; n < neighbours.size() ; n++) {
+          MPI_Request_free( &sendRequestAll[n]);
+          MPI_Request_free( &recvRequestAll[n]);
+        }
+      }
     #endif
     if(thisInstance==1) {
       idfx::cout << "Mpi(" << thisInstance << "): measured throughput is "
@@ -237,14 +238,33 @@ Mpi::~Mpi() {
       idfx::cout << "        X1: " << bufferSizeX1*sizeof(real)/1024.0/1024.0 << " MB" << std::endl;
       idfx::cout << "        X2: " << bufferSizeX2*sizeof(real)/1024.0/1024.0 << " MB" << std::endl;
       idfx::cout << "        X3: " << bufferSizeX3*sizeof(real)/1024.0/1024.0 << " MB" << std::endl;
+      if(haveExchangeAll) {
+        int64_t bufferSizeAll = 0;
+        for(int n = 0 ; n < neighbours.size() ; n++) bufferSizeAll += neighbours[n].bufferSize;
+        idfx::cout << "        All: " << bufferSizeAll*sizeof(real)/1024.0/1024.0 << " MB in "
+                  << neighbours.size() << " messages" << std::endl;
+      }
     }
     isInitialized = false;
   }
   idfx::popRegion();
 }
 
-void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
-  idfx::pushRegion("Mpi::ExchangeX1");
+///
+/// Exchange the ghost zones in the X1 direction. This is split in two phases: StartExchangeX1
+/// fills the buffers and sends the messages, FinishExchangeX1 waits for the messages and fills
+/// the ghost zones. Computations which do not depend on the ghost zones can be performed in
+/// between, while the messages are in flight.
+///
+template <typename T>
+void Mpi::ExchangeX1(IdefixArray4D<T> Vc, IdefixArray4D<real> Vs) {
+  StartExchangeX1(Vc, Vs);
+  FinishExchangeX1(Vc, Vs);
+}
+
+template <typename T>
+void Mpi::StartExchangeX1(IdefixArray4D<T> Vc, IdefixArray4D<real> Vs) {
+  idfx::pushRegion("Mpi::StartExchangeX1");
 
   // Load  the buffers with data
   int ibeg,iend,jbeg,jend,kbeg,kend,offset,nx;
@@ -256,9 +276,6 @@ void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   myTimer -= MPI_Wtime();
   double tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
-  MPI_Status sendStatus[2];
-  MPI_Status recvStatus[2];
-
   MPI_SAFE_CALL(MPI_Startall(2, recvRequestX1));
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 #endif
@@ -328,39 +345,29 @@ void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
   MPI_SAFE_CALL(MPI_Startall(2, sendRequestX1));
-  // Wait for buffers to be received
-  MPI_Waitall(2,recvRequestX1,recvStatus);
 
 #else
   int procSend, procRecv;
 
   #ifdef MPI_NON_BLOCKING
-  MPI_Status sendStatus[2];
-  MPI_Status recvStatus[2];
-  MPI_Request sendRequest[2];
-  MPI_Request recvRequest[2];
-
   // We receive from procRecv, and we send to procSend
   MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,0,1,&procRecv,&procSend ));
 
   MPI_SAFE_CALL(MPI_Isend(BufferSendX1[faceRight].data(), bufferSizeX1, realMPI, procSend, 100,
-                mygrid->CartComm, &sendRequest[0]));
+                mygrid->CartComm, &sendRequestX1[0]));
 
   MPI_SAFE_CALL(MPI_Irecv(BufferRecvX1[faceLeft].data(), bufferSizeX1, realMPI, procRecv, 100,
-                mygrid->CartComm, &recvRequest[0]));
+                mygrid->CartComm, &recvRequestX1[0]));
 
   // Send to the left
   // We receive from procRecv, and we send to procSend
   MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,0,-1,&procRecv,&procSend ));
 
   MPI_SAFE_CALL(MPI_Isend(BufferSendX1[faceLeft].data(), bufferSizeX1, realMPI, procSend, 101,
-                mygrid->CartComm, &sendRequest[1]));
+                mygrid->CartComm, &sendRequestX1[1]));
 
   MPI_SAFE_CALL(MPI_Irecv(BufferRecvX1[faceRight].data(), bufferSizeX1, realMPI, procRecv, 101,
-                mygrid->CartComm, &recvRequest[1]));
-
-  // Wait for recv to complete (we don't care about the sends)
-  MPI_Waitall(2, recvRequest, recvStatus);
+                mygrid->CartComm, &recvRequestX1[1]));
 
   #else
   MPI_Status status;
@@ -383,9 +390,49 @@ void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 #endif
   myTimer += MPI_Wtime();
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  sendTime[IDIR] = MPI_Wtime();
+
+  idfx::popRegion();
+}
+
+template <typename T>
+void Mpi::FinishExchangeX1(IdefixArray4D<T> Vc, IdefixArray4D<real> Vs) {
+  idfx::pushRegion("Mpi::FinishExchangeX1");
+
+  int ibeg,iend,jbeg,jend,kbeg,kend,offset;
+  IdefixArray1D<int> map = this->mapVars;
+
+  // Coordinates of the ghost region which needs to be filled
+  ibeg   = 0;
+  iend   = nghost[IDIR];
+  offset = end[IDIR];     // Distance between beginning of left and right ghosts
+  jbeg   = beg[JDIR];
+  jend   = end[JDIR];
+
+  kbeg   = beg[KDIR];
+  kend   = end[KDIR];
+
+  // Make sure the computations performed while the messages were in flight are completed, so
+  // that they are not accounted for as MPI time
+  Kokkos::fence();
+
+  myTimer -= MPI_Wtime();
+  double tStart = MPI_Wtime();
+#if defined(MPI_PERSISTENT) || defined(MPI_NON_BLOCKING)
+  MPI_Status sendStatus[2];
+  MPI_Status recvStatus[2];
+
+  idfx::mpiOverlapTimer += tStart - sendTime[IDIR];
+
+  // Wait for buffers to be received
+  MPI_Waitall(2, recvRequestX1, recvStatus);
+#endif
+  myTimer += MPI_Wtime();
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
   // Unpack
-  BufferLeft=BufferRecvX1[faceLeft];
-  BufferRight=BufferRecvX1[faceRight];
+  Buffer BufferLeft=BufferRecvX1[faceLeft];
+  Buffer BufferRight=BufferRecvX1[faceRight];
 
   BufferLeft.ResetPointer();
   BufferRight.ResetPointer();
@@ -430,12 +477,8 @@ void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   }
 
 myTimer -= MPI_Wtime();
-#ifdef MPI_NON_BLOCKING
+#if defined(MPI_PERSISTENT) || defined(MPI_NON_BLOCKING)
   // Wait for the sends if they have not yet completed
-  MPI_Waitall(2, sendRequest, sendStatus);
-#endif
-
-#ifdef MPI_PERSISTENT
   MPI_Waitall(2, sendRequestX1, sendStatus);
 #endif
   myTimer += MPI_Wtime();
@@ -445,8 +488,15 @@ myTimer -= MPI_Wtime();
 }
 
 
-void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
-  idfx::pushRegion("Mpi::ExchangeX2");
+template <typename T>
+void Mpi::ExchangeX2(IdefixArray4D<T> Vc, IdefixArray4D<real> Vs) {
+  StartExchangeX2(Vc, Vs);
+  FinishExchangeX2(Vc, Vs);
+}
+
+template <typename T>
+void Mpi::StartExchangeX2(IdefixArray4D<T> Vc, IdefixArray4D<real> Vs) {
+  idfx::pushRegion("Mpi::StartExchangeX2");
 
   // Load  the buffers with data
   int ibeg,iend,jbeg,jend,kbeg,kend,offset,ny;
@@ -458,9 +508,6 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   myTimer -= MPI_Wtime();
   double tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
-  MPI_Status sendStatus[2];
-  MPI_Status recvStatus[2];
-
   MPI_SAFE_CALL(MPI_Startall(2, recvRequestX2));
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 #endif
@@ -527,38 +574,29 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
   MPI_SAFE_CALL(MPI_Startall(2, sendRequestX2));
-  MPI_Waitall(2,recvRequestX2,recvStatus);
 
 #else
   int procSend, procRecv;
 
   #ifdef MPI_NON_BLOCKING
-  MPI_Status sendStatus[2];
-  MPI_Status recvStatus[2];
-  MPI_Request sendRequest[2];
-  MPI_Request recvRequest[2];
-
   // We receive from procRecv, and we send to procSend
   MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,1,1,&procRecv,&procSend ));
 
   MPI_SAFE_CALL(MPI_Isend(BufferSendX2[faceRight].data(), bufferSizeX2, realMPI, procSend, 100,
-                mygrid->CartComm, &sendRequest[0]));
+                mygrid->CartComm, &sendRequestX2[0]));
 
   MPI_SAFE_CALL(MPI_Irecv(BufferRecvX2[faceLeft].data(), bufferSizeX2, realMPI, procRecv, 100,
-                mygrid->CartComm, &recvRequest[0]));
+                mygrid->CartComm, &recvRequestX2[0]));
 
   // Send to the left
   // We receive from procRecv, and we send to procSend
   MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,1,-1,&procRecv,&procSend ));
 
   MPI_SAFE_CALL(MPI_Isend(BufferSendX2[faceLeft].data(), bufferSizeX2, realMPI, procSend, 101,
-                mygrid->CartComm, &sendRequest[1]));
+                mygrid->CartComm, &sendRequestX2[1]));
 
   MPI_SAFE_CALL(MPI_Irecv(BufferRecvX2[faceRight].data(), bufferSizeX2, realMPI, procRecv, 101,
-                mygrid->CartComm, &recvRequest[1]));
-
-  // Wait for recv to complete (we don't care about the sends)
-  MPI_Waitall(2, recvRequest, recvStatus);
+                mygrid->CartComm, &recvRequestX2[1]));
 
   #else
   MPI_Status status;
@@ -581,9 +619,50 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 #endif
   myTimer += MPI_Wtime();
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  sendTime[JDIR] = MPI_Wtime();
+
+  idfx::popRegion();
+}
+
+template <typename T>
+void Mpi::FinishExchangeX2(IdefixArray4D<T> Vc, IdefixArray4D<real> Vs) {
+  idfx::pushRegion("Mpi::FinishExchangeX2");
+
+  int ibeg,iend,jbeg,jend,kbeg,kend,offset;
+  IdefixArray1D<int> map = this->mapVars;
+
+  // Coordinates of the ghost region which needs to be filled
+  ibeg   = 0;
+  iend   = ntot[IDIR];
+
+  jbeg   = 0;
+  jend   = nghost[JDIR];
+  offset = end[JDIR];     // Distance between beginning of left and right ghosts
+
+  kbeg   = beg[KDIR];
+  kend   = end[KDIR];
+
+  // Make sure the computations performed while the messages were in flight are completed, so
+  // that they are not accounted for as MPI time
+  Kokkos::fence();
+
+  myTimer -= MPI_Wtime();
+  double tStart = MPI_Wtime();
+#if defined(MPI_PERSISTENT) || defined(MPI_NON_BLOCKING)
+  MPI_Status sendStatus[2];
+  MPI_Status recvStatus[2];
+
+  idfx::mpiOverlapTimer += tStart - sendTime[JDIR];
+
+  // Wait for buffers to be received
+  MPI_Waitall(2, recvRequestX2, recvStatus);
+#endif
+  myTimer += MPI_Wtime();
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
   // Unpack
-  BufferLeft=BufferRecvX2[faceLeft];
-  BufferRight=BufferRecvX2[faceRight];
+  Buffer BufferLeft=BufferRecvX2[faceLeft];
+  Buffer BufferRight=BufferRecvX2[faceRight];
 
   BufferLeft.ResetPointer();
   BufferRight.ResetPointer();
@@ -627,12 +706,8 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   }
 
   myTimer -= MPI_Wtime();
-#ifdef MPI_NON_BLOCKING
+#if defined(MPI_PERSISTENT) || defined(MPI_NON_BLOCKING)
   // Wait for the sends if they have not yet completed
-  MPI_Waitall(2, sendRequest, sendStatus);
-#endif
-
-#ifdef MPI_PERSISTENT
   MPI_Waitall(2, sendRequestX2, sendStatus);
 #endif
   myTimer += MPI_Wtime();
@@ -642,8 +717,15 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 }
 
 
-void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
-  idfx::pushRegion("Mpi::ExchangeX3");
+template <typename T>
+void Mpi::ExchangeX3(IdefixArray4D<T> Vc, IdefixArray4D<real> Vs) {
+  StartExchangeX3(Vc, Vs);
+  FinishExchangeX3(Vc, Vs);
+}
+
+template <typename T>
+void Mpi::StartExchangeX3(IdefixArray4D<T> Vc, IdefixArray4D<real> Vs) {
+  idfx::pushRegion("Mpi::StartExchangeX3");
 
 
   // Load  the buffers with data
@@ -657,9 +739,6 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 
   double tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
-  MPI_Status sendStatus[2];
-  MPI_Status recvStatus[2];
-
   MPI_SAFE_CALL(MPI_Startall(2, recvRequestX3));
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 #endif
@@ -727,39 +806,29 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
   MPI_SAFE_CALL(MPI_Startall(2, sendRequestX3));
-  MPI_Waitall(2,recvRequestX3,recvStatus);
-  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 
 #else
   int procSend, procRecv;
 
   #ifdef MPI_NON_BLOCKING
-  MPI_Status sendStatus[2];
-  MPI_Status recvStatus[2];
-  MPI_Request sendRequest[2];
-  MPI_Request recvRequest[2];
-
   // We receive from procRecv, and we send to procSend
   MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,2,1,&procRecv,&procSend ));
 
   MPI_SAFE_CALL(MPI_Isend(BufferSendX3[faceRight].data(), bufferSizeX3, realMPI, procSend, 100,
-                mygrid->CartComm, &sendRequest[0]));
+                mygrid->CartComm, &sendRequestX3[0]));
 
   MPI_SAFE_CALL(MPI_Irecv(BufferRecvX3[faceLeft].data(), bufferSizeX3, realMPI, procRecv, 100,
-                mygrid->CartComm, &recvRequest[0]));
+                mygrid->CartComm, &recvRequestX3[0]));
 
   // Send to the left
   // We receive from procRecv, and we send to procSend
   MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,2,-1,&procRecv,&procSend ));
 
   MPI_SAFE_CALL(MPI_Isend(BufferSendX3[faceLeft].data(), bufferSizeX3, realMPI, procSend, 101,
-                mygrid->CartComm, &sendRequest[1]));
+                mygrid->CartComm, &sendRequestX3[1]));
 
   MPI_SAFE_CALL(MPI_Irecv(BufferRecvX3[faceRight].data(), bufferSizeX3, realMPI, procRecv, 101,
-                mygrid->CartComm, &recvRequest[1]));
-
-  // Wait for recv to complete (we don't care about the sends)
-  MPI_Waitall(2, recvRequest, recvStatus);
+                mygrid->CartComm, &recvRequestX3[1]));
 
   #else
   MPI_Status status;
@@ -781,9 +850,50 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 #endif
   myTimer += MPI_Wtime();
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  sendTime[KDIR] = MPI_Wtime();
+
+  idfx::popRegion();
+}
+
+template <typename T>
+void Mpi::FinishExchangeX3(IdefixArray4D<T> Vc, IdefixArray4D<real> Vs) {
+  idfx::pushRegion("Mpi::FinishExchangeX3");
+
+  int ibeg,iend,jbeg,jend,kbeg,kend,offset;
+  IdefixArray1D<int> map = this->mapVars;
+
+  // Coordinates of the ghost region which needs to be filled
+  ibeg   = 0;
+  iend   = ntot[IDIR];
+
+  jbeg   = 0;
+  jend   = ntot[JDIR];
+
+  kbeg   = 0;
+  kend   = nghost[KDIR];
+  offset = end[KDIR];     // Distance between beginning of left and right ghosts
+
+  // Make sure the computations performed while the messages were in flight are completed, so
+  // that they are not accounted for as MPI time
+  Kokkos::fence();
+
+  myTimer -= MPI_Wtime();
+  double tStart = MPI_Wtime();
+#if defined(MPI_PERSISTENT) || defined(MPI_NON_BLOCKING)
+  MPI_Status sendStatus[2];
+  MPI_Status recvStatus[2];
+
+  idfx::mpiOverlapTimer += tStart - sendTime[KDIR];
+
+  // Wait for buffers to be received
+  MPI_Waitall(2, recvRequestX3, recvStatus);
+#endif
+  myTimer += MPI_Wtime();
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
   // Unpack
-  BufferLeft=BufferRecvX3[faceLeft];
-  BufferRight=BufferRecvX3[faceRight];
+  Buffer BufferLeft=BufferRecvX3[faceLeft];
+  Buffer BufferRight=BufferRecvX3[faceRight];
 
   BufferLeft.ResetPointer();
   BufferRight.ResetPointer();
@@ -830,21 +940,282 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   }
 
   myTimer -= MPI_Wtime();
-#ifdef MPI_NON_BLOCKING
+#if defined(MPI_PERSISTENT) || defined(MPI_NON_BLOCKING)
   // Wait for the sends if they have not yet completed
-  MPI_Waitall(2, sendRequest, sendStatus);
+  MPI_Waitall(2, sendRequestX3, sendStatus);
 #endif
+  myTimer += MPI_Wtime();
+  bytesSentOrReceived += 4*bufferSizeX3*sizeof(real);
+
+  idfx::popRegion();
+}
+
+///
+/// Initialise the exchange of the ghost zones with all of the neighbours of this process,
+/// along faces, edges and corners. ExchangeAll then fills the ghost zones in a single round of
+/// messages, instead of the three successive rounds of ExchangeX1, ExchangeX2 and ExchangeX3.
+/// Only the decomposed directions are involved: the ghost zones of the other directions
+/// (including the corners they share with the decomposed directions) are left to the
+/// boundary conditions.
+///
+void Mpi::InitExchangeAll() {
+  idfx::pushRegion("Mpi::InitExchangeAll");
+  int dims[3], periods[3], coords[3];
+  MPI_SAFE_CALL(MPI_Cart_get(mygrid->CartComm, 3, dims, periods, coords));
+
+  // Index of a neighbour, used to tag the messages sent in its direction
+  auto neighbourIndex = [] (const std::array<int,3> &offset) {
+    return((offset[KDIR]+1)*9 + (offset[JDIR]+1)*3 + offset[IDIR]+1);
+  };
+
+  for(int dk = -1 ; dk <= 1 ; dk++) {
+    for(int dj = -1 ; dj <= 1 ; dj++) {
+      for(int di = -1 ; di <= 1 ; di++) {
+        const std::array<int,3> offset = {di, dj, dk};
+        bool isNeighbour = !(di == 0 && dj == 0 && dk == 0);
+        int neighbourCoords[3];
+        for(int dir = 0 ; dir < 3 ; dir++) {
+          neighbourCoords[dir] = coords[dir] + offset[dir];
+          if(offset[dir] == 0) continue;
+          if(dir >= DIMENSIONS || dims[dir] == 1) {
+            // Direction not decomposed
+            isNeighbour = false;
+          } else if(neighbourCoords[dir] < 0 || neighbourCoords[dir] >= dims[dir]) {
+            if(periods[dir]) {
+              neighbourCoords[dir] = (neighbourCoords[dir] + dims[dir]) % dims[dir];
+            } else {
+              // Physical boundary of the domain
+              isNeighbour = false;
+            }
+          }
+        }
+        if(!isNeighbour) continue;
+
+        Neighbour neighbour;
+        neighbour.offset = offset;
+        MPI_SAFE_CALL(MPI_Cart_rank(mygrid->CartComm, neighbourCoords, &neighbour.rank));
+
+        // Number of elements exchanged with this neighbour
+        auto regionSize = [&] (const int staggeredDir) {
+          int size = 1;
+          for(int dir = 0 ; dir < 3 ; dir++) {
+            auto range = NeighbourRange(dir, offset[dir], true, dir == staggeredDir);
+            size *= range.second - range.first;
+          }
+          return(size);
+        };
+        neighbour.bufferSize = regionSize(-1) * mapNVars;
+        if(haveVs) {
+          for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+            neighbour.bufferSize += regionSize(dir);
+          }
+        }
+        neighbour.bufferSend = Buffer(neighbour.bufferSize);
+        neighbour.bufferRecv = Buffer(neighbour.bufferSize);
+        neighbours.push_back(neighbour);
+      }
+    }
+  }
+
+  sendRequestAll.resize(neighbours.size());
+  recvRequestAll.resize(neighbours.size());
 
 #ifdef MPI_PERSISTENT
-  MPI_Waitall(2, sendRequestX3, sendStatus);
+  for(int n = 0 ; n < neighbours.size() ; n++) {
+    Neighbour &neighbour = neighbours[n];
+    const std::array<int,3> opposite = {-neighbour.offset[IDIR],
+                                        -neighbour.offset[JDIR],
+                                        -neighbour.offset[KDIR]};
+    // Messages are tagged with the direction in which they are sent, so that they can be told
+    // apart when the same process is a neighbour on several sides.
+    MPI_SAFE_CALL(MPI_Send_init(neighbour.bufferSend.data(), neighbour.bufferSize, realMPI,
+                  neighbour.rank, thisInstance*1000+100+neighbourIndex(neighbour.offset),
+                  mygrid->CartComm, &sendRequestAll[n]));
+
+    MPI_SAFE_CALL(MPI_Recv_init(neighbour.bufferRecv.data(), neighbour.bufferSize, realMPI,
+                  neighbour.rank, thisInstance*1000+100+neighbourIndex(opposite),
+                  mygrid->CartComm, &recvRequestAll[n]));
+  }
+#endif
+
+  haveExchangeAll = true;
+
+  idfx::popRegion();
+}
+
+///
+/// Range of indices exchanged in direction dir with a neighbour located at offset (-1, 0 or
+/// +1) in this direction. Sent elements are taken from the active zone, received ones are
+/// written in the ghost zones. Face-centered elements staggered in direction dir skip the faces
+/// on the boundary between the two processes, as these are known on both sides.
+///
+std::pair<int,int> Mpi::NeighbourRange(int dir, int offset, bool isSend, bool isStaggered) {
+  const int s = isStaggered ? 1 : 0;
+  if(offset == 0) return(std::make_pair(beg[dir], end[dir]+s));
+  if(offset < 0) {
+    if(isSend) return(std::make_pair(beg[dir]+s, beg[dir]+nghost[dir]+s));
+    return(std::make_pair(0, nghost[dir]));
+  }
+  if(isSend) return(std::make_pair(end[dir]-nghost[dir], end[dir]));
+  return(std::make_pair(end[dir]+s, end[dir]+nghost[dir]+s));
+}
+
+template <typename T>
+void Mpi::PackNeighbour(Neighbour &neighbour, IdefixArray4D<T> &Vc,
+                        IdefixArray4D<real> &Vs) {
+  Buffer buffer = neighbour.bufferSend;
+  auto range = [&] (const int dir, const bool isStaggered) {
+    return(NeighbourRange(dir, neighbour.offset[dir], true, isStaggered));
+  };
+  buffer.ResetPointer();
+  buffer.Pack(Vc, mapVars, range(IDIR, false), range(JDIR, false), range(KDIR, false));
+  if(haveVs) {
+    buffer.Pack(Vs, BX1s, range(IDIR, true), range(JDIR, false), range(KDIR, false));
+    #if DIMENSIONS >= 2
+    buffer.Pack(Vs, BX2s, range(IDIR, false), range(JDIR, true), range(KDIR, false));
+    #endif
+    #if DIMENSIONS == 3
+    buffer.Pack(Vs, BX3s, range(IDIR, false), range(JDIR, false), range(KDIR, true));
+    #endif
+  }
+}
+
+template <typename T>
+void Mpi::UnpackNeighbour(Neighbour &neighbour, IdefixArray4D<T> &Vc,
+                          IdefixArray4D<real> &Vs) {
+  Buffer buffer = neighbour.bufferRecv;
+  auto range = [&] (const int dir, const bool isStaggered) {
+    return(NeighbourRange(dir, neighbour.offset[dir], false, isStaggered));
+  };
+  buffer.ResetPointer();
+  buffer.Unpack(Vc, mapVars, range(IDIR, false), range(JDIR, false), range(KDIR, false));
+  if(haveVs) {
+    buffer.Unpack(Vs, BX1s, range(IDIR, true), range(JDIR, false), range(KDIR, false));
+    #if DIMENSIONS >= 2
+    buffer.Unpack(Vs, BX2s, range(IDIR, false), range(JDIR, true), range(KDIR, false));
+    #endif
+    #if DIMENSIONS == 3
+    buffer.Unpack(Vs, BX3s, range(IDIR, false), range(JDIR, false), range(KDIR, true));
+    #endif
+  }
+}
+
+///
+/// Exchange the ghost zones with all of the neighbours in a single round of messages. The
+/// boundary conditions of all of the directions should be enforced afterwards. As for the
+/// directional exchanges, this is split in StartExchangeAll and FinishExchangeAll.
+///
+template <typename T>
+void Mpi::ExchangeAll(IdefixArray4D<T> Vc, IdefixArray4D<real> Vs) {
+  StartExchangeAll(Vc, Vs);
+  FinishExchangeAll(Vc, Vs);
+}
+
+template <typename T>
+void Mpi::StartExchangeAll(IdefixArray4D<T> Vc, IdefixArray4D<real> Vs) {
+  idfx::pushRegion("Mpi::StartExchangeAll");
+  if(!haveExchangeAll) {
+    IDEFIX_ERROR("Mpi::InitExchangeAll should be called before exchanging with all neighbours");
+  }
+  const int nNeighbours = neighbours.size();
+
+  // If MPI Persistent, start receiving even before the buffers are filled
+  myTimer -= MPI_Wtime();
+  double tStart = MPI_Wtime();
+#ifdef MPI_PERSISTENT
+  MPI_SAFE_CALL(MPI_Startall(nNeighbours, recvRequestAll.data()));
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 #endif
   myTimer += MPI_Wtime();
-  bytesSentOrReceived += 4*bufferSizeX3*sizeof(real);
+
+  for(int n = 0 ; n < nNeighbours ; n++) {
+    PackNeighbour(neighbours[n], Vc, Vs);
+  }
+
+  // Wait for completion before sending out everything
+  Kokkos::fence();
+  myTimer -= MPI_Wtime();
+  tStart = MPI_Wtime();
+#ifdef MPI_PERSISTENT
+  MPI_SAFE_CALL(MPI_Startall(nNeighbours, sendRequestAll.data()));
+#else
+  auto neighbourIndex = [] (const std::array<int,3> &offset) {
+    return((offset[KDIR]+1)*9 + (offset[JDIR]+1)*3 + offset[IDIR]+1);
+  };
+  for(int n = 0 ; n < nNeighbours ; n++) {
+    Neighbour &neighbour = neighbours[n];
+    const std::array<int,3> opposite = {-neighbour.offset[IDIR],
+                                        -neighbour.offset[JDIR],
+                                        -neighbour.offset[KDIR]};
+    MPI_SAFE_CALL(MPI_Irecv(neighbour.bufferRecv.data(), neighbour.bufferSize, realMPI,
+                  neighbour.rank, 100+neighbourIndex(opposite),
+                  mygrid->CartComm, &recvRequestAll[n]));
+    MPI_SAFE_CALL(MPI_Isend(neighbour.bufferSend.data(), neighbour.bufferSize, realMPI,
+                  neighbour.rank, 100+neighbourIndex(neighbour.offset),
+                  mygrid->CartComm, &sendRequestAll[n]));
+  }
+#endif
+  myTimer += MPI_Wtime();
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  sendTimeAll = MPI_Wtime();
 
   idfx::popRegion();
 }
 
+template <typename T>
+void Mpi::FinishExchangeAll(IdefixArray4D<T> Vc, IdefixArray4D<real> Vs) {
+  idfx::pushRegion("Mpi::FinishExchangeAll");
+  const int nNeighbours = neighbours.size();
 
+  // Make sure the computations performed while the messages were in flight are completed, so
+  // that they are not accounted for as MPI time
+  Kokkos::fence();
+
+  myTimer -= MPI_Wtime();
+  double tStart = MPI_Wtime();
+  idfx::mpiOverlapTimer += tStart - sendTimeAll;
+
+  // Wait for buffers to be received
+  MPI_Waitall(nNeighbours, recvRequestAll.data(), MPI_STATUSES_IGNORE);
+  myTimer += MPI_Wtime();
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
+  // We fill the ghost zones
+  int64_t bufferSizeAll = 0;
+  for(int n = 0 ; n < nNeighbours ; n++) {
+    UnpackNeighbour(neighbours[n], Vc, Vs);
+    bufferSizeAll += neighbours[n].bufferSize;
+  }
+
+  myTimer -= MPI_Wtime();
+  // Wait for the sends if they have not yet completed
+  MPI_Waitall(nNeighbours, sendRequestAll.data(), MPI_STATUSES_IGNORE);
+  myTimer += MPI_Wtime();
+  bytesSentOrReceived += 2*bufferSizeAll*sizeof(real);
+
+  idfx::popRegion();
+}
+
+// Explicit instantiations of the exchange functions, for real arrays and, with mixed
+// precision, for the arrays stored in realStore
+#define MPI_INSTANTIATE_EXCHANGE(T) \
+  template void Mpi::ExchangeAll(IdefixArray4D<T>, IdefixArray4D<real>); \
+  template void Mpi::StartExchangeAll(IdefixArray4D<T>, IdefixArray4D<real>); \
+  template void Mpi::FinishExchangeAll(IdefixArray4D<T>, IdefixArray4D<real>); \
+  template void Mpi::ExchangeX1(IdefixArray4D<T>, IdefixArray4D<real>); \
+  template void Mpi::StartExchangeX1(IdefixArray4D<T>, IdefixArray4D<real>); \
+  template void Mpi::FinishExchangeX1(IdefixArray4D<T>, IdefixArray4D<real>); \
+  template void Mpi::ExchangeX2(IdefixArray4D<T>, IdefixArray4D<real>); \
+  template void Mpi::StartExchangeX2(IdefixArray4D<T>, IdefixArray4D<real>); \
+  template void Mpi::FinishExchangeX2(IdefixArray4D<T>, IdefixArray4D<real>); \
+  template void Mpi::ExchangeX3(IdefixArray4D<T>, IdefixArray4D<real>); \
+  template void Mpi::StartExchangeX3(IdefixArray4D<T>, IdefixArray4D<real>); \
+  template void Mpi::FinishExchangeX3(IdefixArray4D<T>, IdefixArray4D<real>);
+
+MPI_INSTANTIATE_EXCHANGE(real)
+#ifdef MIXED_PRECISION
+MPI_INSTANTIATE_EXCHANGE(realStore)
+#endif
 
 void Mpi::CheckConfig() {
   idfx::pushRegion("Mpi::CheckConfig");
@@ -9,6 +9,7 @@
 #define MPI_HPP_
 
 #include <signal.h>
+#include <array>
 #include <vector>
 #include <utility>
 #include "idefix.hpp"
@@ -55,7 +56,8 @@ class Buffer {
     this->pointer += ninjnk;
   }
 
-  void Pack(IdefixArray4D<real>& in,
+  template <typename T>
+  void Pack(IdefixArray4D<T>& in,
        const int var,
        std::pair<int,int> ib,
        std::pair<int,int> jb,
@@ -78,7 +80,8 @@ class Buffer {
     this->pointer += ninjnk;
   }
 
-  void Pack(IdefixArray4D<real>& in,
+  template <typename T>
+  void Pack(IdefixArray4D<T>& in,
        IdefixArray1D<int>& map,
        std::pair<int,int> ib,
        std::pair<int,int> jb,
@@ -92,13 +95,25 @@ class Buffer {
     const int offset = this->pointer;
     auto arr = this->array;
 
-    idefix_for("LoadBuffer4D",0,map.size(),
-                             kb.first,kb.second,
-                             jb.first,jb.second,
-                             ib.first,ib.second,
-      KOKKOS_LAMBDA (int n, int k, int j, int i) {
-      arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + n*ninjnk + offset ) = in(map(n), k,j,i);
-    });
+    #ifdef FIELD_LAYOUT_AOS
+      // All of the variables of a cell are contiguous in memory: pack them together
+      const int nmap = map.size();
+      idefix_for("LoadBuffer4D",kb.first,kb.second,jb.first,jb.second,ib.first,ib.second,
+        KOKKOS_LAMBDA (int k, int j, int i) {
+        const int idx = (i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj)*nmap + offset;
+        for(int n = 0 ; n < nmap ; n++) {
+          arr(idx + n) = in(map(n), k,j,i);
+        }
+      });
+    #else
+      idefix_for("LoadBuffer4D",0,map.size(),
+                               kb.first,kb.second,
+                               jb.first,jb.second,
+                               ib.first,ib.second,
+        KOKKOS_LAMBDA (int n, int k, int j, int i) {
+        arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + n*ninjnk + offset ) = in(map(n), k,j,i);
+      });
+    #endif
 
     // Update pointer
     this->pointer += ninjnk*map.size();
@@ -126,7 +141,8 @@ class Buffer {
     this->pointer += ninjnk;
   }
 
-  void Unpack(IdefixArray4D<real>& out,
+  template <typename T>
+  void Unpack(IdefixArray4D<T>& out,
        const int var,
        std::pair<int,int> ib,
        std::pair<int,int> jb,
@@ -149,7 +165,8 @@ class Buffer {
     this->pointer += ninjnk;
   }
 
-  void Unpack(IdefixArray4D<real>& out,
+  template <typename T>
+  void Unpack(IdefixArray4D<T>& out,
        IdefixArray1D<int>& map,
        std::pair<int,int> ib,
        std::pair<int,int> jb,
@@ -163,13 +180,25 @@ class Buffer {
     const int offset = this->pointer;
 
     auto arr = this->array;
-    idefix_for("LoadBuffer4D",0,map.size(),
-                              kb.first,kb.second,
-                              jb.first,jb.second,
-                              ib.first,ib.second,
-      KOKKOS_LAMBDA (int n, int k, int j, int i) {
-        out(map(n),k,j,i) = arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + n*ninjnk + offset );
-    });
+    #ifdef FIELD_LAYOUT_AOS
+      // All of the variables of a cell are contiguous in memory: unpack them together
+      const int nmap = map.size();
+      idefix_for("LoadBuffer4D",kb.first,kb.second,jb.first,jb.second,ib.first,ib.second,
+        KOKKOS_LAMBDA (int k, int j, int i) {
+          const int idx = (i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj)*nmap + offset;
+          for(int n = 0 ; n < nmap ; n++) {
+            out(map(n),k,j,i) = arr(idx + n);
+          }
+      });
+    #else
+      idefix_for("LoadBuffer4D",0,map.size(),
+                                kb.first,kb.second,
+                                jb.first,jb.second,
+                                ib.first,ib.second,
+        KOKKOS_LAMBDA (int n, int k, int j, int i) {
+          out(map(n),k,j,i) = arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + n*ninjnk + offset );
+      });
+    #endif
 
     // Update pointer
     this->pointer += ninjnk*map.size();
@@ -184,22 +213,59 @@ class Buffer {
 class Mpi {
  public:
   Mpi() = default;
-  // MPI Exchange functions
-  void ExchangeAll();   ///< Exchange boundary elements in all directions (todo)
-  void ExchangeX1(IdefixArray4D<real> inputVc,
+  // MPI Exchange functions. The cell-centered array can either be a real array or, with mixed
+  // precision, an array stored in realStore (the messages are always sent in real precision).
+  template <typename T>
+  void ExchangeAll(IdefixArray4D<T> inputVc,
+                   IdefixArray4D<real> inputVs = IdefixArray4D<real>());
+                                      ///< Exchange boundary elements with all of the neighbours
+  template <typename T>
+  void ExchangeX1(IdefixArray4D<T> inputVc,
                   IdefixArray4D<real> inputVs = IdefixArray4D<real>());
                                       ///< Exchange boundary elements in the X1 direction
-  void ExchangeX2(IdefixArray4D<real> inputVc,
+  template <typename T>
+  void ExchangeX2(IdefixArray4D<T> inputVc,
                 IdefixArray4D<real> inputVs = IdefixArray4D<real>());
                                     ///< Exchange boundary elements in the X2 direction
-  void ExchangeX3(IdefixArray4D<real> inputVc,
+  template <typename T>
+  void ExchangeX3(IdefixArray4D<T> inputVc,
                 IdefixArray4D<real> inputVs = IdefixArray4D<real>());
                                       ///< Exchange boundary elements in the X3 direction
 
+  // Split-phase exchange functions: the exchange is started, and the ghost zones are only
+  // filled when it is finished, so that computations can be performed in the meantime
+  template <typename T>
+  void StartExchangeX1(IdefixArray4D<T> inputVc,
+                       IdefixArray4D<real> inputVs = IdefixArray4D<real>());
+  template <typename T>
+  void FinishExchangeX1(IdefixArray4D<T> inputVc,
+                        IdefixArray4D<real> inputVs = IdefixArray4D<real>());
+  template <typename T>
+  void StartExchangeX2(IdefixArray4D<T> inputVc,
+                       IdefixArray4D<real> inputVs = IdefixArray4D<real>());
+  template <typename T>
+  void FinishExchangeX2(IdefixArray4D<T> inputVc,
+                        IdefixArray4D<real> inputVs = IdefixArray4D<real>());
+  template <typename T>
+  void StartExchangeX3(IdefixArray4D<T> inputVc,
+                       IdefixArray4D<real> inputVs = IdefixArray4D<real>());
+  template <typename T>
+  void FinishExchangeX3(IdefixArray4D<T> inputVc,
+                        IdefixArray4D<real> inputVs = IdefixArray4D<real>());
+  template <typename T>
+  void StartExchangeAll(IdefixArray4D<T> inputVc,
+                        IdefixArray4D<real> inputVs = IdefixArray4D<real>());
+  template <typename T>
+  void FinishExchangeAll(IdefixArray4D<T> inputVc,
+                         IdefixArray4D<real> inputVs = IdefixArray4D<real>());
+
   // Init from datablock
   void Init(Grid *grid, std::vector<int> inputMap,
             int nghost[3], int nint[3], bool inputHaveVs = false );
 
+  // Init the exchange with all of the neighbours, including edges and corners (ExchangeAll)
+  void InitExchangeAll();
+
   // Check that MPI will work with the designated target (in particular GPU Direct)
   static void CheckConfig();
 
@@ -256,10 +322,33 @@ class Mpi {
   MPI_Request recvRequestX2[2];
   MPI_Request recvRequestX3[2];
 
+  // Neighbours involved in ExchangeAll, along faces, edges and corners
+  struct Neighbour {
+    std::array<int,3> offset;   //< position of the neighbour (-1, 0 or 1 in each direction)
+    int rank;                   //< rank of the neighbour in the cartesian communicator
+    int bufferSize;             //< number of elements exchanged with the neighbour
+    Buffer bufferSend;
+    Buffer bufferRecv;
+  };
+  std::vector<Neighbour> neighbours;
+  std::vector<MPI_Request> sendRequestAll;
+  std::vector<MPI_Request> recvRequestAll;
+  bool haveExchangeAll{false};
+
+  // Range of indices exchanged with a neighbour located at offset in direction dir
+  std::pair<int,int> NeighbourRange(int dir, int offset, bool isSend, bool isStaggered);
+  template <typename T>
+  void PackNeighbour(Neighbour &, IdefixArray4D<T> &, IdefixArray4D<real> &);
+  template <typename T>
+  void UnpackNeighbour(Neighbour &, IdefixArray4D<T> &, IdefixArray4D<real> &);
+
   Grid *mygrid;
 
   // MPI throughput timer specific to this object
   double myTimer{0};
+  // Time at which the messages of the last exchange in each direction were sent
+  double sendTime[3]{0, 0, 0};
+  double sendTimeAll{0};
   int64_t bytesSentOrReceived{0};
 
   // Error handler used by CheckConfig
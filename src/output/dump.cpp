@@ -6,6 +6,7 @@
 // ***********************************************************************************
 
 #include <algorithm>
+#include <cerrno>
 #include <unordered_set>
 #if __has_include(<filesystem>)
   #include <filesystem>
@@ -17,6 +18,8 @@
   #error "Missing the <filesystem> header."
 #endif
 #include <iomanip>
+#include <fcntl.h>
+#include <unistd.h>
 #include "dump.hpp"
 #include "version.hpp"
 #include "dataBlockHost.hpp"
@@ -28,6 +31,8 @@
 #define  NAMESIZE     16
 #define  FILENAMESIZE   256
 #define  HEADERSIZE 128
+// Max number of values in the chunks of compressed fields
+#define  CHUNKSIZE  262144
 
 // Register a variable to be dumped (and read)
 
@@ -61,6 +66,16 @@ void  Dump::RegisterVariable(IdefixHostArray4D<real>& in,
     dumpFieldMap.emplace(name, DumpField(in, varnum, loc, dir));
 }
 
+#ifdef MIXED_PRECISION
+void  Dump::RegisterVariable(IdefixArray4D<realStore>& in,
+                        std::string name,
+                        int varnum,
+                        int dir,
+                        DumpField::ArrayLocation loc) {
+    dumpFieldMap.emplace(name, DumpField(in, varnum, loc, dir));
+}
+#endif
+
 
 
 void Dump::CreateMPIDataType(GridBox gb, bool read) {
@@ -191,6 +206,10 @@ void Dump::Init(DataBlock *datain) {
 
   this->scrch = new real[nmax];
 
+  for(int dir = 0; dir < 3 ; dir++) {
+    gstart[dir] = data->gbeg[dir]-data->nghost[dir];
+  }
+
   #ifdef WITH_MPI
     Grid *grid = data->mygrid;
     GridBox gb;
@@ -224,6 +243,43 @@ Dump::Dump(Input &input, DataBlock *datain) {
     outputDirectory = "./";
   }
   Init(datain);
+
+  // Number of snapshots which can be written in the background
+  asyncSnapshots = input.GetOrSet<int>("Output","dmp_async",0,0);
+  if(asyncSnapshots < 0) {
+    IDEFIX_ERROR("[Output]:dmp_async should be a positive integer");
+  }
+  if(asyncSnapshots > 0) {
+    for(int n = 0 ; n < asyncSnapshots ; n++) {
+      snapshots.push_back(std::make_unique<DumpSnapshot>());
+      freeSnapshots.push_back(snapshots.back().get());
+    }
+    writer = std::thread(&Dump::WriterLoop, this);
+  }
+
+  // Compression of the distributed fields
+  std::string codec = input.GetOrSet<std::string>("Output","dmp_compression",0,"none");
+  if(codec.compare("lossless") == 0) {
+    compression = true;
+  } else if(codec.compare("none") != 0) {
+    IDEFIX_ERROR("Unknown [Output]:dmp_compression "+codec+". Should be none or lossless.");
+  }
+  const int nlossy = input.CheckEntry("Output","dmp_lossy");
+  if(nlossy > 0) {
+    if(!compression) {
+      IDEFIX_ERROR("[Output]:dmp_lossy requires dmp_compression lossless");
+    }
+    if(nlossy % 2 != 0) {
+      IDEFIX_ERROR("[Output]:dmp_lossy expects pairs of field names and error bounds");
+    }
+    for(int n = 0 ; n < nlossy ; n += 2) {
+      const double tolerance = input.Get<double>("Output","dmp_lossy",n+1);
+      if(!(tolerance > 0)) {
+        IDEFIX_ERROR("[Output]:dmp_lossy error bounds should be positive");
+      }
+      lossyFields[input.Get<std::string>("Output","dmp_lossy",n)] = tolerance;
+    }
+  }
 }
 
 Dump::Dump(DataBlock *datain) {
@@ -235,6 +291,15 @@ Dump::Dump(DataBlock *datain) {
 }
 
 Dump::~Dump() {
+  if(asyncSnapshots > 0) {
+    Flush();
+    {
+      std::lock_guard<std::mutex> lock(writerMutex);
+      stopWriter = true;
+    }
+    writerCondition.notify_all();
+    writer.join();
+  }
   delete scrch;
 }
 
@@ -514,6 +579,19 @@ void Dump::Skip(IdfxFileHandler fileHdl, int ndim, int *dim,
                             DataType type) {
   int size;
   int64_t ntot=1;
+  if(type == CompressedType) {
+    // The size of the field is given by its chunk index
+    std::vector<DumpChunk> index;
+    ReadChunkIndex(fileHdl, index);
+    int64_t total = 0;
+    for(auto const &chunk : index) total += chunk.nbytes;
+    #ifdef WITH_MPI
+      offset += total;
+    #else
+      fseek(fileHdl, total, SEEK_CUR);
+    #endif
+    return;
+  }
   // Get total size
   for(int i=0; i < ndim; i++) {
     ntot=ntot*dim[i];
@@ -617,6 +695,9 @@ bool Dump::Read(Output& output, int readNumber ) {
 
   idfx::pushRegion("Dump::Read");
 
+  // Make sure that the dumps being written are complete
+  Flush();
+
   fs::path readDir = this->outputDirectory;
 
   if(readNumber<0) {
@@ -728,7 +809,9 @@ bool Dump::Read(Output& output, int readNumber ) {
               if(i!=direction) nx[i] ++;
             }
           }
-          if(scalar.GetLocation() == DumpField::ArrayLocation::Center) {
+          if(type == CompressedType) {
+            ReadCompressed(fileHdl, nx, gstart.data(), scrch);
+          } else if(scalar.GetLocation() == DumpField::ArrayLocation::Center) {
             ReadDistributed(fileHdl, ndim, nx, nxglob, descCR, scrch);
           } else if(scalar.GetLocation() == DumpField::ArrayLocation::Face) {
             ReadDistributed(fileHdl, ndim, nx, nxglob, descSR[direction], scrch);
@@ -794,6 +877,9 @@ int Dump::Write(Output& output) {
   char fieldName[NAMESIZE+1]; // +1 is just in case
   int nx[3];
   int nxtot[3];
+  std::vector<DumpChunk> chunkIndex;
+  std::vector<char> chunks;
+  int64_t chunkPosition;
 
   #ifndef SINGLE_PRECISION
   const DataType realType = DoubleType;
@@ -802,6 +888,10 @@ int Dump::Write(Output& output) {
   #endif
   IdfxFileHandler fileHdl;
 
+  CheckLossyFields();
+
+  if(asyncSnapshots > 0) return(WriteAsync(output));
+
   idfx::pushRegion("Dump::Write");
 
   idfx::cout << "Dump: Write file n " << dumpFileNumber << "..." << std::flush;
@@ -880,41 +970,15 @@ int Dump::Write(Output& output) {
     if(scalar.GetType() == DumpField::Type::IdefixArray) {
       auto toWrite = scalar.GetHostField<IdefixHostArray3D<real>>();
       int dir = scalar.GetDirection();
-      for(int i = 0; i < 3 ; i++) {
-        nx[i] = data->np_int[i];
-        nxtot[i] = gridHost.np_int[i];
-      }
-
-      if(scalar.GetLocation() == DumpField::ArrayLocation::Face) {
-        // If it is the last datablock of the dimension, increase the size by one to get the last
-        //active face of the staggered mesh.
-        if(data->mygrid->xproc[dir] == data->mygrid->nproc[dir] - 1  ) nx[dir]++;
-        nxtot[dir]++;
-      }
-
-      if(scalar.GetLocation() == DumpField::ArrayLocation::Edge) {
-        // If it is the last datablock of the dimension, increase the size by one in the direction
-        // perpendicular to the vector.
-        for(int i = 0 ; i < DIMENSIONS ; i++) {
-          if(i != dir) {
-            if(data->mygrid->xproc[i] == data->mygrid->nproc[i] - 1) nx[i]++;
-            nxtot[i]++;
-          }
-        }
-      }
+      GetFieldSize(scalar, nx, nxtot);
 
       // Load the dataset in the scratch array
-      for(int k = 0; k < nx[KDIR]; k++) {
-        for(int j = 0 ; j < nx[JDIR]; j++) {
-          for(int i = 0; i < nx[IDIR]; i++) {
-            scrch[i + j*nx[IDIR] + k*nx[IDIR]*nx[JDIR]] = toWrite(k+data->beg[KDIR],
-                                                                  j+data->beg[JDIR],
-                                                                  i+data->beg[IDIR]);
-          }
-        }
-      }
+      LoadLocalBlock(toWrite, nx, scrch);
 
-      if(scalar.GetLocation() == DumpField::ArrayLocation::Center) {
+      if(compression) {
+        CompressLocalBlock(name, scalar, nx, scrch, chunkIndex, chunks, chunkPosition);
+        WriteCompressed(fileHdl, nxtot, fieldName, chunkIndex, chunks, chunkPosition);
+      } else if(scalar.GetLocation() == DumpField::ArrayLocation::Center) {
         WriteDistributed(fileHdl, 3, nx, nxtot, fieldName, this->descCW, scrch);
       } else if(scalar.GetLocation() == DumpField::ArrayLocation::Face) {
         WriteDistributed(fileHdl, 3, nx, nxtot, fieldName, this->descSW[dir], scrch);
@@ -957,3 +1021,555 @@ int Dump::Write(Output& output) {
 
   return(0);
 }
+
+// Size of the local block and of the full domain of a distributed field
+void Dump::GetFieldSize(const DumpField &scalar, int *nx, int *nxtot) {
+  int dir = scalar.GetDirection();
+  for(int i = 0; i < 3 ; i++) {
+    nx[i] = data->np_int[i];
+    nxtot[i] = data->mygrid->np_int[i];
+  }
+
+  if(scalar.GetLocation() == DumpField::ArrayLocation::Face) {
+    // If it is the last datablock of the dimension, increase the size by one to get the last
+    //active face of the staggered mesh.
+    if(data->mygrid->xproc[dir] == data->mygrid->nproc[dir] - 1  ) nx[dir]++;
+    nxtot[dir]++;
+  }
+
+  if(scalar.GetLocation() == DumpField::ArrayLocation::Edge) {
+    // If it is the last datablock of the dimension, increase the size by one in the direction
+    // perpendicular to the vector.
+    for(int i = 0 ; i < DIMENSIONS ; i++) {
+      if(i != dir) {
+        if(data->mygrid->xproc[i] == data->mygrid->nproc[i] - 1) nx[i]++;
+        nxtot[i]++;
+      }
+    }
+  }
+}
+
+// Copy the active part of a field in a contiguous array
+void Dump::LoadLocalBlock(const IdefixHostArray3D<real> &toWrite, int *nx, real *dest) {
+  for(int k = 0; k < nx[KDIR]; k++) {
+    for(int j = 0 ; j < nx[JDIR]; j++) {
+      for(int i = 0; i < nx[IDIR]; i++) {
+        dest[i + j*nx[IDIR] + k*nx[IDIR]*nx[JDIR]] = toWrite(k+data->beg[KDIR],
+                                                             j+data->beg[JDIR],
+                                                             i+data->beg[IDIR]);
+      }
+    }
+  }
+}
+
+// Check the fields which are compressed with the lossy codec
+void Dump::CheckLossyFields() {
+  if(lossyChecked) return;
+  lossyChecked = true;
+  for(auto const& [name, tolerance] : lossyFields) {
+    auto it = dumpFieldMap.find(name);
+    if(it == dumpFieldMap.end() || it->second.GetType() != DumpField::Type::IdefixArray) {
+      IDEFIX_WARNING("[Output]:dmp_lossy: "+name+" is not a distributed field of the dumps. "
+                     "Ignoring it.");
+    } else if(it->second.GetLocation() != DumpField::ArrayLocation::Center) {
+      // Lossy face-centered fields would not be divergence-free anymore on restarts
+      IDEFIX_ERROR("[Output]:dmp_lossy: "+name+" is face or edge-centered and can only be "
+                   "compressed losslessly.");
+    }
+  }
+}
+
+// Split the local block of a distributed field in chunks, compress them, and build the chunk
+// index of the full domain. Return the compressed chunks of this process and their position
+// in the field, after the chunk index.
+void Dump::CompressLocalBlock(const std::string &name, const DumpField &scalar, int *nx,
+                              real *block, std::vector<DumpChunk> &chunkIndex,
+                              std::vector<char> &chunks, int64_t &position) {
+  DumpCodec::Codec codec = DumpCodec::lossless;
+  double tolerance = 0;
+  if(auto it = lossyFields.find(name) ; it != lossyFields.end()
+                                    && scalar.GetLocation() == DumpField::ArrayLocation::Center) {
+    codec = DumpCodec::lossy;
+    tolerance = it->second;
+  }
+
+  // The chunks are slabs along the outermost direction, which are contiguous in the block
+  int dir = KDIR;
+  while(dir > IDIR && nx[dir] == 1) dir--;
+  int64_t plane = 1;
+  for(int d = 0 ; d < 3 ; d++) {
+    if(d != dir) plane *= nx[d];
+  }
+  const int nslab = static_cast<int>(std::max<int64_t>(1, CHUNKSIZE/plane));
+
+  std::vector<DumpChunk> localIndex;
+  std::vector<char> buffer;
+  chunks.clear();
+  for(int s = 0 ; s < nx[dir] ; s += nslab) {
+    DumpChunk chunk;
+    for(int d = 0 ; d < 3 ; d++) {
+      chunk.start[d] = gstart[d];
+      chunk.size[d] = nx[d];
+    }
+    chunk.start[dir] += s;
+    chunk.size[dir] = std::min(nslab, nx[dir]-s);
+    chunk.codec = DumpCodec::Compress(block + plane*s, plane*chunk.size[dir], codec,
+                                      tolerance, buffer);
+    chunk.wordSize = sizeof(real);
+    chunk.tolerance = (chunk.codec == DumpCodec::lossy) ? tolerance : 0;
+    chunk.nbytes = buffer.size();
+    chunks.insert(chunks.end(), buffer.begin(), buffer.end());
+    localIndex.push_back(chunk);
+  }
+
+  // Gather the index of all the processes, in the order of the ranks
+  int first = 0;
+  #ifdef WITH_MPI
+    const int nlocal = localIndex.size();
+    std::vector<int> count(idfx::psize);
+    std::vector<int> displ(idfx::psize);
+    MPI_SAFE_CALL(MPI_Allgather(&nlocal, 1, MPI_INT, count.data(), 1, MPI_INT,
+                                MPI_COMM_WORLD));
+    int nchunks = 0;
+    for(int p = 0 ; p < idfx::psize ; p++) {
+      if(p == idfx::prank) first = nchunks;
+      displ[p] = nchunks*sizeof(DumpChunk);
+      nchunks += count[p];
+      count[p] *= sizeof(DumpChunk);
+    }
+    chunkIndex.resize(nchunks);
+    MPI_SAFE_CALL(MPI_Allgatherv(localIndex.data(), nlocal*sizeof(DumpChunk), MPI_BYTE,
+                                 chunkIndex.data(), count.data(), displ.data(), MPI_BYTE,
+                                 MPI_COMM_WORLD));
+  #else
+    chunkIndex = localIndex;
+  #endif
+
+  int64_t current = 0;
+  for(int c = 0 ; c < chunkIndex.size() ; c++) {
+    if(c == first) position = current;
+    chunkIndex[c].position = current;
+    current += chunkIndex[c].nbytes;
+  }
+}
+
+void Dump::WriteCompressed(IdfxFileHandler fileHdl, int *gdim, char *name,
+                           std::vector<DumpChunk> &chunkIndex, std::vector<char> &chunks,
+                           int64_t position) {
+  DataType type = CompressedType;
+  int ndim = 3;
+  int nchunks = chunkIndex.size();
+  int64_t total = 0;
+  for(auto const &chunk : chunkIndex) total += chunk.nbytes;
+
+  // Write field name
+  WriteString(fileHdl, name, NAMESIZE);
+
+  #ifdef WITH_MPI
+    MPI_Status status;
+    // Write data type, dimensions and chunk index
+    MPI_SAFE_CALL(MPI_File_set_view(fileHdl, offset, MPI_BYTE,
+                                    MPI_CHAR, "native", MPI_INFO_NULL ));
+    if(idfx::prank==0) {
+      MPI_SAFE_CALL(MPI_File_write(fileHdl, &type, 1, MPI_INT, &status));
+      MPI_SAFE_CALL(MPI_File_write(fileHdl, &ndim, 1, MPI_INT, &status));
+      MPI_SAFE_CALL(MPI_File_write(fileHdl, gdim, ndim, MPI_INT, &status));
+      MPI_SAFE_CALL(MPI_File_write(fileHdl, &nchunks, 1, MPI_INT, &status));
+      MPI_SAFE_CALL(MPI_File_write(fileHdl, chunkIndex.data(), nchunks*sizeof(DumpChunk),
+                                   MPI_BYTE, &status));
+    }
+    offset = offset + (3+ndim)*sizeof(int) + nchunks*sizeof(DumpChunk);
+
+    // Each process writes its own chunks
+    MPI_SAFE_CALL(MPI_File_set_view(fileHdl, offset, MPI_BYTE,
+                                    MPI_BYTE, "native", MPI_INFO_NULL ));
+    MPI_SAFE_CALL(MPI_File_write_at_all(fileHdl, position, chunks.data(), chunks.size(),
+                                        MPI_BYTE, MPI_STATUS_IGNORE));
+    offset = offset + total;
+  #else
+    fwrite(&type, 1, sizeof(int), fileHdl);
+    fwrite(&ndim, 1, sizeof(int), fileHdl);
+    fwrite(gdim, ndim, sizeof(int), fileHdl);
+    fwrite(&nchunks, 1, sizeof(int), fileHdl);
+    fwrite(chunkIndex.data(), nchunks, sizeof(DumpChunk), fileHdl);
+    fwrite(chunks.data(), 1, chunks.size(), fileHdl);
+  #endif
+}
+
+void Dump::ReadChunkIndex(IdfxFileHandler fileHdl, std::vector<DumpChunk> &chunkIndex) {
+  int nchunks;
+  #ifdef WITH_MPI
+    MPI_Status status;
+    MPI_SAFE_CALL(MPI_File_set_view(fileHdl, this->offset, MPI_BYTE,
+                                    MPI_CHAR, "native", MPI_INFO_NULL ));
+    if(idfx::prank==0) {
+      MPI_SAFE_CALL(MPI_File_read(fileHdl, &nchunks, 1, MPI_INT, &status));
+    }
+    MPI_SAFE_CALL(MPI_Bcast(&nchunks, 1, MPI_INT, 0, MPI_COMM_WORLD));
+    chunkIndex.resize(nchunks);
+    if(idfx::prank==0) {
+      MPI_SAFE_CALL(MPI_File_read(fileHdl, chunkIndex.data(), nchunks*sizeof(DumpChunk),
+                                  MPI_BYTE, &status));
+    }
+    MPI_SAFE_CALL(MPI_Bcast(chunkIndex.data(), nchunks*sizeof(DumpChunk), MPI_BYTE,
+                            0, MPI_COMM_WORLD));
+    offset = offset + sizeof(int) + nchunks*sizeof(DumpChunk);
+  #else
+    if(fread(&nchunks, sizeof(int), 1, fileHdl) < 1) {
+      IDEFIX_ERROR("Error: unexpected end of dump file");
+    }
+    chunkIndex.resize(nchunks);
+    if(fread(chunkIndex.data(), sizeof(DumpChunk), nchunks, fileHdl) < nchunks) {
+      IDEFIX_ERROR("Error: unexpected end of dump file");
+    }
+  #endif
+}
+
+// Read the part of a compressed field starting at the global index start, of size dim.
+// Only the chunks which overlap this box are read and decompressed.
+void Dump::ReadCompressed(IdfxFileHandler fileHdl, int *dim, int *start, real *data) {
+  std::vector<DumpChunk> chunkIndex;
+  ReadChunkIndex(fileHdl, chunkIndex);
+
+  int64_t total = 0;
+  for(auto const &chunk : chunkIndex) total += chunk.nbytes;
+
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_File_set_view(fileHdl, offset, MPI_BYTE,
+                                    MPI_BYTE, "native", MPI_INFO_NULL ));
+  #else
+    const int64_t dataStart = ftell(fileHdl);
+  #endif
+
+  std::vector<char> buffer;
+  std::vector<real> values;
+  for(auto const &chunk : chunkIndex) {
+    int lo[3], hi[3];
+    bool overlap = true;
+    for(int d = 0 ; d < 3 ; d++) {
+      lo[d] = std::max(start[d], chunk.start[d]);
+      hi[d] = std::min(start[d]+dim[d], chunk.start[d]+chunk.size[d]);
+      if(hi[d] <= lo[d]) overlap = false;
+    }
+    if(!overlap) continue;
+
+    if(chunk.wordSize != sizeof(real)) {
+      IDEFIX_ERROR("Compressed dump written with a different precision");
+    }
+    buffer.resize(chunk.nbytes);
+    #ifdef WITH_MPI
+      MPI_SAFE_CALL(MPI_File_read_at(fileHdl, chunk.position, buffer.data(), chunk.nbytes,
+                                     MPI_BYTE, MPI_STATUS_IGNORE));
+    #else
+      fseek(fileHdl, dataStart + chunk.position, SEEK_SET);
+      if(fread(buffer.data(), 1, chunk.nbytes, fileHdl) < chunk.nbytes) {
+        IDEFIX_ERROR("Error: unexpected end of dump file");
+      }
+    #endif
+    const int64_t n = static_cast<int64_t>(chunk.size[IDIR])*chunk.size[JDIR]*chunk.size[KDIR];
+    values.resize(n);
+    if(!DumpCodec::Decompress(buffer.data(), chunk.nbytes,
+                              static_cast<DumpCodec::Codec>(chunk.codec), chunk.tolerance,
+                              n, values.data())) {
+      IDEFIX_ERROR("Corrupted chunk in compressed dump file");
+    }
+
+    // Copy the overlap in the destination block
+    for(int k = lo[KDIR] ; k < hi[KDIR] ; k++) {
+      for(int j = lo[JDIR] ; j < hi[JDIR] ; j++) {
+        for(int i = lo[IDIR] ; i < hi[IDIR] ; i++) {
+          data[(i-start[IDIR]) + (j-start[JDIR])*dim[IDIR]
+               + (k-start[KDIR])*dim[IDIR]*dim[JDIR]] =
+            values[(i-chunk.start[IDIR]) + (j-chunk.start[JDIR])*chunk.size[IDIR]
+                   + (k-chunk.start[KDIR])*chunk.size[IDIR]*chunk.size[JDIR]];
+        }
+      }
+    }
+  }
+
+  #ifdef WITH_MPI
+    offset = offset + total;
+  #else
+    fseek(fileHdl, dataStart + total, SEEK_SET);
+  #endif
+}
+
+// Asynchronous version of Write: the content of the dump is copied in a host snapshot, which
+// is written by a background thread while the integration goes on.
+int Dump::WriteAsync(Output& output) {
+  fs::path filename;
+  int nx[3];
+  int nxtot[3];
+
+  #ifndef SINGLE_PRECISION
+  const DataType realType = DoubleType;
+  #else
+  const DataType realType = SingleType;
+  #endif
+
+  idfx::pushRegion("Dump::WriteAsync");
+
+  // Wait for a free snapshot (this blocks when too many dumps are being written)
+  DumpSnapshot *snap;
+  std::string error;
+  {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    writerCondition.wait(lock, [this] { return !freeSnapshots.empty(); });
+    snap = freeSnapshots.front();
+    freeSnapshots.pop_front();
+    error = writerError;
+  }
+  if(!error.empty()) IDEFIX_ERROR(error);
+
+  idfx::cout << "Dump: Write file n " << dumpFileNumber << " in the background..." << std::flush;
+
+  // Reset timer
+  timer.reset();
+
+  // Set filenames
+  std::stringstream ssdumpFileNum,ssFileName;
+  ssdumpFileNum << std::setfill('0') << std::setw(4) << dumpFileNumber;
+  ssFileName << "dump." << ssdumpFileNum.str() << ".dmp";
+  filename = outputDirectory/ssFileName.str();
+
+  dumpFileNumber++;   // For next one
+
+  // Create an empty file, which is then filled by the writer thread of each process
+  if(idfx::prank==0) {
+    if(fs::exists(filename)) {
+      fs::remove(filename);
+    }
+    FILE *file = fopen(filename.c_str(),"wb");
+    if(file == NULL) {
+      std::stringstream msg;
+      msg << "Dump: cannot create file " << filename;
+      IDEFIX_ERROR(msg);
+    }
+    fclose(file);
+  }
+  #ifdef WITH_MPI
+  MPI_Barrier(MPI_COMM_WORLD);
+  #endif
+
+  snap->filename = filename;
+  snap->nrecords = 0;
+
+  GridHost gridHost(*data->mygrid);
+  gridHost.SyncFromDevice();
+
+  // Test endianness
+  std::string endian;
+  int tmp1 = 1;
+  unsigned char *tmp2 = (unsigned char *) &tmp1;
+  if (*tmp2 != 0) {
+    endian = "little";
+  } else {
+    endian = "big";
+  }
+  snap->header.assign(HEADERSIZE, 0);
+  std::snprintf(snap->header.data(), HEADERSIZE, "Idefix %s Dump Data %s endian",
+                IDEFIX_VERSION, endian.c_str());
+
+  for(int dir = 0; dir < 3 ; dir++) {
+    const int n = gridHost.np_int[dir];
+    const int ng = gridHost.nghost[dir];
+    snap->AddRecord("x"+std::to_string(dir+1), realType, {n},
+                    gridHost.x[dir].data()+ng, n*sizeof(real));
+    snap->AddRecord("xl"+std::to_string(dir+1), realType, {n},
+                    gridHost.xl[dir].data()+ng, n*sizeof(real));
+    snap->AddRecord("xr"+std::to_string(dir+1), realType, {n},
+                    gridHost.xr[dir].data()+ng, n*sizeof(real));
+  }
+
+  for(auto const& [name, scalar] : dumpFieldMap) {
+    if(scalar.GetType() == DumpField::Type::IdefixArray) {
+      auto toWrite = scalar.GetHostField<IdefixHostArray3D<real>>();
+      GetFieldSize(scalar, nx, nxtot);
+      if(compression) {
+        // The chunks are compressed here, since their position in the file depends on the
+        // size of the chunks of the other processes
+        LoadLocalBlock(toWrite, nx, scrch);
+        std::vector<DumpChunk> chunkIndex;
+        auto &rec = snap->AddRecord(name, CompressedType,
+                                    {nxtot[IDIR], nxtot[JDIR], nxtot[KDIR]}, nullptr, 0);
+        CompressLocalBlock(name, scalar, nx, scrch, chunkIndex, rec.chunks, rec.chunkPosition);
+        const int nchunks = chunkIndex.size();
+        rec.compressed = true;
+        rec.data.resize(sizeof(int) + nchunks*sizeof(DumpChunk));
+        std::memcpy(rec.data.data(), &nchunks, sizeof(int));
+        std::memcpy(rec.data.data()+sizeof(int), chunkIndex.data(), nchunks*sizeof(DumpChunk));
+        rec.chunkBytes = 0;
+        for(auto const &chunk : chunkIndex) rec.chunkBytes += chunk.nbytes;
+        continue;
+      }
+      auto &rec = snap->AddRecord(name, realType, {nxtot[IDIR], nxtot[JDIR], nxtot[KDIR]},
+                                  nullptr, sizeof(real)*nx[IDIR]*nx[JDIR]*nx[KDIR]);
+      rec.distributed = true;
+      rec.nx = {nx[IDIR], nx[JDIR], nx[KDIR]};
+      LoadLocalBlock(toWrite, nx, reinterpret_cast<real*>(rec.data.data()));
+    } else {
+      // Scalar type if a fundamental type, not distributed
+      DataType thisType;
+      size_t size;
+      if(scalar.GetType()==DumpField::Type::Int) {
+        thisType = DataType::IntegerType;
+        size = sizeof(int);
+      }
+      if(scalar.GetType()==DumpField::Type::Single) {
+        thisType = DataType::SingleType;
+        size = sizeof(float);
+      }
+      if(scalar.GetType()==DumpField::Type::Double) {
+        thisType = DataType::DoubleType;
+        size = sizeof(double);
+      }
+      if(scalar.GetType()==DumpField::Type::Bool) {
+        thisType = DataType::BoolType;
+        size = sizeof(bool);
+      }
+      snap->AddRecord(name, thisType, {scalar.GetSize()}, scalar.GetHostField<void*>(),
+                      size*scalar.GetSize());
+    }
+  }
+
+  // End of file
+  real zero = 0.0;
+  snap->AddRecord("eof", realType, {1}, &zero, sizeof(real));
+
+  // Hand the snapshot over to the writer
+  {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    pendingSnapshots.push_back(snap);
+  }
+  writerCondition.notify_all();
+
+  idfx::cout << "snapshot taken in " << timer.seconds() << " s." << std::endl;
+  idfx::popRegion();
+  return(0);
+}
+
+// Main loop of the background writer thread
+void Dump::WriterLoop() {
+  while(true) {
+    DumpSnapshot *snap;
+    {
+      std::unique_lock<std::mutex> lock(writerMutex);
+      writerCondition.wait(lock, [this] { return stopWriter || !pendingSnapshots.empty(); });
+      if(pendingSnapshots.empty()) return;
+      snap = pendingSnapshots.front();
+      pendingSnapshots.pop_front();
+      writerBusy = true;
+    }
+    WriteSnapshot(*snap);
+    {
+      std::lock_guard<std::mutex> lock(writerMutex);
+      writerBusy = false;
+      freeSnapshots.push_back(snap);
+    }
+    writerCondition.notify_all();
+  }
+}
+
+// Write a snapshot with positional writes: each process writes its own part of the distributed
+// fields at its offset in the file, so that no MPI call is needed in the writer thread.
+// The file has the same layout as the one produced by Write.
+void Dump::WriteSnapshot(DumpSnapshot &snap) {
+  int fd = open(snap.filename.c_str(), O_WRONLY);
+  bool success = (fd >= 0);
+  const bool root = (idfx::prank == 0);
+
+  auto writeAt = [&](const void *buffer, size_t size, off_t position) {
+    const char *ptr = static_cast<const char*>(buffer);
+    while(success && size > 0) {
+      ssize_t n = pwrite(fd, ptr, size, position);
+      if(n < 0 && errno == EINTR) continue;
+      if(n <= 0) {
+        success = false;
+        break;
+      }
+      ptr += n;
+      size -= n;
+      position += n;
+    }
+  };
+
+  off_t offset = 0;
+  if(root) writeAt(snap.header.data(), HEADERSIZE, offset);
+  offset += HEADERSIZE;
+
+  for(int r = 0 ; r < snap.nrecords ; r++) {
+    DumpSnapshot::Record &rec = snap.records[r];
+    int ndim = rec.dim.size();
+    int type = rec.type;
+    if(root) {
+      char fieldName[NAMESIZE+1] = {0};
+      std::snprintf(fieldName, NAMESIZE, "%s", rec.name.c_str());
+      writeAt(fieldName, NAMESIZE, offset);
+      writeAt(&type, sizeof(int), offset + NAMESIZE);
+      writeAt(&ndim, sizeof(int), offset + NAMESIZE + sizeof(int));
+      writeAt(rec.dim.data(), ndim*sizeof(int), offset + NAMESIZE + 2*sizeof(int));
+    }
+    offset += NAMESIZE + (2+ndim)*sizeof(int);
+
+    if(rec.compressed) {
+      // Chunk index, then the chunks of each process
+      if(root) writeAt(rec.data.data(), rec.data.size(), offset);
+      offset += rec.data.size();
+      writeAt(rec.chunks.data(), rec.chunks.size(), offset + rec.chunkPosition);
+      offset += rec.chunkBytes;
+    } else if(!rec.distributed) {
+      if(root) writeAt(rec.data.data(), rec.data.size(), offset);
+      offset += rec.data.size();
+    } else {
+      // Write the lines of the local block, merging those which are contiguous in the file
+      const int64_t gx = rec.dim[IDIR];
+      const int64_t gy = rec.dim[JDIR];
+      const size_t len = rec.nx[IDIR]*sizeof(real);
+      off_t runFile = 0;
+      size_t runMem = 0;
+      size_t runLen = 0;
+      for(int k = 0 ; k < rec.nx[KDIR] ; k++) {
+        for(int j = 0 ; j < rec.nx[JDIR] ; j++) {
+          const off_t pos = offset + ((k+gstart[KDIR])*gy*gx + (j+gstart[JDIR])*gx
+                                      + gstart[IDIR])*sizeof(real);
+          const size_t mem = (static_cast<size_t>(k)*rec.nx[JDIR] + j)*len;
+          if(runLen > 0 && pos == runFile + static_cast<off_t>(runLen)
+                        && mem == runMem + runLen) {
+            runLen += len;
+          } else {
+            if(runLen > 0) writeAt(rec.data.data() + runMem, runLen, runFile);
+            runFile = pos;
+            runMem = mem;
+            runLen = len;
+          }
+        }
+      }
+      if(runLen > 0) writeAt(rec.data.data() + runMem, runLen, runFile);
+      offset += gx*gy*rec.dim[KDIR]*sizeof(real);
+    }
+  }
+
+  if(fd >= 0) close(fd);
+
+  if(!success) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    writerError = "Dump: failed to write " + snap.filename.string();
+  }
+}
+
+void Dump::Flush() {
+  if(asyncSnapshots == 0) return;
+  idfx::pushRegion("Dump::Flush");
+  std::string error;
+  {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    writerCondition.wait(lock, [this] { return pendingSnapshots.empty() && !writerBusy; });
+    error = writerError;
+  }
+  if(!error.empty()) IDEFIX_ERROR(error);
+  #ifdef WITH_MPI
+  // The dump files are complete once every process has written its part
+  MPI_Barrier(MPI_COMM_WORLD);
+  #endif
+  idfx::popRegion();
+}
@@ -10,6 +10,13 @@
 #include <string>
 #include <map>
 #include <array>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
 #if __has_include(<filesystem>)
   #include <filesystem>
   namespace fs = std::filesystem;
@@ -22,9 +29,10 @@
 #include "idefix.hpp"
 #include "input.hpp"
 #include "dataBlock.hpp"
+#include "dumpCodec.hpp"
 
 
-enum DataType {DoubleType, SingleType, IntegerType, BoolType};
+enum DataType {DoubleType, SingleType, IntegerType, BoolType, CompressedType};
 
 // Define data descriptor used for distributed I/O when MPI is enabled
 #ifdef WITH_MPI
@@ -42,7 +50,7 @@ class DataBlock;
 class DumpField {
  public:
   enum Type {Int, Single, Double, Bool, IdefixArray};
-  enum ArrayType {Device3D, Device4D, Host3D, Host4D};
+  enum ArrayType {Device3D, Device4D, DeviceStore4D, Host3D, Host4D};
   enum ArrayLocation {Center, Face, Edge};
 
   DumpField(IdefixArray4D<real>& in, const int varnum, const ArrayLocation loc, const int dir):
@@ -53,6 +61,13 @@ class DumpField {
     h4Darray{in}, var{varnum}, arrayType{Host4D},
     type{IdefixArray}, arrayLocation{loc}, direction{dir} {};
 
+#ifdef MIXED_PRECISION
+  DumpField(IdefixArray4D<realStore>& in, const int varnum, const ArrayLocation loc,
+            const int dir):
+    ds4Darray{in}, var{varnum}, arrayType{DeviceStore4D},
+    type{IdefixArray}, arrayLocation{loc}, direction{dir} {};
+#endif
+
   DumpField(IdefixArray3D<real>& in, const ArrayLocation loc, const int dir):
     d3Darray{in}, arrayType{Device3D},
     type{IdefixArray}, arrayLocation{loc}, direction{dir} {};
@@ -92,11 +107,34 @@ class DumpField {
         Kokkos::deep_copy(arr3D,d3Darray);
         return(arr3D);
       } else if(arrayType==Device4D) {
-        IdefixArray3D<real> arrDev3D = Kokkos::subview(
-                                       d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+        #ifdef FIELD_LAYOUT_AOS
+          // The variable is not contiguous in memory: gather it in a temporary array first
+          IdefixArray3D<real> arrDev3D("DumpFieldSlice", d4Darray.extent(1),
+                                       d4Darray.extent(2), d4Darray.extent(3));
+          Kokkos::deep_copy(arrDev3D, Kokkos::subview(
+                                        d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL));
+        #else
+          IdefixArray3D<real> arrDev3D = Kokkos::subview(
+                                        d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+        #endif
+        IdefixHostArray3D<real> arr3D = Kokkos::create_mirror(arrDev3D);
+        Kokkos::deep_copy(arr3D,arrDev3D);
+        return(arr3D);
+#ifdef MIXED_PRECISION
+      } else if(arrayType==DeviceStore4D) {
+        // Dumps are always written in real precision
+        IdefixArray3D<real> arrDev3D("DumpFieldSlice", ds4Darray.extent(1),
+                                     ds4Darray.extent(2), ds4Darray.extent(3));
+        IdefixArray4D<realStore> arr4D = ds4Darray;
+        const int nv = var;
+        idefix_for("DumpFieldConvert",0,arr4D.extent(1),0,arr4D.extent(2),0,arr4D.extent(3),
+          KOKKOS_LAMBDA (int k, int j, int i) {
+            arrDev3D(k,j,i) = static_cast<real>(arr4D(nv,k,j,i));
+          });
         IdefixHostArray3D<real> arr3D = Kokkos::create_mirror(arrDev3D);
         Kokkos::deep_copy(arr3D,arrDev3D);
         return(arr3D);
+#endif
       } else {
         IDEFIX_ERROR("unknown field");
         return(h3Darray);
@@ -120,9 +158,30 @@ class DumpField {
       } else if(arrayType==Device3D) {
         Kokkos::deep_copy(d3Darray,in);
       } else if(arrayType==Device4D) {
-        IdefixArray3D<real> arrDev3D = Kokkos::subview(
-                                       d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+        #ifdef FIELD_LAYOUT_AOS
+          // The variable is not contiguous in memory: scatter it from a temporary array
+          IdefixArray3D<real> arrDev3D("DumpFieldSlice", d4Darray.extent(1),
+                                       d4Darray.extent(2), d4Darray.extent(3));
+          Kokkos::deep_copy(arrDev3D,in);
+          Kokkos::deep_copy(Kokkos::subview(
+                              d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL), arrDev3D);
+        #else
+          IdefixArray3D<real> arrDev3D = Kokkos::subview(
+                                         d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+          Kokkos::deep_copy(arrDev3D,in);
+        #endif
+#ifdef MIXED_PRECISION
+      } else if(arrayType==DeviceStore4D) {
+        IdefixArray3D<real> arrDev3D("DumpFieldSlice", ds4Darray.extent(1),
+                                     ds4Darray.extent(2), ds4Darray.extent(3));
         Kokkos::deep_copy(arrDev3D,in);
+        IdefixArray4D<realStore> arr4D = ds4Darray;
+        const int nv = var;
+        idefix_for("DumpFieldConvert",0,arr4D.extent(1),0,arr4D.extent(2),0,arr4D.extent(3),
+          KOKKOS_LAMBDA (int k, int j, int i) {
+            arr4D(nv,k,j,i) = static_cast<realStore>(arrDev3D(k,j,i));
+          });
+#endif
       }
     }
     // Nothing to sync otherwise
@@ -155,6 +214,9 @@ class DumpField {
   IdefixArray3D<real> d3Darray;
   IdefixHostArray4D<real> h4Darray;
   IdefixHostArray3D<real> h3Darray;
+#ifdef MIXED_PRECISION
+  IdefixArray4D<realStore> ds4Darray;
+#endif
 
   void *rawData;
   int rawSize;
@@ -172,8 +234,57 @@ struct GridBox {
   std::array<int,3> sizeGlob;
 };
 
+// Entry of the chunk index of a compressed distributed field. In the file, a compressed field
+// is made of the number of chunks, the chunk index, and the compressed chunks.
+struct DumpChunk {
+  int start[3];       // Global index of the first element of the chunk
+  int size[3];        // Size of the chunk
+  int codec;          // DumpCodec::Codec used for this chunk
+  int wordSize;       // Size of the uncompressed values
+  int64_t position;   // Position of the compressed chunk, from the end of the chunk index
+  int64_t nbytes;     // Size of the compressed chunk
+  double tolerance;   // Error bound of lossy chunks
+};
+
+// Host copy of the content of a dump file, which is written by a background thread in
+// asynchronous mode. Snapshots are recycled from one dump to the next, so that the host
+// staging buffers are only allocated once.
+struct DumpSnapshot {
+  struct Record {
+    std::string name;
+    DataType type;
+    std::vector<int> dim;         // Dimensions of the field in the file
+    bool distributed{false};      // Whether the field is distributed between processes
+    std::array<int,3> nx;         // Size of the local block (distributed fields)
+    std::vector<char> data;       // Raw data (local block for distributed fields)
+    bool compressed{false};       // Compressed field: data holds the chunk index
+    std::vector<char> chunks;     // Compressed chunks of the local block
+    int64_t chunkPosition{0};     // Position of the local chunks after the chunk index
+    int64_t chunkBytes{0};        // Size of the compressed chunks of all the processes
+  };
+  fs::path filename;
+  std::vector<char> header;
+  std::vector<Record> records;
+  int nrecords{0};                // Number of records of the current dump
+
+  Record& AddRecord(const std::string &name, DataType type, std::vector<int> dim,
+                    const void *src, size_t size) {
+    if(nrecords == records.size()) records.emplace_back();
+    Record &rec = records[nrecords++];
+    rec.name = name;
+    rec.type = type;
+    rec.dim = dim;
+    rec.distributed = false;
+    rec.compressed = false;
+    rec.data.resize(size);
+    if(src != nullptr) std::memcpy(rec.data.data(), src, size);
+    return(rec);
+  }
+};
+
 class Dump {
   friend class DumpImage; // Allow dumpimag to have access to dump API
+  friend class LoadBalancer; // Allow the load balancer to migrate the registered fields
  public:
   explicit Dump(Input &, DataBlock *);               // Create Dump Object
   explicit Dump(DataBlock *);               // Create a dump object independent of input
@@ -183,6 +294,8 @@ class Dump {
   int Write(Output&);
   // Read and load a dump file as current state of the code
   bool Read(Output&, int);
+  // Wait for the completion of the dumps written in the background
+  void Flush();
 
   // Register IdefixArrays
   void RegisterVariable(IdefixArray3D<real>&,
@@ -207,6 +320,14 @@ class Dump {
                         int dir = -1,
                         DumpField::ArrayLocation loc = DumpField::ArrayLocation::Center );
 
+#ifdef MIXED_PRECISION
+  void RegisterVariable(IdefixArray4D<realStore>&,
+                        std::string,
+                        int varnum,
+                        int dir = -1,
+                        DumpField::ArrayLocation loc = DumpField::ArrayLocation::Center );
+#endif
+
   // Register any other fundamental type
   template<typename T>
   void RegisterVariable(T*,
@@ -249,8 +370,39 @@ class Dump {
   void Skip(IdfxFileHandler, int, int *, DataType);
   int GetLastDumpInDirectory(fs::path &);
   void CreateMPIDataType(GridBox, bool);
+  void GetFieldSize(const DumpField &, int *, int *);
+  void LoadLocalBlock(const IdefixHostArray3D<real> &, int *, real *);
+
+  // Compressed distributed fields
+  bool compression{false};                  // Whether distributed fields are compressed
+  std::map<std::string, double> lossyFields; // Fields using the lossy codec, and error bound
+  bool lossyChecked{false};
+  void CheckLossyFields();
+  void CompressLocalBlock(const std::string &, const DumpField &, int *, real *,
+                          std::vector<DumpChunk> &, std::vector<char> &, int64_t &);
+  void WriteCompressed(IdfxFileHandler, int *, char *, std::vector<DumpChunk> &,
+                       std::vector<char> &, int64_t);
+  void ReadChunkIndex(IdfxFileHandler, std::vector<DumpChunk> &);
+  void ReadCompressed(IdfxFileHandler, int *, int *, real *);
 
   fs::path outputDirectory;
+
+  // Asynchronous writes
+  int asyncSnapshots{0};          // Max number of snapshots in flight (0=synchronous writes)
+  std::array<int,3> gstart;       // Global index of the first cell of the local block
+  std::vector<std::unique_ptr<DumpSnapshot>> snapshots;
+  std::deque<DumpSnapshot*> freeSnapshots;
+  std::deque<DumpSnapshot*> pendingSnapshots;
+  bool writerBusy{false};
+  bool stopWriter{false};
+  std::string writerError;
+  std::thread writer;
+  std::mutex writerMutex;
+  std::condition_variable writerCondition;
+
+  int WriteAsync(Output&);
+  void WriterLoop();
+  void WriteSnapshot(DumpSnapshot &);
 };
 
 
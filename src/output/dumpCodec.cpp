@@ -0,0 +1,224 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "dumpCodec.hpp"
+
+// LZ77 parameters. The compressed stream is a series of sequences made of a token byte
+// (number of literals in the high nibble, match length-minMatch in the low nibble, 15 meaning
+// that the length continues in the next bytes), the literals, and a match given by its 2-byte
+// offset. The last sequence only contains literals.
+namespace {
+constexpr int hashBits = 16;
+constexpr int64_t minMatch = 4;
+constexpr int64_t maxOffset = 65535;
+
+inline uint32_t Read32(const uint8_t *p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(uint32_t));
+  return(v);
+}
+
+inline uint32_t Hash(uint32_t v) {
+  return((v*2654435761u) >> (32-hashBits));
+}
+
+// Extra bytes of a length which does not fit in a nibble
+void WriteLength(std::vector<char> &out, int64_t len) {
+  len -= 15;
+  while(len >= 255) {
+    out.push_back(static_cast<char>(255));
+    len -= 255;
+  }
+  out.push_back(static_cast<char>(len));
+}
+
+bool ReadLength(const uint8_t *in, int64_t size, int64_t &ip, int64_t &len) {
+  if(len < 15) return(true);
+  uint8_t b;
+  do {
+    if(ip >= size) return(false);
+    b = in[ip++];
+    len += b;
+  } while(b == 255);
+  return(true);
+}
+}  // namespace
+
+void DumpCodec::LzCompress(const uint8_t *in, int64_t n, std::vector<char> &out) {
+  std::vector<int64_t> table(1 << hashBits, -1);
+  int64_t anchor = 0;
+  int64_t i = 0;
+
+  auto emit = [&](int64_t litEnd, int64_t offset, int64_t matchLen) {
+    const int64_t litLen = litEnd - anchor;
+    const int64_t m = matchLen - minMatch;
+    const uint8_t token = (std::min<int64_t>(litLen, 15) << 4)
+                          | (matchLen > 0 ? std::min<int64_t>(m, 15) : 0);
+    out.push_back(static_cast<char>(token));
+    if(litLen >= 15) WriteLength(out, litLen);
+    out.insert(out.end(), in+anchor, in+litEnd);
+    if(matchLen > 0) {
+      out.push_back(static_cast<char>(offset & 0xff));
+      out.push_back(static_cast<char>(offset >> 8));
+      if(m >= 15) WriteLength(out, m);
+    }
+  };
+
+  while(i + minMatch <= n) {
+    const uint32_t v = Read32(in+i);
+    const uint32_t h = Hash(v);
+    const int64_t candidate = table[h];
+    table[h] = i;
+    if(candidate >= 0 && i - candidate <= maxOffset && Read32(in+candidate) == v) {
+      int64_t len = minMatch;
+      while(i + len < n && in[candidate+len] == in[i+len]) len++;
+      emit(i, i-candidate, len);
+      i += len;
+      anchor = i;
+    } else {
+      // Skip faster through incompressible data
+      i += 1 + ((i-anchor) >> 8);
+    }
+  }
+  // Last literals
+  emit(n, 0, 0);
+}
+
+bool DumpCodec::LzDecompress(const uint8_t *in, int64_t size, uint8_t *out, int64_t n) {
+  int64_t ip = 0;
+  int64_t op = 0;
+  while(op < n) {
+    if(ip >= size) return(false);
+    const uint8_t token = in[ip++];
+    int64_t litLen = token >> 4;
+    if(!ReadLength(in, size, ip, litLen)) return(false);
+    if(ip + litLen > size || op + litLen > n) return(false);
+    std::memcpy(out+op, in+ip, litLen);
+    ip += litLen;
+    op += litLen;
+    if(op == n) break;
+
+    if(ip + 2 > size) return(false);
+    const int64_t offset = in[ip] | (in[ip+1] << 8);
+    ip += 2;
+    int64_t len = token & 15;
+    if(!ReadLength(in, size, ip, len)) return(false);
+    len += minMatch;
+    if(offset == 0 || offset > op || op + len > n) return(false);
+    // The match can overlap the bytes being written
+    for(int64_t k = 0 ; k < len ; k++) out[op+k] = out[op+k-offset];
+    op += len;
+  }
+  return(op == n);
+}
+
+bool DumpCodec::Quantize(const real *in, int64_t n, double tolerance,
+                         std::vector<uint8_t> &out) {
+  if(!(tolerance > 0)) return(false);
+  const double step = 2.0*tolerance;
+  // Largest integer for which the conversion to double is exact
+  const double qmax = 4503599627370496.0;   // 2^52
+  int64_t previous = 0;
+  out.clear();
+  out.reserve(n);
+  for(int64_t i = 0 ; i < n ; i++) {
+    const double v = in[i];
+    if(!std::isfinite(v)) return(false);
+    const double qd = std::nearbyint(v/step);
+    if(std::fabs(qd) >= qmax) return(false);
+    const int64_t q = static_cast<int64_t>(qd);
+    // Check the error bound with the value which will actually be restored
+    if(std::fabs(static_cast<double>(static_cast<real>(q*step)) - v) > tolerance) return(false);
+    // Zigzag encoding of the difference, so that small negative values stay small
+    const int64_t d = q - previous;
+    uint64_t z = (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63);
+    while(z >= 0x80) {
+      out.push_back(static_cast<uint8_t>(z | 0x80));
+      z >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(z));
+    previous = q;
+  }
+  return(true);
+}
+
+DumpCodec::Codec DumpCodec::Compress(const real *in, int64_t n, Codec codec, double tolerance,
+                                     std::vector<char> &out) {
+  out.clear();
+  if(codec == lossy) {
+    std::vector<uint8_t> quantized;
+    if(Quantize(in, n, tolerance, quantized)) {
+      // Size of the quantized stream, followed by its compressed version
+      const int64_t nq = quantized.size();
+      out.resize(sizeof(int64_t));
+      std::memcpy(out.data(), &nq, sizeof(int64_t));
+      LzCompress(quantized.data(), nq, out);
+      return(lossy);
+    }
+  }
+
+  // Byte shuffle
+  const int64_t word = sizeof(real);
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(in);
+  std::vector<uint8_t> shuffled(n*word);
+  for(int64_t b = 0 ; b < word ; b++) {
+    for(int64_t i = 0 ; i < n ; i++) {
+      shuffled[b*n+i] = bytes[i*word+b];
+    }
+  }
+  LzCompress(shuffled.data(), n*word, out);
+  return(lossless);
+}
+
+bool DumpCodec::Decompress(const char *in, int64_t size, Codec codec, double tolerance,
+                           int64_t n, real *out) {
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(in);
+  if(codec == lossy) {
+    int64_t nq;
+    if(size < static_cast<int64_t>(sizeof(int64_t))) return(false);
+    std::memcpy(&nq, in, sizeof(int64_t));
+    if(nq < n || nq > 10*n) return(false);
+    std::vector<uint8_t> quantized(nq);
+    if(!LzDecompress(bytes+sizeof(int64_t), size-sizeof(int64_t), quantized.data(), nq)) {
+      return(false);
+    }
+    const double step = 2.0*tolerance;
+    int64_t previous = 0;
+    int64_t ip = 0;
+    for(int64_t i = 0 ; i < n ; i++) {
+      uint64_t z = 0;
+      int shift = 0;
+      uint8_t b;
+      do {
+        if(ip >= nq || shift > 63) return(false);
+        b = quantized[ip++];
+        z |= static_cast<uint64_t>(b & 0x7f) << shift;
+        shift += 7;
+      } while(b & 0x80);
+      const int64_t d = static_cast<int64_t>(z >> 1) ^ -static_cast<int64_t>(z & 1);
+      previous += d;
+      out[i] = static_cast<real>(previous*step);
+    }
+    return(ip == nq);
+  }
+
+  if(codec != lossless) return(false);
+  const int64_t word = sizeof(real);
+  std::vector<uint8_t> shuffled(n*word);
+  if(!LzDecompress(bytes, size, shuffled.data(), n*word)) return(false);
+  uint8_t *outBytes = reinterpret_cast<uint8_t *>(out);
+  for(int64_t b = 0 ; b < word ; b++) {
+    for(int64_t i = 0 ; i < n ; i++) {
+      outBytes[i*word+b] = shuffled[b*n+i];
+    }
+  }
+  return(true);
+}
@@ -0,0 +1,41 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef OUTPUT_DUMPCODEC_HPP_
+#define OUTPUT_DUMPCODEC_HPP_
+
+#include <cstdint>
+#include <vector>
+#include "idefix.hpp"
+
+// Codecs used to compress the chunks of the distributed fields of compressed dump files.
+// - lossless: the bytes of the values are shuffled (all the first bytes, then all the second
+//   bytes...) so that the slowly varying sign/exponent bytes are contiguous, and the result
+//   is compressed with a byte-oriented LZ77 scheme.
+// - lossy: the values are quantized on a uniform grid of step 2*tolerance, so that the
+//   pointwise error is bounded by tolerance. The differences between consecutive quantized
+//   values are stored as variable length integers, which are then compressed with LZ77.
+//   Chunks which cannot be quantized (non finite values, or tolerance too small compared to
+//   the values) fall back to the lossless codec.
+class DumpCodec {
+ public:
+  enum Codec {lossless = 0, lossy = 1};
+
+  // Compress n values in out. Return the codec which has actually been used.
+  static Codec Compress(const real *in, int64_t n, Codec codec, double tolerance,
+                        std::vector<char> &out);
+  // Decompress size bytes into n values. Return false if the data are corrupted.
+  static bool Decompress(const char *in, int64_t size, Codec codec, double tolerance,
+                         int64_t n, real *out);
+
+ private:
+  static void LzCompress(const uint8_t *in, int64_t n, std::vector<char> &out);
+  static bool LzDecompress(const uint8_t *in, int64_t size, uint8_t *out, int64_t n);
+  static bool Quantize(const real *in, int64_t n, double tolerance, std::vector<uint8_t> &out);
+};
+
+#endif // OUTPUT_DUMPCODEC_HPP_
@@ -0,0 +1,355 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <cmath>
+#include "insitu.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+#include "gridHost.hpp"
+#include "dump.hpp"
+#include "vector.hpp"
+
+// Azimuthal components used by the angular momentum and the stresses. In cartesian
+// geometry, the azimuthal direction is x2, as in the shearing box.
+#if GEOMETRY == CARTESIAN && COMPONENTS >= 2
+  #define iVPHI  VX2
+  #define iBPHI  BX2
+#endif
+#ifdef iVPHI
+  #define INSITU_HAVE_AZIMUTH 1
+#else
+  #define INSITU_HAVE_AZIMUTH 0
+#endif
+
+using InSituVector = Vector<real, InSitu::nIntegrals>;
+
+namespace {
+const char *integralNames[InSitu::nIntegrals] = {"volume", "mass", "kinetic", "magnetic",
+                                                 "thermal", "angmom", "reynolds", "maxwell"};
+}  // namespace
+
+InSitu::InSitu(Input &input, DataBlock &data, real period) {
+  idfx::pushRegion("InSitu::InSitu");
+  this->insituPeriod = period;
+  this->insituLast = data.t - insituPeriod;   // write something in the next CheckForWrite()
+  data.dump->RegisterVariable(&insituLast, "insituLast");
+
+  // Volume integrals. By default, all of those which make sense with this physics
+  std::vector<bool> available(nIntegrals, true);
+  available[Magnetic] = (MHD == YES);
+  available[Thermal] = HAVE_ENERGY;
+  available[AngularMomentum] = INSITU_HAVE_AZIMUTH;
+  available[Reynolds] = INSITU_HAVE_AZIMUTH;
+  available[Maxwell] = (MHD == YES) && INSITU_HAVE_AZIMUTH;
+
+  const int nentries = input.CheckEntry("Output","insitu_integral");
+  if(nentries > 0) {
+    for(int n = 0 ; n < nentries ; n++) {
+      std::string name = input.Get<std::string>("Output","insitu_integral",n);
+      int q = 0;
+      while(q < nIntegrals && name.compare(integralNames[q]) != 0) q++;
+      if(q == nIntegrals) {
+        IDEFIX_ERROR("Unknown [Output]:insitu_integral "+name);
+      }
+      if(!available[q]) {
+        IDEFIX_ERROR("[Output]:insitu_integral "+name+" is not available with this physics");
+      }
+      integrals.push_back(static_cast<Integral>(q));
+    }
+  } else {
+    for(int q = Mass ; q < nIntegrals ; q++) {
+      if(available[q]) integrals.push_back(static_cast<Integral>(q));
+    }
+  }
+  integralHeader = "# t";
+  for(auto q : integrals) integralHeader += std::string(" ")+integralNames[q];
+
+  GridHost grid(*data.mygrid);
+  grid.SyncFromDevice();
+
+  // Profiles averaged over the two other directions
+  for(int n = 1 ; input.CheckEntry("Output","insitu_average"+std::to_string(n)) > 0 ; n++) {
+    const std::string entry = "insitu_average"+std::to_string(n);
+    const int nvars = input.CheckEntry("Output",entry)-1;
+    Average avg;
+    avg.direction = input.Get<int>("Output",entry,0);
+    if(avg.direction < 0 || avg.direction >= DIMENSIONS) {
+      IDEFIX_ERROR("[Output]:"+entry+" direction should be between 0 and DIMENSIONS-1");
+    }
+    if(nvars < 1) {
+      IDEFIX_ERROR("[Output]:"+entry+" expects a direction and a list of variables");
+    }
+    for(int v = 0 ; v < nvars ; v++) {
+      avg.names.push_back(input.Get<std::string>("Output",entry,v+1));
+      avg.vars.push_back(FindVariable(data, avg.names.back()));
+    }
+    avg.varIdx = IdefixArray1D<int>("InSitu_varIdx",nvars);
+    IdefixArray1D<int>::HostMirror varIdxHost = Kokkos::create_mirror_view(avg.varIdx);
+    for(int v = 0 ; v < nvars ; v++) varIdxHost(v) = avg.vars[v];
+    Kokkos::deep_copy(avg.varIdx, varIdxHost);
+    avg.sum = IdefixArray2D<real>("InSitu_average", nvars+1, data.np_tot[avg.direction]);
+    avg.filename = entry+".dat";
+
+    // The header holds the coordinates of the profile
+    const int dir = avg.direction;
+    std::stringstream header;
+    header << std::scientific << std::setprecision(12);
+    header << "# Volume average along x" << dir+1 << " of";
+    for(auto const &name : avg.names) header << " " << name;
+    header << std::endl << "# x" << dir+1;
+    for(int i = 0 ; i < grid.np_int[dir] ; i++) header << " " << grid.x[dir](i+grid.nghost[dir]);
+    header << std::endl << "# t, then the profile of each variable";
+    avg.header = header.str();
+    averages.push_back(avg);
+  }
+
+  // Histograms
+  for(int n = 1 ; input.CheckEntry("Output","insitu_hist"+std::to_string(n)) > 0 ; n++) {
+    const std::string entry = "insitu_hist"+std::to_string(n);
+    Histogram hist;
+    hist.name = input.Get<std::string>("Output",entry,0);
+    hist.var = FindVariable(data, hist.name);
+    hist.nbins = input.Get<int>("Output",entry,1);
+    hist.vmin = input.Get<real>("Output",entry,2);
+    hist.vmax = input.Get<real>("Output",entry,3);
+    hist.logScale = (input.GetOrSet<std::string>("Output",entry,4,"lin").compare("log") == 0);
+    if(hist.nbins < 1 || !(hist.vmax > hist.vmin) || (hist.logScale && hist.vmin <= 0)) {
+      IDEFIX_ERROR("[Output]:"+entry+" expects a variable, a number of bins, and a valid range");
+    }
+    hist.bins = IdefixArray1D<real>("InSitu_hist", hist.nbins+1);
+    hist.filename = entry+".dat";
+
+    std::stringstream header;
+    header << std::scientific << std::setprecision(12);
+    header << "# Volume fraction of " << hist.name << " in " << hist.nbins
+           << (hist.logScale ? " logarithmic" : " linear") << " bins between "
+           << hist.vmin << " and " << hist.vmax << std::endl << "# bins";
+    for(int b = 0 ; b <= hist.nbins ; b++) {
+      const real f = static_cast<real>(b)/hist.nbins;
+      header << " " << (hist.logScale ? hist.vmin*std::pow(hist.vmax/hist.vmin, f)
+                                      : hist.vmin + (hist.vmax-hist.vmin)*f);
+    }
+    header << std::endl << "# t, then the volume fraction in each bin";
+    hist.header = header.str();
+    histograms.push_back(hist);
+  }
+
+  idfx::popRegion();
+}
+
+int InSitu::FindVariable(DataBlock &data, const std::string &name) {
+  auto &names = data.hydro->VcName;
+  for(int n = 0 ; n < names.size() ; n++) {
+    if(names[n].compare(name) == 0) return(n);
+  }
+  IDEFIX_ERROR("In-situ analysis: unknown variable "+name);
+  return(-1);
+}
+
+void InSitu::CheckForWrite(DataBlock &data) {
+  idfx::pushRegion("InSitu::CheckForWrite");
+
+  if(data.t >= insituLast + insituPeriod) {
+    std::vector<real> values;
+    if(integrals.size() > 0) {
+      ComputeIntegrals(data, values);
+      WriteLine("insitu.dat", integralHeader, data.t, values);
+    }
+    for(auto &avg : averages) {
+      ComputeAverage(data, avg, values);
+      WriteLine(avg.filename, avg.header, data.t, values);
+    }
+    for(auto &hist : histograms) {
+      ComputeHistogram(data, hist, values);
+      WriteLine(hist.filename, hist.header, data.t, values);
+    }
+
+    insituLast += insituPeriod;
+    if((insituLast+insituPeriod <= data.t) && insituPeriod > 0.0) {
+      while(insituLast <= data.t - insituPeriod) {
+        insituLast += insituPeriod;
+      }
+    }
+  }
+  idfx::popRegion();
+}
+
+// All of the volume integrals are computed in a single pass over the domain
+void InSitu::ComputeIntegrals(DataBlock &data, std::vector<real> &values) {
+  idfx::pushRegion("InSitu::ComputeIntegrals");
+  auto Vc = data.hydro->Vc;
+  auto dV = data.dV;
+  auto x1 = data.x[IDIR];
+  auto x2 = data.x[JDIR];
+  auto sinx2 = data.sinx2;
+  #if HAVE_ENERGY
+    EquationOfState eos = *(data.hydro->eos.get());
+  #endif
+
+  InSituVector result;
+  idefix_reduce("InSitu_Integrals",
+                data.beg[KDIR], data.end[KDIR],
+                data.beg[JDIR], data.end[JDIR],
+                data.beg[IDIR], data.end[IDIR],
+                KOKKOS_LAMBDA (int k, int j, int i, InSituVector &local) {
+    const real dv = dV(k,j,i);
+    const real rho = Vc(RHO,k,j,i);
+    real v2 = ZERO_F;
+    for(int n = 0 ; n < COMPONENTS ; n++) {
+      const real v = Vc(VX1+n,k,j,i);
+      v2 += v*v;
+    }
+    local.v[Volume] += dv;
+    local.v[Mass] += rho*dv;
+    local.v[Kinetic] += HALF_F*rho*v2*dv;
+    #if MHD == YES
+      real b2 = ZERO_F;
+      for(int n = 0 ; n < COMPONENTS ; n++) {
+        const real b = Vc(BX1+n,k,j,i);
+        b2 += b*b;
+      }
+      local.v[Magnetic] += HALF_F*b2*dv;
+    #endif
+    #if HAVE_ENERGY
+      const real prs = Vc(PRS,k,j,i);
+      local.v[Thermal] += prs/(eos.GetGamma(prs,rho)-ONE_F)*dv;
+    #endif
+    #if INSITU_HAVE_AZIMUTH
+      const real vphi = Vc(iVPHI,k,j,i);
+      #if GEOMETRY == CARTESIAN
+        const real lz = x1(i)*vphi - x2(j)*Vc(VX1,k,j,i);
+      #elif GEOMETRY == SPHERICAL
+        const real lz = x1(i)*sinx2(j)*vphi;
+      #else
+        const real lz = x1(i)*vphi;
+      #endif
+      local.v[AngularMomentum] += rho*lz*dv;
+      local.v[Reynolds] += rho*Vc(VX1,k,j,i)*vphi*dv;
+      #if MHD == YES
+        local.v[Maxwell] -= Vc(BX1,k,j,i)*Vc(iBPHI,k,j,i)*dv;
+      #endif
+    #endif
+  }, Kokkos::Sum<InSituVector>(result));
+
+  #ifdef WITH_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &result.v, nIntegrals, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  #endif
+
+  values.clear();
+  for(auto q : integrals) values.push_back(result.v[q]);
+  idfx::popRegion();
+}
+
+void InSitu::ComputeAverage(DataBlock &data, Average &avg, std::vector<real> &values) {
+  idfx::pushRegion("InSitu::ComputeAverage");
+  auto Vc = data.hydro->Vc;
+  auto dV = data.dV;
+  auto sum = avg.sum;
+  auto varIdx = avg.varIdx;
+  const int dir = avg.direction;
+  const int nvars = avg.vars.size();
+
+  Kokkos::deep_copy(sum, ZERO_F);
+  idefix_for("InSitu_Average",
+             data.beg[KDIR], data.end[KDIR],
+             data.beg[JDIR], data.end[JDIR],
+             data.beg[IDIR], data.end[IDIR],
+             KOKKOS_LAMBDA (int k, int j, int i) {
+    const int n = (dir == IDIR ? i : (dir == JDIR ? j : k));
+    const real dv = dV(k,j,i);
+    for(int v = 0 ; v < nvars ; v++) {
+      Kokkos::atomic_add(&sum(v,n), Vc(varIdx(v),k,j,i)*dv);
+    }
+    Kokkos::atomic_add(&sum(nvars,n), dv);
+  });
+  IdefixArray2D<real>::HostMirror sumHost = Kokkos::create_mirror_view(sum);
+  Kokkos::deep_copy(sumHost, sum);
+
+  // Each process adds its part in the global profile, which is then summed over the processes
+  const int nglob = data.mygrid->np_int[dir];
+  const int offset = data.gbeg[dir] - data.beg[dir];
+  std::vector<real> profile((nvars+1)*nglob, ZERO_F);
+  for(int v = 0 ; v <= nvars ; v++) {
+    for(int n = data.beg[dir] ; n < data.end[dir] ; n++) {
+      profile[v*nglob + n + offset - data.nghost[dir]] = sumHost(v,n);
+    }
+  }
+  #ifdef WITH_MPI
+    MPI_Allreduce(MPI_IN_PLACE, profile.data(), profile.size(), realMPI, MPI_SUM,
+                  MPI_COMM_WORLD);
+  #endif
+
+  values.resize(nvars*nglob);
+  for(int v = 0 ; v < nvars ; v++) {
+    for(int n = 0 ; n < nglob ; n++) {
+      values[v*nglob+n] = profile[v*nglob+n]/profile[nvars*nglob+n];
+    }
+  }
+  idfx::popRegion();
+}
+
+void InSitu::ComputeHistogram(DataBlock &data, Histogram &hist, std::vector<real> &values) {
+  idfx::pushRegion("InSitu::ComputeHistogram");
+  auto Vc = data.hydro->Vc;
+  auto dV = data.dV;
+  auto bins = hist.bins;
+  const int var = hist.var;
+  const int nbins = hist.nbins;
+  const bool logScale = hist.logScale;
+  const real vmin = logScale ? std::log10(hist.vmin) : hist.vmin;
+  const real dbin = ((logScale ? std::log10(hist.vmax) : hist.vmax) - vmin)/nbins;
+
+  Kokkos::deep_copy(bins, ZERO_F);
+  idefix_for("InSitu_Histogram",
+             data.beg[KDIR], data.end[KDIR],
+             data.beg[JDIR], data.end[JDIR],
+             data.beg[IDIR], data.end[IDIR],
+             KOKKOS_LAMBDA (int k, int j, int i) {
+    const real dv = dV(k,j,i);
+    Kokkos::atomic_add(&bins(nbins), dv);
+    real q = Vc(var,k,j,i);
+    if(logScale) {
+      if(q <= ZERO_F) return;
+      q = std::log10(q);
+    }
+    const real b = std::floor((q-vmin)/dbin);
+    // Values out of the range of the histogram are ignored
+    if(b >= 0 && b < nbins) Kokkos::atomic_add(&bins(static_cast<int>(b)), dv);
+  });
+  IdefixArray1D<real>::HostMirror binsHost = Kokkos::create_mirror_view(bins);
+  Kokkos::deep_copy(binsHost, bins);
+
+  values.resize(nbins+1);
+  for(int b = 0 ; b <= nbins ; b++) values[b] = binsHost(b);
+  #ifdef WITH_MPI
+    MPI_Allreduce(MPI_IN_PLACE, values.data(), nbins+1, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  #endif
+  for(int b = 0 ; b < nbins ; b++) values[b] /= values[nbins];
+  values.pop_back();
+  idfx::popRegion();
+}
+
+// Append a line to a time series, starting with its header if the file does not exist yet
+void InSitu::WriteLine(const std::string &filename, const std::string &header, real t,
+                       const std::vector<real> &values) {
+  if(idfx::prank != 0) return;
+  const bool newFile = !fs::exists(filename);
+  std::ofstream file(filename, std::ios::app);
+  if(!file) {
+    IDEFIX_ERROR("In-situ analysis: cannot open "+filename);
+  }
+  file << std::scientific << std::setprecision(12);
+  if(newFile) file << header << std::endl;
+  file << t;
+  for(auto v : values) file << " " << v;
+  file << std::endl;
+}
@@ -0,0 +1,68 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef OUTPUT_INSITU_HPP_
+#define OUTPUT_INSITU_HPP_
+
+#include <string>
+#include <vector>
+#include "idefix.hpp"
+#include "input.hpp"
+#include "dataBlock.hpp"
+
+// In-situ analysis of the gas, declared in the [Output] section of the input file.
+// The reductions are performed on the device, and only their (small) results are copied
+// back to the host and written in text time series by the root process:
+// - insitu.dat: volume integrals (mass, energies, angular momentum, stresses)
+// - insitu_averageN.dat: volume-weighted profiles along one direction
+// - insitu_histN.dat: volume-weighted histograms
+class InSitu {
+ public:
+  InSitu(Input &, DataBlock &, real);
+  void CheckForWrite(DataBlock &);
+  real insituPeriod = 0.0;
+  real insituLast = 0.0;
+
+  // Quantities integrated over the volume, all computed in a single reduction
+  enum Integral {Volume, Mass, Kinetic, Magnetic, Thermal, AngularMomentum, Reynolds, Maxwell,
+                 nIntegrals};
+
+ private:
+  struct Average {
+    int direction;
+    std::vector<int> vars;            // Indices of the averaged variables in Vc
+    std::vector<std::string> names;
+    IdefixArray1D<int> varIdx;         // Same, on the device
+    IdefixArray2D<real> sum;           // Local sums (last entry is the volume)
+    std::string filename;
+    std::string header;
+  };
+  struct Histogram {
+    int var;
+    std::string name;
+    int nbins;
+    real vmin;
+    real vmax;
+    bool logScale;
+    IdefixArray1D<real> bins;          // Volume in each bin (last entry is the total volume)
+    std::string filename;
+    std::string header;
+  };
+
+  std::vector<Integral> integrals;    // Volume integrals written in insitu.dat
+  std::string integralHeader;
+  std::vector<Average> averages;
+  std::vector<Histogram> histograms;
+
+  void ComputeIntegrals(DataBlock &, std::vector<real> &);
+  void ComputeAverage(DataBlock &, Average &, std::vector<real> &);
+  void ComputeHistogram(DataBlock &, Histogram &, std::vector<real> &);
+  void WriteLine(const std::string &, const std::string &, real, const std::vector<real> &);
+  int FindVariable(DataBlock &, const std::string &);
+};
+
+#endif // OUTPUT_INSITU_HPP_
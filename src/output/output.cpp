@@ -115,6 +115,15 @@ Output::Output(Input &input, DataBlock &data) {
     }
   }
 
+  // Look for in-situ analyses
+  if(input.CheckEntry("Output","insitu")>0) {
+    real period = input.Get<real>("Output","insitu",0);
+    if(period >= 0.0) {
+      haveInSitu = true;
+      insitu = std::make_unique<InSitu>(input, data, period);
+    }
+  }
+
   // Register variables that are needed in restart dumps
   data.dump->RegisterVariable(&dumpLast, "dumpLast");
   data.dump->RegisterVariable(&analysisLast, "analysisLast");
@@ -227,6 +236,11 @@ int Output::CheckForWrites(DataBlock &data) {
       slices[i]->CheckForWrite(data);
     }
   }
+  if(haveInSitu) {
+    elapsedTime -= timer.seconds();
+    insitu->CheckForWrite(data);
+    elapsedTime += timer.seconds();
+  }
   // Do we need a restart dump?
   if(dumpEnabled) {
     bool haveClockDump = false;
@@ -284,7 +298,11 @@ bool Output::RestartFromDump(DataBlock &data, int readNumber) {
 void Output::ForceWriteDump(DataBlock &data) {
   idfx::pushRegion("Output::ForceWriteDump");
 
-  if(!forceNoWrite) data.dump->Write(*this);
+  if(!forceNoWrite) {
+    data.dump->Write(*this);
+    // Make sure that the dump is complete, in case the code stops right after
+    data.dump->Flush();
+  }
 
   idfx::popRegion();
 }
@@ -20,6 +20,7 @@
 #endif
 #include "dump.hpp"
 #include "slice.hpp"
+#include "insitu.hpp"
 
 using AnalysisFunc = void (*) (DataBlock &);
 
@@ -79,6 +80,9 @@ class Output {
   bool haveSlices = false;
   std::vector<std::unique_ptr<Slice>> slices;
 
+  bool haveInSitu = false;
+  std::unique_ptr<InSitu> insitu;
+
   Kokkos::Timer timer;
   double elapsedTime{0.0};
 };
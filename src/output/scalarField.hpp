@@ -14,7 +14,7 @@
 
 class ScalarField {
  public:
-  enum Type {Device3D, Device4D, Host3D, Host4D};
+  enum Type {Device3D, Device4D, DeviceStore4D, Host3D, Host4D};
 
   explicit ScalarField(IdefixArray4D<real>& in, const int varnum):
     d4Darray{in}, var{varnum}, type{Device4D} {};
@@ -24,6 +24,10 @@ class ScalarField {
     d3Darray{in}, type{Device3D} {};
   explicit ScalarField(IdefixHostArray3D<real>& in):
     h3Darray{in}, type{Host3D} {};
+#ifdef MIXED_PRECISION
+  explicit ScalarField(IdefixArray4D<realStore>& in, const int varnum):
+    ds4Darray{in}, var{varnum}, type{DeviceStore4D} {};
+#endif
 
   IdefixHostArray3D<real> GetHostField() const {
     if(type==Host3D) {
@@ -37,11 +41,34 @@ class ScalarField {
       Kokkos::deep_copy(arr3D,d3Darray);
       return(arr3D);
     } else if(type==Device4D) {
-      IdefixArray3D<real> arrDev3D = Kokkos::subview(
+      #ifdef FIELD_LAYOUT_AOS
+        // The variable is not contiguous in memory: gather it in a temporary array first
+        IdefixArray3D<real> arrDev3D("ScalarFieldSlice", d4Darray.extent(1),
+                                     d4Darray.extent(2), d4Darray.extent(3));
+        Kokkos::deep_copy(arrDev3D, Kokkos::subview(
+                                      d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL));
+      #else
+        IdefixArray3D<real> arrDev3D = Kokkos::subview(
                                       d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+      #endif
       IdefixHostArray3D<real> arr3D = Kokkos::create_mirror(arrDev3D);
       Kokkos::deep_copy(arr3D,arrDev3D);
       return(arr3D);
+#ifdef MIXED_PRECISION
+    } else if(type==DeviceStore4D) {
+      // Convert the variable back to real precision before sending it to the host
+      IdefixArray3D<real> arrDev3D("ScalarFieldSlice", ds4Darray.extent(1),
+                                   ds4Darray.extent(2), ds4Darray.extent(3));
+      IdefixArray4D<realStore> in = ds4Darray;
+      const int nv = var;
+      idefix_for("ScalarFieldConvert",0,in.extent(1),0,in.extent(2),0,in.extent(3),
+        KOKKOS_LAMBDA (int k, int j, int i) {
+          arrDev3D(k,j,i) = static_cast<real>(in(nv,k,j,i));
+        });
+      IdefixHostArray3D<real> arr3D = Kokkos::create_mirror(arrDev3D);
+      Kokkos::deep_copy(arr3D,arrDev3D);
+      return(arr3D);
+#endif
     } else {
       IDEFIX_ERROR("unknown field");
       return(h3Darray);
@@ -53,6 +80,9 @@ class ScalarField {
   IdefixArray3D<real> d3Darray;
   IdefixHostArray4D<real> h4Darray;
   IdefixHostArray3D<real> h3Darray;
+#ifdef MIXED_PRECISION
+  IdefixArray4D<realStore> ds4Darray;
+#endif
   int var;
   Type type;
 };
@@ -66,6 +66,16 @@ Slice::Slice(Input &input, DataBlock & data, int nSlice, SliceType type,
   idfx::popRegion();
 }
 
+Slice::~Slice() {
+  #ifdef WITH_MPI
+    if(type==SliceType::Average) {
+      int finalized;
+      MPI_Finalized(&finalized);
+      if(!finalized) MPI_Comm_free(&avgComm);
+    }
+  #endif
+}
+
 void Slice::EnrollUserDefVariables(std::map<std::string,IdefixHostArray3D<real>> userDefVar) {
   this->userDefVariableMap = userDefVar;
   this->haveUserDefinedVariables = true;
@@ -5,7 +5,14 @@
 // Licensed under CeCILL 2.1 License, see COPYING for more information
 // ***********************************************************************************
 
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
+#include <fstream>
 #include <iomanip>
 #include <mutex>    // NOLINT [build/c++11]
 #include <string>
@@ -14,6 +21,17 @@
 #include "idefix.hpp"
 #include "profiler.hpp"
 
+namespace {
+std::string EscapeJSON(const std::string &name) {
+  std::string escapedName;
+  for(char c : name) {
+    if(c == '"' || c == '\\') escapedName += '\\';
+    escapedName += c;
+  }
+  return(escapedName);
+}
+} // namespace
+
 /////////////////////////////
 // Kokkos Profiler hooks (needed to track memory allocation)
 /////////////////////////////
@@ -106,16 +124,242 @@ void idfx::Profiler::Show() {
     rootRegion.Show(rootRegion.GetTimer());
     idfx::cout << "-------------------------------------------------------------------------------";
     idfx::cout << std::endl;
+    if(!costs.empty()) {
+      idfx::cout << "[GB/s, GFlop/s]: achieved bandwidth and flop rate, from the estimated cost ";
+      idfx::cout << "of each call" << std::endl;
+    }
+    if(countersEnabled) {
+      idfx::cout << "[instr, cache miss]: hardware counters of the main thread" << std::endl;
+    }
+    ShowImbalance();
     idfx::cout << "Profiler: end of performance profiling report." << std::endl;
   }
+  if(traceEnabled) WriteTrace();
+}
+
+// Show the min/mean/max time spent in each region over the processes
+void idfx::Profiler::ShowImbalance() {
+  #ifdef WITH_MPI
+    if(idfx::psize == 1) return;
+    std::vector<std::string> paths;
+    std::vector<double> times;
+    rootRegion.GetPaths(paths, times);
+
+    // Gather the paths (separated by newlines) and the times of all of the processes
+    std::string localPaths;
+    for(auto &path : paths) localPaths += path + "\n";
+    int nLocal[2] = {static_cast<int>(localPaths.size()), static_cast<int>(times.size())};
+    std::vector<int> nAll(2*idfx::psize);
+    MPI_SAFE_CALL(MPI_Gather(nLocal, 2, MPI_INT, nAll.data(), 2, MPI_INT, 0, MPI_COMM_WORLD));
+    std::vector<int> nChars(idfx::psize), nTimes(idfx::psize);
+    std::vector<int> charOffset(idfx::psize+1, 0), timeOffset(idfx::psize+1, 0);
+    for(int p = 0 ; p < idfx::psize ; p++) {
+      nChars[p] = nAll[2*p];
+      nTimes[p] = nAll[2*p+1];
+      charOffset[p+1] = charOffset[p] + nChars[p];
+      timeOffset[p+1] = timeOffset[p] + nTimes[p];
+    }
+    std::vector<char> allPaths(charOffset[idfx::psize]);
+    std::vector<double> allTimes(timeOffset[idfx::psize]);
+    MPI_SAFE_CALL(MPI_Gatherv(localPaths.data(), nLocal[0], MPI_CHAR, allPaths.data(),
+                              nChars.data(), charOffset.data(), MPI_CHAR, 0, MPI_COMM_WORLD));
+    MPI_SAFE_CALL(MPI_Gatherv(times.data(), nLocal[1], MPI_DOUBLE, allTimes.data(),
+                              nTimes.data(), timeOffset.data(), MPI_DOUBLE, 0, MPI_COMM_WORLD));
+    if(idfx::prank != 0) return;
+
+    // Time of each region on each process (zero when a process never entered a region)
+    std::map<std::string, std::vector<double>> regionTimes;
+    for(auto &path : paths) regionTimes[path] = std::vector<double>(idfx::psize, 0);
+    for(int p = 0 ; p < idfx::psize ; p++) {
+      std::string path;
+      int n = timeOffset[p];
+      for(int c = charOffset[p] ; c < charOffset[p+1] ; c++) {
+        if(allPaths[c] != '\n') {
+          path += allPaths[c];
+          continue;
+        }
+        auto &regionTime = regionTimes[path];
+        if(regionTime.empty()) {
+          // Region which was not entered by the root process
+          regionTime = std::vector<double>(idfx::psize, 0);
+          paths.push_back(path);
+        }
+        regionTime[p] = allTimes[n++];
+        path.clear();
+      }
+    }
+
+    idfx::cout << "Profiler: imbalance between the " << idfx::psize << " processes: " << std::endl;
+    idfx::cout << "-------------------------------------------------------------------------------";
+    idfx::cout << std::endl;
+    idfx::cout << "<min time>  <mean time>  <max time>  <(max-mean)/mean>  <name>" << std::endl;
+    idfx::cout << "-------------------------------------------------------------------------------";
+    idfx::cout << std::endl;
+    for(auto &path : paths) {
+      const auto &regionTime = regionTimes[path];
+      const double minTime = *std::min_element(regionTime.begin(), regionTime.end());
+      const double maxTime = *std::max_element(regionTime.begin(), regionTime.end());
+      double meanTime = 0;
+      for(auto t : regionTime) meanTime += t / idfx::psize;
+      const int level = std::count(path.begin(), path.end(), '/');
+      for(int i = 0 ; i < level ; i++) {
+        idfx::cout << "|   ";
+      }
+      idfx::cout << "|-> " << std::scientific << std::setprecision(2)
+                 << minTime << "  " << meanTime << "  " << maxTime << "  "
+                 << std::fixed << std::setprecision(1)
+                 << (meanTime > 0 ? (maxTime-meanTime)/meanTime*100 : 0) << "%  "
+                 << path.substr(path.rfind('/')+1) << std::endl;
+    }
+    idfx::cout << "-------------------------------------------------------------------------------";
+    idfx::cout << std::endl;
+  #endif
 }
 
 void idfx::Profiler::EnablePerformanceProfiling() {
+  if(perfEnabled) return;
+  clock.reset();
   currentRegion = &rootRegion;
   rootRegion.Start();
   perfEnabled = true;
 }
 
+// Each call of a region is recorded in the trace
+void idfx::Profiler::EnableTrace() {
+  traceEnabled = true;
+  EnablePerformanceProfiling();
+}
+
+void idfx::Profiler::RecordEvent(Region *region, double start, double duration,
+                                 const std::array<int64_t,nHardwareCounters> &eventCounters) {
+  if(events.size() >= maxEvents) {
+    if(!traceFull) {
+      IDEFIX_WARNING("The trace is full, the following calls will not be recorded");
+      traceFull = true;
+    }
+    return;
+  }
+  events.push_back({region, start, duration, eventCounters});
+}
+
+// Trace of the calls of each region of this process, in the Chrome trace event format
+// (which can be read by chrome://tracing or https://ui.perfetto.dev)
+void idfx::Profiler::WriteTrace() {
+  std::string filename = "idefix-trace." + std::to_string(idfx::prank) + ".json";
+  std::ofstream file(filename, std::ios::trunc);
+  if(!file.good()) {
+    IDEFIX_WARNING("Cannot open the trace file " + filename);
+    return;
+  }
+  file << std::fixed << std::setprecision(3);
+  file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << std::endl;
+  file << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << idfx::prank
+       << ", \"tid\": 0, \"args\": {\"name\": \"rank " << idfx::prank << "\"}}";
+  for(auto &event : events) {
+    // Timestamps and durations are in microseconds
+    file << "," << std::endl << "{\"name\": \"" << EscapeJSON(event.region->name)
+         << "\", \"cat\": \"idefix\", \"ph\": \"X\", \"pid\": " << idfx::prank
+         << ", \"tid\": 0, \"ts\": " << event.start*1e6 << ", \"dur\": " << event.duration*1e6
+         << ", \"args\": {";
+    std::string separator = "";
+    const RegionCost *cost = GetCost(event.region->name);
+    if(cost != nullptr) {
+      file << "\"bytes\": " << cost->bytes << ", \"flops\": " << cost->flops;
+      separator = ", ";
+    }
+    if(countersEnabled) {
+      file << separator << "\"instructions\": " << event.counters[0]
+           << ", \"cacheMisses\": " << event.counters[1];
+    }
+    file << "}}";
+  }
+  file << std::endl << "]}" << std::endl;
+}
+
+// Hardware counters of the calling thread (and of the threads it creates afterwards), read
+// with the Linux perf_event interface
+void idfx::Profiler::EnableHardwareCounters() {
+  #ifdef __linux__
+    const uint64_t config[nHardwareCounters] = {PERF_COUNT_HW_INSTRUCTIONS,
+                                                PERF_COUNT_HW_CACHE_MISSES};
+    for(int n = 0 ; n < nHardwareCounters ; n++) {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = config[n];
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.inherit = 1;
+      counterFd[n] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+      if(counterFd[n] < 0) {
+        for(int m = 0 ; m < n ; m++) close(counterFd[m]);
+        IDEFIX_WARNING("Cannot open the hardware counters (check /proc/sys/kernel/"
+                       "perf_event_paranoid), they will not be reported");
+        return;
+      }
+    }
+    countersEnabled = true;
+    EnablePerformanceProfiling();
+  #else
+    IDEFIX_WARNING("Hardware counters are only available on Linux");
+  #endif
+}
+
+bool idfx::Profiler::ReadHardwareCounters(std::array<int64_t,nHardwareCounters> &values) {
+  #ifdef __linux__
+    for(int n = 0 ; n < nHardwareCounters ; n++) {
+      if(read(counterFd[n], &values[n], sizeof(int64_t)) != sizeof(int64_t)) return(false);
+    }
+    return(true);
+  #else
+    return(false);
+  #endif
+}
+
+// Estimated number of bytes moved and of floating point operations of each call of a region
+void idfx::Profiler::RegisterCost(const std::string &name, double bytes, double flops) {
+  costs[name] = {bytes, flops};
+}
+
+const idfx::RegionCost* idfx::Profiler::GetCost(const std::string &name) {
+  auto it = costs.find(name);
+  if(it == costs.end()) return(nullptr);
+  return(&it->second);
+}
+
+// The benchmark file needs the time spent in each region
+void idfx::Profiler::EnableBenchmark(std::string filename) {
+  benchmarkFile = filename;
+  if(!perfEnabled) EnablePerformanceProfiling();
+}
+
+// Memory usage and region times are those of the root process. Should be called after Show().
+void idfx::Profiler::WriteBenchmark(int64_t nCycles, double cellUpdates, double mpiOverhead) {
+  if(idfx::prank != 0) return;
+  std::ofstream file(benchmarkFile, std::ios::trunc);
+  if(!file.good()) {
+    IDEFIX_WARNING("Cannot open the benchmark file " + benchmarkFile);
+    return;
+  }
+  file << std::scientific << std::setprecision(6);
+  file << "{" << std::endl;
+  file << "  \"executionSpace\": \"" << Kokkos::DefaultExecutionSpace::name() << "\"," << std::endl;
+  file << "  \"processes\": " << idfx::psize << "," << std::endl;
+  file << "  \"cycles\": " << nCycles << "," << std::endl;
+  file << "  \"wallTime\": " << rootRegion.GetTimer() << "," << std::endl;
+  file << "  \"cellUpdatesPerSecond\": " << cellUpdates << "," << std::endl;
+  file << "  \"mpiOverhead\": " << mpiOverhead << "," << std::endl;
+  file << "  \"maxMemory\": {";
+  for(int i=0; i < this->numSpaces ; i++) {
+    file << (i > 0 ? ", " : "") << "\"" << this->spaceName[i] << "\": " << this->spaceMax[i];
+  }
+  file << "}," << std::endl;
+  file << "  \"regions\": ";
+  rootRegion.WriteJSON(file, 1);
+  file << std::endl << "}" << std::endl;
+}
+
 
 ///////////////////////////////////
 // Region functions definitions //
@@ -145,6 +389,8 @@ idfx::Region::~Region() {
 
 void idfx::Region::Start() {
   this->nCalls++;
+  if(idfx::prof.traceEnabled) this->startTime = idfx::prof.GetTime();
+  if(idfx::prof.countersEnabled) idfx::prof.ReadHardwareCounters(this->counterStart);
   this->timer.reset();
 }
 
@@ -153,7 +399,38 @@ double idfx::Region::GetTimer() {
 }
 
 void idfx::Region::Stop() {
-  this->myTime += this->timer.seconds();
+  const double duration = this->timer.seconds();
+  this->myTime += duration;
+  std::array<int64_t,nHardwareCounters> delta{};
+  if(idfx::prof.countersEnabled && idfx::prof.ReadHardwareCounters(delta)) {
+    for(int n = 0 ; n < nHardwareCounters ; n++) {
+      delta[n] -= this->counterStart[n];
+      this->counters[n] += delta[n];
+    }
+  }
+  if(idfx::prof.traceEnabled) idfx::prof.RecordEvent(this, this->startTime, duration, delta);
+}
+
+// Name of the region preceded by the names of its parents, separated by '/'
+std::string idfx::Region::GetPath() {
+  if(parent == nullptr) return(name);
+  return(parent->GetPath() + "/" + name);
+}
+
+// Paths and times of this region and of its children, in the order of Show()
+void idfx::Region::GetPaths(std::vector<std::string> &paths, std::vector<double> &times) {
+  paths.push_back(GetPath());
+  times.push_back(myTime);
+  if(!isLeaf) {
+    std::vector<Region*> sorted;
+    for( auto &it : this->children) {
+      sorted.push_back(it.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), this->Compare);
+    for( auto &it : sorted) {
+      it->GetPaths(paths, times);
+    }
+  }
 }
 
 idfx::Region * idfx::Region::GetChild(std::string name) {
@@ -187,7 +464,17 @@ void idfx::Region::Show(double totTime) {
              << this->myTime/totTime*100 << "%  "
              << (this->myTime-childTime)/this->myTime*100 << "%  "
              << this->nCalls << "  "
-             << this->name << std::endl;
+             << this->name;
+  const RegionCost *cost = idfx::prof.GetCost(this->name);
+  if(cost != nullptr && this->myTime > 0) {
+    idfx::cout << "  [" << std::setprecision(2) << cost->bytes*nCalls/myTime/1e9 << " GB/s, "
+               << cost->flops*nCalls/myTime/1e9 << " GFlop/s]";
+  }
+  if(idfx::prof.countersEnabled) {
+    idfx::cout << "  [" << std::scientific << std::setprecision(2)
+               << static_cast<double>(counters[0]) << " instr, " << static_cast<double>(counters[1]) << " cache miss]";
+  }
+  idfx::cout << std::endl;
   if(!isLeaf) {
     // Sort the children
     std::vector<Region*> sorted;
@@ -201,3 +488,27 @@ void idfx::Region::Show(double totTime) {
         }
   }
 }
+
+void idfx::Region::WriteJSON(std::ostream &file, int indent) {
+  const std::string pad(2*indent, ' ');
+  file << "{\"name\": \"" << EscapeJSON(this->name) << "\", \"time\": " << this->myTime
+       << ", \"calls\": " << this->nCalls;
+  const RegionCost *cost = idfx::prof.GetCost(this->name);
+  if(cost != nullptr) {
+    file << ", \"bytes\": " << cost->bytes*nCalls << ", \"flops\": " << cost->flops*nCalls;
+  }
+  file << ", \"children\": [";
+  if(!isLeaf) {
+    std::vector<Region*> sorted;
+    for( auto &it : this->children) {
+      sorted.push_back(it.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), this->Compare);
+    for(int n = 0 ; n < sorted.size() ; n++) {
+      file << (n > 0 ? "," : "") << std::endl << pad << "  ";
+      sorted[n]->WriteJSON(file, indent+1);
+    }
+    file << std::endl << pad;
+  }
+  file << "]}";
+}
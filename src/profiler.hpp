@@ -8,9 +8,12 @@
 #ifndef PROFILER_HPP_
 #define PROFILER_HPP_
 
+#include <array>
 #include <map>
 #include <mutex>  // NOLINT [build/c++11]
+#include <ostream>
 #include <string>
+#include <vector>
 
 namespace idfx {
 
@@ -18,6 +21,15 @@ struct SpaceHandle {
   char name[64];
 };
 
+// Number of hardware counters read around each region (instructions and cache misses)
+constexpr int nHardwareCounters = 2;
+
+// Estimated cost of one call of a region, registered by the modules
+struct RegionCost {
+  double bytes{0};    // bytes moved from/to memory
+  double flops{0};    // floating point operations
+};
+
 // Region is a helper class to Profiler
 // it used to generate a tree of the regions encountered while running
 // and produce a performance report.
@@ -29,8 +41,12 @@ class Region {
   void Start();
   void Stop();
   void Show(double );
+  void WriteJSON(std::ostream &, int);
   Region* GetChild(std::string name);
   double GetTimer();
+  int64_t GetNCalls() { return nCalls; }
+  std::string GetPath();
+  void GetPaths(std::vector<std::string> &, std::vector<double> &);
   static bool Compare(Region *, Region *);
   bool isLeaf{true};
   std::string name;
@@ -41,6 +57,17 @@ class Region {
   Kokkos::Timer timer;
   double myTime{0};
   int64_t nCalls{0};
+  double startTime{0};    // Start of the current call, since the start of the profiler
+  std::array<int64_t,nHardwareCounters> counterStart{};
+  std::array<int64_t,nHardwareCounters> counters{};
+};
+
+// A call of a region, as written in the trace file
+struct TraceEvent {
+  Region *region;
+  double start;
+  double duration;
+  std::array<int64_t,nHardwareCounters> counters;
 };
 
 
@@ -49,6 +76,18 @@ class Profiler {
   void Init();
   void Show();
   void EnablePerformanceProfiling();
+  void EnableBenchmark(std::string);
+  // Write the performance summary of the run in the benchmark file (JSON format)
+  void WriteBenchmark(int64_t nCycles, double cellUpdates, double mpiOverhead);
+  void EnableTrace();
+  void WriteTrace();   // Write the trace file of this process (Chrome trace format)
+  void EnableHardwareCounters();
+  bool ReadHardwareCounters(std::array<int64_t,nHardwareCounters> &);
+  void RegisterCost(const std::string &, double bytes, double flops);
+  const RegionCost* GetCost(const std::string &);
+  double GetTime() { return clock.seconds(); }   // Time since the start of the profiler
+  void RecordEvent(Region *, double, double, const std::array<int64_t,nHardwareCounters> &);
+  void ShowImbalance();
   int numSpaces;
   int64_t spaceSize[16];
   int64_t spaceMax[16];
@@ -56,6 +95,15 @@ class Profiler {
   std::mutex m;
 
   bool perfEnabled{false};
+  std::string benchmarkFile;
+  bool traceEnabled{false};
+  bool countersEnabled{false};
+  std::array<int,nHardwareCounters> counterFd{-1, -1};
+  std::map<std::string, RegionCost> costs;
+  std::vector<TraceEvent> events;
+  bool traceFull{false};
+  static constexpr size_t maxEvents = 1 << 22;   // Limit of the size of the trace (~200 MB)
+  Kokkos::Timer clock;
   Region rootRegion;
   Region *currentRegion;
 };
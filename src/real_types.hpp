@@ -24,6 +24,15 @@
   #endif
 #endif // SINGLE_PRECISION
 
+// Storage type of the large cell-centered arrays (Vc, Uc, FluxRiemann and RKL work arrays).
+// In mixed precision, these arrays are stored in single precision while the arithmetics
+// (and all of the other arrays) remain in double precision.
+#ifdef MIXED_PRECISION
+  using realStore = float;
+#else
+  using realStore = real;
+#endif // MIXED_PRECISION
+
 // math function
 #ifdef SINGLE_PRECISION
 
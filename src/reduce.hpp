@@ -15,6 +15,9 @@
 #include <string>
 #include "idefix.hpp"
 #include "global.hpp"
+#ifdef LOOP_PATTERN_AUTOTUNE
+#include "loopTuner.hpp"
+#endif
 
 
 // 1D default loop pattern
@@ -57,6 +60,33 @@ inline void idefix_reduce(const std::string & NAME,
     #endif
 }
 
+// 3D loop with a given pattern
+template <LoopPattern pattern, typename Function, typename Reducer>
+inline void idefix_reduce_pattern(const std::string & NAME,
+                const int & KB, const int & KE,
+                const int & JB, const int & JE,
+                const int & IB, const int & IE,
+                Function function,
+                Reducer redFunction) {
+    if constexpr(pattern == LoopPattern::RANGE) {
+      const int NJ = JE - JB;
+      const int NI = IE - IB;
+      const int NJNI = NJ * NI;
+      const int NKNJNI = (KE - KB) * NJNI;
+      Kokkos::parallel_reduce(NAME, NKNJNI,
+        KOKKOS_LAMBDA (const int& IDX, typename Reducer::value_type &result) {
+          int k = IDX / NJNI;
+          int j = (IDX - k*NJNI) / NI;
+          int i = IDX - k*NJNI - j*NI;
+          function(k+KB, j+JB, i+IB, result);
+        }, redFunction);
+    } else {
+      Kokkos::parallel_reduce(NAME,
+        Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
+          ({KB,JB,IB},{KE,JE,IE}), function, redFunction);
+    }
+}
+
 // 3D default loop pattern
 template <typename Function, typename Reducer>
 inline void idefix_reduce(const std::string & NAME,
@@ -67,12 +97,27 @@ inline void idefix_reduce(const std::string & NAME,
                 Reducer redFunction) {
     // We only implement MDRange reductions here since the other implementations are too
     // complicated to be implemented for any reduction operator on any class
+    // (the autotuner may also pick a 1D range, which works with any Kokkos reducer)
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
-    Kokkos::parallel_reduce(NAME,
-      Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({KB,JB,IB},{KE,JE,IE}), function, redFunction);
+    #ifdef LOOP_PATTERN_AUTOTUNE
+      auto &entry = idfx::loopTuner.GetEntry(LoopTuner::Reduce, NAME, {KE-KB, JE-JB, IE-IB});
+      const LoopTuner::Candidate &candidate = entry.choice >= 0 ?
+                    idfx::loopTuner.GetCandidate(LoopTuner::Reduce, entry.choice) :
+                    idfx::loopTuner.GetTrial(LoopTuner::Reduce, entry);
+      // Reductions are blocking, the trials only need to wait for the previous kernels
+      if(entry.choice < 0) Kokkos::fence();
+      Kokkos::Timer timer;
+      if(candidate.pattern == LoopPattern::RANGE) {
+        idefix_reduce_pattern<LoopPattern::RANGE>(NAME,KB,KE,JB,JE,IB,IE,function,redFunction);
+      } else {
+        idefix_reduce_pattern<LoopPattern::MDRANGE>(NAME,KB,KE,JB,JE,IB,IE,function,redFunction);
+      }
+      if(entry.choice < 0) idfx::loopTuner.Record(LoopTuner::Reduce, entry, timer.seconds());
+    #else
+      idefix_reduce_pattern<LoopPattern::MDRANGE>(NAME,KB,KE,JB,JE,IB,IE,function,redFunction);
+    #endif
 
     #ifdef DEBUG
     Kokkos::fence();
@@ -35,12 +35,12 @@ class RKLegendre {
   template <int> void CalcParabolicRHS(real);
   void ComputeDt();
   void ShowConfig();
-  void Copy(IdefixArray4D<real>&, IdefixArray4D<real>&);
+  void Copy(IdefixArray4D<realStore>&, IdefixArray4D<realStore>&);
 
-  IdefixArray4D<real> dU;      // variation of main cell-centered conservative variables
-  IdefixArray4D<real> dU0;      // dU of the first stage
-  IdefixArray4D<real> Uc0;      // Uc at initial stage
-  IdefixArray4D<real> Uc1;      // Uc of the previous stage, Uc1 = Uc(stage-1)
+  IdefixArray4D<realStore> dU;    // variation of main cell-centered conservative variables
+  IdefixArray4D<realStore> dU0;    // dU of the first stage
+  IdefixArray4D<realStore> Uc0;    // Uc at initial stage
+  IdefixArray4D<realStore> Uc1;    // Uc of the previous stage, Uc1 = Uc(stage-1)
 
   IdefixArray4D<real> dB;      // Variation of cell-centered magnetic variables
   IdefixArray4D<real> dB0;     // dB of the first stage
@@ -59,6 +59,7 @@ class RKLegendre {
 
   real dt, cfl_rkl, rmax_par;
   int stage{0};
+  int nstages{0};               // # of stages of the last cycle
 
  private:
   friend struct RKLegendre_ResetStageFunctor<Phys>;
@@ -106,7 +107,7 @@ void RKLegendre<Phys>::AddVariable(int var, std::vector<int> &varListHost ) {
 
 // Copy just the variables required by the RK scheme
 template<typename Phys>
-void RKLegendre<Phys>::Copy(IdefixArray4D<real> &out, IdefixArray4D<real> &in) {
+void RKLegendre<Phys>::Copy(IdefixArray4D<realStore> &out, IdefixArray4D<realStore> &in) {
   IdefixArray1D<int> vars = this->varList;
 
   idefix_for("RKL_Copy",
@@ -199,52 +200,55 @@ RKLegendre<Phys>::RKLegendre(Input &input, Fluid<Phys>* hydroin) {
 
   #ifdef WITH_MPI
     mpi.Init(data->mygrid, varListHost, data->nghost.data(), data->np_int.data(), haveVs);
+    if(data->haveNeighbourExchange) mpi.InitExchangeAll();
   #endif
 
 
-  // Variable allocation
+  // Variable allocation (only live during the RKL cycle)
+  ScratchArena *scratch = data->scratch.get();
+  constexpr int phase = ScratchArena::RKL;
 
-  dU = IdefixArray4D<real>("RKL_dU", NVAR,
+  dU = scratch->Get4D<realStore>(phase, "RKL_dU", NVAR,
                            data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  dU0 = IdefixArray4D<real>("RKL_dU0", NVAR,
+  dU0 = scratch->Get4D<realStore>(phase, "RKL_dU0", NVAR,
                            data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  Uc0 = IdefixArray4D<real>("RKL_Uc0", NVAR,
+  Uc0 = scratch->Get4D<realStore>(phase, "RKL_Uc0", NVAR,
                            data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  Uc1 = IdefixArray4D<real>("RKL_Uc1", NVAR,
+  Uc1 = scratch->Get4D<realStore>(phase, "RKL_Uc1", NVAR,
                            data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
 
   if(haveVs) {
     #ifdef EVOLVE_VECTOR_POTENTIAL
-      dA = IdefixArray4D<real>("RKL_dA", AX3e+1,
+      dA = scratch->Get4D<real>(phase, "RKL_dA", AX3e+1,
                       data->np_tot[KDIR]+KOFFSET,
                       data->np_tot[JDIR]+JOFFSET,
                       data->np_tot[IDIR]+IOFFSET);
-      dA0 = IdefixArray4D<real>("RKL_dA0", AX3e+1,
+      dA0 = scratch->Get4D<real>(phase, "RKL_dA0", AX3e+1,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
                         data->np_tot[IDIR]+IOFFSET);
-      Ve0 = IdefixArray4D<real>("RKL_Ve0", AX3e+1,
+      Ve0 = scratch->Get4D<real>(phase, "RKL_Ve0", AX3e+1,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
                         data->np_tot[IDIR]+IOFFSET);
-      Ve1 = IdefixArray4D<real>("RKL_Ve1", AX3e+1,
+      Ve1 = scratch->Get4D<real>(phase, "RKL_Ve1", AX3e+1,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
                         data->np_tot[IDIR]+IOFFSET);
     #else
-      dB = IdefixArray4D<real>("RKL_dB", DIMENSIONS,
+      dB = scratch->Get4D<real>(phase, "RKL_dB", DIMENSIONS,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
                         data->np_tot[IDIR]+IOFFSET);
-      dB0 = IdefixArray4D<real>("RKL_dB0", DIMENSIONS,
+      dB0 = scratch->Get4D<real>(phase, "RKL_dB0", DIMENSIONS,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
                         data->np_tot[IDIR]+IOFFSET);
-      Vs0 = IdefixArray4D<real>("RKL_Vs0", DIMENSIONS,
+      Vs0 = scratch->Get4D<real>(phase, "RKL_Vs0", DIMENSIONS,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
                         data->np_tot[IDIR]+IOFFSET);
-      Vs1 = IdefixArray4D<real>("RKL_Vs1", DIMENSIONS,
+      Vs1 = scratch->Get4D<real>(phase, "RKL_Vs1", DIMENSIONS,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
                         data->np_tot[IDIR]+IOFFSET);
@@ -282,11 +286,11 @@ template<typename Phys>
 void RKLegendre<Phys>::Cycle() {
   idfx::pushRegion("RKLegendre::Cycle");
 
-  IdefixArray4D<real> dU = this->dU;
-  IdefixArray4D<real> dU0 = this->dU0;
-  IdefixArray4D<real> Uc = hydro->Uc;
-  IdefixArray4D<real> Uc0 = this->Uc0;
-  IdefixArray4D<real> Uc1 = this->Uc1;
+  IdefixArray4D<realStore> dU = this->dU;
+  IdefixArray4D<realStore> dU0 = this->dU0;
+  IdefixArray4D<realStore> Uc = hydro->Uc;
+  IdefixArray4D<realStore> Uc0 = this->Uc0;
+  IdefixArray4D<realStore> Uc1 = this->Uc1;
 
   IdefixArray4D<real> dB = this->dB;
   IdefixArray4D<real> dB0 = this->dB0;
@@ -365,6 +369,7 @@ void RKLegendre<Phys>::Cycle() {
   //#error Invalid RKL_ORDER
 #endif
   int rklstages = 1 + floor(nrkl);
+  nstages = rklstages;
 
   // Compute coefficients
   real w1, mu_tilde_j;
@@ -557,7 +562,7 @@ void RKLegendre<Phys>::Cycle() {
 template<typename Phys>
 void RKLegendre<Phys>::ResetFlux() {
   idfx::pushRegion("RKLegendre::ResetFlux");
-  IdefixArray4D<real> Flux = hydro->FluxRiemann;
+  IdefixArray4D<realStore> Flux = hydro->FluxRiemann;
   IdefixArray1D<int> vars = this->varList;
   idefix_for("RKL_ResetFlux",
              0,nvarRKL,
@@ -595,8 +600,8 @@ struct RKLegendre_ResetStageFunctor {
     }
   }
 
-  IdefixArray4D<real> dU;
-  IdefixArray4D<real> Flux;
+  IdefixArray4D<realStore> dU;
+  IdefixArray4D<realStore> Flux;
   IdefixArray1D<int> vars;
   IdefixArray4D<real> dA, dB;
   IdefixArray3D<real> ex,ey,ez;
@@ -724,7 +729,7 @@ template <int dir>
 void RKLegendre<Phys>::CalcParabolicRHS(real t) {
   idfx::pushRegion("RKLegendre::CalcParabolicRHS");
 
-  IdefixArray4D<real> Flux = hydro->FluxRiemann;
+  IdefixArray4D<realStore> Flux = hydro->FluxRiemann;
   IdefixArray3D<real> A    = data->A[dir];
   IdefixArray3D<real> dV   = data->dV;
   IdefixArray1D<real> x1m  = data->xl[IDIR];
@@ -738,7 +743,7 @@ void RKLegendre<Phys>::CalcParabolicRHS(real t) {
   IdefixArray3D<real> invDt = hydro->InvDt;
   IdefixArray3D<real> dMax = hydro->dMax;
   IdefixArray4D<real> viscSrc;
-  IdefixArray4D<real> dU = this->dU;
+  IdefixArray4D<realStore> dU = this->dU;
   IdefixArray1D<int> varList = this->varList;
 
   bool haveViscosity = hydro->viscosityStatus.isRKL;
@@ -907,12 +912,16 @@ void RKLegendre<Phys>::SetBoundaries(real t) {
   // by the MPI instance of RKLegendre
   //if(hydro->boundary->haveInternalBoundary)
   //   hydro->boundary->internalBoundaryFunc(*data, t);
+  #ifdef WITH_MPI
+  // Exchange all of the ghost zones at once, the boundary conditions are enforced below
+  if(data->haveNeighbourExchange && idfx::psize>1) this->mpi.ExchangeAll(hydro->Vc, hydro->Vs);
+  #endif
   for(int dir=0 ; dir < DIMENSIONS ; dir++ ) {
       // MPI Exchange data when needed
       // We use the RKL instance MPI object to ensure that we only exchange the data
       // solved by RKL
     #ifdef WITH_MPI
-    if(data->mygrid->nproc[dir]>1) {
+    if(data->mygrid->nproc[dir]>1 && !data->haveNeighbourExchange) {
       switch(dir) {
         case 0:
           this->mpi.ExchangeX1(hydro->Vc, hydro->Vs);
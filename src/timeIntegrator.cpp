@@ -9,6 +9,7 @@
 
 #include <cstdio>
 #include <iomanip>
+#include <limits>
 #include <string>
 #include <vector>
 #include "idefix.hpp"
@@ -26,6 +27,7 @@ TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data) {
   this->timer.reset();
   this->lastLog=timer.seconds();
   this->lastMpiLog=idfx::mpiCallsTimer + idfx::mpiCallsTimer;
+  this->lastOverlapLog=idfx::mpiOverlapTimer;
 
   nstages=input.Get<int>("TimeIntegrator","nstages",0);
 
@@ -75,13 +77,27 @@ TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data) {
     haveRKL = true;
   }
 
+  if(data.hydro->haveHallSubcycle) {
+    haveHallSubcycle = true;
+  }
+
+  if(data.haveLocalTimestep && haveFixedDt) {
+    IDEFIX_ERROR("Local time stepping (lts_levels) is not compatible with fixed_dt");
+  }
+
+  Rebind(data);
+
+  idfx::popRegion();
+}
+
+void TimeIntegrator::Rebind(DataBlock &data) {
   // If multi-stage, create a new state in the datablock called "begin"
   if(nstages>1) {
     data.states["begin"] = StateContainer();
     data.states["begin"].AllocateAs(data.states["current"]);
   }
-
-  idfx::popRegion();
+  // The self-gravity timer starts over with a new datablock
+  lastSGLog = 0;
 }
 
 
@@ -95,6 +111,13 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
   // reduce to an normalized overhead in %
   double mpiOverhead = 100.0 * mpiCycleTime / (timer.seconds() - lastLog);
   lastMpiLog = idfx::mpiCallsTimer;
+  // Fraction of the time spent communicating which was overlapped with computations
+  double overlapCycleTime = idfx::mpiOverlapTimer - lastOverlapLog;
+  double mpiOverlap = 0.0;
+  if(overlapCycleTime+mpiCycleTime > 0) {
+    mpiOverlap = 100.0 * overlapCycleTime / (overlapCycleTime + mpiCycleTime);
+  }
+  lastOverlapLog = idfx::mpiOverlapTimer;
 #endif
   double sgOverhead;
   if(data.haveGravity && data.gravity->haveSelfGravityPotential) {
@@ -115,6 +138,9 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
     idfx::cout << " | " << std::setw(col_width) << "cell (updates/s)";
 #ifdef WITH_MPI
     idfx::cout << " | " << std::setw(col_width) << "MPI overhead (%)";
+    if(data.haveBoundaryOverlap) {
+      idfx::cout << " | " << std::setw(col_width) << "MPI overlap (%)";
+    }
     if(idfx::prank==0)  {
       idfx::cout << " | " << std::setw(col_width) << "MPI imbalance(%)";
     }
@@ -125,6 +151,12 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
     if(haveRKL) {
       idfx::cout << " | " << std::setw(col_width) << "RKL stages";
     }
+    if(haveHallSubcycle) {
+      idfx::cout << " | " << std::setw(col_width) << "Hall substeps";
+    }
+    if(data.haveLocalTimestep) {
+      idfx::cout << " | " << std::setw(col_width) << "LTS substeps";
+    }
     if(data.haveGravity && data.gravity->haveSelfGravityPotential) {
       idfx::cout << " | " << std::setw(col_width) << "SG iterations";
       idfx::cout << " | " << std::setw(col_width) << "SG error";
@@ -147,6 +179,9 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
 #ifdef WITH_MPI
   idfx::cout << std::fixed;
     idfx::cout << " | " << std::setw(col_width) << mpiOverhead;
+  if(data.haveBoundaryOverlap) {
+    idfx::cout << " | " << std::setw(col_width) << mpiOverlap;
+  }
   if(idfx::prank==0) {
     idfx::cout << " | " << std::setw(col_width) << imbalance;
   }
@@ -155,6 +190,9 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
     idfx::cout << " | " << std::setw(col_width) << "N/A";
 #if WITH_MPI
     idfx::cout << " | " << std::setw(col_width) << "N/A";
+    if(data.haveBoundaryOverlap) {
+      idfx::cout << " | " << std::setw(col_width) << "N/A";
+    }
     if(idfx::prank==0) {
       idfx::cout << " | " << std::setw(col_width) << "N/A";
     }
@@ -175,7 +213,13 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
   }
 #endif
   if(haveRKL) {
-    idfx::cout << " | " << std::setw(col_width) << data.hydro->rkl->stage;
+    idfx::cout << " | " << std::setw(col_width) << data.hydro->rkl->nstages;
+  }
+  if(haveHallSubcycle) {
+    idfx::cout << " | " << std::setw(col_width) << data.hydro->hallSubcycle->nsteps;
+  }
+  if(data.haveLocalTimestep) {
+    idfx::cout << " | " << std::setw(col_width) << data.lts->GetNSubsteps();
   }
   if(data.haveGravity && data.gravity->haveSelfGravityPotential) {
     if(ncycles>=cyclePeriod) {
@@ -259,6 +303,10 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     data.EvolveRKLStage();
   }
 
+  if(haveHallSubcycle && (ncycles%2)==1) {    // Hall subcycles
+    data.EvolveHallStage();
+  }
+
   // save t at the begining of the cycle
   const real t0 = data.t;
 
@@ -269,92 +317,124 @@ void TimeIntegrator::Cycle(DataBlock &data) {
   MPI_Request dtReduce;
 #endif
 
-  /////////////////////////////////////////////////
-  // BEGIN STAGES LOOP                           //
-  /////////////////////////////////////////////////
-  for(int stage=0; stage < nstages ; stage++) {
-    // Apply Boundary conditions
-    data.SetBoundaries();
+  // With local time stepping, the cycle is made of 2^nlevels substeps of the finest timestep,
+  // each of them only evolving the cells and faces which are due for an update
+  int nSubsteps = 1;
+  if(data.haveLocalTimestep) {
+    // First cycle
+    if(data.lts->dtSub <= 0) data.lts->dtSub = data.dt;
+    // Without levels (first cycle or restart), the cycle is a single step of the finest dt
+    nSubsteps = data.lts->GetNSubsteps();
+    if(nSubsteps == 1) data.dt = data.lts->dtSub;
+  }
+  const real dtCycle = data.dt;
 
-    // Remove Fargo velocity so that the integrator works on the residual
-    if(data.haveFargo) data.fargo->SubstractVelocity(data.t);
+  for(int substep = 0 ; substep < nSubsteps ; substep++) {
+    if(data.haveLocalTimestep) {
+      data.lts->SetSubstep(substep);
+      data.dt = data.lts->dtSub;
+    }
+    // save t at the begining of the substep
+    const real ts = data.t;
+
+    /////////////////////////////////////////////////
+    // BEGIN STAGES LOOP                           //
+    /////////////////////////////////////////////////
+    for(int stage=0; stage < nstages ; stage++) {
+      // Apply Boundary conditions
+      if(data.haveBoundaryOverlap) {
+        // Ghost zones are filled in EvolveStage, overlapped with the update of the interior
+        data.StartBoundaries();
+      } else {
+        data.SetBoundaries();
+      }
 
-    // Convert current state into conservative variable and save it
-    data.PrimToCons();
+      // Remove Fargo velocity so that the integrator works on the residual
+      if(data.haveFargo) data.fargo->SubstractVelocity(data.t);
 
-    // Store (deep copy) initial stage for multi-stage time integrators
-    if(nstages>1 && stage==0) {
-      data.states["begin"].CopyFrom(data.states["current"]);
-    }
-    // If gravity is needed, update it
-    if(data.haveGravity) {
-      if(ncycles % data.gravity->skipGravity == 0) data.gravity->ComputeGravity(ncycles);
-    }
+      // Convert current state into conservative variable and save it
+      data.PrimToCons();
 
-    Kokkos::fence();
-    computeLastLog -= timer.seconds();
-    // Update Uc & Vs
-    data.EvolveStage();
-    Kokkos::fence();
-    computeLastLog += timer.seconds();
-
-    // evolve dt accordingly
-    data.t += data.dt;
-
-    // Look for Nans every now and then (this actually cost a lot of time on GPUs
-    // because streams are divergent)
-    if(ncycles%checkNanPeriodicity==0) {
-      if(data.CheckNan()>0) {
-        throw std::runtime_error(std::string("Nan found after integration cycle"));
+      // Store (deep copy) initial stage for multi-stage time integrators
+      if(nstages>1 && stage==0) {
+        data.states["begin"].CopyFrom(data.states["current"]);
+      }
+      // If gravity is needed, update it
+      if(data.haveGravity) {
+        if(ncycles % data.gravity->skipGravity == 0) data.gravity->ComputeGravity(ncycles);
       }
-    }
 
-    // Compute next time_step during first stage
-    if(stage==0) {
-      if(!haveFixedDt) {
-        newdt = cfl*data.ComputeTimestep();
-        #ifdef WITH_MPI
-          if(idfx::psize>1) {
-            MPI_SAFE_CALL(MPI_Iallreduce(MPI_IN_PLACE, &newdt, 1, realMPI, MPI_MIN, MPI_COMM_WORLD,
-                                        &dtReduce));
-          }
-        #endif
+      Kokkos::fence();
+      computeLastLog -= timer.seconds();
+      computeTime -= timer.seconds();
+      // Update Uc & Vs
+      data.EvolveStage();
+      Kokkos::fence();
+      computeLastLog += timer.seconds();
+      computeTime += timer.seconds();
+
+      // evolve dt accordingly
+      data.t += data.dt;
+
+      // Look for Nans every now and then (this actually cost a lot of time on GPUs
+      // because streams are divergent)
+      if(ncycles%checkNanPeriodicity==0) {
+        if(data.CheckNan()>0) {
+          throw std::runtime_error(std::string("Nan found after integration cycle"));
+        }
+      }
+
+      // Compute next time_step during first stage (all of the cells are updated in the first
+      // substep)
+      if(stage==0 && substep==0) {
+        if(data.haveLocalTimestep) {
+          newdt = data.lts->ComputeTimestep(cfl);
+        } else if(!haveFixedDt) {
+          newdt = cfl*data.ComputeTimestep();
+          #ifdef WITH_MPI
+            if(idfx::psize>1) {
+              MPI_SAFE_CALL(MPI_Iallreduce(MPI_IN_PLACE, &newdt, 1, realMPI, MPI_MIN,
+                                           MPI_COMM_WORLD, &dtReduce));
+            }
+          #endif
+        }
       }
-    }
 
-    // Is this not the first stage?
-    if(stage>0) {
-      // do the partial evolution required by the multi-step
-      real wcs=wc[stage-1];
-      real w0s=w0[stage-1];
-      data.states["current"].AddAndStore(wcs, w0s, data.states["begin"]);
+      // Is this not the first stage?
+      if(stage>0) {
+        // do the partial evolution required by the multi-step
+        real wcs=wc[stage-1];
+        real w0s=w0[stage-1];
+        data.states["current"].AddAndStore(wcs, w0s, data.states["begin"]);
 
-      // update t
-      data.t = wcs*data.t + w0s*t0;
-    }
-    // Shift solution according to fargo if this is our last stage
-    if(data.haveFargo && stage==nstages-1) {
-      data.fargo->ShiftSolution(t0,data.dt);
-    }
+        // update t
+        data.t = wcs*data.t + w0s*ts;
+      }
+      // Shift solution according to fargo if this is our last stage
+      if(data.haveFargo && stage==nstages-1) {
+        data.fargo->ShiftSolution(t0,data.dt);
+      }
 
-    // Coarsen conservative variables once they have been evolved
-    if(data.haveGridCoarsening) {
-      data.Coarsen();
-    }
+      // Coarsen conservative variables once they have been evolved
+      if(data.haveGridCoarsening) {
+        data.Coarsen();
+      }
 
-    // Back to using Vc
-    data.ConsToPrim();
+      // Back to using Vc
+      data.ConsToPrim();
 
-    // Add back fargo velocity so that boundary conditions are applied on the total V
-    if(data.haveFargo) data.fargo->AddVelocity(data.t);
+      // Add back fargo velocity so that boundary conditions are applied on the total V
+      if(data.haveFargo) data.fargo->AddVelocity(data.t);
+    }
+    /////////////////////////////////////////////////
+    // END STAGES LOOP                             //
+    /////////////////////////////////////////////////
   }
-  /////////////////////////////////////////////////
-  // END STAGES LOOP                             //
-  /////////////////////////////////////////////////
+  data.dt = dtCycle;
 
   // Wait for dt MPI reduction
 #ifdef WITH_MPI
-  if(!haveFixedDt && idfx::psize>1) {
+  if(!haveFixedDt && !data.haveLocalTimestep && idfx::psize>1) {
     MPI_SAFE_CALL(MPI_Wait(&dtReduce, MPI_STATUS_IGNORE));
   }
 #endif
@@ -363,6 +443,10 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     data.EvolveRKLStage();
   }
 
+  if(haveHallSubcycle && (ncycles%2)==0) {    // Hall subcycles
+    data.EvolveHallStage();
+  }
+
   // Update planet position
   if(data.haveplanetarySystem) {
     data.planetarySystem->EvolveSystem(data, data.dt);
@@ -379,30 +463,43 @@ void TimeIntegrator::Cycle(DataBlock &data) {
   // Update current time (should have already been done, but this gets rid of roundoff errors)
   data.t=t0+data.dt;
 
+  // Largest timestep allowed by the RKL scheme
+  real maxdt = std::numeric_limits<real>::max();
   if(haveRKL) {
     // update next time step
     real tt = newdt/data.hydro->rkl->dt;
     newdt *= std::fmin(ONE_F, data.hydro->rkl->rmax_par/(tt));
+    maxdt = data.hydro->rkl->rmax_par*data.hydro->rkl->dt;
+  }
+  // Same for the number of Hall substeps
+  if(haveHallSubcycle) {
+    real tt = newdt/data.hydro->hallSubcycle->dt;
+    newdt *= std::fmin(ONE_F, data.hydro->hallSubcycle->nmax/(tt));
+    maxdt = std::fmin(maxdt, data.hydro->hallSubcycle->nmax*data.hydro->hallSubcycle->dt);
   }
 
   // Next time step
   if(!haveFixedDt) {
-    if(newdt>cflMaxVar*data.dt) {
-      data.dt=cflMaxVar*data.dt;
+    // With local time stepping, the CFL condition constrains the finest timestep
+    real &dt = data.haveLocalTimestep ? data.lts->dtSub : data.dt;
+    if(newdt>cflMaxVar*dt) {
+      dt=cflMaxVar*dt;
     } else {
-      if(ncycles==0 && newdt < 0.5*data.dt) {
+      if(ncycles==0 && newdt < 0.5*dt) {
         std::stringstream msg;
         msg << "Your guessed first_dt is too large. My next dt=" << newdt << std::endl;
         msg << "Try to reduce first_dt in the ini file.";
         IDEFIX_ERROR(msg);
       }
-      data.dt=newdt;
+      dt=newdt;
     }
-    if(data.dt < 1e-15) {
+    if(dt < 1e-15) {
       std::stringstream msg;
-      msg << "dt = " << data.dt << " is too small.";
+      msg << "dt = " << dt << " is too small.";
       throw std::runtime_error(msg.str());
     }
+    // Group the cells in levels of the finest timestep, which sets the timestep of the cycle
+    if(data.haveLocalTimestep) data.dt = data.lts->SetLevels(maxdt);
   } else {
     data.dt = fixedDt;
   }
@@ -24,6 +24,12 @@ class TimeIntegrator {
   // Do one integration cycle
   void Cycle(DataBlock &);
 
+  // Attach the integrator to a new datablock (after a change of the domain decomposition)
+  void Rebind(DataBlock &);
+
+  // Time spent updating the datablock since the beginning of the run
+  double GetComputeTime() const { return(computeTime); }
+
   // check whether we have reached the maximum runtime
   bool CheckForMaxRuntime();
 
@@ -38,6 +44,9 @@ class TimeIntegrator {
   // Whether we have RKL
   bool haveRKL{false};
 
+  // Whether the Hall effect is subcycled
+  bool haveHallSubcycle{false};
+
   int nstages;
   // Weights of time integrator
   real w0[2];
@@ -54,9 +63,11 @@ class TimeIntegrator {
   int64_t ncycles;        // # of cycles
 
   double computeLastLog;  // Timer for actual computeTime
+  double computeTime{0};  // Same, never reset
 
   double lastLog;         // time for the last log (s)
   double lastMpiLog;      // time for the last MPI log (s)
+  double lastOverlapLog;  // time for the last MPI overlap log (s)
   double lastSGLog;      // time for the last SelfGravity log (s)
   double maxRuntime;      // Maximum runtime requested (disabled when negative)
   int64_t cyclePeriod;    // # of cycles between two logs
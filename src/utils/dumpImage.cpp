@@ -22,6 +22,7 @@ DumpImage::DumpImage(std::string filename, DataBlock *data, bool enableDomainDec
   int ndim;
   IdfxFileHandler fileHdl;
   Dump dump(data);
+  int boxStart[3] = {0, 0, 0};    // Global index of the first cell of the image
 
   idfx::cout << "DumpImage: loading restart file " << filename << "..." << std::flush;
 
@@ -70,6 +71,7 @@ DumpImage::DumpImage(std::string filename, DataBlock *data, bool enableDomainDec
   if(enableDomainDecomposition) {
     #ifdef WITH_MPI
       GridBox gridBox = GetBox(data);
+      for(int dir = 0 ; dir < 3 ; dir++) boxStart[dir] = gridBox.start[dir];
       // Create sub-x domains
       for(int dir = 0 ; dir < 3 ; dir ++) {
         IdefixHostArray1D<real> xLoc("DumpImageX",gridBox.size[dir]);
@@ -139,7 +141,10 @@ DumpImage::DumpImage(std::string filename, DataBlock *data, bool enableDomainDec
                                     ("DumpImage"+fieldName,nxloc[2],nxloc[1],nxloc[0] );
 
         // load the data
-        if(nType==0) {
+        if(type == CompressedType) {
+          dump.ReadCompressed(fileHdl, nxloc, boxStart,
+                              reinterpret_cast<real*>(this->arrays[fieldName].data()) );
+        } else if(nType==0) {
           dump.ReadDistributed(fileHdl, ndim, nxloc, nx, dump.descCR,
                               reinterpret_cast<void*>(this->arrays[fieldName].data()) );
         } else if(nType==1) {
@@ -153,8 +158,13 @@ DumpImage::DumpImage(std::string filename, DataBlock *data, bool enableDomainDec
       } else {
         this->arrays[fieldName] = IdefixHostArray3D<real>("DumpImage"+fieldName,nx[2],nx[1],nx[0]);
         // Load it
-        dump.ReadSerial(fileHdl,ndim,nx,type,
-                        reinterpret_cast<void*>(this->arrays[fieldName].data()));
+        if(type == CompressedType) {
+          dump.ReadCompressed(fileHdl, nx, boxStart,
+                              reinterpret_cast<real*>(this->arrays[fieldName].data()));
+        } else {
+          dump.ReadSerial(fileHdl,ndim,nx,type,
+                          reinterpret_cast<void*>(this->arrays[fieldName].data()));
+        }
       }
     } else if(fieldName.compare("time") == 0) {
       dump.ReadSerial(fileHdl, ndim, nx, type, &this->time);
@@ -0,0 +1,296 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "fft.hpp"
+
+Fft::Fft(Grid *gridIn, std::array<int,3> nlocalIn) {
+  idfx::pushRegion("Fft::Fft");
+  this->grid = gridIn;
+  this->nlocal = nlocalIn;
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    nglob[dir] = nlocal[dir]*grid->nproc[dir];
+    offset[dir] = nlocal[dir]*grid->xproc[dir];
+  }
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    if(nglob[dir] > 1) InitPlan(dir);
+  }
+  idfx::popRegion();
+}
+
+Fft::~Fft() {
+  #ifdef WITH_MPI
+    int finalized;
+    MPI_Finalized(&finalized);
+    if(finalized) return;
+    for(Plan &p : plan) {
+      if(p.nproc > 1) MPI_Comm_free(&p.comm);
+    }
+  #endif
+}
+
+void Fft::InitPlan(int dir) {
+  Plan &p = plan[dir];
+  p.n = nglob[dir];
+  p.nproc = grid->nproc[dir];
+
+  p.m = 1;
+  while(p.m < p.n) p.m *= 2;
+  if(p.m != p.n) {
+    // Bluestein's algorithm needs a convolution of length >= 2n-1
+    p.bluestein = true;
+    p.m = 1;
+    while(p.m < 2*p.n-1) p.m *= 2;
+  }
+
+  // Lines of the local block, shared between the processes of the direction
+  int64_t nblock = 1;
+  for(int d = 0 ; d < 3 ; d++) {
+    if(d != dir) nblock *= nlocal[d];
+  }
+  const int rank = grid->xproc[dir];
+  p.nlines = static_cast<int>(nblock*(rank+1)/p.nproc - nblock*rank/p.nproc);
+
+  // Twiddle factors
+  const int ntw = (p.m > 1) ? p.m/2 : 1;
+  p.twRe = IdefixArray1D<real>("Fft_twRe", ntw);
+  p.twIm = IdefixArray1D<real>("Fft_twIm", ntw);
+  IdefixArray1D<real>::HostMirror twReH = Kokkos::create_mirror_view(p.twRe);
+  IdefixArray1D<real>::HostMirror twImH = Kokkos::create_mirror_view(p.twIm);
+  for(int k = 0 ; k < ntw ; k++) {
+    twReH(k) = std::cos(2.0*M_PI*k/p.m);
+    twImH(k) = -std::sin(2.0*M_PI*k/p.m);
+  }
+  Kokkos::deep_copy(p.twRe, twReH);
+  Kokkos::deep_copy(p.twIm, twImH);
+
+  p.lineRe = IdefixArray2D<real>("Fft_lineRe", p.nlines, p.n);
+  p.lineIm = IdefixArray2D<real>("Fft_lineIm", p.nlines, p.n);
+
+  if(p.bluestein) {
+    p.chirpRe = IdefixArray1D<real>("Fft_chirpRe", p.n);
+    p.chirpIm = IdefixArray1D<real>("Fft_chirpIm", p.n);
+    p.kernelRe = IdefixArray2D<real>("Fft_kernelRe", 1, p.m);
+    p.kernelIm = IdefixArray2D<real>("Fft_kernelIm", 1, p.m);
+    IdefixArray1D<real>::HostMirror cReH = Kokkos::create_mirror_view(p.chirpRe);
+    IdefixArray1D<real>::HostMirror cImH = Kokkos::create_mirror_view(p.chirpIm);
+    IdefixArray2D<real>::HostMirror kReH = Kokkos::create_mirror_view(p.kernelRe);
+    IdefixArray2D<real>::HostMirror kImH = Kokkos::create_mirror_view(p.kernelIm);
+    for(int k = 0 ; k < p.m ; k++) {
+      kReH(0,k) = 0;
+      kImH(0,k) = 0;
+    }
+    for(int k = 0 ; k < p.n ; k++) {
+      // k^2 modulo 2n keeps the phase accurate for large k
+      const int64_t k2 = (static_cast<int64_t>(k)*k) % (2*p.n);
+      cReH(k) = std::cos(M_PI*k2/p.n);
+      cImH(k) = -std::sin(M_PI*k2/p.n);
+      // The convolution kernel is the conjugate chirp, wrapped around
+      kReH(0,k) = cReH(k);
+      kImH(0,k) = -cImH(k);
+      if(k > 0) {
+        kReH(0,p.m-k) = cReH(k);
+        kImH(0,p.m-k) = -cImH(k);
+      }
+    }
+    Kokkos::deep_copy(p.chirpRe, cReH);
+    Kokkos::deep_copy(p.chirpIm, cImH);
+    Kokkos::deep_copy(p.kernelRe, kReH);
+    Kokkos::deep_copy(p.kernelIm, kImH);
+
+    auto kRe = p.kernelRe;
+    auto kIm = p.kernelIm;
+    auto twRe = p.twRe;
+    auto twIm = p.twIm;
+    const int m = p.m;
+    idefix_for("Fft_Kernel", 0, 1,
+      KOKKOS_LAMBDA (int l) {
+        FftRadix2(kRe, kIm, l, m, twRe, twIm, 1.0);
+      });
+
+    p.workRe = IdefixArray2D<real>("Fft_workRe", p.nlines, p.m);
+    p.workIm = IdefixArray2D<real>("Fft_workIm", p.nlines, p.m);
+  }
+
+  #ifdef WITH_MPI
+    if(p.nproc > 1) {
+      int remainDims[3] = {false, false, false};
+      remainDims[dir] = true;
+      MPI_SAFE_CALL(MPI_Cart_sub(grid->CartComm, remainDims, &p.comm));
+      p.sendBuffer = IdefixArray1D<real>("Fft_sendBuffer", 2*nblock*nlocal[dir]);
+      p.recvBuffer = IdefixArray1D<real>("Fft_recvBuffer", 2*p.nlines*p.n);
+    }
+  #endif
+}
+
+void Fft::Transform(IdefixArray3D<real> &re, IdefixArray3D<real> &im, int dir,
+                    Direction direction) {
+  if(dir >= DIMENSIONS || nglob[dir] == 1) return;
+  idfx::pushRegion("Fft::Transform");
+  Plan &p = plan[dir];
+
+  const int ni = nlocal[IDIR];
+  const int nj = nlocal[JDIR];
+  const int nk = nlocal[KDIR];
+  const int nd = nlocal[dir];
+  auto lineRe = p.lineRe;
+  auto lineIm = p.lineIm;
+
+  // Index of the line and position along the line of the element (k,j,i) of the block
+  auto lineIndex = KOKKOS_LAMBDA (int k, int j, int i, int &l, int &a) {
+    if(dir == IDIR) {
+      l = k*nj + j;
+      a = i;
+    } else if(dir == JDIR) {
+      l = k*ni + i;
+      a = j;
+    } else {
+      l = j*ni + i;
+      a = k;
+    }
+  };
+
+  if(p.nproc == 1) {
+    idefix_for("Fft_BlockToLines", 0, nk, 0, nj, 0, ni,
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        int l, a;
+        lineIndex(k, j, i, l, a);
+        lineRe(l,a) = re(k,j,i);
+        lineIm(l,a) = im(k,j,i);
+      });
+    TransformLines(p, direction);
+    idefix_for("Fft_LinesToBlock", 0, nk, 0, nj, 0, ni,
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        int l, a;
+        lineIndex(k, j, i, l, a);
+        re(k,j,i) = lineRe(l,a);
+        im(k,j,i) = lineIm(l,a);
+      });
+  } else {
+  #ifdef WITH_MPI
+    // The lines of the block are split in contiguous chunks, one per process, so that the send
+    // buffer is ordered by line and position along the line.
+    auto sendBuffer = p.sendBuffer;
+    auto recvBuffer = p.recvBuffer;
+    const int nproc = p.nproc;
+    const int nlines = p.nlines;
+    const int64_t nblock = static_cast<int64_t>(ni)*nj*nk/nd;
+    std::vector<int> sendCount(nproc), sendDispl(nproc), recvCount(nproc), recvDispl(nproc);
+    for(int q = 0 ; q < nproc ; q++) {
+      const int64_t lbeg = nblock*q/nproc;
+      const int64_t lend = nblock*(q+1)/nproc;
+      sendCount[q] = static_cast<int>(2*(lend-lbeg)*nd);
+      sendDispl[q] = static_cast<int>(2*lbeg*nd);
+      recvCount[q] = 2*nlines*nd;
+      recvDispl[q] = 2*q*nlines*nd;
+    }
+
+    idefix_for("Fft_PackBlock", 0, nk, 0, nj, 0, ni,
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        int l, a;
+        lineIndex(k, j, i, l, a);
+        const int64_t n = 2*(static_cast<int64_t>(l)*nd + a);
+        sendBuffer(n) = re(k,j,i);
+        sendBuffer(n+1) = im(k,j,i);
+      });
+    Kokkos::fence();
+    idfx::mpiCallsTimer -= MPI_Wtime();
+    MPI_SAFE_CALL(MPI_Alltoallv(sendBuffer.data(), sendCount.data(), sendDispl.data(), realMPI,
+                                recvBuffer.data(), recvCount.data(), recvDispl.data(), realMPI,
+                                p.comm));
+    idfx::mpiCallsTimer += MPI_Wtime();
+    idefix_for("Fft_UnpackLines", 0, nproc, 0, nlines, 0, nd,
+      KOKKOS_LAMBDA (int q, int l, int a) {
+        const int64_t n = 2*((static_cast<int64_t>(q)*nlines + l)*nd + a);
+        lineRe(l,q*nd+a) = recvBuffer(n);
+        lineIm(l,q*nd+a) = recvBuffer(n+1);
+      });
+
+    TransformLines(p, direction);
+
+    // Send the lines back to the blocks
+    idefix_for("Fft_PackLines", 0, nproc, 0, nlines, 0, nd,
+      KOKKOS_LAMBDA (int q, int l, int a) {
+        const int64_t n = 2*((static_cast<int64_t>(q)*nlines + l)*nd + a);
+        recvBuffer(n) = lineRe(l,q*nd+a);
+        recvBuffer(n+1) = lineIm(l,q*nd+a);
+      });
+    Kokkos::fence();
+    idfx::mpiCallsTimer -= MPI_Wtime();
+    MPI_SAFE_CALL(MPI_Alltoallv(recvBuffer.data(), recvCount.data(), recvDispl.data(), realMPI,
+                                sendBuffer.data(), sendCount.data(), sendDispl.data(), realMPI,
+                                p.comm));
+    idfx::mpiCallsTimer += MPI_Wtime();
+    idefix_for("Fft_UnpackBlock", 0, nk, 0, nj, 0, ni,
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        int l, a;
+        lineIndex(k, j, i, l, a);
+        const int64_t n = 2*(static_cast<int64_t>(l)*nd + a);
+        re(k,j,i) = sendBuffer(n);
+        im(k,j,i) = sendBuffer(n+1);
+      });
+  #endif
+  }
+  idfx::popRegion();
+}
+
+void Fft::TransformLines(Plan &p, Direction direction) {
+  auto lineRe = p.lineRe;
+  auto lineIm = p.lineIm;
+  auto twRe = p.twRe;
+  auto twIm = p.twIm;
+  const int n = p.n;
+  const int m = p.m;
+  const real sign = (direction == forward) ? 1.0 : -1.0;
+
+  if(!p.bluestein) {
+    idefix_for("Fft_Radix2", 0, p.nlines,
+      KOKKOS_LAMBDA (int l) {
+        FftRadix2(lineRe, lineIm, l, n, twRe, twIm, sign);
+      });
+  } else {
+    auto workRe = p.workRe;
+    auto workIm = p.workIm;
+    auto cRe = p.chirpRe;
+    auto cIm = p.chirpIm;
+    auto kRe = p.kernelRe;
+    auto kIm = p.kernelIm;
+    idefix_for("Fft_Bluestein", 0, p.nlines,
+      KOKKOS_LAMBDA (int l) {
+        // The backward transform is the conjugate of the forward transform of the conjugate
+        for(int k = 0 ; k < m ; k++) {
+          if(k < n) {
+            const real xr = lineRe(l,k);
+            const real xi = sign*lineIm(l,k);
+            workRe(l,k) = xr*cRe(k) - xi*cIm(k);
+            workIm(l,k) = xr*cIm(k) + xi*cRe(k);
+          } else {
+            workRe(l,k) = 0;
+            workIm(l,k) = 0;
+          }
+        }
+        // Convolution with the kernel
+        FftRadix2(workRe, workIm, l, m, twRe, twIm, 1.0);
+        for(int k = 0 ; k < m ; k++) {
+          const real wr = workRe(l,k);
+          const real wi = workIm(l,k);
+          workRe(l,k) = wr*kRe(0,k) - wi*kIm(0,k);
+          workIm(l,k) = wr*kIm(0,k) + wi*kRe(0,k);
+        }
+        FftRadix2(workRe, workIm, l, m, twRe, twIm, -1.0);
+        for(int k = 0 ; k < n ; k++) {
+          const real wr = workRe(l,k)/m;
+          const real wi = workIm(l,k)/m;
+          lineRe(l,k) = wr*cRe(k) - wi*cIm(k);
+          lineIm(l,k) = sign*(wr*cIm(k) + wi*cRe(k));
+        }
+      });
+  }
+}
@@ -0,0 +1,104 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef UTILS_FFT_HPP_
+#define UTILS_FFT_HPP_
+
+#include <array>
+#include "idefix.hpp"
+#include "grid.hpp"
+
+// Distributed complex Fourier transforms of 3D arrays (without ghost zones) which are
+// decomposed in blocks following the MPI domain decomposition of the grid.
+// A transform along one direction gathers complete lines (pencils) along this direction with
+// an all-to-all exchange between the processes sharing the same position in the other
+// directions, transforms each line, and scatters the lines back to the blocks. Without domain
+// decomposition in that direction, the lines are transformed in place (serial fallback).
+// Lines whose length is a power of 2 use a radix-2 FFT, other lengths use Bluestein's
+// algorithm, so that any grid size is handled in O(N log N).
+class Fft {
+ public:
+  enum Direction {forward, backward};
+
+  // nlocal: size of the local block in each direction
+  Fft(Grid *, std::array<int,3> nlocal);
+  ~Fft();
+
+  // In-place unnormalised transform of (re,im) along dir
+  void Transform(IdefixArray3D<real> &re, IdefixArray3D<real> &im, int dir, Direction);
+
+  std::array<int,3> nlocal;   // Size of the local block
+  std::array<int,3> nglob;    // Size of the full domain
+  std::array<int,3> offset;   // Global index of the first element of the local block
+
+ private:
+  Grid *grid;
+
+  struct Plan {
+    int n{1};         // Length of the transformed lines
+    int m{1};         // Length of the radix-2 transforms (=n, or Bluestein's padded length)
+    bool bluestein{false};
+    int nlines{0};    // Number of lines held by this process while transforming
+    int nproc{1};     // Number of processes sharing the lines
+    IdefixArray1D<real> twRe, twIm;           // radix-2 twiddle factors exp(-2 i pi k/m)
+    IdefixArray1D<real> chirpRe, chirpIm;     // Bluestein chirp exp(-i pi k^2/n)
+    IdefixArray2D<real> kernelRe, kernelIm;   // FFT of the Bluestein convolution kernel
+    IdefixArray2D<real> lineRe, lineIm;       // Lines being transformed
+    IdefixArray2D<real> workRe, workIm;       // Bluestein work arrays
+    #ifdef WITH_MPI
+    MPI_Comm comm;                            // Processes sharing the lines
+    IdefixArray1D<real> sendBuffer, recvBuffer;
+    #endif
+  };
+  std::array<Plan,3> plan;
+
+  void InitPlan(int dir);
+  void TransformLines(Plan &, Direction);
+};
+
+// In-place radix-2 FFT of the line l of (re,im), of length m (power of 2), with the twiddle
+// factors exp(-2 i pi k/m), k < m/2. sign=+1 for the forward transform, -1 for backward.
+template <typename ViewType>
+KOKKOS_INLINE_FUNCTION void FftRadix2(ViewType re, ViewType im, const int l, const int m,
+                                      IdefixArray1D<real> twRe, IdefixArray1D<real> twIm,
+                                      const real sign) {
+  // Bit reversal permutation
+  for(int i = 1, j = 0 ; i < m ; i++) {
+    int bit = m >> 1;
+    for( ; j & bit ; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if(i < j) {
+      real t = re(l,i);
+      re(l,i) = re(l,j);
+      re(l,j) = t;
+      t = im(l,i);
+      im(l,i) = im(l,j);
+      im(l,j) = t;
+    }
+  }
+  // Butterflies
+  for(int len = 2 ; len <= m ; len <<= 1) {
+    const int half = len >> 1;
+    const int stride = m / len;
+    for(int i = 0 ; i < m ; i += len) {
+      for(int k = 0 ; k < half ; k++) {
+        const real wr = twRe(k*stride);
+        const real wi = sign*twIm(k*stride);
+        const int a = i + k;
+        const int b = a + half;
+        const real tr = re(l,b)*wr - im(l,b)*wi;
+        const real ti = re(l,b)*wi + im(l,b)*wr;
+        re(l,b) = re(l,a) - tr;
+        im(l,b) = im(l,a) - ti;
+        re(l,a) += tr;
+        im(l,a) += ti;
+      }
+    }
+  }
+}
+
+#endif // UTILS_FFT_HPP_
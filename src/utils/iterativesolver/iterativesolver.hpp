@@ -8,6 +8,7 @@
 #ifndef UTILS_ITERATIVESOLVER_ITERATIVESOLVER_HPP_
 #define UTILS_ITERATIVESOLVER_ITERATIVESOLVER_HPP_
 
+#include <functional>
 #include <vector>
 #include "idefix.hpp"
 #include "vector.hpp"
@@ -15,6 +16,9 @@
 template <class T>
 class IterativeSolver {
  public:
+  // Preconditioner: out = M^-1 in, where M is an approximation of the linear operator
+  using Preconditioner = std::function<void(IdefixArray3D<real> &, IdefixArray3D<real> &)>;
+
   IterativeSolver(T &op, real error, int maxIter,
                   std::array<int,3> ntot, std::array<int,3> beg, std::array<int,3> end);
 
@@ -22,6 +26,8 @@ class IterativeSolver {
 
   virtual int Solve(IdefixArray3D<real> &guess, IdefixArray3D<real> &rhs) = 0;
   virtual void ShowConfig() = 0;
+  // Enroll a preconditioner (only used by the solvers which support it)
+  void SetPreconditioner(Preconditioner);
 
   // Internal functions (left public for Lambda capture)
   void SetRes();  // Set residual from current guess
@@ -37,6 +43,8 @@ class IterativeSolver {
   int maxiter;        // Maximum iteration allowed to achieve convergence
   bool convStatus;    // Convergence status
   bool restart{false};
+  bool havePreconditioner{false};
+  Preconditioner preconditioner;
   static constexpr bool isVerbose{false}; // Whether the solver should be verbose while iterating
 
   std::array<int,3> beg;
@@ -308,6 +316,12 @@ real IterativeSolver<T>::ComputeDotProduct(IdefixArray3D<real> mat1, IdefixArray
 }
 
 
+template <class T>
+void IterativeSolver<T>::SetPreconditioner(Preconditioner func) {
+  this->preconditioner = func;
+  this->havePreconditioner = true;
+}
+
 template <class T>
 real IterativeSolver<T>::GetError() {
   return(currentError);
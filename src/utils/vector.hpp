@@ -35,10 +35,10 @@ typedef Vector<real,2> MyVector;
 
 // Define the reduction operator in Kokkos space
 namespace Kokkos {
-template<>
-struct reduction_identity< MyVector > {
-    KOKKOS_FORCEINLINE_FUNCTION static MyVector sum() {
-       return MyVector();
+template<class T, int N>
+struct reduction_identity< Vector<T,N> > {
+    KOKKOS_FORCEINLINE_FUNCTION static Vector<T,N> sum() {
+       return Vector<T,N>();
     }
 };
 }
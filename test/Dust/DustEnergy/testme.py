@@ -25,6 +25,14 @@ def testMe(test):
     test.standardTest()
     test.nonRegressionTest(filename=name)
 
+  # Size drag (whose sound speed depends on the energy), with the separate and the batched
+  # dust species, which should give the same results
+  test.run(inputFile="idefix-size.ini")
+  os.rename(name,"dump-nobatch.dmp")
+  test.run(inputFile="idefix-size-batch.ini")
+  test.compareDump("dump-nobatch.dmp",name,tolerance=1e-14)
+  os.remove("dump-nobatch.dmp")
+
 
 test=tst.idfxTest()
 
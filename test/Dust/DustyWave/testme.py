@@ -15,15 +15,23 @@ name="dump.0001.dmp"
 def testMe(test):
   test.configure()
   test.compile()
-  inifiles=["idefix.ini"]
+  inifiles=["idefix.ini","idefix-implicit.ini"]
 
   # loop on all the ini files for this test
   for ini in inifiles:
     test.run(inputFile=ini)
-    if test.init:
+    if test.init and ini=="idefix.ini":
       test.makeReference(filename=name)
     test.standardTest()
-    test.nonRegressionTest(filename=name,tolerance=1e-14)
+    # The implicit drag is only checked against the analytical decay rate
+    if ini=="idefix.ini":
+      test.nonRegressionTest(filename=name,tolerance=1e-14)
+      os.rename(name,"dump-nobatch.dmp")
+
+  # The batched dust species should give the same results as the separate species
+  test.run(inputFile="idefix-batch.ini")
+  test.compareDump("dump-nobatch.dmp",name,tolerance=1e-14)
+  os.remove("dump-nobatch.dmp")
 
 
 test=tst.idfxTest()
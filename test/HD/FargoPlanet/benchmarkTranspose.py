@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+
+"""
+Compare the performances of the Fargo shift with a domain decomposition along the azimuth when
+the ghost cells needed by the shift are exchanged with the neighbours (default, limited by
+maxShift) and when the full azimuthal rings are transposed between the processes (transpose in
+[Fargo]), and check that both give identical results. The azimuthal resolution is increased so
+that each process has a sizeable subdomain, with a maxShift large enough for its time step.
+
+Usage (e.g. on 8 processes):
+  ./benchmarkTranspose.py -dec 1 8
+
+"""
+import os
+import sys
+sys.path.append(os.getenv("IDEFIX_DIR"))
+
+import pytools.idfx_test as tst
+
+modes=[["ghosts",    "false"],
+       ["transpose", "true"]]
+
+test=tst.idfxTest()
+test.mpi=True
+if not test.dec:
+  test.dec=['1','4']
+test.configure()
+test.compile()
+
+with open("idefix.ini","r") as file:
+  ini=file.read()
+
+perfs={}
+for mode, transpose in modes:
+  with open("idefix-benchmark.ini","w") as file:
+    for line in ini.splitlines():
+      if line.startswith("X2-grid"):
+        line="X2-grid    1  0.0      1024  u  6.283185307179586"
+      if line.startswith("tstop"):
+        line="tstop       1.0"
+      if line.startswith("vtk"):
+        continue
+      if line.startswith("dmp"):
+        line="dmp    1.0"
+      file.write(line+"\n")
+      if line.startswith("[Fargo]"):
+        file.write("maxShift    32\n")
+        file.write("transpose   "+transpose+"\n")
+  test.run(inputFile="idefix-benchmark.ini")
+  perfs[mode]=test.perf
+  os.rename("dump.0001.dmp","dump-"+mode+".dmp")
+os.remove("idefix-benchmark.ini")
+
+test.compareDump("dump-ghosts.dmp","dump-transpose.dmp")
+for mode, transpose in modes:
+  os.remove("dump-"+mode+".dmp")
+
+print(tst.bcolors.OKCYAN+"**************************************************************")
+print("Fargo transpose benchmark on %d processes (cell updates/second)"%
+      (int(test.dec[0])*int(test.dec[1])))
+for mode, transpose in modes:
+  print("%10s: %e (%.2fx)"%(mode,perfs[mode],perfs[mode]/perfs[modes[0][0]]))
+print("**************************************************************"+tst.bcolors.ENDC)
@@ -26,6 +26,17 @@ def testMe(test):
     test.standardTest()
     test.nonRegressionTest(filename="dump.0001.dmp",tolerance=mytol)
 
+  # With MPI, a zero imbalance threshold forces the domain to be rebalanced during the run, which
+  # should not change the results beyond round-off errors
+  if test.mpi:
+    test.run(inputFile="idefix.ini")
+    os.rename("dump.0001.dmp","dump-static.dmp")
+    test.run(inputFile="idefix-balance.ini")
+    with open("idefix.0.log","r") as file:
+      assert "rebalance #" in file.read(), "The domain has not been rebalanced"
+    test.compareDump("dump-static.dmp","dump.0001.dmp",tolerance=tolerance)
+    os.remove("dump-static.dmp")
+
 
 test=tst.idfxTest()
 if not test.dec:
@@ -27,11 +27,24 @@ def testMe(test):
     if test.init and not test.mpi:
       test.makeReference(filename="dump.0001.dmp")
 
-    if(test.single):
+    if(test.single or test.mixed):
       mytol=1e-5
 
     test.nonRegressionTest(filename="dump.0001.dmp",tolerance=mytol)
 
+  # These variants of idefix-hlld.ini only change how the computation is organised, so that they
+  # are compared to it rather than to references of their own
+  variants=["idefix-hlld-fused.ini","idefix-hlld-neighbour.ini","idefix-hlld-overlap.ini"]
+  mytol=tolerance
+  if(test.single or test.mixed):
+    mytol=1e-5
+  test.run(inputFile="idefix-hlld.ini")
+  os.rename("dump.0001.dmp","dump-hlld.dmp")
+  for ini in variants:
+    test.run(inputFile=ini)
+    test.compareDump("dump-hlld.dmp","dump.0001.dmp",tolerance=mytol)
+  os.remove("dump-hlld.dmp")
+
 
 test=tst.idfxTest()
 if not test.dec:
@@ -59,8 +72,13 @@ else:
   test.single=True
   testMe(test)
 
-  # Vector potential validation
+  # mixed precision validation
   test.single=False
+  test.mixed=True
+  testMe(test)
+
+  # Vector potential validation
+  test.mixed=False
   test.mpi=False
   test.vectPot=True
   testMe(test)
@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+
+"""
+Compare the performances of the directional (default) and neighbour ghost zone exchanges
+on the 3D Orszag-Tang vortex, for several sizes of the MPI sub-domains. The neighbour
+exchange is expected to be faster on small sub-domains, where the exchange is latency bound.
+
+Usage (e.g. on 8 MPI processes):
+  ./benchmarkExchange.py -mpi -dec 2 2 2
+
+"""
+import os
+import sys
+sys.path.append(os.getenv("IDEFIX_DIR"))
+
+import pytools.idfx_test as tst
+
+exchanges=["directional","neighbour"]
+# Number of cells of each sub-domain in each direction
+subSizes=[8,16,32]
+
+test=tst.idfxTest()
+test.mpi=True
+if not test.dec:
+  test.dec=['2','2','2']
+
+test.configure()
+test.compile()
+
+with open("idefix.ini","r") as file:
+  ini=file.read()
+
+perfs={}
+for size in subSizes:
+  grid=["X%d-grid    1  0.0  %d  u  1.0"%(n+1,size*int(test.dec[n])) for n in range(3)]
+  for exchange in exchanges:
+    with open("idefix-benchmark.ini","w") as file:
+      for line in ini.splitlines():
+        if line.startswith("X") and "-grid" in line:
+          line=grid[int(line[1])-1]
+        # Short run without outputs
+        if line.startswith("tstop"):
+          line="tstop       0.02"
+        if line.startswith("vtk") or line.startswith("dmp"):
+          continue
+        if line.startswith("[Output]"):
+          file.write("[Parallel]\nexchange    "+exchange+"\n\n")
+        file.write(line+"\n")
+    test.run(inputFile="idefix-benchmark.ini")
+    perfs[(size,exchange)]=test.perf
+
+os.remove("idefix-benchmark.ini")
+
+print(tst.bcolors.OKCYAN+"**************************************************************")
+print("Ghost zone exchange benchmark (cell updates/second/process)")
+for size in subSizes:
+  print("Sub-domains of %d^3 cells:"%size)
+  for exchange in exchanges:
+    print("%12s: %e (%.2fx)"%(exchange,perfs[(size,exchange)],
+                              perfs[(size,exchange)]/perfs[(size,exchanges[0])]))
+print("**************************************************************"+tst.bcolors.ENDC)
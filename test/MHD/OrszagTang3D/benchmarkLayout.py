@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+
+"""
+Compare the performances of the SoA (default) and AoS layouts of the field arrays
+on the 3D Orszag-Tang vortex.
+
+Usage (e.g. on CPUs with OpenMP):
+  OMP_NUM_THREADS=8 ./benchmarkLayout.py -cmake Kokkos_ENABLE_OPENMP=ON
+
+"""
+import os
+import sys
+sys.path.append(os.getenv("IDEFIX_DIR"))
+
+import pytools.idfx_test as tst
+
+layouts=["SoA","AoS"]
+
+test=tst.idfxTest()
+cmakeOpts=test.cmake
+perfs={}
+
+for layout in layouts:
+  test.cmake=cmakeOpts+["Idefix_FIELD_LAYOUT="+layout]
+  test.configure()
+  test.compile()
+  test.run(inputFile="idefix.ini")
+  perfs[layout]=test.perf
+
+print(tst.bcolors.OKCYAN+"**************************************************************")
+print("Field layout benchmark (cell updates/second)")
+for layout in layouts:
+  print("%4s: %e (%.2fx)"%(layout,perfs[layout],perfs[layout]/perfs[layouts[0]]))
+print("**************************************************************"+tst.bcolors.ENDC)
@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+
+"""
+Compare the performances of the untiled (default) and tiled stages on the 3D Orszag-Tang
+vortex and on the 3D spherical disk (../diskSpherical), for several tile sizes. Tiles are
+expected to be faster on CPUs, when the working set of the stage exceeds the caches.
+
+Usage (e.g. on CPUs with OpenMP):
+  OMP_NUM_THREADS=8 ./benchmarkTiling.py -cmake Kokkos_ENABLE_OPENMP=ON
+
+"""
+import os
+import sys
+sys.path.append(os.getenv("IDEFIX_DIR"))
+
+import pytools.idfx_test as tst
+
+# Problems: name, test directory, end time of the (short) runs
+problems=[["OrszagTang3D",  ".",                 "0.02"],
+          ["diskSpherical", "../diskSpherical",  "0.5"]]
+# Tile sizes (none: untiled)
+tileSizes=[None, "16 8 8", "32 8 8", "64 4 4"]
+
+testDir=os.path.dirname(os.path.abspath(__file__))
+
+perfs={}
+for name, directory, tstop in problems:
+  os.chdir(os.path.join(testDir, directory))
+  test=tst.idfxTest()
+  test.configure()
+  test.compile()
+
+  with open("idefix.ini","r") as file:
+    ini=file.read()
+
+  for tileSize in tileSizes:
+    with open("idefix-benchmark.ini","w") as file:
+      for line in ini.splitlines():
+        if line.startswith("tstop"):
+          line="tstop       "+tstop
+        if line.startswith("vtk") or line.startswith("dmp"):
+          continue
+        file.write(line+"\n")
+        if line.startswith("[Hydro]") and tileSize:
+          file.write("tileSize    "+tileSize+"\n")
+    test.run(inputFile="idefix-benchmark.ini")
+    perfs[(name,tileSize)]=test.perf
+  os.remove("idefix-benchmark.ini")
+
+print(tst.bcolors.OKCYAN+"**************************************************************")
+print("Tiled stage benchmark (cell updates/second)")
+for name, directory, tstop in problems:
+  print(name+":")
+  for tileSize in tileSizes:
+    print("%12s: %e (%.2fx)"%(tileSize or "untiled", perfs[(name,tileSize)],
+                              perfs[(name,tileSize)]/perfs[(name,None)]))
+print("**************************************************************"+tst.bcolors.ENDC)
@@ -7,12 +7,34 @@ import os
 import sys
 sys.path.append(os.getenv("IDEFIX_DIR"))
 
+import numpy as np
 import pytools.idfx_test as tst
+from pytools.dump_io import readDump
 
 # Whether we should reset our reference run (only do that on purpose!)
 
 tolerance=1e-13
 
+def checkInSitu(tol):
+  # Compare the in-situ reductions with the ones computed from the dump written at the same time
+  V=readDump("dump.0001.dmp")
+  t=V.data["time"][0]
+  integrals=np.loadtxt("insitu.dat")
+  names=open("insitu.dat").readline().split()[1:]
+  row=integrals[np.argmin(np.abs(integrals[:,0]-t))]
+  mass=integrals[:,names.index("mass")]
+  assert np.all(np.abs(mass/mass[0]-1) < tol), "Mass is not conserved in insitu.dat"
+  dV=1.0/V.data["Vc-RHO"].size
+  rho=V.data["Vc-RHO"]
+  ekin=0.5*np.sum(rho*(V.data["Vc-VX1"]**2+V.data["Vc-VX2"]**2+V.data["Vc-VX3"]**2))*dV
+  assert abs(row[names.index("kinetic")]/ekin-1) < tol, "Wrong in-situ kinetic energy"
+  profiles=np.loadtxt("insitu_average1.dat")
+  profile=profiles[np.argmin(np.abs(profiles[:,0]-t)),1:1+rho.shape[0]]
+  assert np.max(np.abs(profile-np.mean(rho,axis=(1,2)))) < tol, "Wrong in-situ average"
+  hist=np.loadtxt("insitu_hist1.dat")
+  assert np.all(np.abs(np.sum(hist[:,1:],axis=1)-1) < tol), "In-situ histogram is not normalised"
+  print("In-situ analysis check succeeded")
+
 def testMe(test):
   test.configure()
   test.compile()
@@ -27,12 +49,41 @@ def testMe(test):
           test.makeReference(filename="dump.0001.dmp")
   test.nonRegressionTest(filename="dump.0001.dmp",tolerance=tol)
 
+  # Same run, with the dumps written in the background
+  test.run("idefix-asyncdump.ini")
+  test.inifile="idefix.ini"
+  test.nonRegressionTest(filename="dump.0001.dmp",tolerance=tol)
+
+  # Same run, with compressed dumps (lossy tracers)
+  test.run("idefix-compressdump.ini")
+  test.inifile="idefix.ini"
+  test.nonRegressionTest(filename="dump.0001.dmp",tolerance=tol)
+
+  # Same run, computed tile by tile
+  test.run("idefix-tiled.ini")
+  test.inifile="idefix.ini"
+  test.nonRegressionTest(filename="dump.0001.dmp",tolerance=tol)
+
+  # Same run, with in-situ reductions checked against the dump
+  for f in ["insitu.dat","insitu_average1.dat","insitu_hist1.dat"]:
+    if os.path.exists(f):
+      os.remove(f)
+  test.run("idefix-insitu.ini")
+  test.inifile="idefix.ini"
+  test.nonRegressionTest(filename="dump.0001.dmp",tolerance=tol)
+  checkInSitu(max(tol,1e-10))
+
   # Check restarts
   test.run("idefix-checkrestart.ini")
   #force override the inputfile since the result should be identical
   test.inifile="idefix.ini"
   test.nonRegressionTest(filename="dump.0002.dmp",tolerance=tol)
 
+  # Check restarts from compressed dumps
+  test.run("idefix-compressrestart.ini")
+  test.inifile="idefix.ini"
+  test.nonRegressionTest(filename="dump.0002.dmp",tolerance=tol)
+
 
 test=tst.idfxTest()
 
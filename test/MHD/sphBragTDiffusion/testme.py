@@ -25,6 +25,13 @@ def testMe(test):
       test.makeReference(filename=name)
     test.nonRegressionTest(filename=name, tolerance=2e-15)
 
+  # The face differences shared between the thermal diffusion modules should give the same results
+  test.run(inputFile="idefix-diffusive.ini")
+  os.rename(name,"dump-separate.dmp")
+  test.run(inputFile="idefix-diffusive-shared.ini")
+  test.compareDump("dump-separate.dmp",name)
+  os.remove("dump-separate.dmp")
+
 
 test=tst.idfxTest()
 
@@ -28,6 +28,13 @@ def testMe(test):
 
     test.nonRegressionTest(filename=name, tolerance=1e-15)
 
+  # The face differences shared between the viscosity modules should give the same results
+  test.run(inputFile="idefix-viscous.ini")
+  os.rename(name,"dump-separate.dmp")
+  test.run(inputFile="idefix-viscous-shared.ini")
+  test.compareDump("dump-separate.dmp",name)
+  os.remove("dump-separate.dmp")
+
 
 test=tst.idfxTest()
 
@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+
+"""
+Compare the performances of the planet kernels when the cartesian coordinates of the cells
+are computed from the separable sin/cos arrays of the DataBlock (default) and when they are
+read from 3D arrays (cartesianCache in [Memory]), and show the number of transcendental calls
+saved per planet kernel with respect to computing the coordinates from the spherical
+coordinates in each kernel.
+
+Usage (e.g. on CPUs with OpenMP):
+  OMP_NUM_THREADS=8 ./benchmarkCoordinates.py -cmake Kokkos_ENABLE_OPENMP=ON
+
+"""
+import os
+import sys
+sys.path.append(os.getenv("IDEFIX_DIR"))
+
+import pytools.idfx_test as tst
+
+modes=[["separable", "false"],
+       ["cached",    "true"]]
+
+test=tst.idfxTest()
+test.configure()
+test.compile()
+
+with open("idefix.ini","r") as file:
+  ini=file.read()
+
+# Number of cells of the grid (including 2 ghost cells on each side)
+ncells=[]
+for line in ini.splitlines():
+  if line.startswith("X1-grid") or line.startswith("X2-grid") or line.startswith("X3-grid"):
+    ncells.append(int(line.split()[3])+4)
+
+perfs={}
+for mode, cache in modes:
+  with open("idefix-benchmark.ini","w") as file:
+    for line in ini.splitlines():
+      if line.startswith("vtk") or line.startswith("dmp") or line.startswith("analysis"):
+        continue
+      if line.startswith("[Output]"):
+        file.write("[Memory]\ncartesianCache    "+cache+"\n\n")
+      file.write(line+"\n")
+  test.run(inputFile="idefix-benchmark.ini")
+  perfs[mode]=test.perf
+os.remove("idefix-benchmark.ini")
+
+# sin(th), cos(th), sin(phi) and cos(phi) per cell in each kernel, against one evaluation per
+# point of the separable arrays in MakeGeometry
+ntot=ncells[0]*ncells[1]*ncells[2]
+saved=4*ntot
+once=2*(ncells[1]+ncells[2])
+
+print(tst.bcolors.OKCYAN+"**************************************************************")
+print("Cartesian coordinates benchmark (cell updates/second)")
+for mode, cache in modes:
+  print("%10s: %e (%.2fx)"%(mode,perfs[mode],perfs[mode]/perfs[modes[0][0]]))
+print("Transcendental calls saved per planet kernel: %d (%d computed once)"%(saved,once))
+print("**************************************************************"+tst.bcolors.ENDC)
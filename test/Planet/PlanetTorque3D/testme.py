@@ -27,6 +27,14 @@ def testMe(test):
     test.standardTest()
     test.nonRegressionTest(filename=name,tolerance=tolerance)
 
+  # The cartesian coordinates stored in 3D arrays hold the values computed from the separable
+  # arrays, so the results should be identical
+  os.rename(name,"dump-separable.dmp")
+  test.run(inputFile="idefix-cache.ini")
+  test.standardTest()
+  test.compareDump("dump-separable.dmp",name)
+  os.remove("dump-separable.dmp")
+
 
 test=tst.idfxTest()
 if not test.dec:
@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+
+"""
+Compare the performances of the direct FFT Poisson solver and of the BICGSTAB solver
+on the periodic random sphere, for several grid sizes. Each time step solves the Poisson
+equation, so that the code performance is dominated by the self-gravity solver.
+
+Usage (e.g. on 4 MPI processes):
+  ./benchmarkFFT.py -mpi -dec 2 2 1
+
+"""
+import os
+import sys
+sys.path.append(os.getenv("IDEFIX_DIR"))
+
+import pytools.idfx_test as tst
+
+solvers=["BICGSTAB","FFT"]
+# Number of cells of the grid in each direction
+sizes=[32,64,128]
+
+test=tst.idfxTest()
+
+test.configure()
+test.compile()
+
+with open("idefix.ini","r") as file:
+  ini=file.read()
+
+perfs={}
+for size in sizes:
+  for solver in solvers:
+    with open("idefix-benchmark.ini","w") as file:
+      for line in ini.splitlines():
+        if line.startswith("X") and "-grid" in line:
+          line="X%s-grid    1  -0.5  %d  u  0.5"%(line[1],size)
+        # Short run without outputs
+        if line.startswith("tstop"):
+          line="tstop          1.e-3"
+        if line.startswith("solver") and "roe" not in line:
+          line="solver             "+solver
+        if line.startswith("vtk"):
+          continue
+        file.write(line+"\n")
+    test.run(inputFile="idefix-benchmark.ini")
+    perfs[(size,solver)]=test.perf
+
+os.remove("idefix-benchmark.ini")
+
+print(tst.bcolors.OKCYAN+"**************************************************************")
+print("Self-gravity solver benchmark (cell updates/second/process)")
+for size in sizes:
+  print("Grid of %d^3 cells:"%size)
+  for solver in solvers:
+    print("%12s: %e (%.2fx)"%(solver,perfs[(size,solver)],
+                              perfs[(size,solver)]/perfs[(size,solvers[0])]))
+print("**************************************************************"+tst.bcolors.ENDC)
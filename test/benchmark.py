@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+
+"""
+Performance benchmark suite of Idefix. Each problem of the matrix below is compiled with the
+current configuration options (see pytools/idfx_test.py), and run for a fixed number of cycles
+on several grid sizes (the resolution of the input file multiplied by each scale factor) and
+numbers of threads. The performances of each run (cell updates/second, time spent in each
+profiler region, maximum memory usage of each memory space and MPI overhead) are gathered in a
+single JSON file, which can be compared to the results of another commit with -reference.
+
+Usage (e.g. with 4 OpenMP threads and 2 MPI processes, comparing to a previous run):
+  ./benchmark.py -mpi -np 2 -threads 1 4 -reference benchmark-ref.json
+
+This script is also called by the "benchmark" target of the cmake build.
+"""
+import argparse
+import datetime
+import json
+import os
+import platform
+import subprocess
+import sys
+sys.path.append(os.getenv("IDEFIX_DIR"))
+
+import pytools.idfx_test as tst
+
+# Problems of the benchmark: name, test directory, input file
+problems=[["HD-sod",             "HD/sod",                           "idefix.ini"],
+          ["MHD-OrszagTang3D",   "MHD/OrszagTang3D",                 "idefix.ini"],
+          ["HD-FargoPlanet",     "HD/FargoPlanet",                   "idefix.ini"],
+          ["SelfGravity",        "SelfGravity/RandomSphereCartesian", "idefix.ini"],
+          ["HD-ViscosityRKL",    "HD/ViscousFlowPastCylinder",       "idefix-rkl.ini"],
+          ["Dust-FargoPlanet",   "Dust/FargoPlanet",                 "idefix.ini"]]
+
+parser = argparse.ArgumentParser()
+parser.add_argument("-output",
+                    default="benchmark.json",
+                    help="JSON file of the results (default benchmark.json)")
+parser.add_argument("-cycles",
+                    default=50,
+                    type=int,
+                    help="number of integration cycles of each run (default 50)")
+parser.add_argument("-scales",
+                    nargs="+",
+                    default=[1,2],
+                    type=int,
+                    help="factors applied to the resolution of the input files (default 1 2)")
+parser.add_argument("-threads",
+                    nargs="+",
+                    default=[],
+                    type=int,
+                    help="numbers of OpenMP threads (default: unchanged environment)")
+parser.add_argument("-np",
+                    default=1,
+                    type=int,
+                    help="number of MPI processes, when -mpi is enabled (default 1)")
+parser.add_argument("-problems",
+                    nargs="+",
+                    default=[p[0] for p in problems],
+                    help="subset of the problems of the benchmark")
+parser.add_argument("-reference",
+                    help="JSON file of a previous benchmark to be compared with")
+args, unknown=parser.parse_known_args()
+
+testDir=os.path.dirname(os.path.abspath(__file__))
+output=os.path.abspath(args.output)
+
+def scaleGrid(line, scale):
+  # X?-grid  npatch  x0  n0  type0  x1  n1  type1  x2 ...
+  tokens=line.split()
+  for p in range(int(tokens[1])):
+    n=int(tokens[3+3*p])
+    # Directions with a single cell are not active
+    if n>1:
+      tokens[3+3*p]=str(n*scale)
+  return "  ".join(tokens)
+
+def writeIni(inifile, scale):
+  with open(inifile,"r") as file:
+    ini=file.read()
+  with open("idefix-benchmark.ini","w") as file:
+    for line in ini.splitlines():
+      if line.startswith("X") and "-grid" in line:
+        line=scaleGrid(line, scale)
+      # The runs are stopped by -maxcycles
+      if line.startswith("tstop"):
+        line="tstop       1.0e30"
+      file.write(line+"\n")
+
+def runBenchmark(test, threads):
+  comm=["./idefix", "-i", "idefix-benchmark.ini", "-maxcycles", str(args.cycles), "-nowrite",
+        "-benchmark", "idefix-benchmark.json"]
+  if test.mpi:
+    comm=["mpirun", "-np", str(args.np)]+comm
+  env=dict(os.environ)
+  if threads:
+    env["OMP_NUM_THREADS"]=str(threads)
+  try:
+    run=subprocess.run(comm, env=env)
+    run.check_returncode()
+  except subprocess.CalledProcessError as e:
+    print(tst.bcolors.FAIL+"***************************************************")
+    print("Benchmark execution failed")
+    print("***************************************************"+tst.bcolors.ENDC)
+    raise e
+  with open("idefix-benchmark.json","r") as file:
+    result=json.load(file)
+  os.remove("idefix-benchmark.json")
+  return result
+
+commit=subprocess.run(["git", "-C", testDir, "rev-parse", "HEAD"],
+                      capture_output=True, text=True).stdout.strip()
+results={"commit": commit,
+         "date": datetime.datetime.now().isoformat(),
+         "host": platform.node(),
+         "cycles": args.cycles,
+         "runs": []}
+
+for name, directory, inifile in problems:
+  if name not in args.problems:
+    continue
+  os.chdir(os.path.join(testDir, directory))
+  test=tst.idfxTest()
+  test.configure()
+  test.compile()
+  for scale in args.scales:
+    writeIni(inifile, scale)
+    for threads in args.threads or [0]:
+      run=runBenchmark(test, threads)
+      run.update({"problem": name, "inifile": inifile, "scale": scale, "threads": threads})
+      results["runs"].append(run)
+  os.remove("idefix-benchmark.ini")
+
+with open(output,"w") as file:
+  json.dump(results, file, indent=2)
+
+print(tst.bcolors.OKCYAN+"**************************************************************")
+print("Idefix benchmark (cell updates/second), results written in "+output)
+reference={}
+if args.reference:
+  with open(args.reference,"r") as file:
+    ref=json.load(file)
+  print("Compared to commit "+ref["commit"])
+  for run in ref["runs"]:
+    reference[(run["problem"], run["scale"], run["threads"])]=run["cellUpdatesPerSecond"]
+for run in results["runs"]:
+  key=(run["problem"], run["scale"], run["threads"])
+  line="%20s  scale %2d  threads %3d: %e  (MPI %4.1f%%)"%(key[0], key[1], key[2],
+                                                         run["cellUpdatesPerSecond"],
+                                                         100*run["mpiOverhead"])
+  if key in reference:
+    line+="  %+.1f%%"%(100*(run["cellUpdatesPerSecond"]/reference[key]-1))
+  print(line)
+print("**************************************************************"+tst.bcolors.ENDC)